@@ -4,13 +4,15 @@
 
 #include "Core/Assets/Resource.hpp"
 #include "Core/Object.hpp"
+#include "Utils/StringId.hpp"
 
+#include <chrono>
 #include <unordered_map>
 
 namespace Stone::Core::Assets {
 
 class Bundle : public Object {
-	STONE_OBJECT(Bundle)
+	STONE_OBJECT(Bundle, Object)
 
 public:
 	Bundle(const Bundle &other) = delete;
@@ -23,24 +25,36 @@ public:
 
 	template <typename ResourceType, typename... Args>
 	std::shared_ptr<ResourceType> loadResource(const std::string &filepath, Args... args) {
-		const std::string &reducedPath = reducePath(filepath);
+		StringId reducedPath(reducePath(filepath));
 		auto it = _resources.find(reducedPath);
 		if (it != _resources.end()) {
 			return std::static_pointer_cast<ResourceType>(it->second);
 		}
 		auto thisBundle = std::static_pointer_cast<Bundle>(shared_from_this());
-		auto resource = std::make_shared<ResourceType>(thisBundle, reducedPath, std::forward<Args>(args)...);
+		auto loadBegin = std::chrono::steady_clock::now();
+		auto resource = std::make_shared<ResourceType>(thisBundle, reducedPath.str(), std::forward<Args>(args)...);
 		_resources[reducedPath] = resource;
+		_resourceLoaded(std::chrono::steady_clock::now() - loadBegin);
 		return resource;
 	}
 
 	std::shared_ptr<Resource> getResource(const std::string &filepath) const;
 
+	/**
+	 * @brief Get a loaded resource from its path already reduced with `reducePath`, without hashing the path.
+	 */
+	std::shared_ptr<Resource> getResource(StringId reducedPath) const;
+
 	const std::string &getRootDirectory() const;
 
 	static std::string reducePath(const std::string &path);
 
 protected:
+	/**
+	 * @brief Report a newly loaded resource and its loading time to the engine metrics.
+	 */
+	static void _resourceLoaded(std::chrono::steady_clock::duration loadTime);
+
 	/**
 	 * @brief The root directory of the bundle
 	 */
@@ -49,7 +63,7 @@ protected:
 	/**
 	 * @brief The map of resources indexed by their filename shortned path
 	 */
-	std::unordered_map<std::string, std::shared_ptr<Resource>> _resources;
+	std::unordered_map<StringId, std::shared_ptr<Resource>> _resources;
 };
 
 } // namespace Stone::Core::Assets
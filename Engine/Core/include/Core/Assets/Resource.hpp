@@ -12,7 +12,7 @@ class Bundle;
  * @brief Represents a resource.
  */
 class Resource : public Object {
-	STONE_ABSTRACT_OBJECT(Resource)
+	STONE_ABSTRACT_OBJECT(Resource, Object)
 
 public:
 	Resource(const std::shared_ptr<Bundle> &bundle, const std::string &filepath);
@@ -0,0 +1,153 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+namespace Stone::Core {
+
+class Object;
+
+/**
+ * @brief The slot of an object in the `HandleTable` and the generation of the slot when the object took it.
+ *
+ * A generation of 0 is the null handle.
+ */
+struct HandleId {
+	uint32_t index = 0;
+	uint32_t generation = 0;
+
+	bool operator==(const HandleId &other) const = default;
+};
+
+/**
+ * @brief Finds the objects referenced by a `Handle`, from any thread.
+ *
+ * An object takes a slot the first time a handle is made to it and releases it when destroyed. Released slots are
+ * reused with the next generation, so the handles to a destroyed object never find the object taking its slot.
+ */
+class HandleTable {
+public:
+	static HandleTable &instance();
+
+	HandleTable(const HandleTable &) = delete;
+	HandleTable &operator=(const HandleTable &) = delete;
+
+	/**
+	 * @brief The handle of the object, giving it a slot if it has none.
+	 */
+	HandleId acquire(Object &object);
+
+	/**
+	 * @brief Frees the slot of the object, called by its destructor.
+	 */
+	void release(Object &object);
+
+	/**
+	 * @brief Finds the object of a handle.
+	 *
+	 * @return The object, or nullptr if it was destroyed or is not owned by a `std::shared_ptr`.
+	 */
+	[[nodiscard]] std::shared_ptr<Object> find(HandleId id) const;
+
+	/**
+	 * @brief Checks whether `find` would give the object, without locking it.
+	 */
+	[[nodiscard]] bool contains(HandleId id) const;
+
+	/**
+	 * @brief The number of objects holding a slot.
+	 */
+	[[nodiscard]] std::size_t size() const;
+
+private:
+	struct Slot {
+		Object *object = nullptr;
+		uint32_t generation = 1;
+		uint32_t nextFree = 0; /**< The next free slot plus one, 0 ending the free list */
+	};
+
+	HandleTable() = default;
+	~HandleTable() = default;
+
+	mutable std::shared_mutex _mutex;
+	std::vector<Slot> _slots;
+	uint32_t _firstFree = 0; /**< The first free slot plus one */
+	std::size_t _liveCount = 0;
+};
+
+/**
+ * @brief A weak reference to an object, as an index and a generation in the `HandleTable`.
+ *
+ * Handles are 8 bytes, copied without atomic operations and can be stored, compared and hashed without keeping the
+ * object alive. `lock` gives the object back in constant time while it lives.
+ *
+ * @tparam T The class of the object, inheriting from `Object`.
+ */
+template <typename T>
+class Handle {
+public:
+	Handle() = default;
+
+	explicit Handle(T &object) : _id(HandleTable::instance().acquire(object)) {
+		static_assert(std::derived_from<T, Object>, "Handles reference objects");
+	}
+
+	explicit Handle(const std::shared_ptr<T> &object)
+		: _id(object == nullptr ? HandleId() : HandleTable::instance().acquire(*object)) {
+		static_assert(std::derived_from<T, Object>, "Handles reference objects");
+	}
+
+	template <typename U>
+		requires std::convertible_to<U *, T *>
+	Handle(const Handle<U> &other) : _id(other.getId()) { // NOLINT(google-explicit-constructor)
+	}
+
+	/**
+	 * @brief The object, or nullptr if the handle is null or the object was destroyed.
+	 */
+	[[nodiscard]] std::shared_ptr<T> lock() const {
+		if (_id.generation == 0)
+			return nullptr;
+		return std::static_pointer_cast<T>(HandleTable::instance().find(_id));
+	}
+
+	[[nodiscard]] bool expired() const {
+		return _id.generation == 0 || !HandleTable::instance().contains(_id);
+	}
+
+	[[nodiscard]] HandleId getId() const {
+		return _id;
+	}
+
+	explicit operator bool() const {
+		return _id.generation != 0;
+	}
+
+	bool operator==(const Handle &other) const = default;
+
+private:
+	HandleId _id;
+};
+
+} // namespace Stone::Core
+
+template <>
+struct std::hash<Stone::Core::HandleId> {
+	std::size_t operator()(const Stone::Core::HandleId &id) const noexcept {
+		return std::hash<uint64_t>()((static_cast<uint64_t>(id.generation) << 32) | id.index);
+	}
+};
+
+template <typename T>
+struct std::hash<Stone::Core::Handle<T>> {
+	std::size_t operator()(const Stone::Core::Handle<T> &handle) const noexcept {
+		return std::hash<Stone::Core::HandleId>()(handle.getId());
+	}
+};
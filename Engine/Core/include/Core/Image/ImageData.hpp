@@ -10,7 +10,7 @@ namespace Stone::Core::Image {
 class ImageSource;
 
 class ImageData : public Object {
-	STONE_OBJECT(ImageData)
+	STONE_OBJECT(ImageData, Object)
 
 public:
 	ImageData() = delete;
@@ -28,6 +28,15 @@ public:
 
 	ImageData(const std::string &filepath, Channel channels);
 
+	/**
+	 * @brief Create an image from tightly packed pixels, rows from top to bottom.
+	 *
+	 * @param size The size of the image in pixels.
+	 * @param channels The number of bytes per pixel.
+	 * @param data The pixels to copy, or nullptr to zero initialize the image.
+	 */
+	ImageData(const Size &size, Channel channels, const uint8_t *data = nullptr);
+
 protected:
 	Size _size = Size(0);
 	int _channels = 0;
@@ -15,7 +15,7 @@ class ImageData;
  * It is used to load the image data when needed and hold the reference to the loaded image data.
  */
 class ImageSource : public Assets::Resource {
-	STONE_OBJECT(ImageSource)
+	STONE_OBJECT(ImageSource, Assets::Resource)
 
 public:
 	ImageSource(const std::shared_ptr<Assets::Bundle> &bundle, const std::string &filepath,
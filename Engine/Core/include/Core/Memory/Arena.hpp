@@ -0,0 +1,102 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Stone::Core::Memory {
+
+/**
+ * @brief The allocation counts of an arena.
+ */
+struct ArenaStatistics {
+	std::size_t usedBytes = 0;	   /**< The bytes given by the allocations, with their alignment padding */
+	std::size_t reservedBytes = 0; /**< The bytes of every slab */
+	std::size_t slabCount = 0;
+	std::size_t liveAllocations = 0; /**< The allocations not deallocated yet */
+};
+
+/**
+ * @brief Allocates memory of any size by bumping a pointer in large slabs, and frees it all at once.
+ *
+ * Deallocating only counts the allocations, the memory is released when the arena is destroyed. It suits objects
+ * created together and released together, like the nodes of a loaded level.
+ */
+class Arena {
+public:
+	explicit Arena(std::size_t slabSize = 64 * 1024);
+	Arena(const Arena &) = delete;
+	Arena &operator=(const Arena &) = delete;
+
+	~Arena();
+
+	[[nodiscard]] void *allocate(std::size_t size, std::size_t alignment);
+	void deallocate(void *pointer, std::size_t size);
+
+	[[nodiscard]] ArenaStatistics getStatistics() const;
+
+private:
+	const std::size_t _slabSize;
+
+	mutable std::mutex _mutex;
+	std::vector<std::pair<char *, std::size_t>> _slabs;
+	char *_current = nullptr;
+	char *_end = nullptr;
+	std::size_t _usedBytes = 0;
+	std::size_t _reservedBytes = 0;
+	std::size_t _liveAllocations = 0;
+};
+
+/**
+ * @brief A standard allocator taking its memory from an arena.
+ *
+ * The allocator shares the ownership of the arena, so that the objects created with `std::allocate_shared` keep it
+ * alive until the last of them is released.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> arena) : _arena(std::move(arena)) {
+	}
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U> &other) noexcept // NOLINT(google-explicit-constructor)
+		: _arena(other.getArena()) {
+	}
+
+	T *allocate(std::size_t n) {
+		return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T *pointer, std::size_t n) noexcept {
+		_arena->deallocate(pointer, n * sizeof(T));
+	}
+
+	[[nodiscard]] const std::shared_ptr<Arena> &getArena() const {
+		return _arena;
+	}
+
+	template <typename U>
+	bool operator==(const ArenaAllocator<U> &other) const noexcept {
+		return _arena == other.getArena();
+	}
+
+private:
+	std::shared_ptr<Arena> _arena;
+};
+
+/**
+ * @brief Create a shared object in an arena, the arena version of `std::make_shared`.
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> makeInArena(const std::shared_ptr<Arena> &arena, Args &&...args) {
+	return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+}
+
+} // namespace Stone::Core::Memory
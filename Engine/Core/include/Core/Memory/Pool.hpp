@@ -0,0 +1,152 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace Stone::Logging {
+class Gauge;
+} // namespace Stone::Logging
+
+namespace Stone::Core::Memory {
+
+/**
+ * @brief The allocation counts of a pool.
+ */
+struct PoolStatistics {
+	std::string name;
+	std::size_t blockSize = 0;
+	std::size_t liveBlocks = 0;		/**< The blocks currently allocated */
+	std::size_t reservedBlocks = 0; /**< The blocks of every slab, allocated or free */
+	std::size_t slabCount = 0;
+	uint64_t allocations = 0; /**< The blocks allocated since the creation of the pool */
+};
+
+/**
+ * @brief Allocates blocks of a single size from contiguous slabs.
+ *
+ * Freed blocks are kept in a free list and given back by the next allocations, slabs are only released with the pool.
+ * Every pool is listed by `Pool::allStatistics`.
+ */
+class Pool {
+public:
+	Pool(std::string name, std::size_t blockSize, std::size_t blockAlign, std::size_t blocksPerSlab = 256);
+	Pool(const Pool &) = delete;
+	Pool &operator=(const Pool &) = delete;
+
+	~Pool();
+
+	[[nodiscard]] void *allocate();
+	void deallocate(void *block);
+
+	[[nodiscard]] PoolStatistics getStatistics() const;
+
+	/**
+	 * @brief The statistics of every pool alive.
+	 */
+	[[nodiscard]] static std::vector<PoolStatistics> allStatistics();
+
+	/**
+	 * @brief Set the `memory.pool.<name>.live_blocks` and `.reserved_bytes` gauges of the engine metrics for each pool.
+	 */
+	static void publishMetrics();
+
+private:
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	void _addSlab();
+
+	const std::string _name;
+	const std::size_t _blockSize;
+	const std::size_t _blockAlign;
+	const std::size_t _blocksPerSlab;
+
+	mutable std::mutex _mutex;
+	FreeBlock *_freeBlocks = nullptr;
+	std::vector<void *> _slabs;
+	std::size_t _liveBlocks = 0;
+	uint64_t _allocations = 0;
+
+	Logging::Gauge *_liveBlocksGauge = nullptr;
+	Logging::Gauge *_reservedBytesGauge = nullptr;
+};
+
+/**
+ * @brief The pool of the blocks of a type, named after its owner class.
+ *
+ * Pools are never destroyed, so that objects released by static destructors at exit still have their pool.
+ */
+template <typename T, typename Owner = T>
+Pool &poolOf() {
+	static Pool &pool = *new Pool(
+		[] {
+			if constexpr (requires { Owner::StaticClassName(); })
+				return std::string(Owner::StaticClassName());
+			else
+				return std::string(typeid(Owner).name());
+		}(),
+		sizeof(T), alignof(T));
+	return pool;
+}
+
+/**
+ * @brief A standard allocator taking single objects from the pool of their type.
+ *
+ * With `std::allocate_shared`, the allocator is rebound to the type holding both the object and its reference counts,
+ * which then share a block. Arrays fall back to the global allocator.
+ *
+ * @tparam Owner The class naming the pool in the statistics.
+ */
+template <typename T, typename Owner = T>
+class PoolAllocator {
+public:
+	using value_type = T;
+
+	template <typename U>
+	struct rebind {
+		using other = PoolAllocator<U, Owner>;
+	};
+
+	PoolAllocator() = default;
+
+	template <typename U>
+	PoolAllocator(const PoolAllocator<U, Owner> &) noexcept { // NOLINT(google-explicit-constructor)
+	}
+
+	T *allocate(std::size_t n) {
+		if (n == 1)
+			return static_cast<T *>(poolOf<T, Owner>().allocate());
+		return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+	}
+
+	void deallocate(T *pointer, std::size_t n) noexcept {
+		if (n == 1)
+			poolOf<T, Owner>().deallocate(pointer);
+		else
+			::operator delete(pointer, std::align_val_t(alignof(T)));
+	}
+
+	template <typename U>
+	bool operator==(const PoolAllocator<U, Owner> &) const noexcept {
+		return true;
+	}
+};
+
+/**
+ * @brief Create a shared object in the pool of its class, the pooled version of `std::make_shared`.
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> makePooled(Args &&...args) {
+	return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+} // namespace Stone::Core::Memory
@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include "Core/Handle.hpp"
+#include "Core/TypeInfo.hpp"
+
 #include <iostream>
 #include <memory>
 #include <string>
@@ -12,52 +15,109 @@ namespace Stone::Core {
 class Object : public std::enable_shared_from_this<Object> {
 public:
 	Object();
+
+	/**
+	 * @brief Copies an object, the copy having its own ID and no handle.
+	 */
 	Object(const Object &other);
+	Object &operator=(const Object &other);
 
-	virtual ~Object() = default;
+	virtual ~Object();
 
+	/**
+	 * @brief The ID of the object, unique among the objects created by the process.
+	 *
+	 * IDs are taken by blocks for each thread, so objects created on different threads are not numbered in order.
+	 */
 	uint32_t getId() const;
 
 	const static char *StaticClassName() {
 		return "Object";
 	}
 
-	static std::intptr_t StaticHashCode() {
-		return reinterpret_cast<std::intptr_t>(StaticClassName());
+	static constexpr std::intptr_t StaticHashCode() {
+		return static_cast<std::intptr_t>(hashTypeName("Object"));
 	}
 
+	static const TypeInfo &StaticTypeInfo();
+
 	virtual const char *getClassName() const = 0;
 
+	virtual const TypeInfo &getTypeInfo() const = 0;
+
 	std::intptr_t getClassHashCode() const {
-		return reinterpret_cast<std::intptr_t>(getClassName());
+		return static_cast<std::intptr_t>(getTypeInfo().getHash());
+	}
+
+	/**
+	 * @brief Checks whether the object is a T, without a dynamic_cast.
+	 *
+	 * T must declare its type with a `STONE_OBJECT` macro, interfaces inheriting the type of their parent are not told
+	 * apart from it.
+	 */
+	template <typename T>
+	[[nodiscard]] bool isA() const {
+		return getTypeInfo().isA(T::StaticTypeInfo());
 	}
 
 	virtual std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const;
 
 protected:
 	uint32_t _id;
+
+private:
+	friend class HandleTable;
+
+	HandleId _handle; /**< Set by the HandleTable when a handle is first made to the object */
 };
 
+/**
+ * @brief Casts a shared object to T when it is one, the `isA` version of `std::dynamic_pointer_cast`.
+ */
+template <typename T, typename U>
+std::shared_ptr<T> objectCast(const std::shared_ptr<U> &object) {
+	if (object == nullptr || !object->template isA<T>())
+		return nullptr;
+	return std::static_pointer_cast<T>(object);
+}
+
 } // namespace Stone::Core
 
-#define STONE_ABSTRACT_OBJECT(ClassName)                                                                               \
+#define __STONE_OBJECT_TYPE(ClassName, ParentClassName, Constructor)                                                   \
                                                                                                                        \
 public:                                                                                                                \
 	static const char *StaticClassName() {                                                                             \
 		return #ClassName;                                                                                             \
 	}                                                                                                                  \
-	static std::intptr_t StaticHashCode() {                                                                            \
-		return reinterpret_cast<std::intptr_t>(StaticClassName());                                                     \
+	static constexpr std::intptr_t StaticHashCode() {                                                                  \
+		return static_cast<std::intptr_t>(Stone::Core::hashTypeName(#ClassName));                                      \
+	}                                                                                                                  \
+	static const Stone::Core::TypeInfo &StaticTypeInfo() {                                                             \
+		/* In the body, where the class is complete, so that the parent can be checked */                              \
+		static_assert(std::is_base_of_v<ParentClassName, ClassName>, "The parent class is not a base of " #ClassName); \
+		static const Stone::Core::TypeInfo typeInfo(#ClassName, &ParentClassName::StaticTypeInfo(), Constructor);      \
+		return typeInfo;                                                                                               \
 	}                                                                                                                  \
                                                                                                                        \
 private:
 
-#define STONE_OBJECT(ClassName)                                                                                        \
-	STONE_ABSTRACT_OBJECT(ClassName)                                                                                   \
+/**
+ * @brief Macro to use inside an abstract object class, with the class it inherits from.
+ */
+#define STONE_ABSTRACT_OBJECT(ClassName, ParentClassName) __STONE_OBJECT_TYPE(ClassName, ParentClassName, nullptr)
+
+/**
+ * @brief Macro to use inside an object class, with the class it inherits from.
+ */
+#define STONE_OBJECT(ClassName, ParentClassName)                                                                       \
+	__STONE_OBJECT_TYPE(ClassName, ParentClassName, Stone::Core::TypeInfo::constructorOf<ClassName>())                 \
                                                                                                                        \
 public:                                                                                                                \
 	const char *getClassName() const override {                                                                        \
 		return StaticClassName();                                                                                      \
+	}                                                                                                                  \
+	const Stone::Core::TypeInfo &getTypeInfo() const override {                                                        \
+		return StaticTypeInfo();                                                                                       \
 	}                                                                                                                  \
                                                                                                                        \
 private:
@@ -0,0 +1,136 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Core/Memory/Pool.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Stone::Core {
+
+class Object;
+
+/**
+ * @brief Hashes a class name with FNV-1a, at compile time when the name is a constant.
+ */
+constexpr uint64_t hashTypeName(std::string_view name) {
+	uint64_t hash = 14695981039346656037ull;
+	for (char character : name) {
+		hash ^= static_cast<uint8_t>(character);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+/**
+ * @brief The runtime description of an Object class, declared by the `STONE_OBJECT` macros.
+ *
+ * Types are identified by the hash of their class name, which is the same in every shared library. Each type knows
+ * the hashes of its ancestors, so that `isA` is a single comparison.
+ */
+class TypeInfo {
+public:
+	/** Creates an object of the type, a plain function pointer */
+	using Constructor = std::shared_ptr<Object> (*)();
+
+	/**
+	 * @brief Describes a type and registers it to the `TypeRegistry`.
+	 *
+	 * @param name The class name, a string literal.
+	 * @param parent The type of the parent class, null for `Object`.
+	 * @param constructor The function creating an object of the type, null for abstract types.
+	 */
+	TypeInfo(const char *name, const TypeInfo *parent, Constructor constructor);
+	TypeInfo(const TypeInfo &) = delete;
+	TypeInfo &operator=(const TypeInfo &) = delete;
+
+	~TypeInfo() = default;
+
+	[[nodiscard]] const char *getName() const;
+	[[nodiscard]] uint64_t getHash() const;
+	[[nodiscard]] const TypeInfo *getParent() const;
+
+	/**
+	 * @brief The index of the type in the `TypeRegistry`, dense from 0.
+	 */
+	[[nodiscard]] uint32_t getIndex() const;
+
+	/**
+	 * @brief Checks whether this type is the given type or inherits from it.
+	 */
+	[[nodiscard]] bool isA(const TypeInfo &other) const {
+		std::size_t depth = other._ancestors.size() - 1;
+		return depth < _ancestors.size() && _ancestors[depth] == other._hash;
+	}
+
+	/**
+	 * @brief Creates an object of the type.
+	 *
+	 * @return The object, or nullptr if the type is abstract or not default constructible.
+	 */
+	[[nodiscard]] std::shared_ptr<Object> create() const;
+
+	/**
+	 * @brief The constructor of a type, in the pool of its class, or null if it is not default constructible.
+	 */
+	template <typename T>
+	static constexpr Constructor constructorOf() {
+		if constexpr (std::is_default_constructible_v<T> && !std::is_abstract_v<T>) {
+			return []() -> std::shared_ptr<Object> { return Memory::makePooled<T>(); };
+		} else {
+			return nullptr;
+		}
+	}
+
+private:
+	const char *_name;
+	uint64_t _hash;
+	const TypeInfo *_parent;
+	Constructor _constructor;
+	uint32_t _index;
+	std::vector<uint64_t> _ancestors; /**< The hashes of the types from `Object` to this one */
+};
+
+/**
+ * @brief Indexes the `TypeInfo` of every registered Object class, by hash and by dense index.
+ *
+ * Node classes are registered at startup by `STONE_NODE_IMPLEMENTATION`, other classes when their `StaticTypeInfo` is
+ * first used. A class declared in several shared libraries is registered once.
+ */
+class TypeRegistry {
+public:
+	static TypeRegistry &instance();
+
+	TypeRegistry(const TypeRegistry &) = delete;
+	TypeRegistry &operator=(const TypeRegistry &) = delete;
+
+	[[nodiscard]] const TypeInfo *find(uint64_t hash) const;
+
+	[[nodiscard]] const TypeInfo *find(std::string_view name) const {
+		return find(hashTypeName(name));
+	}
+
+	[[nodiscard]] const TypeInfo *get(uint32_t index) const;
+
+	[[nodiscard]] std::size_t size() const;
+
+private:
+	friend class TypeInfo;
+
+	TypeRegistry() = default;
+	~TypeRegistry() = default;
+
+	mutable std::mutex _mutex;
+	std::vector<const TypeInfo *> _types; /**< Indexed by the type indices */
+	std::unordered_map<uint64_t, uint32_t> _indices;
+
+	uint32_t _register(const TypeInfo &type);
+};
+
+} // namespace Stone::Core
@@ -2,6 +2,8 @@
 
 #include "Core/Assets/Bundle.hpp"
 
+#include "Logging/Metrics.hpp"
+
 #include <filesystem>
 
 namespace Stone::Core::Assets {
@@ -24,7 +26,12 @@ std::ostream &Bundle::writeToStream(std::ostream &stream, bool closing_bracer) c
 }
 
 std::shared_ptr<Resource> Bundle::getResource(const std::string &filepath) const {
-	auto it = _resources.find(reducePath(filepath));
+	std::optional<StringId> reducedPath = StringId::find(reducePath(filepath));
+	return reducedPath ? getResource(*reducedPath) : nullptr;
+}
+
+std::shared_ptr<Resource> Bundle::getResource(StringId reducedPath) const {
+	auto it = _resources.find(reducedPath);
 	if (it != _resources.end()) {
 		return it->second;
 	}
@@ -35,6 +42,14 @@ const std::string &Bundle::getRootDirectory() const {
 	return _rootDirectory;
 }
 
+void Bundle::_resourceLoaded(std::chrono::steady_clock::duration loadTime) {
+	static Logging::Counter &resourcesLoaded = Logging::MetricsRegistry::instance().counter("assets.resources_loaded");
+	static Logging::Histogram &resourceLoadTime =
+		Logging::MetricsRegistry::instance().histogram("assets.resource_load_time_ns");
+	resourcesLoaded.add();
+	resourceLoadTime.record(loadTime);
+}
+
 std::string Bundle::reducePath(const std::string &path) {
 	namespace fs = std::filesystem;
 	return fs::path(path).lexically_normal().string();
@@ -0,0 +1,80 @@
+// Copyright 2024 Stone-Engine
+
+#include "Core/Handle.hpp"
+
+#include "Core/Object.hpp"
+
+#include <mutex>
+
+namespace Stone::Core {
+
+HandleTable &HandleTable::instance() {
+	// Leaked, so that objects can be destroyed during the destruction of static objects
+	static HandleTable &table = *new HandleTable();
+	return table;
+}
+
+HandleId HandleTable::acquire(Object &object) {
+	{
+		std::shared_lock lock(_mutex);
+		if (object._handle.generation != 0)
+			return object._handle;
+	}
+
+	std::unique_lock lock(_mutex);
+	if (object._handle.generation != 0)
+		return object._handle;
+
+	uint32_t index;
+	if (_firstFree != 0) {
+		index = _firstFree - 1;
+		_firstFree = _slots[index].nextFree;
+	} else {
+		index = static_cast<uint32_t>(_slots.size());
+		_slots.emplace_back();
+	}
+	Slot &slot = _slots[index];
+	slot.object = &object;
+	slot.nextFree = 0;
+	++_liveCount;
+	object._handle = {index, slot.generation};
+	return object._handle;
+}
+
+void HandleTable::release(Object &object) {
+	std::unique_lock lock(_mutex);
+	Slot &slot = _slots[object._handle.index];
+	slot.object = nullptr;
+	if (++slot.generation == 0)
+		slot.generation = 1;
+	slot.nextFree = _firstFree;
+	_firstFree = object._handle.index + 1;
+	--_liveCount;
+	object._handle = {};
+}
+
+std::shared_ptr<Object> HandleTable::find(HandleId id) const {
+	std::shared_lock lock(_mutex);
+	if (id.index >= _slots.size())
+		return nullptr;
+	const Slot &slot = _slots[id.index];
+	if (slot.generation != id.generation || slot.object == nullptr)
+		return nullptr;
+	// The object releases its slot before its last base is destroyed, so its weak reference can still be read here
+	return slot.object->weak_from_this().lock();
+}
+
+bool HandleTable::contains(HandleId id) const {
+	std::shared_lock lock(_mutex);
+	if (id.index >= _slots.size())
+		return false;
+	const Slot &slot = _slots[id.index];
+	return slot.generation == id.generation && slot.object != nullptr && !slot.object->weak_from_this().expired();
+}
+
+std::size_t HandleTable::size() const {
+	std::shared_lock lock(_mutex);
+	return _liveCount;
+}
+
+} // namespace Stone::Core
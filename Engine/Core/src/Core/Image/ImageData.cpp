@@ -4,6 +4,9 @@
 
 #include "Utils/Glm.hpp"
 
+#include <cstdlib>
+#include <cstring>
+
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/io.hpp>
 #include <stb_image.h>
@@ -48,4 +51,20 @@ ImageData::ImageData(const std::string &filepath, Channel channels) {
 	assert(_channels >= 1 && _channels <= 4);
 }
 
+ImageData::ImageData(const Size &size, Channel channels, const uint8_t *data)
+	: _size(size), _channels(static_cast<int>(channels)) {
+	if (_size.x <= 0 || _size.y <= 0) {
+		throw std::runtime_error("Invalid image size: " + std::to_string(_size.x) + "x" + std::to_string(_size.y));
+	}
+	size_t byteSize = static_cast<size_t>(_size.x) * static_cast<size_t>(_size.y) * static_cast<size_t>(_channels);
+	// Allocated like the images loaded by stb_image, so the destructor can release both the same way
+	_data = static_cast<uint8_t *>(std::calloc(byteSize, 1));
+	if (_data == nullptr) {
+		throw std::bad_alloc();
+	}
+	if (data != nullptr) {
+		std::memcpy(_data, data, byteSize);
+	}
+}
+
 } // namespace Stone::Core::Image
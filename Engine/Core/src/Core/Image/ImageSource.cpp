@@ -8,7 +8,7 @@
 namespace Stone::Core::Image {
 
 ImageSource::ImageSource(const std::shared_ptr<Assets::Bundle> &bundle, const std::string &filepath, Channel channels)
-	: Assets::Resource(bundle, filepath), _channels(channels) {
+	: Assets::Resource(bundle, filepath), _filepath(filepath), _channels(channels) {
 }
 
 std::ostream &ImageSource::writeToStream(std::ostream &stream, bool closing_bracer) const {
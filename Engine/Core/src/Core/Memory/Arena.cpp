@@ -0,0 +1,54 @@
+// Copyright 2024 Stone-Engine
+
+#include "Core/Memory/Arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Stone::Core::Memory {
+
+Arena::Arena(std::size_t slabSize) : _slabSize(std::max<std::size_t>(slabSize, 64)) {
+}
+
+Arena::~Arena() {
+	for (const auto &[slab, size] : _slabs) {
+		::operator delete(slab, std::align_val_t(alignof(std::max_align_t)));
+	}
+}
+
+void *Arena::allocate(std::size_t size, std::size_t alignment) {
+	std::lock_guard lock(_mutex);
+	auto aligned = [alignment](char *pointer) {
+		auto address = reinterpret_cast<std::uintptr_t>(pointer);
+		return reinterpret_cast<char *>((address + alignment - 1) / alignment * alignment);
+	};
+	char *begin = _current == nullptr ? nullptr : aligned(_current);
+	if (begin == nullptr || begin + size > _end) {
+		// Allocations larger than a slab get a slab of their own
+		std::size_t slabSize = std::max(_slabSize, size + alignment);
+		auto *slab = static_cast<char *>(::operator new(slabSize, std::align_val_t(alignof(std::max_align_t))));
+		_slabs.emplace_back(slab, slabSize);
+		_reservedBytes += slabSize;
+		_current = slab;
+		_end = slab + slabSize;
+		begin = aligned(_current);
+	}
+	_usedBytes += static_cast<std::size_t>(begin + size - _current);
+	_current = begin + size;
+	++_liveAllocations;
+	return begin;
+}
+
+void Arena::deallocate(void *pointer, std::size_t) {
+	if (pointer == nullptr)
+		return;
+	std::lock_guard lock(_mutex);
+	--_liveAllocations;
+}
+
+ArenaStatistics Arena::getStatistics() const {
+	std::lock_guard lock(_mutex);
+	return {_usedBytes, _reservedBytes, _slabs.size(), _liveAllocations};
+}
+
+} // namespace Stone::Core::Memory
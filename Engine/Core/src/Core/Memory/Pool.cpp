@@ -0,0 +1,116 @@
+// Copyright 2024 Stone-Engine
+
+#include "Core/Memory/Pool.hpp"
+
+#include "Logging/Metrics.hpp"
+
+#include <algorithm>
+
+namespace Stone::Core::Memory {
+
+namespace {
+
+struct PoolList {
+	std::mutex mutex;
+	std::vector<Pool *> pools;
+};
+
+/** Leaked like the pools, so that pools destroyed at exit can still unregister */
+PoolList &poolList() {
+	static PoolList &list = *new PoolList();
+	return list;
+}
+
+std::size_t roundUp(std::size_t size, std::size_t alignment) {
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+Pool::Pool(std::string name, std::size_t blockSize, std::size_t blockAlign, std::size_t blocksPerSlab)
+	: _name(std::move(name)),
+	  _blockSize(roundUp(std::max(blockSize, sizeof(FreeBlock)), std::max(blockAlign, alignof(FreeBlock)))),
+	  _blockAlign(std::max(blockAlign, alignof(FreeBlock))), _blocksPerSlab(std::max<std::size_t>(blocksPerSlab, 1)) {
+	PoolList &list = poolList();
+	std::lock_guard lock(list.mutex);
+	list.pools.push_back(this);
+}
+
+Pool::~Pool() {
+	{
+		PoolList &list = poolList();
+		std::lock_guard lock(list.mutex);
+		list.pools.erase(std::find(list.pools.begin(), list.pools.end(), this));
+	}
+	for (void *slab : _slabs) {
+		::operator delete(slab, std::align_val_t(_blockAlign));
+	}
+}
+
+void *Pool::allocate() {
+	std::lock_guard lock(_mutex);
+	if (_freeBlocks == nullptr)
+		_addSlab();
+	FreeBlock *block = _freeBlocks;
+	_freeBlocks = block->next;
+	++_liveBlocks;
+	++_allocations;
+	return block;
+}
+
+void Pool::deallocate(void *block) {
+	if (block == nullptr)
+		return;
+	std::lock_guard lock(_mutex);
+	auto *freeBlock = static_cast<FreeBlock *>(block);
+	freeBlock->next = _freeBlocks;
+	_freeBlocks = freeBlock;
+	--_liveBlocks;
+}
+
+void Pool::_addSlab() {
+	auto *slab = static_cast<char *>(::operator new(_blockSize * _blocksPerSlab, std::align_val_t(_blockAlign)));
+	_slabs.push_back(slab);
+	// Linked in address order, so that consecutive allocations are contiguous
+	for (std::size_t index = _blocksPerSlab; index-- > 0;) {
+		auto *block = reinterpret_cast<FreeBlock *>(slab + index * _blockSize);
+		block->next = _freeBlocks;
+		_freeBlocks = block;
+	}
+}
+
+PoolStatistics Pool::getStatistics() const {
+	std::lock_guard lock(_mutex);
+	return {_name, _blockSize, _liveBlocks, _slabs.size() * _blocksPerSlab, _slabs.size(), _allocations};
+}
+
+std::vector<PoolStatistics> Pool::allStatistics() {
+	PoolList &list = poolList();
+	std::lock_guard lock(list.mutex);
+	std::vector<PoolStatistics> statistics;
+	statistics.reserve(list.pools.size());
+	for (const Pool *pool : list.pools) {
+		statistics.push_back(pool->getStatistics());
+	}
+	return statistics;
+}
+
+void Pool::publishMetrics() {
+	PoolList &list = poolList();
+	std::lock_guard lock(list.mutex);
+	for (Pool *pool : list.pools) {
+		// The gauges are looked up once, publishing runs every frame
+		if (pool->_liveBlocksGauge == nullptr) {
+			Logging::MetricsRegistry &registry = Logging::MetricsRegistry::instance();
+			const std::string prefix = "memory.pool." + pool->_name;
+			pool->_liveBlocksGauge = &registry.gauge(prefix + ".live_blocks");
+			pool->_reservedBytesGauge = &registry.gauge(prefix + ".reserved_bytes");
+		}
+		std::lock_guard poolLock(pool->_mutex);
+		pool->_liveBlocksGauge->set(static_cast<double>(pool->_liveBlocks));
+		std::size_t reservedBytes = pool->_slabs.size() * pool->_blocksPerSlab * pool->_blockSize;
+		pool->_reservedBytesGauge->set(static_cast<double>(reservedBytes));
+	}
+}
+
+} // namespace Stone::Core::Memory
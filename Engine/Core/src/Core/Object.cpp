@@ -2,15 +2,47 @@
 
 #include "Core/Object.hpp"
 
+#include <atomic>
+
 namespace Stone::Core {
 
-Object::Object() : std::enable_shared_from_this<Object>() {
-	static uint32_t id = 0;
-	_id = id++;
+namespace {
+
+/** The IDs taken by a thread at once, so that creating an object rarely touches the shared counter */
+constexpr uint32_t idBlockSize = 1024;
+
+uint32_t nextObjectId() {
+	static std::atomic<uint32_t> nextBlock = 0;
+	thread_local uint32_t next = 0;
+	thread_local uint32_t end = 0;
+	if (next == end) {
+		next = nextBlock.fetch_add(idBlockSize, std::memory_order_relaxed);
+		end = next + idBlockSize;
+	}
+	return next++;
+}
+
+} // namespace
+
+Object::Object() : std::enable_shared_from_this<Object>(), _id(nextObjectId()) {
+}
+
+Object::Object(const Object &other) : std::enable_shared_from_this<Object>(other), _id(nextObjectId()) {
+}
+
+Object &Object::operator=(const Object &other) {
+	std::enable_shared_from_this<Object>::operator=(other);
+	return *this;
+}
+
+Object::~Object() {
+	if (_handle.generation != 0)
+		HandleTable::instance().release(*this);
 }
 
-Object::Object(const Object &other) : std::enable_shared_from_this<Object>(other) {
-	_id = other._id;
+const TypeInfo &Object::StaticTypeInfo() {
+	static const TypeInfo typeInfo("Object", nullptr, nullptr);
+	return typeInfo;
 }
 
 uint32_t Object::getId() const {
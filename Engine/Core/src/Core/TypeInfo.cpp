@@ -0,0 +1,74 @@
+// Copyright 2024 Stone-Engine
+
+#include "Core/TypeInfo.hpp"
+
+#include "Core/Object.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace Stone::Core {
+
+TypeInfo::TypeInfo(const char *name, const TypeInfo *parent, Constructor constructor)
+	: _name(name), _hash(hashTypeName(name)), _parent(parent), _constructor(constructor), _index(0) {
+	if (parent != nullptr)
+		_ancestors = parent->_ancestors;
+	_ancestors.push_back(_hash);
+	_index = TypeRegistry::instance()._register(*this);
+}
+
+const char *TypeInfo::getName() const {
+	return _name;
+}
+
+uint64_t TypeInfo::getHash() const {
+	return _hash;
+}
+
+const TypeInfo *TypeInfo::getParent() const {
+	return _parent;
+}
+
+uint32_t TypeInfo::getIndex() const {
+	return _index;
+}
+
+std::shared_ptr<Object> TypeInfo::create() const {
+	return _constructor == nullptr ? nullptr : _constructor();
+}
+
+TypeRegistry &TypeRegistry::instance() {
+	// Leaked, so that types can be used during the destruction of static objects
+	static TypeRegistry &registry = *new TypeRegistry();
+	return registry;
+}
+
+const TypeInfo *TypeRegistry::find(uint64_t hash) const {
+	std::lock_guard lock(_mutex);
+	auto it = _indices.find(hash);
+	return it == _indices.end() ? nullptr : _types[it->second];
+}
+
+const TypeInfo *TypeRegistry::get(uint32_t index) const {
+	std::lock_guard lock(_mutex);
+	return index < _types.size() ? _types[index] : nullptr;
+}
+
+std::size_t TypeRegistry::size() const {
+	std::lock_guard lock(_mutex);
+	return _types.size();
+}
+
+uint32_t TypeRegistry::_register(const TypeInfo &type) {
+	std::lock_guard lock(_mutex);
+	auto [it, inserted] = _indices.try_emplace(type.getHash(), static_cast<uint32_t>(_types.size()));
+	if (inserted) {
+		_types.push_back(&type);
+	} else if (std::strcmp(_types[it->second]->getName(), type.getName()) != 0) {
+		throw std::runtime_error(std::string("The class names ") + type.getName() + " and " +
+								 _types[it->second]->getName() + " have the same hash");
+	}
+	return it->second;
+}
+
+} // namespace Stone::Core
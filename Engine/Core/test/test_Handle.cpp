@@ -0,0 +1,97 @@
+#include "Core/Handle.hpp"
+#include "Core/Object.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace Stone;
+
+class HandleObject : public Core::Object {
+	STONE_OBJECT(HandleObject, Core::Object)
+};
+
+class HandleSubObject : public HandleObject {
+	STONE_OBJECT(HandleSubObject, HandleObject)
+};
+
+TEST(Handle, LockAndExpire) {
+	Core::Handle<HandleObject> handle;
+	EXPECT_FALSE(handle);
+	EXPECT_EQ(handle.lock(), nullptr);
+	EXPECT_TRUE(handle.expired());
+
+	auto object = std::make_shared<HandleObject>();
+	handle = Core::Handle<HandleObject>(object);
+	EXPECT_TRUE(handle);
+	EXPECT_FALSE(handle.expired());
+	EXPECT_EQ(handle.lock(), object);
+	EXPECT_EQ(Core::Handle<HandleObject>(*object), handle);
+
+	object.reset();
+	EXPECT_TRUE(handle.expired());
+	EXPECT_EQ(handle.lock(), nullptr);
+}
+
+TEST(Handle, ReusedSlot) {
+	auto first = std::make_shared<HandleObject>();
+	Core::Handle<HandleObject> firstHandle(first);
+	std::size_t liveCount = Core::HandleTable::instance().size();
+	first.reset();
+	EXPECT_EQ(Core::HandleTable::instance().size(), liveCount - 1);
+
+	auto second = std::make_shared<HandleObject>();
+	Core::Handle<HandleObject> secondHandle(second);
+	EXPECT_EQ(secondHandle.getId().index, firstHandle.getId().index);
+	EXPECT_NE(secondHandle.getId().generation, firstHandle.getId().generation);
+	EXPECT_EQ(firstHandle.lock(), nullptr);
+	EXPECT_EQ(secondHandle.lock(), second);
+}
+
+TEST(Handle, Conversion) {
+	auto object = std::make_shared<HandleSubObject>();
+	Core::Handle<HandleSubObject> handle(object);
+	Core::Handle<Core::Object> baseHandle = handle;
+	EXPECT_EQ(baseHandle.getId(), handle.getId());
+	EXPECT_EQ(Core::objectCast<HandleSubObject>(baseHandle.lock()), object);
+
+	std::unordered_set<Core::Handle<Core::Object>> handles = {baseHandle};
+	EXPECT_EQ(handles.count(Core::Handle<Core::Object>(object)), 1);
+}
+
+TEST(Handle, NotSharedObject) {
+	HandleObject object;
+	Core::Handle<HandleObject> handle(object);
+	EXPECT_TRUE(handle);
+	EXPECT_EQ(handle.lock(), nullptr);
+}
+
+TEST(Handle, ConcurrentLookups) {
+	std::vector<std::shared_ptr<HandleObject>> objects;
+	std::vector<Core::Handle<HandleObject>> handles;
+	for (int i = 0; i < 64; ++i) {
+		objects.push_back(std::make_shared<HandleObject>());
+		handles.emplace_back(objects.back());
+	}
+
+	std::atomic<int> found = 0;
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < 4; ++thread) {
+		threads.emplace_back([&handles, &found] {
+			for (int round = 0; round < 100; ++round) {
+				for (const auto &handle : handles) {
+					if (handle.lock() != nullptr)
+						found.fetch_add(1, std::memory_order_relaxed);
+				}
+				auto temporary = std::make_shared<HandleObject>();
+				Core::Handle<HandleObject> temporaryHandle(temporary);
+				EXPECT_EQ(temporaryHandle.lock(), temporary);
+			}
+		});
+	}
+	for (auto &thread : threads)
+		thread.join();
+	EXPECT_EQ(found.load(), 4 * 100 * 64);
+}
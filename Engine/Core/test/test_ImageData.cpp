@@ -0,0 +1,29 @@
+#include "Core/Image/ImageData.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace Stone::Core::Image;
+
+TEST(ImageData, FromPixels) {
+	const uint8_t pixels[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+	auto image = std::make_shared<ImageData>(Size(2, 2), Channel::RGB, pixels);
+
+	EXPECT_EQ(image->getSize(), Size(2, 2));
+	EXPECT_EQ(image->getChannels(), Channel::RGB);
+	ASSERT_NE(image->getData(), pixels);
+	for (size_t i = 0; i < sizeof(pixels); ++i) {
+		EXPECT_EQ(image->getData()[i], pixels[i]);
+	}
+}
+
+TEST(ImageData, ZeroInitialized) {
+	auto image = std::make_shared<ImageData>(Size(3, 1), Channel::GREY);
+
+	for (size_t i = 0; i < 3; ++i) {
+		EXPECT_EQ(image->getData()[i], 0);
+	}
+}
+
+TEST(ImageData, InvalidSize) {
+	EXPECT_THROW(ImageData(Size(0, 4), Channel::RGBA), std::runtime_error);
+}
@@ -1,15 +1,17 @@
 #include "Core/Object.hpp"
 
 #include <gtest/gtest.h>
+#include <set>
+#include <thread>
 
 using namespace Stone;
 
 class MockObject : public Core::Object {
-	STONE_OBJECT(MockObject)
+	STONE_OBJECT(MockObject, Core::Object)
 };
 
 class MockSubObject : public MockObject {
-	STONE_OBJECT(MockSubObject)
+	STONE_OBJECT(MockSubObject, MockObject)
 };
 
 TEST(Object, ClassName) {
@@ -56,3 +58,56 @@ TEST(Object, Id) {
 
 	EXPECT_NE(object->getId(), object2->getId());
 }
+
+TEST(Object, IsA) {
+	std::shared_ptr<Core::Object> mockObject = std::make_shared<MockObject>();
+	std::shared_ptr<Core::Object> mockSubObject = std::make_shared<MockSubObject>();
+
+	EXPECT_TRUE(mockObject->isA<Core::Object>());
+	EXPECT_TRUE(mockObject->isA<MockObject>());
+	EXPECT_FALSE(mockObject->isA<MockSubObject>());
+	EXPECT_TRUE(mockSubObject->isA<MockObject>());
+
+	EXPECT_EQ(Core::objectCast<MockSubObject>(mockObject), nullptr);
+	EXPECT_EQ(Core::objectCast<MockObject>(mockSubObject), mockSubObject);
+}
+
+TEST(Object, TypeRegistry) {
+	static_assert(MockObject::StaticHashCode() == static_cast<std::intptr_t>(Core::hashTypeName("MockObject")));
+
+	const Core::TypeInfo &subType = MockSubObject::StaticTypeInfo();
+	Core::TypeRegistry &registry = Core::TypeRegistry::instance();
+	EXPECT_EQ(registry.find("MockSubObject"), &subType);
+	EXPECT_EQ(registry.get(subType.getIndex()), &subType);
+	EXPECT_EQ(subType.getParent(), &MockObject::StaticTypeInfo());
+	EXPECT_EQ(registry.find("UnknownObject"), nullptr);
+
+	std::shared_ptr<Core::Object> created = subType.create();
+	ASSERT_NE(created, nullptr);
+	EXPECT_STREQ(created->getClassName(), "MockSubObject");
+	EXPECT_EQ(Core::Object::StaticTypeInfo().create(), nullptr);
+}
+
+TEST(Object, IdAcrossThreads) {
+	constexpr int threadCount = 4;
+	constexpr int objectCount = 2000;
+	std::vector<std::vector<uint32_t>> ids(threadCount);
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < threadCount; ++thread) {
+		threads.emplace_back([&ids, thread] {
+			for (int i = 0; i < objectCount; ++i)
+				ids[thread].push_back(std::make_shared<MockObject>()->getId());
+		});
+	}
+	for (auto &thread : threads)
+		thread.join();
+
+	std::set<uint32_t> uniqueIds;
+	for (const auto &threadIds : ids)
+		uniqueIds.insert(threadIds.begin(), threadIds.end());
+	EXPECT_EQ(uniqueIds.size(), static_cast<std::size_t>(threadCount * objectCount));
+
+	MockObject object;
+	MockObject copy(object);
+	EXPECT_NE(object.getId(), copy.getId());
+}
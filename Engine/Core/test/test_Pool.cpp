@@ -0,0 +1,76 @@
+#include "Core/Memory/Arena.hpp"
+#include "Core/Memory/Pool.hpp"
+#include "Core/Object.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace Stone;
+
+class PooledObject : public Core::Object {
+	STONE_OBJECT(PooledObject, Core::Object)
+
+public:
+	explicit PooledObject(int value) : value(value) {
+	}
+
+	int value;
+};
+
+TEST(Pool, ReuseFreedBlocks) {
+	Core::Memory::Pool pool("test", 24, 8, 4);
+
+	void *first = pool.allocate();
+	void *second = pool.allocate();
+	EXPECT_NE(first, second);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % 8, 0);
+
+	pool.deallocate(first);
+	EXPECT_EQ(pool.allocate(), first);
+
+	for (int i = 0; i < 6; i++)
+		(void)pool.allocate();
+	Core::Memory::PoolStatistics statistics = pool.getStatistics();
+	EXPECT_EQ(statistics.liveBlocks, 8);
+	EXPECT_EQ(statistics.slabCount, 2);
+	EXPECT_EQ(statistics.reservedBlocks, 8);
+	EXPECT_EQ(statistics.allocations, 9);
+}
+
+TEST(Pool, MakePooled) {
+	std::shared_ptr<PooledObject> object = Core::Memory::makePooled<PooledObject>(42);
+	EXPECT_EQ(object->value, 42);
+	EXPECT_EQ(object->shared_from_this(), object);
+
+	auto findStatistics = [] {
+		auto all = Core::Memory::Pool::allStatistics();
+		auto it = std::find_if(all.begin(), all.end(), [](const auto &statistics) {
+			return statistics.name == PooledObject::StaticClassName();
+		});
+		return it == all.end() ? Core::Memory::PoolStatistics() : *it;
+	};
+	EXPECT_EQ(findStatistics().liveBlocks, 1);
+	object.reset();
+	EXPECT_EQ(findStatistics().liveBlocks, 0);
+}
+
+TEST(Arena, MakeInArena) {
+	auto arena = std::make_shared<Core::Memory::Arena>(256);
+	std::weak_ptr<Core::Memory::Arena> weakArena = arena;
+
+	std::vector<std::shared_ptr<PooledObject>> objects;
+	for (int i = 0; i < 20; i++)
+		objects.push_back(Core::Memory::makeInArena<PooledObject>(arena, i));
+	for (int i = 0; i < 20; i++)
+		EXPECT_EQ(objects[i]->value, i);
+
+	Core::Memory::ArenaStatistics statistics = arena->getStatistics();
+	EXPECT_EQ(statistics.liveAllocations, 20);
+	EXPECT_GT(statistics.slabCount, 1);
+
+	// The objects keep the arena alive
+	arena.reset();
+	EXPECT_FALSE(weakArena.expired());
+	objects.clear();
+	EXPECT_TRUE(weakArena.expired());
+}
@@ -1 +1,7 @@
 #pragma once
+
+#include "Logging/LogSink.hpp"
+#include "Logging/Logger.hpp"
+#include "Logging/Metrics.hpp"
+#include "Logging/Profiler.hpp"
+#include "Logging/TermColor.hpp"
@@ -0,0 +1,96 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Logging/Logger.hpp"
+
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Stone::Logging {
+
+/**
+ * @brief Format a message as one line: time, level, category and text, without line break.
+ */
+std::string formatLogLine(const LogMessage &message);
+
+/**
+ * @brief Destination of the messages of a logger.
+ *
+ * Sinks are called from the writer thread of the logger only.
+ */
+class LogSink {
+public:
+	LogSink() = default;
+	LogSink(const LogSink &) = delete;
+
+	virtual ~LogSink() = default;
+
+	virtual void write(const LogMessage &message) = 0;
+
+	virtual void flush() {
+	}
+};
+
+/**
+ * @brief Write the messages to a stream, std::cout by default, colored by level.
+ */
+class ConsoleSink : public LogSink {
+public:
+	explicit ConsoleSink(bool colors = true);
+	ConsoleSink(std::ostream &stream, bool colors);
+
+	void write(const LogMessage &message) override;
+	void flush() override;
+
+private:
+	std::ostream &_stream;
+	bool _colors;
+};
+
+/**
+ * @brief Write the messages to a file, renamed with a numbered suffix when it exceeds its maximum size.
+ *
+ * The current file is the given path, the previous ones are path.1 (most recent) up to path.<maxFiles - 1>.
+ */
+class RotatingFileSink : public LogSink {
+public:
+	RotatingFileSink(std::string path, size_t maxSize = 10 * 1024 * 1024, size_t maxFiles = 5);
+
+	void write(const LogMessage &message) override;
+	void flush() override;
+
+private:
+	void _rotate();
+
+	std::string _path;
+	size_t _maxSize;
+	size_t _maxFiles;
+	size_t _size = 0;
+	std::ofstream _file;
+};
+
+/**
+ * @brief Keep the last messages in memory, to display them in a console widget or inspect them in tests.
+ */
+class MemorySink : public LogSink {
+public:
+	explicit MemorySink(size_t capacity = 1024);
+
+	void write(const LogMessage &message) override;
+
+	[[nodiscard]] std::vector<LogMessage> getMessages() const;
+
+	void clear();
+
+private:
+	size_t _capacity;
+	mutable std::mutex _mutex;
+	std::deque<LogMessage> _messages;
+};
+
+} // namespace Stone::Logging
@@ -0,0 +1,267 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#define STONE_LOG_LEVEL_TRACE 0
+#define STONE_LOG_LEVEL_DEBUG 1
+#define STONE_LOG_LEVEL_INFO 2
+#define STONE_LOG_LEVEL_WARNING 3
+#define STONE_LOG_LEVEL_ERROR 4
+#define STONE_LOG_LEVEL_OFF 5
+
+#ifndef STONE_LOG_LEVEL
+#ifdef NDEBUG
+#define STONE_LOG_LEVEL STONE_LOG_LEVEL_INFO
+#else
+#define STONE_LOG_LEVEL STONE_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+namespace Stone::Logging {
+
+class LogSink;
+
+enum class Level : uint8_t {
+	Trace = STONE_LOG_LEVEL_TRACE,
+	Debug = STONE_LOG_LEVEL_DEBUG,
+	Info = STONE_LOG_LEVEL_INFO,
+	Warning = STONE_LOG_LEVEL_WARNING,
+	Error = STONE_LOG_LEVEL_ERROR,
+	Off = STONE_LOG_LEVEL_OFF,
+};
+
+const char *toString(Level level);
+
+/**
+ * @brief An argument of a log call, kept unformatted until the writer thread formats the message.
+ */
+using LogArgument = std::variant<std::monostate, bool, char, int64_t, uint64_t, double, const void *, std::string>;
+
+/**
+ * @brief Capture an argument by value, types without a dedicated alternative are formatted with operator<< now.
+ */
+template <typename T>
+LogArgument makeLogArgument(const T &value) {
+	using Type = std::decay_t<T>;
+	if constexpr (std::is_same_v<Type, bool> || std::is_same_v<Type, char>) {
+		return value;
+	} else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+		return static_cast<int64_t>(value);
+	} else if constexpr (std::is_integral_v<Type>) {
+		return static_cast<uint64_t>(value);
+	} else if constexpr (std::is_enum_v<Type>) {
+		return static_cast<int64_t>(value);
+	} else if constexpr (std::is_floating_point_v<Type>) {
+		return static_cast<double>(value);
+	} else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+		if constexpr (std::is_pointer_v<T>) {
+			if (value == nullptr) {
+				return std::string("(null)");
+			}
+		}
+		return std::string(std::string_view(value));
+	} else if constexpr (std::is_pointer_v<Type>) {
+		return static_cast<const void *>(value);
+	} else {
+		std::ostringstream stream;
+		stream << value;
+		return stream.str();
+	}
+}
+
+/**
+ * @brief A formatted message, as given to the sinks.
+ */
+struct LogMessage {
+	Level level = Level::Info;
+	std::chrono::system_clock::time_point time = {};
+	uint32_t thread = 0; /**< A small number identifying the thread that logged the message. */
+	const char *category = "";
+	std::string text;
+};
+
+/**
+ * @brief Replace each {} of the format by the next argument, {{ and }} write a brace.
+ */
+std::string formatLogArguments(const char *format, const LogArgument *arguments, size_t argumentCount);
+
+/**
+ * @brief Asynchronous logger writing the messages to its sinks from a background thread.
+ *
+ * A log call copies its arguments in a lock-free ring buffer owned by the calling thread and returns,
+ * the formatting and the I/O happen on the writer thread. Messages logged while the buffer of a thread is full
+ * are dropped and reported. The format and the category are not copied, they must be string literals.
+ *
+ * Levels below STONE_LOG_LEVEL are removed at compile time by the STONE_LOG_* macros,
+ * the others are filtered at runtime with setLevel.
+ */
+class Logger {
+public:
+	static constexpr size_t maxArguments = 8;
+	static constexpr size_t threadBufferCapacity = 4096;
+
+	/**
+	 * @brief The logger used by the STONE_LOG_* macros, writing to the console by default.
+	 */
+	static Logger &instance();
+
+	Logger();
+	Logger(const Logger &) = delete;
+	Logger &operator=(const Logger &) = delete;
+
+	/**
+	 * @brief Write the pending messages and stop the writer thread.
+	 */
+	virtual ~Logger();
+
+	void setLevel(Level level) {
+		_level.store(level, std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] Level getLevel() const {
+		return _level.load(std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] bool isEnabled(Level level) const {
+		return level >= getLevel() && level != Level::Off;
+	}
+
+	void addSink(const std::shared_ptr<LogSink> &sink);
+	void removeSink(const std::shared_ptr<LogSink> &sink);
+	void clearSinks();
+
+	template <typename... Args>
+	void log(Level level, const char *category, const char *format, const Args &...args) {
+		static_assert(sizeof...(Args) <= maxArguments, "Too many arguments for a log message");
+		if (!isEnabled(level)) {
+			return;
+		}
+
+		ThreadBuffer &buffer = _threadBuffer();
+		Record *record = _reserve(buffer);
+		if (record == nullptr) {
+			return;
+		}
+		record->level = level;
+		record->time = std::chrono::system_clock::now();
+		record->category = category;
+		record->format = format;
+		record->argumentCount = sizeof...(Args);
+		size_t index = 0;
+		((record->arguments[index++] = makeLogArgument(args)), ...);
+		_commit(buffer, level);
+	}
+
+	/**
+	 * @brief Block until every message logged before the call is written and the sinks are flushed.
+	 */
+	void flush();
+
+	[[nodiscard]] uint64_t getDroppedCount() const;
+
+private:
+	struct Record {
+		Level level = Level::Info;
+		std::chrono::system_clock::time_point time = {};
+		const char *category = "";
+		const char *format = "";
+		std::array<LogArgument, maxArguments> arguments = {};
+		size_t argumentCount = 0;
+	};
+
+	struct ThreadBuffer {
+		uint32_t thread = 0;
+		std::vector<Record> records = std::vector<Record>(threadBufferCapacity);
+		std::atomic<uint64_t> head = 0; /**< Written by the owning thread only. */
+		std::atomic<uint64_t> tail = 0; /**< Written by the writer thread only. */
+		std::atomic<uint64_t> dropped = 0;
+	};
+
+	ThreadBuffer &_threadBuffer();
+
+	Record *_reserve(ThreadBuffer &buffer);
+
+	void _commit(ThreadBuffer &buffer, Level level);
+
+	void _wakeWriter();
+
+	void _writerLoop();
+
+	void _writePending();
+
+	const uint64_t _id;
+
+	std::atomic<Level> _level;
+
+	mutable std::mutex _mutex;
+	std::condition_variable _condition;
+	std::condition_variable _flushCondition;
+	bool _stopping = false;
+	bool _wakeRequested = false;
+	uint64_t _flushRequested = 0;
+	uint64_t _flushDone = 0;
+	std::vector<std::shared_ptr<ThreadBuffer>> _threadBuffers;
+	uint32_t _nextThread = 1;
+
+	std::mutex _sinkMutex;
+	std::vector<std::shared_ptr<LogSink>> _sinks;
+
+	uint64_t _reportedDropped = 0;
+
+	std::thread _writer;
+};
+
+} // namespace Stone::Logging
+
+#define STONE_LOG(level, category, format, ...)                                                                       \
+	::Stone::Logging::Logger::instance().log(level, category, format __VA_OPT__(, ) __VA_ARGS__)
+
+#if STONE_LOG_LEVEL <= STONE_LOG_LEVEL_TRACE
+#define STONE_LOG_TRACE(category, format, ...)                                                                        \
+	STONE_LOG(::Stone::Logging::Level::Trace, category, format __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define STONE_LOG_TRACE(category, format, ...) (void)0
+#endif
+
+#if STONE_LOG_LEVEL <= STONE_LOG_LEVEL_DEBUG
+#define STONE_LOG_DEBUG(category, format, ...)                                                                        \
+	STONE_LOG(::Stone::Logging::Level::Debug, category, format __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define STONE_LOG_DEBUG(category, format, ...) (void)0
+#endif
+
+#if STONE_LOG_LEVEL <= STONE_LOG_LEVEL_INFO
+#define STONE_LOG_INFO(category, format, ...)                                                                         \
+	STONE_LOG(::Stone::Logging::Level::Info, category, format __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define STONE_LOG_INFO(category, format, ...) (void)0
+#endif
+
+#if STONE_LOG_LEVEL <= STONE_LOG_LEVEL_WARNING
+#define STONE_LOG_WARNING(category, format, ...)                                                                      \
+	STONE_LOG(::Stone::Logging::Level::Warning, category, format __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define STONE_LOG_WARNING(category, format, ...) (void)0
+#endif
+
+#if STONE_LOG_LEVEL <= STONE_LOG_LEVEL_ERROR
+#define STONE_LOG_ERROR(category, format, ...)                                                                        \
+	STONE_LOG(::Stone::Logging::Level::Error, category, format __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define STONE_LOG_ERROR(category, format, ...) (void)0
+#endif
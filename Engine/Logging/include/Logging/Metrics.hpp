@@ -0,0 +1,289 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Utils/Json.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Stone::Logging {
+
+/**
+ * @brief The number of shards each metric spreads its accumulation over.
+ */
+constexpr size_t metricsShardCount = 16;
+
+/**
+ * @brief The shard written by the calling thread, threads are spread over the shards in creation order.
+ */
+size_t metricsThreadShard();
+
+/**
+ * @brief A monotonic count, incremented from any thread without lock.
+ *
+ * Each thread adds to its own cache line, the shards are only summed when the value is read.
+ */
+class Counter {
+public:
+	explicit Counter(std::string name);
+	Counter(const Counter &) = delete;
+	Counter &operator=(const Counter &) = delete;
+
+	void add(uint64_t value = 1) {
+		_shards[metricsThreadShard()].value.fetch_add(value, std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] const std::string &getName() const {
+		return _name;
+	}
+
+	/**
+	 * @brief The count accumulated since the counter was created.
+	 */
+	[[nodiscard]] uint64_t getTotal() const;
+
+	/**
+	 * @brief The count accumulated during the last frame closed by MetricsRegistry::endFrame.
+	 */
+	[[nodiscard]] uint64_t getLastFrame() const {
+		return _lastFrame.load(std::memory_order_relaxed);
+	}
+
+private:
+	friend class MetricsRegistry;
+
+	struct alignas(64) Shard {
+		std::atomic<uint64_t> value = 0;
+	};
+
+	void _endFrame();
+
+	std::string _name;
+	std::array<Shard, metricsShardCount> _shards;
+	std::atomic<uint64_t> _frameStart = 0;
+	std::atomic<uint64_t> _lastFrame = 0;
+};
+
+/**
+ * @brief A value sampled at a point in time, like a queue size or a memory usage.
+ */
+class Gauge {
+public:
+	explicit Gauge(std::string name);
+	Gauge(const Gauge &) = delete;
+	Gauge &operator=(const Gauge &) = delete;
+
+	void set(double value) {
+		_value.store(value, std::memory_order_relaxed);
+	}
+
+	void add(double delta) {
+		_value.fetch_add(delta, std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] double get() const {
+		return _value.load(std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] const std::string &getName() const {
+		return _name;
+	}
+
+private:
+	std::string _name;
+	std::atomic<double> _value = 0.0;
+};
+
+/**
+ * @brief The merged buckets of a histogram, with the usual statistics precomputed.
+ */
+struct HistogramSnapshot {
+	uint64_t count = 0;
+	uint64_t sum = 0;
+	uint64_t min = 0;
+	uint64_t max = 0;
+	std::vector<uint64_t> buckets; /**< Count of the values of each bucket, see Histogram::bucketIndex. */
+
+	[[nodiscard]] double getMean() const {
+		return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+	}
+
+	/**
+	 * @brief The highest value of the bucket holding the given percentile, in [0, 100], clamped to [min, max].
+	 */
+	[[nodiscard]] uint64_t getValueAtPercentile(double percentile) const;
+};
+
+/**
+ * @brief Distribution of integer values, usually latencies in nanoseconds, with a bounded relative error.
+ *
+ * Like an HDR histogram, values are grouped in buckets whose width doubles with each power of two:
+ * each power of two is split in 2^subBucketBits buckets, so a value is known within 1 / 2^subBucketBits.
+ * The whole 64 bits range is covered. Each thread records in its own shard, allocated on its first record.
+ */
+class Histogram {
+public:
+	static constexpr uint32_t subBucketBits = 4;
+	static constexpr size_t subBucketCount = size_t(1) << subBucketBits;
+	static constexpr size_t bucketCount = (64 - subBucketBits + 1) * subBucketCount;
+
+	explicit Histogram(std::string name);
+	Histogram(const Histogram &) = delete;
+	Histogram &operator=(const Histogram &) = delete;
+
+	~Histogram();
+
+	void record(uint64_t value);
+
+	template <typename Rep, typename Period>
+	void record(std::chrono::duration<Rep, Period> duration) {
+		record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+	}
+
+	[[nodiscard]] const std::string &getName() const {
+		return _name;
+	}
+
+	[[nodiscard]] HistogramSnapshot snapshot() const;
+
+	[[nodiscard]] static size_t bucketIndex(uint64_t value);
+	[[nodiscard]] static uint64_t bucketLowerBound(size_t index);
+	[[nodiscard]] static uint64_t bucketUpperBound(size_t index);
+
+private:
+	struct Shard {
+		std::array<std::atomic<uint64_t>, bucketCount> buckets = {};
+		std::atomic<uint64_t> count = 0;
+		std::atomic<uint64_t> sum = 0;
+		std::atomic<uint64_t> min = UINT64_MAX;
+		std::atomic<uint64_t> max = 0;
+	};
+
+	Shard &_threadShard();
+
+	std::string _name;
+	std::array<std::atomic<Shard *>, metricsShardCount> _shards = {};
+};
+
+/**
+ * @brief Record the lifetime of the scope in a histogram, in nanoseconds.
+ */
+class ScopedTimer {
+public:
+	explicit ScopedTimer(Histogram &histogram) : _histogram(histogram), _begin(std::chrono::steady_clock::now()) {
+	}
+
+	ScopedTimer(const ScopedTimer &) = delete;
+	ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+	~ScopedTimer() {
+		_histogram.record(std::chrono::steady_clock::now() - _begin);
+	}
+
+private:
+	Histogram &_histogram;
+	std::chrono::steady_clock::time_point _begin;
+};
+
+struct CounterSnapshot {
+	uint64_t total = 0;
+	uint64_t lastFrame = 0;
+};
+
+/**
+ * @brief The values of every metric of a registry at a point in time.
+ */
+struct MetricsSnapshot {
+	uint64_t frameCount = 0;
+	std::map<std::string, CounterSnapshot> counters;
+	std::map<std::string, double> gauges;
+	std::map<std::string, HistogramSnapshot> histograms;
+
+	/**
+	 * @brief Convert to Json, histograms are summarized by their count, mean, extrema and percentiles.
+	 */
+	[[nodiscard]] Json::Value toJson() const;
+};
+
+/**
+ * @brief Owns the named metrics of the engine.
+ *
+ * Metrics are created on their first request and live as long as the registry, so the references
+ * can be kept, usually in a function static, to skip the lookup on hot paths.
+ */
+class MetricsRegistry {
+public:
+	static MetricsRegistry &instance();
+
+	MetricsRegistry() = default;
+	MetricsRegistry(const MetricsRegistry &) = delete;
+	MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+	Counter &counter(const std::string &name);
+	Gauge &gauge(const std::string &name);
+	Histogram &histogram(const std::string &name);
+
+	/**
+	 * @brief Close the current frame, the count of each counter during that frame becomes its last frame value.
+	 */
+	void endFrame();
+
+	[[nodiscard]] uint64_t getFrameCount() const {
+		return _frameCount.load(std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] MetricsSnapshot snapshot() const;
+
+private:
+	mutable std::mutex _mutex;
+	std::map<std::string, std::unique_ptr<Counter>> _counters;
+	std::map<std::string, std::unique_ptr<Gauge>> _gauges;
+	std::map<std::string, std::unique_ptr<Histogram>> _histograms;
+	std::atomic<uint64_t> _frameCount = 0;
+};
+
+/**
+ * @brief Periodically write the snapshot of a registry as Json to a file, for the monitoring tools.
+ *
+ * The file is replaced atomically, readers never see a partial dump. A last dump is written on destruction.
+ */
+class MetricsDumper {
+public:
+	MetricsDumper(MetricsRegistry &registry, std::string path,
+				  std::chrono::milliseconds interval = std::chrono::seconds(10));
+	MetricsDumper(const MetricsDumper &) = delete;
+	MetricsDumper &operator=(const MetricsDumper &) = delete;
+
+	virtual ~MetricsDumper();
+
+	/**
+	 * @brief Write the dump now.
+	 *
+	 * @return false if the file could not be written.
+	 */
+	bool dump();
+
+private:
+	void _loop();
+
+	MetricsRegistry &_registry;
+	std::string _path;
+	std::chrono::milliseconds _interval;
+
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	bool _stopping = false;
+	std::thread _thread;
+};
+
+} // namespace Stone::Logging
@@ -0,0 +1,175 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Stone::Logging {
+
+/**
+ * @brief A timed zone recorded by the profiler.
+ *
+ * The name and category are not copied, they must outlive the profiler, string literals or __func__.
+ */
+struct ProfileEvent {
+	const char *name = nullptr;
+	const char *category = nullptr;
+	uint64_t begin = 0;	   /**< Nanoseconds since the profiler epoch. */
+	uint64_t duration = 0; /**< Nanoseconds. */
+	uint32_t track = 0;	   /**< The thread that recorded the event, or the GPU track. */
+};
+
+/**
+ * @brief Collects CPU and GPU timed zones and exports them as a Chrome trace, readable by Perfetto.
+ *
+ * Each thread writes in its own fixed size ring buffer without lock, the buffers are drained by collect.
+ * Events recorded while a buffer is full are dropped and counted. GPU zones are few per frame and are
+ * appended to the collected events directly.
+ * Recording is disabled at runtime by default, and the scope macros compile to nothing without STONE_PROFILING.
+ */
+class Profiler {
+public:
+	/** The track of the events measured on the GPU with timestamp queries. */
+	static constexpr uint32_t gpuTrack = 0;
+
+	/** The number of events each thread can hold between two collects. */
+	static constexpr size_t threadBufferCapacity = 1 << 14;
+
+	static Profiler &instance();
+
+	Profiler(const Profiler &) = delete;
+	Profiler &operator=(const Profiler &) = delete;
+
+	void setEnabled(bool enabled) {
+		_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] bool isEnabled() const {
+		return _enabled.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Nanoseconds elapsed since the profiler epoch, on a steady clock.
+	 */
+	[[nodiscard]] static uint64_t now();
+
+	/**
+	 * @brief Name the track of the calling thread in the exported trace.
+	 */
+	void setThreadName(const std::string &name);
+
+	/**
+	 * @brief Record a zone measured on the calling thread.
+	 */
+	void recordCpuEvent(const char *name, const char *category, uint64_t begin, uint64_t end);
+
+	/**
+	 * @brief Record a zone measured on the GPU, already converted to the profiler clock.
+	 */
+	void recordGpuEvent(const char *name, uint64_t begin, uint64_t end);
+
+	/**
+	 * @brief Move the events of every thread buffer to the collected events.
+	 */
+	void collect();
+
+	/**
+	 * @brief Collect and return every event recorded so far, sorted by begin time.
+	 */
+	[[nodiscard]] std::vector<ProfileEvent> getEvents();
+
+	/**
+	 * @brief Forget the collected events and the pending events of every thread.
+	 */
+	void clear();
+
+	[[nodiscard]] uint64_t getDroppedEventCount() const;
+
+	/**
+	 * @brief Collect and write the events in the Chrome trace event format.
+	 */
+	void writeChromeTrace(std::ostream &stream);
+
+	/**
+	 * @brief Collect and write the events in a Chrome trace file.
+	 *
+	 * @return false if the file could not be written.
+	 */
+	bool saveChromeTrace(const std::string &path);
+
+private:
+	Profiler() = default;
+
+	struct ThreadBuffer {
+		uint32_t track = 0;
+		std::string name;
+		std::vector<ProfileEvent> events = std::vector<ProfileEvent>(threadBufferCapacity);
+		std::atomic<uint64_t> head = 0; /**< Written by the owning thread only. */
+		std::atomic<uint64_t> tail = 0; /**< Written by the collecting thread only. */
+		std::atomic<uint64_t> dropped = 0;
+	};
+
+	ThreadBuffer &_threadBuffer();
+
+	void _push(ThreadBuffer &buffer, const ProfileEvent &event);
+
+	void _drain(ThreadBuffer &buffer);
+
+	std::atomic<bool> _enabled = false;
+
+	mutable std::mutex _mutex;
+	std::vector<std::shared_ptr<ThreadBuffer>> _threadBuffers;
+	std::vector<ProfileEvent> _events;
+	uint32_t _nextTrack = gpuTrack + 1;
+};
+
+/**
+ * @brief Record the lifetime of the scope as a CPU zone when the profiler is enabled.
+ */
+class ProfileScope {
+public:
+	explicit ProfileScope(const char *name, const char *category = "cpu")
+		: _name(name), _category(category), _active(Profiler::instance().isEnabled()),
+		  _begin(_active ? Profiler::now() : 0) {
+	}
+
+	ProfileScope(const ProfileScope &) = delete;
+	ProfileScope &operator=(const ProfileScope &) = delete;
+
+	~ProfileScope() {
+		if (_active) {
+			Profiler::instance().recordCpuEvent(_name, _category, _begin, Profiler::now());
+		}
+	}
+
+private:
+	const char *_name;
+	const char *_category;
+	bool _active;
+	uint64_t _begin;
+};
+
+} // namespace Stone::Logging
+
+#define STONE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define STONE_PROFILE_CONCAT(a, b) STONE_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef STONE_PROFILING
+#define STONE_PROFILE_SCOPE(name)                                                                                     \
+	::Stone::Logging::ProfileScope STONE_PROFILE_CONCAT(_stoneProfileScope, __LINE__)(name)
+#define STONE_PROFILE_SCOPE_CATEGORY(name, category)                                                                  \
+	::Stone::Logging::ProfileScope STONE_PROFILE_CONCAT(_stoneProfileScope, __LINE__)(name, category)
+#define STONE_PROFILE_FUNCTION() STONE_PROFILE_SCOPE(__func__)
+#define STONE_PROFILE_THREAD_NAME(name) ::Stone::Logging::Profiler::instance().setThreadName(name)
+#else
+#define STONE_PROFILE_SCOPE(name) (void)0
+#define STONE_PROFILE_SCOPE_CATEGORY(name, category) (void)0
+#define STONE_PROFILE_FUNCTION() (void)0
+#define STONE_PROFILE_THREAD_NAME(name) (void)0
+#endif
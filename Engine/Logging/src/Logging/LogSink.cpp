@@ -0,0 +1,132 @@
+// Copyright 2024 Stone-Engine
+
+#include "Logging/LogSink.hpp"
+
+#include "Logging/TermColor.hpp"
+
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace Stone::Logging {
+
+std::string formatLogLine(const LogMessage &message) {
+	std::time_t time = std::chrono::system_clock::to_time_t(message.time);
+	auto milliseconds =
+		std::chrono::duration_cast<std::chrono::milliseconds>(message.time.time_since_epoch()).count() % 1000;
+
+	std::tm localTime = {};
+#ifdef _WIN32
+	localtime_s(&localTime, &time);
+#else
+	localtime_r(&time, &localTime);
+#endif
+
+	std::ostringstream stream;
+	stream << std::put_time(&localTime, "%H:%M:%S") << '.' << std::setfill('0') << std::setw(3) << milliseconds << ' '
+		   << toString(message.level) << " [" << message.category << "] " << message.text;
+	return stream.str();
+}
+
+/** ConsoleSink */
+
+static const char *levelColor(Level level) {
+	switch (level) {
+	case Level::Trace: return TERM_COLOR_GRAY;
+	case Level::Debug: return TERM_COLOR_CYAN;
+	case Level::Info: return TERM_COLOR_GREEN;
+	case Level::Warning: return TERM_COLOR_YELLOW;
+	case Level::Error: return TERM_COLOR_BOLD TERM_COLOR_RED;
+	default: return TERM_COLOR_RESET;
+	}
+}
+
+ConsoleSink::ConsoleSink(bool colors) : ConsoleSink(std::cout, colors) {
+}
+
+ConsoleSink::ConsoleSink(std::ostream &stream, bool colors) : LogSink(), _stream(stream), _colors(colors) {
+}
+
+void ConsoleSink::write(const LogMessage &message) {
+	if (_colors) {
+		_stream << levelColor(message.level) << formatLogLine(message) << TERM_COLOR_RESET << '\n';
+	} else {
+		_stream << formatLogLine(message) << '\n';
+	}
+}
+
+void ConsoleSink::flush() {
+	_stream.flush();
+}
+
+/** RotatingFileSink */
+
+RotatingFileSink::RotatingFileSink(std::string path, size_t maxSize, size_t maxFiles)
+	: LogSink(), _path(std::move(path)), _maxSize(maxSize), _maxFiles(std::max<size_t>(maxFiles, 1)) {
+	std::error_code error;
+	auto size = std::filesystem::file_size(_path, error);
+	_size = error ? 0 : static_cast<size_t>(size);
+	_file.open(_path, std::ios::out | std::ios::app);
+	if (!_file.is_open()) {
+		throw std::runtime_error("Failed to open log file: " + _path);
+	}
+}
+
+void RotatingFileSink::write(const LogMessage &message) {
+	std::string line = formatLogLine(message);
+	line += '\n';
+
+	if (_size > 0 && _size + line.size() > _maxSize) {
+		_rotate();
+	}
+
+	_file << line;
+	_size += line.size();
+}
+
+void RotatingFileSink::flush() {
+	_file.flush();
+}
+
+void RotatingFileSink::_rotate() {
+	_file.close();
+
+	std::error_code error;
+	if (_maxFiles > 1) {
+		std::filesystem::remove(_path + "." + std::to_string(_maxFiles - 1), error);
+		for (size_t i = _maxFiles - 1; i > 1; --i) {
+			std::filesystem::rename(_path + "." + std::to_string(i - 1), _path + "." + std::to_string(i), error);
+		}
+		std::filesystem::rename(_path, _path + ".1", error);
+	}
+
+	_file.open(_path, std::ios::out | std::ios::trunc);
+	_size = 0;
+}
+
+/** MemorySink */
+
+MemorySink::MemorySink(size_t capacity) : LogSink(), _capacity(capacity) {
+}
+
+void MemorySink::write(const LogMessage &message) {
+	std::unique_lock<std::mutex> lock(_mutex);
+	_messages.push_back(message);
+	while (_messages.size() > _capacity) {
+		_messages.pop_front();
+	}
+}
+
+std::vector<LogMessage> MemorySink::getMessages() const {
+	std::unique_lock<std::mutex> lock(_mutex);
+	return {_messages.begin(), _messages.end()};
+}
+
+void MemorySink::clear() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	_messages.clear();
+}
+
+} // namespace Stone::Logging
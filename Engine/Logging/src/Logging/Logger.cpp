@@ -0,0 +1,248 @@
+// Copyright 2024 Stone-Engine
+
+#include "Logging/Logger.hpp"
+
+#include "Logging/LogSink.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace Stone::Logging {
+
+const char *toString(Level level) {
+	switch (level) {
+	case Level::Trace: return "TRACE";
+	case Level::Debug: return "DEBUG";
+	case Level::Info: return "INFO";
+	case Level::Warning: return "WARNING";
+	case Level::Error: return "ERROR";
+	default: return "OFF";
+	}
+}
+
+static void appendArgument(std::string &text, const LogArgument &argument) {
+	std::visit(
+		[&text](const auto &value) {
+			using Type = std::decay_t<decltype(value)>;
+			if constexpr (std::is_same_v<Type, std::monostate>) {
+			} else if constexpr (std::is_same_v<Type, bool>) {
+				text += value ? "true" : "false";
+			} else if constexpr (std::is_same_v<Type, char>) {
+				text += value;
+			} else if constexpr (std::is_same_v<Type, std::string>) {
+				text += value;
+			} else {
+				std::ostringstream stream;
+				stream << value;
+				text += stream.str();
+			}
+		},
+		argument);
+}
+
+std::string formatLogArguments(const char *format, const LogArgument *arguments, size_t argumentCount) {
+	std::string text;
+	size_t argumentIndex = 0;
+	for (const char *c = format; *c != '\0'; ++c) {
+		if (c[0] == '{' && c[1] == '{') {
+			text += '{';
+			++c;
+		} else if (c[0] == '}' && c[1] == '}') {
+			text += '}';
+			++c;
+		} else if (c[0] == '{' && c[1] == '}' && argumentIndex < argumentCount) {
+			appendArgument(text, arguments[argumentIndex++]);
+			++c;
+		} else {
+			text += *c;
+		}
+	}
+	return text;
+}
+
+static std::atomic<uint64_t> nextLoggerId = 1;
+
+Logger &Logger::instance() {
+	static Logger logger;
+	static const bool consoleInstalled = (logger.addSink(std::make_shared<ConsoleSink>()), true);
+	(void)consoleInstalled;
+	return logger;
+}
+
+Logger::Logger() : _id(nextLoggerId++), _level(static_cast<Level>(STONE_LOG_LEVEL)) {
+	_writer = std::thread(&Logger::_writerLoop, this);
+}
+
+Logger::~Logger() {
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_condition.notify_all();
+	if (_writer.joinable()) {
+		_writer.join();
+	}
+}
+
+void Logger::addSink(const std::shared_ptr<LogSink> &sink) {
+	std::unique_lock<std::mutex> lock(_sinkMutex);
+	_sinks.push_back(sink);
+}
+
+void Logger::removeSink(const std::shared_ptr<LogSink> &sink) {
+	std::unique_lock<std::mutex> lock(_sinkMutex);
+	_sinks.erase(std::remove(_sinks.begin(), _sinks.end(), sink), _sinks.end());
+}
+
+void Logger::clearSinks() {
+	std::unique_lock<std::mutex> lock(_sinkMutex);
+	_sinks.clear();
+}
+
+void Logger::flush() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	uint64_t request = ++_flushRequested;
+	_wakeRequested = true;
+	_condition.notify_all();
+	_flushCondition.wait(lock, [this, request] { return _flushDone >= request || _stopping; });
+}
+
+uint64_t Logger::getDroppedCount() const {
+	std::unique_lock<std::mutex> lock(_mutex);
+	uint64_t dropped = 0;
+	for (const auto &buffer : _threadBuffers) {
+		dropped += buffer->dropped.load(std::memory_order_relaxed);
+	}
+	return dropped;
+}
+
+Logger::ThreadBuffer &Logger::_threadBuffer() {
+	// Several loggers may be used by a thread, the last one is cached to skip the lookup
+	thread_local std::unordered_map<uint64_t, std::shared_ptr<ThreadBuffer>> buffers;
+	thread_local uint64_t lastId = 0;
+	thread_local ThreadBuffer *lastBuffer = nullptr;
+
+	if (lastId == _id) {
+		return *lastBuffer;
+	}
+
+	std::shared_ptr<ThreadBuffer> &buffer = buffers[_id];
+	if (buffer == nullptr) {
+		// The logger keeps the buffer alive after the thread exits so its last messages are still written
+		buffer = std::make_shared<ThreadBuffer>();
+		std::unique_lock<std::mutex> lock(_mutex);
+		buffer->thread = _nextThread++;
+		_threadBuffers.push_back(buffer);
+	}
+	lastId = _id;
+	lastBuffer = buffer.get();
+	return *buffer;
+}
+
+Logger::Record *Logger::_reserve(ThreadBuffer &buffer) {
+	uint64_t head = buffer.head.load(std::memory_order_relaxed);
+	if (head - buffer.tail.load(std::memory_order_acquire) >= threadBufferCapacity) {
+		buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+	return &buffer.records[head % threadBufferCapacity];
+}
+
+void Logger::_commit(ThreadBuffer &buffer, Level level) {
+	uint64_t head = buffer.head.load(std::memory_order_relaxed) + 1;
+	buffer.head.store(head, std::memory_order_release);
+
+	// The writer polls, it is only woken for problems or when the buffer fills up
+	if (level >= Level::Warning ||
+		head - buffer.tail.load(std::memory_order_relaxed) == threadBufferCapacity / 2) {
+		_wakeWriter();
+	}
+}
+
+void Logger::_wakeWriter() {
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_wakeRequested = true;
+	}
+	_condition.notify_one();
+}
+
+void Logger::_writerLoop() {
+	while (true) {
+		bool stopping = false;
+		uint64_t flushRequested = 0;
+		uint64_t flushDone = 0;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_condition.wait_for(lock, std::chrono::milliseconds(10), [this] { return _stopping || _wakeRequested; });
+			_wakeRequested = false;
+			stopping = _stopping;
+			flushRequested = _flushRequested;
+			flushDone = _flushDone;
+		}
+
+		_writePending();
+
+		if (flushRequested != flushDone || stopping) {
+			std::unique_lock<std::mutex> sinkLock(_sinkMutex);
+			for (const auto &sink : _sinks) {
+				sink->flush();
+			}
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_flushDone = flushRequested;
+		}
+		_flushCondition.notify_all();
+
+		if (stopping) {
+			return;
+		}
+	}
+}
+
+void Logger::_writePending() {
+	std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		threadBuffers = _threadBuffers;
+	}
+
+	std::vector<LogMessage> messages;
+	uint64_t dropped = 0;
+	for (const auto &buffer : threadBuffers) {
+		uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+		uint64_t head = buffer->head.load(std::memory_order_acquire);
+		for (; tail != head; ++tail) {
+			const Record &record = buffer->records[tail % threadBufferCapacity];
+			messages.push_back({record.level, record.time, buffer->thread, record.category,
+								formatLogArguments(record.format, record.arguments.data(), record.argumentCount)});
+		}
+		buffer->tail.store(tail, std::memory_order_release);
+		dropped += buffer->dropped.load(std::memory_order_relaxed);
+	}
+
+	if (dropped > _reportedDropped) {
+		std::string text = std::to_string(dropped - _reportedDropped) + " messages dropped, the log buffers were full";
+		messages.push_back({Level::Warning, std::chrono::system_clock::now(), 0, "Logging", text});
+		_reportedDropped = dropped;
+	}
+
+	if (messages.empty()) {
+		return;
+	}
+
+	// Each thread buffer is ordered, interleave them by time
+	std::stable_sort(messages.begin(), messages.end(),
+					 [](const LogMessage &lhs, const LogMessage &rhs) { return lhs.time < rhs.time; });
+
+	std::unique_lock<std::mutex> sinkLock(_sinkMutex);
+	for (const LogMessage &message : messages) {
+		for (const auto &sink : _sinks) {
+			sink->write(message);
+		}
+	}
+}
+
+} // namespace Stone::Logging
@@ -0,0 +1,295 @@
+// Copyright 2024 Stone-Engine
+
+#include "Logging/Metrics.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace Stone::Logging {
+
+size_t metricsThreadShard() {
+	static std::atomic<size_t> nextShard = 0;
+	thread_local const size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % metricsShardCount;
+	return shard;
+}
+
+/** Counter */
+
+Counter::Counter(std::string name) : _name(std::move(name)) {
+}
+
+uint64_t Counter::getTotal() const {
+	uint64_t total = 0;
+	for (const Shard &shard : _shards) {
+		total += shard.value.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+void Counter::_endFrame() {
+	uint64_t total = getTotal();
+	_lastFrame.store(total - _frameStart.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	_frameStart.store(total, std::memory_order_relaxed);
+}
+
+/** Gauge */
+
+Gauge::Gauge(std::string name) : _name(std::move(name)) {
+}
+
+/** Histogram */
+
+uint64_t HistogramSnapshot::getValueAtPercentile(double percentile) const {
+	if (count == 0) {
+		return 0;
+	}
+
+	double clamped = std::clamp(percentile, 0.0, 100.0);
+	auto rank = static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count)));
+	rank = std::max<uint64_t>(rank, 1);
+
+	uint64_t seen = 0;
+	for (size_t index = 0; index < buckets.size(); ++index) {
+		seen += buckets[index];
+		if (seen >= rank) {
+			return std::clamp(Histogram::bucketUpperBound(index), min, max);
+		}
+	}
+	return max;
+}
+
+Histogram::Histogram(std::string name) : _name(std::move(name)) {
+}
+
+Histogram::~Histogram() {
+	for (auto &shard : _shards) {
+		delete shard.load(std::memory_order_relaxed);
+	}
+}
+
+size_t Histogram::bucketIndex(uint64_t value) {
+	if (value < subBucketCount) {
+		return static_cast<size_t>(value);
+	}
+	auto exponent = static_cast<uint32_t>(std::bit_width(value) - 1);
+	size_t subBucket = (value >> (exponent - subBucketBits)) & (subBucketCount - 1);
+	return ((exponent - subBucketBits + 1) << subBucketBits) + subBucket;
+}
+
+uint64_t Histogram::bucketLowerBound(size_t index) {
+	if (index < subBucketCount) {
+		return index;
+	}
+	size_t block = index >> subBucketBits;
+	uint64_t subBucket = index & (subBucketCount - 1);
+	return (subBucketCount + subBucket) << (block - 1);
+}
+
+uint64_t Histogram::bucketUpperBound(size_t index) {
+	if (index < subBucketCount) {
+		return index;
+	}
+	size_t block = index >> subBucketBits;
+	return bucketLowerBound(index) + ((uint64_t(1) << (block - 1)) - 1);
+}
+
+void Histogram::record(uint64_t value) {
+	Shard &shard = _threadShard();
+	shard.buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	shard.count.fetch_add(1, std::memory_order_relaxed);
+	shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+	// A shard is usually written by a single thread, the loops almost never retry
+	uint64_t min = shard.min.load(std::memory_order_relaxed);
+	while (value < min && !shard.min.compare_exchange_weak(min, value, std::memory_order_relaxed)) {
+	}
+	uint64_t max = shard.max.load(std::memory_order_relaxed);
+	while (value > max && !shard.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+	}
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+	HistogramSnapshot snapshot;
+	snapshot.buckets.resize(bucketCount, 0);
+	snapshot.min = UINT64_MAX;
+
+	for (const auto &shardPointer : _shards) {
+		const Shard *shard = shardPointer.load(std::memory_order_acquire);
+		if (shard == nullptr) {
+			continue;
+		}
+		for (size_t index = 0; index < bucketCount; ++index) {
+			snapshot.buckets[index] += shard->buckets[index].load(std::memory_order_relaxed);
+		}
+		snapshot.count += shard->count.load(std::memory_order_relaxed);
+		snapshot.sum += shard->sum.load(std::memory_order_relaxed);
+		snapshot.min = std::min(snapshot.min, shard->min.load(std::memory_order_relaxed));
+		snapshot.max = std::max(snapshot.max, shard->max.load(std::memory_order_relaxed));
+	}
+
+	if (snapshot.count == 0) {
+		snapshot.min = 0;
+	}
+	return snapshot;
+}
+
+Histogram::Shard &Histogram::_threadShard() {
+	std::atomic<Shard *> &slot = _shards[metricsThreadShard()];
+	Shard *shard = slot.load(std::memory_order_acquire);
+	if (shard != nullptr) {
+		return *shard;
+	}
+
+	auto newShard = std::make_unique<Shard>();
+	if (slot.compare_exchange_strong(shard, newShard.get(), std::memory_order_acq_rel)) {
+		return *newShard.release();
+	}
+	return *shard;
+}
+
+/** MetricsSnapshot */
+
+static Json::Value histogramToJson(const HistogramSnapshot &histogram) {
+	return Json::object({
+		{"count", Json::number(static_cast<double>(histogram.count))},
+		{"mean", Json::number(histogram.getMean())},
+		{"min", Json::number(static_cast<double>(histogram.min))},
+		{"max", Json::number(static_cast<double>(histogram.max))},
+		{"p50", Json::number(static_cast<double>(histogram.getValueAtPercentile(50.0)))},
+		{"p90", Json::number(static_cast<double>(histogram.getValueAtPercentile(90.0)))},
+		{"p99", Json::number(static_cast<double>(histogram.getValueAtPercentile(99.0)))},
+		{"p999", Json::number(static_cast<double>(histogram.getValueAtPercentile(99.9)))},
+	});
+}
+
+Json::Value MetricsSnapshot::toJson() const {
+	Json::Object countersJson;
+	for (const auto &[name, counter] : counters) {
+		countersJson[name] = Json::object({
+			{"total", Json::number(static_cast<double>(counter.total))},
+			{"last_frame", Json::number(static_cast<double>(counter.lastFrame))},
+		});
+	}
+
+	Json::Object gaugesJson;
+	for (const auto &[name, value] : gauges) {
+		gaugesJson[name] = Json::number(value);
+	}
+
+	Json::Object histogramsJson;
+	for (const auto &[name, histogram] : histograms) {
+		histogramsJson[name] = histogramToJson(histogram);
+	}
+
+	return Json::object({
+		{"frame_count", Json::number(static_cast<double>(frameCount))},
+		{"counters", Json::object(countersJson)},
+		{"gauges", Json::object(gaugesJson)},
+		{"histograms", Json::object(histogramsJson)},
+	});
+}
+
+/** MetricsRegistry */
+
+MetricsRegistry &MetricsRegistry::instance() {
+	static MetricsRegistry registry;
+	return registry;
+}
+
+template <typename Metric>
+static Metric &findOrCreate(std::map<std::string, std::unique_ptr<Metric>> &metrics, const std::string &name) {
+	std::unique_ptr<Metric> &metric = metrics[name];
+	if (metric == nullptr) {
+		metric = std::make_unique<Metric>(name);
+	}
+	return *metric;
+}
+
+Counter &MetricsRegistry::counter(const std::string &name) {
+	std::unique_lock<std::mutex> lock(_mutex);
+	return findOrCreate(_counters, name);
+}
+
+Gauge &MetricsRegistry::gauge(const std::string &name) {
+	std::unique_lock<std::mutex> lock(_mutex);
+	return findOrCreate(_gauges, name);
+}
+
+Histogram &MetricsRegistry::histogram(const std::string &name) {
+	std::unique_lock<std::mutex> lock(_mutex);
+	return findOrCreate(_histograms, name);
+}
+
+void MetricsRegistry::endFrame() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	for (auto &[name, counter] : _counters) {
+		counter->_endFrame();
+	}
+	_frameCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const {
+	std::unique_lock<std::mutex> lock(_mutex);
+	MetricsSnapshot snapshot;
+	snapshot.frameCount = getFrameCount();
+	for (const auto &[name, counter] : _counters) {
+		snapshot.counters[name] = {counter->getTotal(), counter->getLastFrame()};
+	}
+	for (const auto &[name, gauge] : _gauges) {
+		snapshot.gauges[name] = gauge->get();
+	}
+	for (const auto &[name, histogram] : _histograms) {
+		snapshot.histograms[name] = histogram->snapshot();
+	}
+	return snapshot;
+}
+
+/** MetricsDumper */
+
+MetricsDumper::MetricsDumper(MetricsRegistry &registry, std::string path, std::chrono::milliseconds interval)
+	: _registry(registry), _path(std::move(path)), _interval(interval) {
+	_thread = std::thread(&MetricsDumper::_loop, this);
+}
+
+MetricsDumper::~MetricsDumper() {
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_condition.notify_all();
+	if (_thread.joinable()) {
+		_thread.join();
+	}
+	dump();
+}
+
+bool MetricsDumper::dump() {
+	std::string json = _registry.snapshot().toJson().serialize();
+
+	std::string temporaryPath = _path + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::out | std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+		file << json;
+		if (!file.good()) {
+			return false;
+		}
+	}
+	return std::rename(temporaryPath.c_str(), _path.c_str()) == 0;
+}
+
+void MetricsDumper::_loop() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (!_condition.wait_for(lock, _interval, [this] { return _stopping; })) {
+		lock.unlock();
+		dump();
+		lock.lock();
+	}
+}
+
+} // namespace Stone::Logging
@@ -0,0 +1,166 @@
+// Copyright 2024 Stone-Engine
+
+#include "Logging/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+namespace Stone::Logging {
+
+Profiler &Profiler::instance() {
+	static Profiler profiler;
+	return profiler;
+}
+
+uint64_t Profiler::now() {
+	static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+	return static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Profiler::setThreadName(const std::string &name) {
+	ThreadBuffer &buffer = _threadBuffer();
+	std::unique_lock<std::mutex> lock(_mutex);
+	buffer.name = name;
+}
+
+void Profiler::recordCpuEvent(const char *name, const char *category, uint64_t begin, uint64_t end) {
+	ThreadBuffer &buffer = _threadBuffer();
+	_push(buffer, {name, category, begin, end > begin ? end - begin : 0, buffer.track});
+}
+
+void Profiler::recordGpuEvent(const char *name, uint64_t begin, uint64_t end) {
+	std::unique_lock<std::mutex> lock(_mutex);
+	_events.push_back({name, "gpu", begin, end > begin ? end - begin : 0, gpuTrack});
+}
+
+void Profiler::collect() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	for (const auto &buffer : _threadBuffers) {
+		_drain(*buffer);
+	}
+}
+
+std::vector<ProfileEvent> Profiler::getEvents() {
+	collect();
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	std::vector<ProfileEvent> events = _events;
+	std::stable_sort(events.begin(), events.end(),
+					 [](const ProfileEvent &lhs, const ProfileEvent &rhs) { return lhs.begin < rhs.begin; });
+	return events;
+}
+
+void Profiler::clear() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	for (const auto &buffer : _threadBuffers) {
+		buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+		buffer->dropped.store(0, std::memory_order_relaxed);
+	}
+	_events.clear();
+}
+
+uint64_t Profiler::getDroppedEventCount() const {
+	std::unique_lock<std::mutex> lock(_mutex);
+	uint64_t dropped = 0;
+	for (const auto &buffer : _threadBuffers) {
+		dropped += buffer->dropped.load(std::memory_order_relaxed);
+	}
+	return dropped;
+}
+
+static void writeJsonString(std::ostream &stream, const char *str) {
+	stream << '"';
+	for (const char *c = str != nullptr ? str : ""; *c != '\0'; ++c) {
+		switch (*c) {
+		case '"': stream << "\\\""; break;
+		case '\\': stream << "\\\\"; break;
+		case '\n': stream << "\\n"; break;
+		case '\t': stream << "\\t"; break;
+		default:
+			if (static_cast<unsigned char>(*c) >= 0x20) {
+				stream << *c;
+			}
+		}
+	}
+	stream << '"';
+}
+
+void Profiler::writeChromeTrace(std::ostream &stream) {
+	std::vector<ProfileEvent> events = getEvents();
+
+	std::vector<std::pair<uint32_t, std::string>> trackNames = {
+		{gpuTrack, "GPU"}
+	};
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		for (const auto &buffer : _threadBuffers) {
+			trackNames.emplace_back(buffer->track,
+									buffer->name.empty() ? "Thread " + std::to_string(buffer->track) : buffer->name);
+		}
+	}
+
+	// Timestamps of the trace event format are in microseconds
+	stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	for (const auto &[track, name] : trackNames) {
+		stream << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << track
+			   << ",\"args\":{\"name\":";
+		writeJsonString(stream, name.c_str());
+		stream << "}}";
+		first = false;
+	}
+	for (const ProfileEvent &event : events) {
+		stream << ",{\"name\":";
+		writeJsonString(stream, event.name);
+		stream << ",\"cat\":";
+		writeJsonString(stream, event.category);
+		stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.track << ",\"ts\":" << event.begin / 1000 << "."
+			   << (event.begin / 100) % 10 << ",\"dur\":" << event.duration / 1000 << "."
+			   << (event.duration / 100) % 10 << "}";
+	}
+	stream << "]}";
+}
+
+bool Profiler::saveChromeTrace(const std::string &path) {
+	std::ofstream file(path);
+	if (!file.is_open()) {
+		return false;
+	}
+	writeChromeTrace(file);
+	return file.good();
+}
+
+Profiler::ThreadBuffer &Profiler::_threadBuffer() {
+	thread_local std::shared_ptr<ThreadBuffer> buffer;
+	if (buffer == nullptr) {
+		// The registry keeps the buffer alive after the thread exits so its events can still be collected
+		buffer = std::make_shared<ThreadBuffer>();
+		std::unique_lock<std::mutex> lock(_mutex);
+		buffer->track = _nextTrack++;
+		_threadBuffers.push_back(buffer);
+	}
+	return *buffer;
+}
+
+void Profiler::_push(ThreadBuffer &buffer, const ProfileEvent &event) {
+	uint64_t head = buffer.head.load(std::memory_order_relaxed);
+	if (head - buffer.tail.load(std::memory_order_acquire) >= threadBufferCapacity) {
+		buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	buffer.events[head % threadBufferCapacity] = event;
+	buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::_drain(ThreadBuffer &buffer) {
+	uint64_t tail = buffer.tail.load(std::memory_order_relaxed);
+	uint64_t head = buffer.head.load(std::memory_order_acquire);
+	for (; tail != head; ++tail) {
+		_events.push_back(buffer.events[tail % threadBufferCapacity]);
+	}
+	buffer.tail.store(tail, std::memory_order_release);
+}
+
+} // namespace Stone::Logging
@@ -0,0 +1,142 @@
+#include "Logging/LogSink.hpp"
+#include "Logging/Logger.hpp"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <map>
+#include <sstream>
+#include <thread>
+
+using namespace Stone::Logging;
+
+TEST(Logger, FormatArguments) {
+	LogArgument arguments[] = {makeLogArgument(42), makeLogArgument("text"), makeLogArgument(true),
+							   makeLogArgument(1.5f)};
+
+	EXPECT_EQ(formatLogArguments("{} {} {} {}", arguments, 4), "42 text true 1.5");
+	EXPECT_EQ(formatLogArguments("{{}} {}", arguments, 1), "{} 42");
+	EXPECT_EQ(formatLogArguments("{} {}", arguments, 1), "42 {}");
+	EXPECT_EQ(formatLogArguments("no argument", arguments, 0), "no argument");
+}
+
+TEST(Logger, ArgumentsAreCopied) {
+	auto logger = std::make_unique<Logger>();
+	auto sink = std::make_shared<MemorySink>();
+	logger->addSink(sink);
+	logger->setLevel(Level::Trace);
+
+	{
+		std::string text = "temporary";
+		logger->log(Level::Info, "Test", "value {} and {}", text, -3);
+		text = "modified";
+	}
+	logger->flush();
+
+	std::vector<LogMessage> messages = sink->getMessages();
+	ASSERT_EQ(messages.size(), 1);
+	EXPECT_EQ(messages[0].level, Level::Info);
+	EXPECT_STREQ(messages[0].category, "Test");
+	EXPECT_EQ(messages[0].text, "value temporary and -3");
+}
+
+TEST(Logger, RuntimeLevel) {
+	auto logger = std::make_unique<Logger>();
+	auto sink = std::make_shared<MemorySink>();
+	logger->addSink(sink);
+	logger->setLevel(Level::Warning);
+
+	logger->log(Level::Debug, "Test", "hidden");
+	logger->log(Level::Error, "Test", "shown");
+	logger->flush();
+
+	std::vector<LogMessage> messages = sink->getMessages();
+	ASSERT_EQ(messages.size(), 1);
+	EXPECT_EQ(messages[0].text, "shown");
+}
+
+TEST(Logger, SeveralThreads) {
+	auto logger = std::make_unique<Logger>();
+	auto sink = std::make_shared<MemorySink>(1000);
+	logger->addSink(sink);
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t) {
+		threads.emplace_back([&logger, t] {
+			for (int i = 0; i < 100; ++i) {
+				logger->log(Level::Info, "Test", "thread {} message {}", t, i);
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	logger->flush();
+
+	std::vector<LogMessage> messages = sink->getMessages();
+	EXPECT_EQ(messages.size() + logger->getDroppedCount(), 400);
+	// The messages of a thread keep their order
+	std::map<uint32_t, std::chrono::system_clock::time_point> lastTimes;
+	for (const LogMessage &message : messages) {
+		EXPECT_LE(lastTimes[message.thread], message.time);
+		lastTimes[message.thread] = message.time;
+	}
+}
+
+TEST(Logger, DestructorWritesPending) {
+	auto sink = std::make_shared<MemorySink>();
+	{
+		Logger logger;
+		logger.addSink(sink);
+		logger.log(Level::Info, "Test", "last words");
+	}
+
+	ASSERT_EQ(sink->getMessages().size(), 1);
+	EXPECT_EQ(sink->getMessages()[0].text, "last words");
+}
+
+TEST(LogSink, Console) {
+	std::stringstream stream;
+	ConsoleSink sink(stream, false);
+
+	sink.write({Level::Warning, std::chrono::system_clock::now(), 1, "Render", "message"});
+
+	std::string line = stream.str();
+	EXPECT_NE(line.find("WARNING [Render] message\n"), std::string::npos);
+}
+
+TEST(LogSink, RotatingFile) {
+	std::string path = (std::filesystem::temp_directory_path() / "stone_test_rotating.log").string();
+	for (const std::string &file : {path, path + ".1", path + ".2"}) {
+		std::filesystem::remove(file);
+	}
+
+	{
+		RotatingFileSink sink(path, 100, 3);
+		for (int i = 0; i < 10; ++i) {
+			sink.write({Level::Info, std::chrono::system_clock::now(), 1, "Test", "a line long enough to rotate"});
+		}
+		sink.flush();
+	}
+
+	EXPECT_TRUE(std::filesystem::exists(path));
+	EXPECT_TRUE(std::filesystem::exists(path + ".1"));
+	EXPECT_TRUE(std::filesystem::exists(path + ".2"));
+	EXPECT_FALSE(std::filesystem::exists(path + ".3"));
+	EXPECT_LE(std::filesystem::file_size(path), 100);
+
+	for (const std::string &file : {path, path + ".1", path + ".2"}) {
+		std::filesystem::remove(file);
+	}
+}
+
+TEST(LogSink, MemoryCapacity) {
+	MemorySink sink(2);
+	for (int i = 0; i < 3; ++i) {
+		sink.write({Level::Info, std::chrono::system_clock::now(), 1, "Test", std::to_string(i)});
+	}
+
+	std::vector<LogMessage> messages = sink.getMessages();
+	ASSERT_EQ(messages.size(), 2);
+	EXPECT_EQ(messages[0].text, "1");
+	EXPECT_EQ(messages[1].text, "2");
+}
@@ -0,0 +1,148 @@
+#include "Logging/Metrics.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace Stone;
+using namespace Stone::Logging;
+
+TEST(Metrics, CounterSeveralThreads) {
+	MetricsRegistry registry;
+	Counter &counter = registry.counter("test.counter");
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 8; ++t) {
+		threads.emplace_back([&counter] {
+			for (int i = 0; i < 10000; ++i) {
+				counter.add();
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	EXPECT_EQ(counter.getTotal(), 80000);
+	EXPECT_EQ(&registry.counter("test.counter"), &counter);
+}
+
+TEST(Metrics, CounterLastFrame) {
+	MetricsRegistry registry;
+	Counter &counter = registry.counter("test.counter");
+
+	counter.add(3);
+	registry.endFrame();
+	counter.add(5);
+	registry.endFrame();
+
+	EXPECT_EQ(counter.getLastFrame(), 5);
+	EXPECT_EQ(counter.getTotal(), 8);
+	EXPECT_EQ(registry.getFrameCount(), 2);
+}
+
+TEST(Metrics, Gauge) {
+	MetricsRegistry registry;
+	Gauge &gauge = registry.gauge("test.gauge");
+
+	gauge.set(2.5);
+	gauge.add(1.0);
+
+	EXPECT_DOUBLE_EQ(gauge.get(), 3.5);
+}
+
+TEST(Metrics, HistogramBuckets) {
+	for (uint64_t value : std::vector<uint64_t>{0, 1, 15, 16, 17, 1000, 123456789, UINT64_MAX}) {
+		size_t index = Histogram::bucketIndex(value);
+		ASSERT_LT(index, Histogram::bucketCount);
+		EXPECT_LE(Histogram::bucketLowerBound(index), value);
+		EXPECT_GE(Histogram::bucketUpperBound(index), value);
+	}
+	for (size_t index = 1; index < Histogram::bucketCount; ++index) {
+		EXPECT_EQ(Histogram::bucketLowerBound(index), Histogram::bucketUpperBound(index - 1) + 1);
+	}
+	EXPECT_EQ(Histogram::bucketUpperBound(Histogram::bucketCount - 1), UINT64_MAX);
+}
+
+TEST(Metrics, HistogramPercentiles) {
+	MetricsRegistry registry;
+	Histogram &histogram = registry.histogram("test.histogram");
+
+	for (uint64_t value = 1; value <= 1000; ++value) {
+		histogram.record(value);
+	}
+
+	HistogramSnapshot snapshot = histogram.snapshot();
+	EXPECT_EQ(snapshot.count, 1000);
+	EXPECT_EQ(snapshot.min, 1);
+	EXPECT_EQ(snapshot.max, 1000);
+	EXPECT_DOUBLE_EQ(snapshot.getMean(), 500.5);
+
+	// Values are known within 1/16
+	EXPECT_NEAR(static_cast<double>(snapshot.getValueAtPercentile(50.0)), 500.0, 500.0 / 16);
+	EXPECT_NEAR(static_cast<double>(snapshot.getValueAtPercentile(99.0)), 990.0, 990.0 / 16);
+	EXPECT_EQ(snapshot.getValueAtPercentile(100.0), 1000);
+}
+
+TEST(Metrics, HistogramSeveralThreads) {
+	MetricsRegistry registry;
+	Histogram &histogram = registry.histogram("test.histogram");
+
+	std::vector<std::thread> threads;
+	for (uint64_t t = 0; t < 4; ++t) {
+		threads.emplace_back([&histogram, t] {
+			for (int i = 0; i < 1000; ++i) {
+				histogram.record(t * 100);
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	HistogramSnapshot snapshot = histogram.snapshot();
+	EXPECT_EQ(snapshot.count, 4000);
+	EXPECT_EQ(snapshot.min, 0);
+	EXPECT_EQ(snapshot.max, 300);
+}
+
+TEST(Metrics, SnapshotToJson) {
+	MetricsRegistry registry;
+	registry.counter("test.counter").add(4);
+	registry.gauge("test.gauge").set(1.5);
+	registry.histogram("test.histogram").record(10);
+	registry.endFrame();
+
+	Json::Value json = registry.snapshot().toJson();
+	auto &root = json.get<Json::Object>();
+	EXPECT_EQ(root["frame_count"].get<double>(), 1.0);
+
+	auto &counter = root["counters"].get<Json::Object>()["test.counter"].get<Json::Object>();
+	EXPECT_EQ(counter["total"].get<double>(), 4.0);
+	EXPECT_EQ(counter["last_frame"].get<double>(), 4.0);
+
+	EXPECT_EQ(root["gauges"].get<Json::Object>()["test.gauge"].get<double>(), 1.5);
+
+	auto &histogram = root["histograms"].get<Json::Object>()["test.histogram"].get<Json::Object>();
+	EXPECT_EQ(histogram["count"].get<double>(), 1.0);
+	EXPECT_EQ(histogram["p50"].get<double>(), 10.0);
+}
+
+TEST(Metrics, DumperWritesFile) {
+	const std::string path = testing::TempDir() + "stone_metrics.json";
+	std::remove(path.c_str());
+
+	MetricsRegistry registry;
+	registry.counter("test.counter").add(2);
+	{
+		MetricsDumper dumper(registry, path, std::chrono::hours(1));
+	}
+
+	Json::Value json;
+	Json::Value::parseFile(path, json);
+	auto &counters = json.get<Json::Object>()["counters"].get<Json::Object>();
+	EXPECT_EQ(counters["test.counter"].get<Json::Object>()["total"].get<double>(), 2.0);
+
+	std::remove(path.c_str());
+}
@@ -0,0 +1,94 @@
+#include "Logging/Profiler.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+
+using namespace Stone::Logging;
+
+class ProfilerTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		Profiler::instance().clear();
+		Profiler::instance().setEnabled(true);
+	}
+
+	void TearDown() override {
+		Profiler::instance().setEnabled(false);
+		Profiler::instance().clear();
+	}
+};
+
+TEST_F(ProfilerTest, ScopeRecordsEvent) {
+	{
+		ProfileScope scope("scope", "test");
+	}
+
+	std::vector<ProfileEvent> events = Profiler::instance().getEvents();
+	ASSERT_EQ(events.size(), 1);
+	EXPECT_STREQ(events[0].name, "scope");
+	EXPECT_STREQ(events[0].category, "test");
+	EXPECT_NE(events[0].track, Profiler::gpuTrack);
+}
+
+TEST_F(ProfilerTest, DisabledRecordsNothing) {
+	Profiler::instance().setEnabled(false);
+	{
+		ProfileScope scope("scope");
+	}
+
+	EXPECT_TRUE(Profiler::instance().getEvents().empty());
+}
+
+TEST_F(ProfilerTest, ThreadsHaveTheirOwnTrack) {
+	uint32_t mainTrack = 0;
+	{
+		ProfileScope scope("main");
+	}
+
+	std::thread thread([] {
+		Profiler::instance().setThreadName("Worker");
+		for (int i = 0; i < 100; ++i) {
+			ProfileScope scope("worker");
+		}
+	});
+	thread.join();
+
+	std::vector<ProfileEvent> events = Profiler::instance().getEvents();
+	ASSERT_EQ(events.size(), 101);
+	for (const ProfileEvent &event : events) {
+		if (std::string(event.name) == "main") {
+			mainTrack = event.track;
+		}
+	}
+	for (const ProfileEvent &event : events) {
+		if (std::string(event.name) == "worker") {
+			EXPECT_NE(event.track, mainTrack);
+		}
+	}
+}
+
+TEST_F(ProfilerTest, FullBufferDropsEvents) {
+	for (size_t i = 0; i < Profiler::threadBufferCapacity + 10; ++i) {
+		Profiler::instance().recordCpuEvent("event", "test", i, i + 1);
+	}
+
+	EXPECT_EQ(Profiler::instance().getDroppedEventCount(), 10);
+	EXPECT_EQ(Profiler::instance().getEvents().size(), Profiler::threadBufferCapacity);
+}
+
+TEST_F(ProfilerTest, ChromeTrace) {
+	Profiler::instance().recordCpuEvent("cpu \"zone\"", "test", 1000, 3500);
+	Profiler::instance().recordGpuEvent("gpu zone", 2000, 3000);
+
+	std::stringstream stream;
+	Profiler::instance().writeChromeTrace(stream);
+	std::string trace = stream.str();
+
+	EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0);
+	EXPECT_NE(trace.find("\"name\":\"GPU\""), std::string::npos);
+	EXPECT_NE(trace.find("\"name\":\"cpu \\\"zone\\\"\",\"cat\":\"test\",\"ph\":\"X\""), std::string::npos);
+	EXPECT_NE(trace.find("\"ts\":1.0,\"dur\":2.5"), std::string::npos);
+	EXPECT_NE(trace.find("\"name\":\"gpu zone\",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":1,\"tid\":0"), std::string::npos);
+	EXPECT_NE(trace.find("\"ts\":2.0,\"dur\":1.0"), std::string::npos);
+}
@@ -16,6 +16,39 @@ public:
 	virtual ~Renderer() = default;
 
 	virtual void updateFrameSize(std::pair<uint32_t, uint32_t> size) = 0;
+
+	/** Pipelined rendering */
+
+	/**
+	 * @brief Allocate the snapshot slots used by snapshotWorld and renderSnapshot.
+	 *
+	 * Must be called while no snapshot is being written or rendered.
+	 */
+	virtual void setSnapshotCount(uint32_t count) = 0;
+
+	/**
+	 * @brief Capture everything needed to draw the world in a snapshot slot, without touching the GPU.
+	 *
+	 * Called from the thread owning the world. The renderables that changed are kept in the snapshot, their renderer
+	 * data is updated by renderSnapshot: the world can be modified again once waitSnapshotReleased returns.
+	 */
+	virtual void snapshotWorld(const std::shared_ptr<Scene::WorldNode> &world, uint32_t slot) = 0;
+
+	/**
+	 * @brief Update the renderer data of the changed renderables, then record and present the draws captured in a
+	 * snapshot slot.
+	 *
+	 * Can be called from a dedicated render thread while the next snapshot is written in another slot.
+	 */
+	virtual void renderSnapshot(uint32_t slot) = 0;
+
+	/**
+	 * @brief Wait until renderSnapshot no longer reads the renderables of the world for a snapshot slot.
+	 *
+	 * Called from the thread owning the world once the slot is handed to the render thread. Returns immediately when
+	 * no renderable changed since the previous snapshot.
+	 */
+	virtual void waitSnapshotReleased(uint32_t slot) = 0;
 };
 
 } // namespace Stone::Render
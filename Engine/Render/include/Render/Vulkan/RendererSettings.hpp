@@ -23,6 +23,19 @@ struct RendererSettings {
 	std::function<VkResult(VkInstance, const VkAllocationCallbacks *, VkSurfaceKHR *)> createSurface = nullptr;
 	std::vector<const char *> deviceExt = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
 	std::pair<uint32_t, uint32_t> frame_size = {};
+	/** Render into offscreen images without surface nor swap chain, the frames are read back with readFrame. */
+	bool headless = false;
+	/** Format of the offscreen images, with 8 bits channels in RGBA order (R8 to R8G8B8A8) to match ImageData. */
+	VkFormat headlessFormat = VK_FORMAT_R8G8B8A8_UNORM;
+	/** Frames recorded by the CPU while the GPU renders, independent from the swap chain image count. */
+	uint32_t framesInFlight = 2;
+	bool enableBindless = true;
+	uint32_t bindlessMaxTextures = 4096;
+	uint32_t bindlessMaxMaterials = 1024;
+	/** Threads recording the draws in secondary command buffers, 0 for one per core, 1 to record inline. */
+	uint32_t recordingThreads = 0;
+	/** Minimum number of draws given to each recording thread. */
+	uint32_t drawsPerRecordingThread = 512;
 };
 
 } // namespace Stone::Render::Vulkan
@@ -5,8 +5,16 @@
 #include "Render/Renderer.hpp"
 #include "Render/Vulkan/RendererSettings.hpp"
 
+#include <condition_variable>
+#include <mutex>
+
+namespace Stone::Core::Image {
+class ImageData;
+}
+
 namespace Stone::Scene {
 class WorldNode;
+class RenderableNode;
 }
 
 namespace Stone::Render::Vulkan {
@@ -15,6 +23,12 @@ class Device;
 class RenderPass;
 class FramesRenderer;
 class SwapChain;
+class OffscreenTarget;
+class BindlessDescriptors;
+class CommandRecorder;
+class GpuProfiler;
+struct RenderQueueItem;
+struct FrameSnapshot;
 struct ImageContext;
 
 class VulkanRenderer : public Renderer {
@@ -32,6 +46,11 @@ public:
 
 	void updateFrameSize(std::pair<uint32_t, uint32_t> size) override;
 
+	void setSnapshotCount(uint32_t count) override;
+	void snapshotWorld(const std::shared_ptr<Scene::WorldNode> &world, uint32_t slot) override;
+	void renderSnapshot(uint32_t slot) override;
+	void waitSnapshotReleased(uint32_t slot) override;
+
 	/** VulkanRenderer */
 
 	[[nodiscard]] const std::shared_ptr<Device> &getDevice() const;
@@ -39,16 +58,60 @@ public:
 	[[nodiscard]] const std::shared_ptr<FramesRenderer> &getFramesRenderer() const;
 	[[nodiscard]] const std::shared_ptr<SwapChain> &getSwapChain() const;
 
+	/**
+	 * @brief Whether the frames are rendered offscreen, in which case there is no swap chain.
+	 */
+	[[nodiscard]] bool isHeadless() const;
+
+	/**
+	 * @brief The size of the rendered frames, from the swap chain or the offscreen target.
+	 */
+	[[nodiscard]] const VkExtent2D &getFrameExtent() const;
+
+	/**
+	 * @brief Copy the last rendered frame back to the host, only available in headless mode.
+	 *
+	 * Waits for the frame to be rendered. The image has as many channels as the headless format of the settings.
+	 */
+	[[nodiscard]] std::shared_ptr<Core::Image::ImageData> readFrame() const;
+
+	/**
+	 * @brief The global texture and material descriptors, or nullptr when the device lacks descriptor indexing.
+	 */
+	[[nodiscard]] const std::shared_ptr<BindlessDescriptors> &getBindlessDescriptors() const;
+
 private:
 	void _recreateSwapChain(std::pair<uint32_t, uint32_t> size);
+	void _recreateOffscreenTarget(std::pair<uint32_t, uint32_t> size);
+
+	void _updateRenderables(const std::vector<std::shared_ptr<Scene::RenderableNode>> &renderables);
+	void _releaseSnapshot(FrameSnapshot &snapshot);
+
+	void _collectRenderQueue(const std::shared_ptr<Scene::WorldNode> &world, FrameSnapshot &snapshot);
+
+	void _recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t frameIndex, ImageContext *imageContext,
+							  const FrameSnapshot &snapshot);
+
+	void _recordRenderQueue(VkCommandBuffer commandBuffer, uint32_t frameIndex, ImageContext *imageContext,
+							const std::vector<RenderQueueItem> &renderQueue, size_t begin, size_t end);
 
-	void _recordCommandBuffer(VkCommandBuffer commandBuffer, ImageContext *imageContext,
-							  const std::shared_ptr<Scene::WorldNode> &world);
+	void _createCommandRecorder();
 
 	std::shared_ptr<Device> _device;
 	std::shared_ptr<RenderPass> _renderPass;
 	std::shared_ptr<FramesRenderer> _framesRenderer;
 	std::shared_ptr<SwapChain> _swapChain;
+	std::shared_ptr<OffscreenTarget> _offscreenTarget;
+	VkFormat _headlessFormat;
+	std::shared_ptr<BindlessDescriptors> _bindlessDescriptors;
+
+	uint32_t _recordingThreads;
+	uint32_t _drawsPerRecordingThread;
+	std::unique_ptr<CommandRecorder> _commandRecorder;
+	std::unique_ptr<GpuProfiler> _gpuProfiler;
+	std::vector<FrameSnapshot> _snapshots;
+	std::mutex _snapshotMutex;
+	std::condition_variable _snapshotReleased;
 };
 
 } // namespace Stone::Render::Vulkan
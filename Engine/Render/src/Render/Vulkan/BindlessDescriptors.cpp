@@ -0,0 +1,431 @@
+// Copyright 2024 Stone-Engine
+
+#include "BindlessDescriptors.hpp"
+
+#include "Device.hpp"
+#include "RenderMetrics.hpp"
+#include "RenderPass.hpp"
+#include "VulkanRenderable/RenderableUtils.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+namespace Stone::Render::Vulkan {
+
+namespace {
+
+template <std::size_t N>
+int findSlot(const std::array<std::pair<StringId, uint32_t>, N> &slots, StringId name) {
+	for (const auto &[slotName, slot] : slots) {
+		if (slotName == name) {
+			return static_cast<int>(slot);
+		}
+	}
+	return -1;
+}
+
+} // namespace
+
+int MaterialParameters::textureSlot(StringId name) {
+	static const std::array<std::pair<StringId, uint32_t>, 8> slots = {{
+		{"diffuse"_id, diffuseTexture},
+		{"specular"_id, specularTexture},
+		{"normals"_id, normalsTexture},
+		{"emissive"_id, emissiveTexture},
+		{"occlusion"_id, occlusionTexture},
+		{"roughness"_id, roughnessTexture},
+		{"metalness"_id, metalnessTexture},
+		{"opacity"_id, opacityTexture},
+	}};
+	return findSlot(slots, name);
+}
+
+int MaterialParameters::vectorSlot(StringId name) {
+	static const std::array<std::pair<StringId, uint32_t>, 4> slots = {{
+		{"diffuse"_id, diffuseVector},
+		{"specular"_id, specularVector},
+		{"ambient"_id, ambientVector},
+		{"emissive"_id, emissiveVector},
+	}};
+	return findSlot(slots, name);
+}
+
+int MaterialParameters::scalarSlot(StringId name) {
+	static const std::array<std::pair<StringId, uint32_t>, 5> slots = {{
+		{"opacity"_id, opacityScalar},
+		{"shininess"_id, shininessScalar},
+		{"roughness"_id, roughnessScalar},
+		{"metallic"_id, metallicScalar},
+		{"reflectivity"_id, reflectivityScalar},
+	}};
+	return findSlot(slots, name);
+}
+
+BindlessDescriptors::BindlessDescriptors(const std::shared_ptr<Device> &device,
+										 const std::shared_ptr<RenderPass> &renderPass, VkExtent2D extent,
+										 uint32_t maxMaterials, uint32_t framesInFlight)
+	: _device(device), _textureCapacity(device->getBindlessTextureLimit()), _materialCapacity(maxMaterials),
+	  _framesInFlight(framesInFlight), _materials(maxMaterials), _frameUploads(framesInFlight) {
+	for (FrameUploads &uploads : _frameUploads) {
+		uploads.pending.resize(maxMaterials, false);
+	}
+	_createDescriptorSetLayouts();
+	_createDescriptorPool();
+	_createDescriptorSet();
+	_createMaterialBuffer();
+	_createGraphicPipeline(renderPass, extent);
+	_createDefaultTexture();
+
+	[[maybe_unused]] uint32_t defaultTexture = registerTexture(_defaultImageView, _defaultSampler);
+	[[maybe_unused]] uint32_t defaultMaterial = registerMaterial();
+	assert(defaultTexture == 0 && defaultMaterial == 0);
+}
+
+BindlessDescriptors::~BindlessDescriptors() {
+	_destroyDefaultTexture();
+	_destroyGraphicPipeline();
+	_destroyMaterialBuffer();
+	_destroyDescriptorPool();
+	_destroyDescriptorSetLayouts();
+}
+
+uint32_t BindlessDescriptors::registerTexture(VkImageView imageView, VkSampler sampler) {
+	// Descriptor writes to the set must not overlap, the lock is kept until the descriptor is written
+	std::lock_guard lock(_mutex);
+	uint32_t slot;
+	if (!_freeTextureSlots.empty()) {
+		slot = _freeTextureSlots.back();
+		_freeTextureSlots.pop_back();
+	} else if (_nextTextureSlot < _textureCapacity) {
+		slot = _nextTextureSlot++;
+	} else {
+		throw std::runtime_error("Bindless texture array is full");
+	}
+
+	VkDescriptorImageInfo imageInfo = {};
+	imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	imageInfo.imageView = imageView;
+	imageInfo.sampler = sampler;
+
+	VkWriteDescriptorSet descriptorWrite = {};
+	descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	descriptorWrite.dstSet = _descriptorSet;
+	descriptorWrite.dstBinding = 0;
+	descriptorWrite.dstArrayElement = slot;
+	descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	descriptorWrite.descriptorCount = 1;
+	descriptorWrite.pImageInfo = &imageInfo;
+
+	vkUpdateDescriptorSets(_device->getDevice(), 1, &descriptorWrite, 0, nullptr);
+	RenderMetrics::instance().descriptorUpdates.add();
+	return slot;
+}
+
+void BindlessDescriptors::releaseTexture(uint32_t slot) {
+	std::lock_guard lock(_mutex);
+	if (slot == 0 || slot >= _nextTextureSlot) {
+		return;
+	}
+	// The descriptor is left as is, partially bound arrays allow stale entries that are never sampled
+	_retiredTextureSlots.push_back({slot, _framesInFlight});
+}
+
+uint32_t BindlessDescriptors::registerMaterial() {
+	std::lock_guard lock(_mutex);
+	uint32_t slot;
+	if (!_freeMaterialSlots.empty()) {
+		slot = _freeMaterialSlots.back();
+		_freeMaterialSlots.pop_back();
+	} else if (_nextMaterialSlot < _materialCapacity) {
+		slot = _nextMaterialSlot++;
+	} else {
+		throw std::runtime_error("Bindless material buffer is full");
+	}
+
+	_setMaterial(slot, MaterialParameters());
+	return slot;
+}
+
+void BindlessDescriptors::updateMaterial(uint32_t slot, const MaterialParameters &parameters) {
+	assert(slot < _materialCapacity);
+	std::lock_guard lock(_mutex);
+	_setMaterial(slot, parameters);
+}
+
+void BindlessDescriptors::_setMaterial(uint32_t slot, const MaterialParameters &parameters) {
+	_materials[slot] = parameters;
+	for (FrameUploads &uploads : _frameUploads) {
+		if (!uploads.pending[slot]) {
+			uploads.pending[slot] = true;
+			uploads.slots.push_back(slot);
+		}
+	}
+}
+
+void BindlessDescriptors::releaseMaterial(uint32_t slot) {
+	std::lock_guard lock(_mutex);
+	if (slot == 0 || slot >= _nextMaterialSlot) {
+		return;
+	}
+	_retiredMaterialSlots.push_back({slot, _framesInFlight});
+}
+
+void BindlessDescriptors::beginFrame(uint32_t frameIndex) {
+	assert(frameIndex < _framesInFlight);
+	std::lock_guard lock(_mutex);
+
+	FrameUploads &uploads = _frameUploads[frameIndex];
+	MaterialParameters *region = _materialBufferMapped + static_cast<size_t>(frameIndex) * _materialCapacity;
+	for (uint32_t slot : uploads.slots) {
+		std::memcpy(region + slot, &_materials[slot], sizeof(MaterialParameters));
+		uploads.pending[slot] = false;
+	}
+	RenderMetrics::instance().uploadedBytes.add(uploads.slots.size() * sizeof(MaterialParameters));
+	uploads.slots.clear();
+
+	_recycleSlots(_retiredTextureSlots, _freeTextureSlots);
+	_recycleSlots(_retiredMaterialSlots, _freeMaterialSlots);
+}
+
+void BindlessDescriptors::_recycleSlots(std::vector<RetiredSlot> &retiredSlots, std::vector<uint32_t> &freeSlots) {
+	// Frames are begun in turn, once every frame has been begun the frames that could use the slot are done
+	std::erase_if(retiredSlots, [&freeSlots](RetiredSlot &retired) {
+		if (--retired.remainingFrames > 0)
+			return false;
+		freeSlots.push_back(retired.slot);
+		return true;
+	});
+}
+
+void BindlessDescriptors::bind(VkCommandBuffer commandBuffer) const {
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _pipeline);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _pipelineLayout, 1, 1, &_descriptorSet, 0,
+							nullptr);
+}
+
+void BindlessDescriptors::_createDescriptorSetLayouts() {
+	std::array<VkDescriptorSetLayoutBinding, 2> bindings = {};
+
+	bindings[0].binding = 0;
+	bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	bindings[0].descriptorCount = _textureCapacity;
+	bindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+	bindings[1].binding = 1;
+	bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	bindings[1].descriptorCount = 1;
+	bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+	std::array<VkDescriptorBindingFlags, 2> bindingFlags = {
+		VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+			VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT,
+		0,
+	};
+
+	VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {};
+	bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+	bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+	bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.pNext = &bindingFlagsInfo;
+	layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+	layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+	layoutInfo.pBindings = bindings.data();
+
+	if (vkCreateDescriptorSetLayout(_device->getDevice(), &layoutInfo, nullptr, &_bindlessSetLayout) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to create bindless descriptor set layout");
+	}
+
+	VkDescriptorSetLayoutBinding uboLayoutBinding = {};
+	uboLayoutBinding.binding = 0;
+	uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	uboLayoutBinding.descriptorCount = 1;
+	uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+	VkDescriptorSetLayoutCreateInfo objectLayoutInfo = {};
+	objectLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	objectLayoutInfo.bindingCount = 1;
+	objectLayoutInfo.pBindings = &uboLayoutBinding;
+
+	if (vkCreateDescriptorSetLayout(_device->getDevice(), &objectLayoutInfo, nullptr, &_objectSetLayout) !=
+		VK_SUCCESS) {
+		throw std::runtime_error("Failed to create object descriptor set layout");
+	}
+}
+
+void BindlessDescriptors::_destroyDescriptorSetLayouts() {
+	vkDestroyDescriptorSetLayout(_device->getDevice(), _objectSetLayout, nullptr);
+	_objectSetLayout = VK_NULL_HANDLE;
+	vkDestroyDescriptorSetLayout(_device->getDevice(), _bindlessSetLayout, nullptr);
+	_bindlessSetLayout = VK_NULL_HANDLE;
+}
+
+void BindlessDescriptors::_createDescriptorPool() {
+	std::array<VkDescriptorPoolSize, 2> poolSizes = {};
+	poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	poolSizes[0].descriptorCount = _textureCapacity;
+	poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSizes[1].descriptorCount = 1;
+
+	VkDescriptorPoolCreateInfo poolInfo = {};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+	poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+	poolInfo.pPoolSizes = poolSizes.data();
+	poolInfo.maxSets = 1;
+
+	if (vkCreateDescriptorPool(_device->getDevice(), &poolInfo, nullptr, &_descriptorPool) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to create bindless descriptor pool");
+	}
+}
+
+void BindlessDescriptors::_destroyDescriptorPool() {
+	vkDestroyDescriptorPool(_device->getDevice(), _descriptorPool, nullptr);
+	_descriptorPool = VK_NULL_HANDLE;
+	_descriptorSet = VK_NULL_HANDLE;
+}
+
+void BindlessDescriptors::_createDescriptorSet() {
+	VkDescriptorSetAllocateInfo allocInfo = {};
+	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocInfo.descriptorPool = _descriptorPool;
+	allocInfo.descriptorSetCount = 1;
+	allocInfo.pSetLayouts = &_bindlessSetLayout;
+
+	if (vkAllocateDescriptorSets(_device->getDevice(), &allocInfo, &_descriptorSet) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to allocate bindless descriptor set");
+	}
+}
+
+void BindlessDescriptors::_createMaterialBuffer() {
+	VkDeviceSize bufferSize = sizeof(MaterialParameters) * _materialCapacity * _framesInFlight;
+
+	std::tie(_materialBuffer, _materialBufferMemory) =
+		_device->createBuffer(bufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+							  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	void *data;
+	vkMapMemory(_device->getDevice(), _materialBufferMemory, 0, bufferSize, 0, &data);
+	_materialBufferMapped = static_cast<MaterialParameters *>(data);
+
+	VkDescriptorBufferInfo bufferInfo = {};
+	bufferInfo.buffer = _materialBuffer;
+	bufferInfo.offset = 0;
+	bufferInfo.range = bufferSize;
+
+	VkWriteDescriptorSet descriptorWrite = {};
+	descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	descriptorWrite.dstSet = _descriptorSet;
+	descriptorWrite.dstBinding = 1;
+	descriptorWrite.dstArrayElement = 0;
+	descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	descriptorWrite.descriptorCount = 1;
+	descriptorWrite.pBufferInfo = &bufferInfo;
+
+	vkUpdateDescriptorSets(_device->getDevice(), 1, &descriptorWrite, 0, nullptr);
+}
+
+void BindlessDescriptors::_destroyMaterialBuffer() {
+	if (_materialBufferMapped != nullptr) {
+		vkUnmapMemory(_device->getDevice(), _materialBufferMemory);
+		_materialBufferMapped = nullptr;
+	}
+	_device->destroyBuffer(_materialBuffer, _materialBufferMemory);
+	_materialBuffer = VK_NULL_HANDLE;
+	_materialBufferMemory = VK_NULL_HANDLE;
+}
+
+void BindlessDescriptors::_createGraphicPipeline(const std::shared_ptr<RenderPass> &renderPass, VkExtent2D extent) {
+	std::array<VkDescriptorSetLayout, 2> setLayouts = {_objectSetLayout, _bindlessSetLayout};
+
+	VkPushConstantRange pushConstantRange = {};
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = sizeof(BindlessDrawConstants);
+
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+	pipelineLayoutInfo.pSetLayouts = setLayouts.data();
+	pipelineLayoutInfo.pushConstantRangeCount = 1;
+	pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+	if (vkCreatePipelineLayout(_device->getDevice(), &pipelineLayoutInfo, nullptr, &_pipelineLayout) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to create bindless pipeline layout");
+	}
+
+	_pipeline = createMeshGraphicPipeline(_device, renderPass->getRenderPass(), _pipelineLayout, extent,
+										  "shaders/vert-bindless.spv", "shaders/frag-bindless.spv");
+}
+
+void BindlessDescriptors::_destroyGraphicPipeline() {
+	if (_pipeline != VK_NULL_HANDLE) {
+		vkDestroyPipeline(_device->getDevice(), _pipeline, nullptr);
+	}
+	_pipeline = VK_NULL_HANDLE;
+	if (_pipelineLayout != VK_NULL_HANDLE) {
+		vkDestroyPipelineLayout(_device->getDevice(), _pipelineLayout, nullptr);
+	}
+	_pipelineLayout = VK_NULL_HANDLE;
+}
+
+void BindlessDescriptors::_createDefaultTexture() {
+	const uint32_t whitePixel = 0xFFFFFFFF;
+	VkDeviceSize imageSize = sizeof(whitePixel);
+
+	auto [stagingBuffer, stagingBufferMemory] =
+		_device->createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+							  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	void *data;
+	vkMapMemory(_device->getDevice(), stagingBufferMemory, 0, imageSize, 0, &data);
+	std::memcpy(data, &whitePixel, static_cast<size_t>(imageSize));
+	vkUnmapMemory(_device->getDevice(), stagingBufferMemory);
+
+	std::tie(_defaultImage, _defaultImageMemory) =
+		_device->createImage(1, 1, 1, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL,
+							 VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+							 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	_device->transitionImageLayout(_defaultImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED,
+								   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+	_device->copyBufferToImage(stagingBuffer, _defaultImage, 1, 1);
+	_device->transitionImageLayout(_defaultImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+								   VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+	_device->destroyBuffer(stagingBuffer, stagingBufferMemory);
+
+	_defaultImageView = _device->createImageView(_defaultImage, VK_FORMAT_R8G8B8A8_UNORM);
+
+	VkSamplerCreateInfo samplerInfo = {};
+	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter = VK_FILTER_NEAREST;
+	samplerInfo.minFilter = VK_FILTER_NEAREST;
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+	samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+
+	if (vkCreateSampler(_device->getDevice(), &samplerInfo, nullptr, &_defaultSampler) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to create default texture sampler");
+	}
+}
+
+void BindlessDescriptors::_destroyDefaultTexture() {
+	vkDestroySampler(_device->getDevice(), _defaultSampler, nullptr);
+	vkDestroyImageView(_device->getDevice(), _defaultImageView, nullptr);
+	vkDestroyImage(_device->getDevice(), _defaultImage, nullptr);
+	vkFreeMemory(_device->getDevice(), _defaultImageMemory, nullptr);
+	_defaultSampler = VK_NULL_HANDLE;
+	_defaultImageView = VK_NULL_HANDLE;
+	_defaultImage = VK_NULL_HANDLE;
+	_defaultImageMemory = VK_NULL_HANDLE;
+}
+
+} // namespace Stone::Render::Vulkan
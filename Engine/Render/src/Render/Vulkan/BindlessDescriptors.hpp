@@ -0,0 +1,225 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Utils/StringId.hpp"
+
+#include <glm/vec4.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Stone::Render::Vulkan {
+
+class Device;
+class RenderPass;
+
+/**
+ * @brief The parameters of one material as laid out in the bindless material storage buffer (std430).
+ *
+ * Every material drawn by the bindless pipeline shares the fixed layout below, whatever the locations of its own
+ * fragment shader: the slot of each known parameter name matches the constants of `shaders/frag-bindless.glsl`.
+ * Texture entries are slots in the bindless texture array.
+ */
+struct MaterialParameters {
+	static constexpr uint32_t maxTextures = 8;
+	static constexpr uint32_t maxVectors = 4;
+	static constexpr uint32_t maxScalars = 8;
+
+	static constexpr uint32_t diffuseTexture = 0;
+	static constexpr uint32_t specularTexture = 1;
+	static constexpr uint32_t normalsTexture = 2;
+	static constexpr uint32_t emissiveTexture = 3;
+	static constexpr uint32_t occlusionTexture = 4;
+	static constexpr uint32_t roughnessTexture = 5;
+	static constexpr uint32_t metalnessTexture = 6;
+	static constexpr uint32_t opacityTexture = 7;
+
+	static constexpr uint32_t diffuseVector = 0;
+	static constexpr uint32_t specularVector = 1;
+	static constexpr uint32_t ambientVector = 2;
+	static constexpr uint32_t emissiveVector = 3;
+
+	static constexpr uint32_t opacityScalar = 0;
+	static constexpr uint32_t shininessScalar = 1;
+	static constexpr uint32_t roughnessScalar = 2;
+	static constexpr uint32_t metallicScalar = 3;
+	static constexpr uint32_t reflectivityScalar = 4;
+
+	/**
+	 * @brief The slot of a parameter name in the fixed layout, or -1 if the layout has none for it.
+	 */
+	[[nodiscard]] static int textureSlot(StringId name);
+	[[nodiscard]] static int vectorSlot(StringId name);
+	[[nodiscard]] static int scalarSlot(StringId name);
+
+	uint32_t textures[maxTextures] = {};
+	/** Unset colors leave the diffuse texture as is and add no emission. */
+	glm::vec4 vectors[maxVectors] = {glm::vec4(1.0f), glm::vec4(0.0f), glm::vec4(0.0f), glm::vec4(0.0f)};
+	float scalars[maxScalars] = {1.0f};
+};
+
+static_assert(sizeof(MaterialParameters) == 128, "MaterialParameters must match the std430 layout of the shaders");
+
+/**
+ * @brief Push constant given to each draw of the bindless pipeline.
+ */
+struct BindlessDrawConstants {
+	uint32_t materialIndex;
+};
+
+/**
+ * @brief Global descriptor set holding every texture and material of the renderer.
+ *
+ * Textures live in one partially bound array of combined image samplers and materials in one storage buffer,
+ * so a draw only needs its material index as a push constant. Slot 0 of both tables holds a default white
+ * texture and a default material so unset parameters are always valid to sample.
+ *
+ * The material buffer holds one region per frame in flight. Updates are kept on the host and copied into the region
+ * of a frame by `beginFrame` once its fence is signaled, so the GPU never reads a material while it is written.
+ * Released texture and material slots are only reused once every frame in flight has been begun again.
+ */
+class BindlessDescriptors {
+public:
+	BindlessDescriptors() = delete;
+	BindlessDescriptors(const std::shared_ptr<Device> &device, const std::shared_ptr<RenderPass> &renderPass,
+						VkExtent2D extent, uint32_t maxMaterials, uint32_t framesInFlight);
+	BindlessDescriptors(const BindlessDescriptors &) = delete;
+
+	virtual ~BindlessDescriptors();
+
+	/**
+	 * @brief Write a texture in a free slot of the texture array.
+	 *
+	 * @return The slot of the texture to reference from the material parameters.
+	 */
+	uint32_t registerTexture(VkImageView imageView, VkSampler sampler);
+	void releaseTexture(uint32_t slot);
+
+	/**
+	 * @brief Reserve a slot in the material buffer, initialized with the default material.
+	 *
+	 * @return The index to push when drawing with this material.
+	 */
+	uint32_t registerMaterial();
+
+	/**
+	 * @brief Set the parameters of a material, copied to the GPU by the next `beginFrame` of each frame.
+	 */
+	void updateMaterial(uint32_t slot, const MaterialParameters &parameters);
+	void releaseMaterial(uint32_t slot);
+
+	/**
+	 * @brief Copy the materials updated since the last upload into the region of a frame, and return to the free
+	 * lists the slots no frame in flight can use anymore.
+	 *
+	 * Must be called once the fence of the frame is signaled and before its commands are recorded.
+	 */
+	void beginFrame(uint32_t frameIndex);
+
+	/**
+	 * @brief The index to push when drawing with a material, pointing into the region of the frame.
+	 */
+	[[nodiscard]] uint32_t getMaterialIndex(uint32_t slot, uint32_t frameIndex) const {
+		return frameIndex * _materialCapacity + slot;
+	}
+
+	/**
+	 * @brief Layout of the per object descriptor set (set 0), holding the mvp uniform buffer at binding 0.
+	 */
+	[[nodiscard]] VkDescriptorSetLayout getObjectSetLayout() const {
+		return _objectSetLayout;
+	}
+
+	[[nodiscard]] VkPipelineLayout getPipelineLayout() const {
+		return _pipelineLayout;
+	}
+
+	[[nodiscard]] VkPipeline getPipeline() const {
+		return _pipeline;
+	}
+
+	/**
+	 * @brief Bind the pipeline and the global descriptor set (set 1) on the command buffer.
+	 */
+	void bind(VkCommandBuffer commandBuffer) const;
+
+	[[nodiscard]] uint32_t getTextureCapacity() const {
+		return _textureCapacity;
+	}
+
+	[[nodiscard]] uint32_t getMaterialCapacity() const {
+		return _materialCapacity;
+	}
+
+private:
+	/** A released slot, reused once `remainingFrames` more frames have been begun. */
+	struct RetiredSlot {
+		uint32_t slot;
+		uint32_t remainingFrames;
+	};
+
+	/** The material slots to copy into the region of a frame. */
+	struct FrameUploads {
+		std::vector<uint32_t> slots;
+		std::vector<bool> pending; /**< Whether each material slot is in `slots`. */
+	};
+
+	void _setMaterial(uint32_t slot, const MaterialParameters &parameters);
+	void _recycleSlots(std::vector<RetiredSlot> &retiredSlots, std::vector<uint32_t> &freeSlots);
+
+	void _createDescriptorSetLayouts();
+	void _destroyDescriptorSetLayouts();
+
+	void _createDescriptorPool();
+	void _destroyDescriptorPool();
+
+	void _createDescriptorSet();
+
+	void _createMaterialBuffer();
+	void _destroyMaterialBuffer();
+
+	void _createGraphicPipeline(const std::shared_ptr<RenderPass> &renderPass, VkExtent2D extent);
+	void _destroyGraphicPipeline();
+
+	void _createDefaultTexture();
+	void _destroyDefaultTexture();
+
+	std::shared_ptr<Device> _device;
+
+	uint32_t _textureCapacity = 0;
+	uint32_t _materialCapacity = 0;
+	uint32_t _framesInFlight = 0;
+
+	VkDescriptorSetLayout _bindlessSetLayout = VK_NULL_HANDLE;
+	VkDescriptorSetLayout _objectSetLayout = VK_NULL_HANDLE;
+	VkDescriptorPool _descriptorPool = VK_NULL_HANDLE;
+	VkDescriptorSet _descriptorSet = VK_NULL_HANDLE;
+
+	VkBuffer _materialBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory _materialBufferMemory = VK_NULL_HANDLE;
+	MaterialParameters *_materialBufferMapped = nullptr;
+
+	/** Guards the slots, the host copy of the materials and the descriptor writes. */
+	std::mutex _mutex;
+	std::vector<MaterialParameters> _materials;
+	std::vector<FrameUploads> _frameUploads;
+
+	VkPipelineLayout _pipelineLayout = VK_NULL_HANDLE;
+	VkPipeline _pipeline = VK_NULL_HANDLE;
+
+	VkImage _defaultImage = VK_NULL_HANDLE;
+	VkDeviceMemory _defaultImageMemory = VK_NULL_HANDLE;
+	VkImageView _defaultImageView = VK_NULL_HANDLE;
+	VkSampler _defaultSampler = VK_NULL_HANDLE;
+
+	uint32_t _nextTextureSlot = 0;
+	std::vector<uint32_t> _freeTextureSlots;
+	std::vector<RetiredSlot> _retiredTextureSlots;
+	uint32_t _nextMaterialSlot = 0;
+	std::vector<uint32_t> _freeMaterialSlots;
+	std::vector<RetiredSlot> _retiredMaterialSlots;
+};
+
+} // namespace Stone::Render::Vulkan
@@ -0,0 +1,182 @@
+// Copyright 2024 Stone-Engine
+
+#include "CommandRecorder.hpp"
+
+#include "Device.hpp"
+#include "Logging/Profiler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+namespace Stone::Render::Vulkan {
+
+CommandRecorder::CommandRecorder(const std::shared_ptr<Device> &device, uint32_t threadCount, uint32_t frameCount)
+	: _device(device), _frameCount(frameCount) {
+	_createWorkers(std::max(threadCount, 1U));
+}
+
+CommandRecorder::~CommandRecorder() {
+	_destroyWorkers();
+}
+
+std::vector<VkCommandBuffer> CommandRecorder::record(uint32_t frameIndex,
+													  const VkCommandBufferInheritanceInfo &inheritance, size_t count,
+													  size_t minPerThread, const RecordFunction &record) {
+	assert(frameIndex < _frameCount);
+
+	size_t rangeCount = (count + std::max<size_t>(minPerThread, 1) - 1) / std::max<size_t>(minPerThread, 1);
+	rangeCount = std::clamp<size_t>(rangeCount, 1, _workers.size());
+
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_frameIndex = frameIndex;
+		_inheritance = &inheritance;
+		_recordFunction = &record;
+		_drawCount = count;
+		_rangeCount = rangeCount;
+		_exception = nullptr;
+		_pendingWorkers = rangeCount - 1;
+		++_generation;
+	}
+	if (rangeCount > 1) {
+		_startCondition.notify_all();
+	}
+
+	try {
+		_recordRange(0);
+	} catch (...) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		_exception = std::current_exception();
+	}
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_doneCondition.wait(lock, [this] { return _pendingWorkers == 0; });
+	_inheritance = nullptr;
+	_recordFunction = nullptr;
+
+	if (_exception) {
+		std::exception_ptr exception = _exception;
+		_exception = nullptr;
+		std::rethrow_exception(exception);
+	}
+
+	std::vector<VkCommandBuffer> commandBuffers;
+	commandBuffers.reserve(rangeCount);
+	for (size_t i = 0; i < rangeCount; ++i) {
+		commandBuffers.push_back(_workers[i].commandBuffers[frameIndex]);
+	}
+	return commandBuffers;
+}
+
+void CommandRecorder::_createWorkers(uint32_t threadCount) {
+	_workers.resize(threadCount);
+
+	for (Worker &worker : _workers) {
+		worker.commandPools.resize(_frameCount, VK_NULL_HANDLE);
+		worker.commandBuffers.resize(_frameCount, VK_NULL_HANDLE);
+
+		for (uint32_t frame = 0; frame < _frameCount; ++frame) {
+			worker.commandPools[frame] = _device->createCommandPool(VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+
+			VkCommandBufferAllocateInfo allocInfo = {};
+			allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			allocInfo.commandPool = worker.commandPools[frame];
+			allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+			allocInfo.commandBufferCount = 1;
+
+			if (vkAllocateCommandBuffers(_device->getDevice(), &allocInfo, &worker.commandBuffers[frame]) !=
+				VK_SUCCESS) {
+				throw std::runtime_error("Failed to allocate secondary command buffer");
+			}
+		}
+	}
+
+	// The worker 0 is the thread calling record
+	for (size_t i = 1; i < _workers.size(); ++i) {
+		_workers[i].thread = std::thread(&CommandRecorder::_workerLoop, this, i);
+	}
+}
+
+void CommandRecorder::_destroyWorkers() {
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_startCondition.notify_all();
+
+	for (Worker &worker : _workers) {
+		if (worker.thread.joinable()) {
+			worker.thread.join();
+		}
+		for (VkCommandPool commandPool : worker.commandPools) {
+			if (commandPool != VK_NULL_HANDLE) {
+				vkDestroyCommandPool(_device->getDevice(), commandPool, nullptr);
+			}
+		}
+	}
+	_workers.clear();
+}
+
+void CommandRecorder::_workerLoop(size_t workerIndex) {
+	STONE_PROFILE_THREAD_NAME("Command recorder " + std::to_string(workerIndex));
+
+	uint64_t generation = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_startCondition.wait(lock, [&] { return _stopping || _generation != generation; });
+			if (_stopping) {
+				return;
+			}
+			generation = _generation;
+			if (workerIndex >= _rangeCount) {
+				continue;
+			}
+		}
+
+		std::exception_ptr exception;
+		try {
+			_recordRange(workerIndex);
+		} catch (...) {
+			exception = std::current_exception();
+		}
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		if (exception && !_exception) {
+			_exception = exception;
+		}
+		if (--_pendingWorkers == 0) {
+			_doneCondition.notify_one();
+		}
+	}
+}
+
+void CommandRecorder::_recordRange(size_t workerIndex) {
+	STONE_PROFILE_SCOPE("Record draw range");
+
+	Worker &worker = _workers[workerIndex];
+	size_t begin = _drawCount * workerIndex / _rangeCount;
+	size_t end = _drawCount * (workerIndex + 1) / _rangeCount;
+
+	vkResetCommandPool(_device->getDevice(), worker.commandPools[_frameIndex], 0);
+	VkCommandBuffer commandBuffer = worker.commandBuffers[_frameIndex];
+
+	VkCommandBufferBeginInfo beginInfo = {};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	beginInfo.pInheritanceInfo = _inheritance;
+
+	if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to begin recording secondary command buffer");
+	}
+
+	(*_recordFunction)(commandBuffer, begin, end);
+
+	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to record secondary command buffer");
+	}
+}
+
+} // namespace Stone::Render::Vulkan
@@ -0,0 +1,94 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Stone::Render::Vulkan {
+
+class Device;
+
+/**
+ * @brief Records the draws of a render pass into secondary command buffers on several threads.
+ *
+ * Each thread owns one command pool per frame slot, so the pools of a frame can be reset as soon as
+ * its fence is signaled without synchronizing with the other threads or frames.
+ * The calling thread records the first range itself, the others are given to background workers.
+ */
+class CommandRecorder {
+public:
+	/**
+	 * @brief The function recording the draws [begin, end) into a secondary command buffer.
+	 */
+	using RecordFunction = std::function<void(VkCommandBuffer commandBuffer, size_t begin, size_t end)>;
+
+	CommandRecorder() = delete;
+	CommandRecorder(const std::shared_ptr<Device> &device, uint32_t threadCount, uint32_t frameCount);
+	CommandRecorder(const CommandRecorder &) = delete;
+
+	virtual ~CommandRecorder();
+
+	[[nodiscard]] uint32_t getThreadCount() const {
+		return static_cast<uint32_t>(_workers.size());
+	}
+
+	[[nodiscard]] uint32_t getFrameCount() const {
+		return _frameCount;
+	}
+
+	/**
+	 * @brief Split [0, count) into contiguous ranges and record each of them in parallel.
+	 *
+	 * @param frameIndex The frame slot, whose fence must have been waited on.
+	 * @param inheritance The render pass and framebuffer the secondary command buffers continue.
+	 * @param count The number of draws to record.
+	 * @param minPerThread The minimum number of draws given to a thread, to avoid waking threads for a few draws.
+	 * @param record The function recording a range, called concurrently from several threads.
+	 * @return The secondary command buffers to execute in order.
+	 */
+	std::vector<VkCommandBuffer> record(uint32_t frameIndex, const VkCommandBufferInheritanceInfo &inheritance,
+										size_t count, size_t minPerThread, const RecordFunction &record);
+
+private:
+	struct Worker {
+		std::thread thread;
+		std::vector<VkCommandPool> commandPools;	  /**< One per frame slot. */
+		std::vector<VkCommandBuffer> commandBuffers; /**< One per frame slot, allocated from the matching pool. */
+	};
+
+	void _createWorkers(uint32_t threadCount);
+	void _destroyWorkers();
+
+	void _workerLoop(size_t workerIndex);
+
+	void _recordRange(size_t workerIndex);
+
+	std::shared_ptr<Device> _device;
+	uint32_t _frameCount;
+
+	std::vector<Worker> _workers;
+
+	std::mutex _mutex;
+	std::condition_variable _startCondition;
+	std::condition_variable _doneCondition;
+	bool _stopping = false;
+	uint64_t _generation = 0;
+	size_t _pendingWorkers = 0;
+
+	// Job of the current generation, written by the calling thread before waking the workers
+	uint32_t _frameIndex = 0;
+	const VkCommandBufferInheritanceInfo *_inheritance = nullptr;
+	const RecordFunction *_recordFunction = nullptr;
+	size_t _drawCount = 0;
+	size_t _rangeCount = 0;
+	std::exception_ptr _exception;
+};
+
+} // namespace Stone::Render::Vulkan
@@ -2,9 +2,11 @@
 
 #include "Render/Vulkan/Device.hpp"
 
+#include "Logging/Logger.hpp"
 #include "Utilities/VulkanUtilities.hpp"
 
-#include <iostream>
+#include <algorithm>
+#include <cstring>
 #include <set>
 
 namespace Stone::Render::Vulkan {
@@ -14,20 +16,24 @@ VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(VkDebugUtilsMessageSeverityFlagBits
 											 const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData,
 											 void *pUserData) {
 	(void)pUserData;
-	// TODO: Log message with logging module
-	if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
-		std::cerr << "ValidationLayer[" << to_string(messageSeverity) << "][" << to_string(messageType)
-				  << "]:" << pCallbackData->pMessage << std::endl;
+	if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
+		STONE_LOG_ERROR("Vulkan", "ValidationLayer[{}][{}]: {}", to_string(messageSeverity), to_string(messageType),
+						pCallbackData->pMessage);
+	} else if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
+		STONE_LOG_WARNING("Vulkan", "ValidationLayer[{}][{}]: {}", to_string(messageSeverity),
+						  to_string(messageType), pCallbackData->pMessage);
 	}
 
 	return VK_FALSE;
 }
 
 Device::Device(RendererSettings &settings) {
-	std::cout << "Device created" << std::endl;
+	STONE_LOG_DEBUG("Render", "Device created");
 	_createInstance(settings);
 	_setupDebugMessenger();
-	_createSurface(settings);
+	if (!settings.headless) {
+		_createSurface(settings);
+	}
 	_pickPhysicalDevice(settings);
 	_createLogicalDevice(settings);
 	_createCommandPool();
@@ -41,7 +47,7 @@ Device::~Device() {
 	_destroySurface();
 	_destroyDebugMessenger();
 	_destroyInstance();
-	std::cout << "Device destroyed" << std::endl;
+	STONE_LOG_DEBUG("Render", "Device destroyed");
 }
 
 VkShaderModule Device::createShaderModule(const std::vector<char> &code) const {
@@ -122,7 +128,13 @@ VkFormat Device::findDepthFormat() const {
 							   VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
 }
 
+std::unique_lock<std::recursive_mutex> Device::lockQueues() const {
+	return std::unique_lock<std::recursive_mutex>(_queueMutex);
+}
+
 void Device::withSingleCommandBuffer(const std::function<void(VkCommandBuffer)> &lambda) const {
+	auto lock = lockQueues();
+
 	VkCommandBufferAllocateInfo allocInfo = {};
 	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
@@ -377,7 +389,19 @@ void Device::_createInstance(RendererSettings &settings) {
 	appInfo.applicationVersion = settings.app_version;
 	appInfo.pEngineName = "Stone-Engine";
 	appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-	appInfo.apiVersion = VK_API_VERSION_1_0;
+	appInfo.apiVersion = _apiVersion;
+
+	// Descriptor indexing is core since Vulkan 1.2, ask for it when the loader can provide it
+	if (settings.enableBindless) {
+		auto enumerateInstanceVersion =
+			(PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion");
+		uint32_t instanceVersion = VK_API_VERSION_1_0;
+		if (enumerateInstanceVersion != nullptr && enumerateInstanceVersion(&instanceVersion) == VK_SUCCESS &&
+			instanceVersion >= VK_API_VERSION_1_2) {
+			_apiVersion = VK_API_VERSION_1_2;
+			appInfo.apiVersion = _apiVersion;
+		}
+	}
 
 	VkInstanceCreateInfo createInfo = {};
 	createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -520,9 +544,11 @@ int deviceSuitability(VkPhysicalDevice device, VkSurfaceKHR surface,
 		return -1;
 	}
 
-	SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device, surface);
-	if (swapChainSupport.formats.empty() || swapChainSupport.presentModes.empty()) {
-		return -1;
+	if (surface != VK_NULL_HANDLE) {
+		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device, surface);
+		if (swapChainSupport.formats.empty() || swapChainSupport.presentModes.empty()) {
+			return -1;
+		}
 	}
 
 	score += static_cast<int>(properties.limits.maxImageDimension2D);
@@ -530,7 +556,49 @@ int deviceSuitability(VkPhysicalDevice device, VkSurfaceKHR surface,
 	return score;
 }
 
+bool checkBindlessSupport(VkPhysicalDevice device, uint32_t &maxSampledImages) {
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(device, &properties);
+	if (properties.apiVersion < VK_API_VERSION_1_2) {
+		return false;
+	}
+
+	VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures = {};
+	indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+
+	VkPhysicalDeviceFeatures2 features = {};
+	features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+	features.pNext = &indexingFeatures;
+	vkGetPhysicalDeviceFeatures2(device, &features);
+
+	if (!indexingFeatures.runtimeDescriptorArray || !indexingFeatures.shaderSampledImageArrayNonUniformIndexing ||
+		!indexingFeatures.descriptorBindingPartiallyBound ||
+		!indexingFeatures.descriptorBindingSampledImageUpdateAfterBind ||
+		!indexingFeatures.descriptorBindingUpdateUnusedWhilePending) {
+		return false;
+	}
+
+	VkPhysicalDeviceDescriptorIndexingProperties indexingProperties = {};
+	indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+	VkPhysicalDeviceProperties2 properties2 = {};
+	properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+	properties2.pNext = &indexingProperties;
+	vkGetPhysicalDeviceProperties2(device, &properties2);
+
+	maxSampledImages = std::min(indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+								indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages);
+	return maxSampledImages > 0;
+}
+
 void Device::_pickPhysicalDevice(RendererSettings &settings) {
+	if (settings.headless) {
+		// Without surface nothing is presented, software implementations may not even expose swap chains
+		std::erase_if(settings.deviceExt, [](const char *extension) {
+			return std::strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0;
+		});
+	}
+
 	uint32_t deviceCount = 0;
 	vkEnumeratePhysicalDevices(_instance, &deviceCount, nullptr);
 	if (deviceCount == 0) {
@@ -553,6 +621,14 @@ void Device::_pickPhysicalDevice(RendererSettings &settings) {
 		throw std::runtime_error("Failed to find a suitable GPU");
 	}
 	_physicalDevice = devices[bestDeviceIndex];
+
+	uint32_t maxSampledImages = 0;
+	_bindlessSupported = settings.enableBindless && _apiVersion >= VK_API_VERSION_1_2 &&
+						 checkBindlessSupport(_physicalDevice, maxSampledImages);
+	_bindlessTextureLimit = _bindlessSupported ? std::min(settings.bindlessMaxTextures, maxSampledImages) : 0;
+	if (settings.enableBindless && !_bindlessSupported) {
+		STONE_LOG_WARNING("Render", "Descriptor indexing unavailable, using per-material descriptor sets");
+	}
 }
 
 /** Logical device */
@@ -582,6 +658,25 @@ void Device::_createLogicalDevice(RendererSettings &settings) {
 	createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 	createInfo.pQueueCreateInfos = queueCreateInfos.data();
 	createInfo.pEnabledFeatures = &deviceFeatures;
+
+	VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures = {};
+	indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+	VkPhysicalDeviceFeatures2 deviceFeatures2 = {};
+	deviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+
+	if (_bindlessSupported) {
+		indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+		indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+		indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+		indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+
+		deviceFeatures2.features = deviceFeatures;
+		deviceFeatures2.pNext = &indexingFeatures;
+		createInfo.pNext = &deviceFeatures2;
+		createInfo.pEnabledFeatures = nullptr;
+	}
+
 	createInfo.enabledExtensionCount = settings.deviceExt.size();
 	createInfo.ppEnabledExtensionNames = settings.deviceExt.data();
 
@@ -611,17 +706,23 @@ void Device::_destroyLogicalDevice() {
 
 /** Command Pool */
 
-void Device::_createCommandPool() {
+VkCommandPool Device::createCommandPool(VkCommandPoolCreateFlags flags) const {
 	QueueFamilyIndices queueFamilyIndices = findQueueFamilies(_physicalDevice, _surface);
 
 	VkCommandPoolCreateInfo poolInfo = {};
 	poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-	poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	poolInfo.flags = flags;
 	poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
 
-	if (vkCreateCommandPool(_device, &poolInfo, nullptr, &_commandPool) != VK_SUCCESS) {
+	VkCommandPool commandPool = VK_NULL_HANDLE;
+	if (vkCreateCommandPool(_device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
 		throw std::runtime_error("Failed to create command pool");
 	}
+	return commandPool;
+}
+
+void Device::_createCommandPool() {
+	_commandPool = createCommandPool(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
 }
 
 void Device::_destroyCommandPool() {
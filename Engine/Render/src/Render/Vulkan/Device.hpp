@@ -5,6 +5,7 @@
 #include "Render/Vulkan/RendererSettings.hpp"
 #include "Utilities/SwapChainProperties.hpp"
 
+#include <mutex>
 #include <optional>
 
 namespace Stone::Render::Vulkan {
@@ -43,8 +44,38 @@ public:
 		return _commandPool;
 	}
 
+	/**
+	 * @brief Whether descriptor indexing was found and enabled on the logical device.
+	 *
+	 * When false, the renderer falls back to per-material descriptor sets.
+	 */
+	[[nodiscard]] bool isBindlessSupported() const {
+		return _bindlessSupported;
+	}
+
+	/**
+	 * @brief The number of sampled images the bindless texture array can hold on this device.
+	 */
+	[[nodiscard]] uint32_t getBindlessTextureLimit() const {
+		return _bindlessTextureLimit;
+	}
+
 	void waitIdle() const;
 
+	/**
+	 * @brief Lock the queues and the device command pool.
+	 *
+	 * Queue submissions and presentation must hold it when resources are uploaded from another thread.
+	 */
+	[[nodiscard]] std::unique_lock<std::recursive_mutex> lockQueues() const;
+
+	/**
+	 * @brief Create a command pool on the graphics queue family.
+	 *
+	 * Command pools are externally synchronized, each recording thread needs its own.
+	 */
+	[[nodiscard]] VkCommandPool createCommandPool(VkCommandPoolCreateFlags flags) const;
+
 	[[nodiscard]] SwapChainProperties createSwapChainProperties(const std::pair<uint32_t, uint32_t> &size) const;
 
 	[[nodiscard]] uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
@@ -120,6 +151,12 @@ private:
 	VkQueue _graphicsQueue = VK_NULL_HANDLE;
 	VkQueue _presentQueue = VK_NULL_HANDLE;
 	VkCommandPool _commandPool = VK_NULL_HANDLE;
+
+	mutable std::recursive_mutex _queueMutex;
+
+	uint32_t _apiVersion = VK_API_VERSION_1_0;
+	bool _bindlessSupported = false;
+	uint32_t _bindlessTextureLimit = 0;
 };
 
 } // namespace Stone::Render::Vulkan
@@ -3,8 +3,8 @@
 #include "VulkanCore.hpp"
 
 #include "../Utilities/VulkanUtilities.hpp"
+#include "Logging/Logger.hpp"
 
-#include <iostream>
 #include <set>
 
 namespace Stone::Render::Vulkan {
@@ -14,17 +14,19 @@ VKAPI_ATTR VkBool32 VKAPI_CALL validationLayerMessageCallback(VkDebugUtilsMessag
 															  const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData,
 															  void *pUserData) {
 	(void)pUserData;
-	// TODO: Log message with logging module
-	if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
-		std::cerr << "ValidationLayer[" << to_string(messageSeverity) << "][" << to_string(messageType)
-				  << "]:" << pCallbackData->pMessage << std::endl;
+	if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
+		STONE_LOG_ERROR("Vulkan", "ValidationLayer[{}][{}]: {}", to_string(messageSeverity), to_string(messageType),
+						pCallbackData->pMessage);
+	} else if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
+		STONE_LOG_WARNING("Vulkan", "ValidationLayer[{}][{}]: {}", to_string(messageSeverity),
+						  to_string(messageType), pCallbackData->pMessage);
 	}
 
 	return VK_FALSE;
 }
 
 VulkanCore::VulkanCore(RendererSettings &settings) {
-	std::cout << "VulkanCore created" << std::endl;
+	STONE_LOG_DEBUG("Render", "VulkanCore created");
 	_createInstance(settings);
 	_setupDebugMessenger();
 	_createSurface(settings);
@@ -41,7 +43,7 @@ VulkanCore::~VulkanCore() {
 	_destroySurface();
 	_destroyDebugMessenger();
 	_destroyInstance();
-	std::cout << "VulkanCore destroyed" << std::endl;
+	STONE_LOG_DEBUG("Render", "VulkanCore destroyed");
 }
 
 void VulkanCore::waitIdle() const {
@@ -3,15 +3,17 @@
 #include "FramesRenderer.hpp"
 
 #include "Device.hpp"
+#include "Logging/Logger.hpp"
 
-#include <iostream>
+#include <algorithm>
+#include <cassert>
 
 
 namespace Stone::Render::Vulkan {
 
 
 SyncronizedObjects::SyncronizedObjects(const VkDevice &device) : _device(device) {
-	std::cout << "Creating syncronized objects" << std::endl;
+	STONE_LOG_DEBUG("Render", "Creating syncronized objects");
 	VkSemaphoreCreateInfo semaphoreInfo = {};
 	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
@@ -20,30 +22,27 @@ SyncronizedObjects::SyncronizedObjects(const VkDevice &device) : _device(device)
 	fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
 	if (vkCreateSemaphore(_device, &semaphoreInfo, nullptr, &imageAvailable) != VK_SUCCESS ||
-		vkCreateSemaphore(_device, &semaphoreInfo, nullptr, &renderFinished) != VK_SUCCESS ||
 		vkCreateFence(_device, &fenceInfo, nullptr, &inFlight) != VK_SUCCESS) {
 		throw std::runtime_error("Failed to create synchronization objects for a frame");
 	}
 }
 
 SyncronizedObjects::~SyncronizedObjects() {
-	std::cout << "Destroying syncronized objects" << std::endl;
+	STONE_LOG_DEBUG("Render", "Destroying syncronized objects");
 	if (imageAvailable != VK_NULL_HANDLE) {
 		vkDestroySemaphore(_device, imageAvailable, nullptr);
 	}
-	if (renderFinished != VK_NULL_HANDLE) {
-		vkDestroySemaphore(_device, renderFinished, nullptr);
-	}
 	if (inFlight != VK_NULL_HANDLE) {
 		vkDestroyFence(_device, inFlight, nullptr);
 	}
 }
 
-FramesRenderer::FramesRenderer(const std::shared_ptr<Device> &device, uint32_t imageCount)
-	: _device(device), _imageCount(imageCount) {
-	std::cout << "Creating frames renderer" << std::endl;
+FramesRenderer::FramesRenderer(const std::shared_ptr<Device> &device, uint32_t framesInFlight, uint32_t imageCount)
+	: _device(device), _framesInFlight(std::max(framesInFlight, 1U)) {
+	STONE_LOG_DEBUG("Render", "Creating frames renderer");
 	_createCommandBuffers();
 	_createSyncObjects();
+	resetImagesInFlight(imageCount);
 }
 
 FramesRenderer::~FramesRenderer() {
@@ -51,15 +50,36 @@ FramesRenderer::~FramesRenderer() {
 		_device->waitIdle();
 	}
 
+	_destroyRenderFinishedSemaphores();
 	_destroySyncObjects();
 	_destroyCommandBuffers();
-	std::cout << "Destroying frames renderer" << std::endl;
+	STONE_LOG_DEBUG("Render", "Destroying frames renderer");
 }
 
 FrameContext FramesRenderer::newFrameContext() {
 	uint32_t currentFrame = _currentFrame;
-	_currentFrame = (_currentFrame + 1) % _imageCount;
-	return {_commandBuffers[currentFrame], _syncObjects[currentFrame]};
+	_currentFrame = (_currentFrame + 1) % _framesInFlight;
+	return {_commandBuffers[currentFrame], _syncObjects[currentFrame], currentFrame};
+}
+
+void FramesRenderer::waitForImage(uint32_t imageIndex, const SyncronizedObjects &syncObject) {
+	assert(imageIndex < _imagesInFlight.size());
+	VkFence &imageFence = _imagesInFlight[imageIndex];
+	if (imageFence != VK_NULL_HANDLE && imageFence != syncObject.inFlight) {
+		vkWaitForFences(_device->getDevice(), 1, &imageFence, VK_TRUE, UINT64_MAX);
+	}
+	imageFence = syncObject.inFlight;
+}
+
+VkSemaphore FramesRenderer::getRenderFinished(uint32_t imageIndex) const {
+	assert(imageIndex < _renderFinished.size());
+	return _renderFinished[imageIndex];
+}
+
+void FramesRenderer::resetImagesInFlight(uint32_t imageCount) {
+	_imagesInFlight.assign(imageCount, VK_NULL_HANDLE);
+	_destroyRenderFinishedSemaphores();
+	_createRenderFinishedSemaphores(imageCount);
 }
 
 
@@ -67,11 +87,13 @@ FrameContext FramesRenderer::newFrameContext() {
 
 void FramesRenderer::_createCommandBuffers() {
 
-	_commandBuffers.resize(_imageCount);
+	// A pool of its own so frames can be recorded while the device pool uploads resources from another thread
+	_commandPool = _device->createCommandPool(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+	_commandBuffers.resize(_framesInFlight);
 
 	VkCommandBufferAllocateInfo allocInfo = {};
 	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-	allocInfo.commandPool = _device->getCommandPool();
+	allocInfo.commandPool = _commandPool;
 	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 	allocInfo.commandBufferCount = static_cast<uint32_t>(_commandBuffers.size());
 
@@ -81,12 +103,11 @@ void FramesRenderer::_createCommandBuffers() {
 }
 
 void FramesRenderer::_destroyCommandBuffers() {
-	if (_commandBuffers.empty()) {
-		return;
-	}
-	vkFreeCommandBuffers(_device->getDevice(), _device->getCommandPool(), static_cast<uint32_t>(_commandBuffers.size()),
-						 _commandBuffers.data());
 	_commandBuffers.clear();
+	if (_commandPool != VK_NULL_HANDLE) {
+		vkDestroyCommandPool(_device->getDevice(), _commandPool, nullptr);
+	}
+	_commandPool = VK_NULL_HANDLE;
 }
 
 
@@ -104,5 +125,26 @@ void FramesRenderer::_destroySyncObjects() {
 	_syncObjects.clear();
 }
 
+void FramesRenderer::_createRenderFinishedSemaphores(uint32_t imageCount) {
+	VkSemaphoreCreateInfo semaphoreInfo = {};
+	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+	_renderFinished.resize(imageCount, VK_NULL_HANDLE);
+	for (VkSemaphore &semaphore : _renderFinished) {
+		if (vkCreateSemaphore(_device->getDevice(), &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create the render finished semaphore of an image");
+		}
+	}
+}
+
+void FramesRenderer::_destroyRenderFinishedSemaphores() {
+	for (VkSemaphore semaphore : _renderFinished) {
+		if (semaphore != VK_NULL_HANDLE) {
+			vkDestroySemaphore(_device->getDevice(), semaphore, nullptr);
+		}
+	}
+	_renderFinished.clear();
+}
+
 
 } // namespace Stone::Render::Vulkan
@@ -14,7 +14,6 @@ class Device;
 
 struct SyncronizedObjects {
 	VkSemaphore imageAvailable = VK_NULL_HANDLE;
-	VkSemaphore renderFinished = VK_NULL_HANDLE;
 	VkFence inFlight = VK_NULL_HANDLE;
 	const VkDevice &_device;
 
@@ -25,22 +24,52 @@ struct SyncronizedObjects {
 struct FrameContext {
 	VkCommandBuffer &commandBuffer;
 	SyncronizedObjects &syncObject;
+	uint32_t frameIndex;
 };
 
 class FramesRenderer {
 public:
 	FramesRenderer() = delete;
-	FramesRenderer(const std::shared_ptr<Device> &device, uint32_t imageCount);
+	FramesRenderer(const std::shared_ptr<Device> &device, uint32_t framesInFlight, uint32_t imageCount);
 	FramesRenderer(const FramesRenderer &) = delete;
 
 	virtual ~FramesRenderer();
 
-	[[nodiscard]] uint32_t getImageCount() const {
-		return _imageCount;
+	/**
+	 * @brief The number of frames the CPU can record while the GPU renders the previous ones.
+	 *
+	 * Per-frame resources are indexed by FrameContext::frameIndex, in [0, framesInFlight).
+	 */
+	[[nodiscard]] uint32_t getFramesInFlight() const {
+		return _framesInFlight;
 	}
 
 	FrameContext newFrameContext();
 
+	/**
+	 * @brief Wait until the frame that last rendered into the swap chain image is done, then mark it as used by
+	 * the given frame.
+	 *
+	 * Needed when there are more swap chain images than frames in flight, or when images are acquired out of order.
+	 */
+	void waitForImage(uint32_t imageIndex, const SyncronizedObjects &syncObject);
+
+	/**
+	 * @brief The semaphore signaled when the rendering into a swap chain image is done, waited on by its present.
+	 *
+	 * Indexed by image rather than by frame, a frame semaphore could be signaled again while the presentation engine
+	 * still waits on it for another image.
+	 */
+	[[nodiscard]] VkSemaphore getRenderFinished(uint32_t imageIndex) const;
+
+	/**
+	 * @brief Forget the images in flight and create the render finished semaphores after the swap chain has been
+	 * recreated with imageCount images.
+	 *
+	 * The device must be idle.
+	 */
+	void resetImagesInFlight(uint32_t imageCount);
+
 private:
 	void _createCommandBuffers();
 	void _destroyCommandBuffers();
@@ -48,13 +77,20 @@ private:
 	void _createSyncObjects();
 	void _destroySyncObjects();
 
+	void _createRenderFinishedSemaphores(uint32_t imageCount);
+	void _destroyRenderFinishedSemaphores();
+
 	std::shared_ptr<Device> _device;
-	uint32_t _imageCount;
+	uint32_t _framesInFlight;
 
+	VkCommandPool _commandPool = VK_NULL_HANDLE;
 	std::vector<VkCommandBuffer> _commandBuffers = {};
 
 	std::vector<SyncronizedObjects> _syncObjects = {};
 	size_t _currentFrame = 0;
+
+	std::vector<VkFence> _imagesInFlight = {}; /**< The fence of the frame using each swap chain image. */
+	std::vector<VkSemaphore> _renderFinished = {}; /**< Signaled when each swap chain image is rendered. */
 };
 
 } // namespace Stone::Render::Vulkan
@@ -0,0 +1,114 @@
+// Copyright 2024 Stone-Engine
+
+#include "GpuProfiler.hpp"
+
+#include "Device.hpp"
+#include "Logging/Profiler.hpp"
+#include "Utilities/VulkanUtilities.hpp"
+
+#include <stdexcept>
+
+namespace Stone::Render::Vulkan {
+
+GpuProfiler::GpuProfiler(const std::shared_ptr<Device> &device, uint32_t frameCount, uint32_t maxZones)
+	: _device(device), _maxZones(maxZones), _frames(frameCount) {
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(_device->getPhysicalDevice(), &properties);
+
+	QueueFamilyIndices indices = findQueueFamilies(_device->getPhysicalDevice(), _device->getSurface());
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(_device->getPhysicalDevice(), &queueFamilyCount, nullptr);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(_device->getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+	uint32_t validBits = queueFamilies[indices.graphicsFamily.value()].timestampValidBits;
+	if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f) {
+		return;
+	}
+	_timestampPeriod = static_cast<double>(properties.limits.timestampPeriod);
+	_timestampMask = validBits >= 64 ? ~0ULL : (1ULL << validBits) - 1;
+
+	VkQueryPoolCreateInfo poolInfo = {};
+	poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+	poolInfo.queryCount = frameCount * _maxZones * 2;
+
+	if (vkCreateQueryPool(_device->getDevice(), &poolInfo, nullptr, &_queryPool) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to create timestamp query pool");
+	}
+}
+
+GpuProfiler::~GpuProfiler() {
+	if (_queryPool != VK_NULL_HANDLE) {
+		vkDestroyQueryPool(_device->getDevice(), _queryPool, nullptr);
+		_queryPool = VK_NULL_HANDLE;
+	}
+}
+
+void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+	if (!isSupported()) {
+		return;
+	}
+
+	FrameQueries &frame = _frames[frameIndex];
+	if (frame.pending) {
+		_readResults(frameIndex);
+	}
+	frame.zoneNames.clear();
+	frame.pending = false;
+
+	vkCmdResetQueryPool(commandBuffer, _queryPool, frameIndex * _maxZones * 2, _maxZones * 2);
+}
+
+uint32_t GpuProfiler::beginZone(VkCommandBuffer commandBuffer, uint32_t frameIndex, const char *name) {
+	FrameQueries &frame = _frames[frameIndex];
+	if (!isSupported() || !Logging::Profiler::instance().isEnabled() || frame.zoneNames.size() >= _maxZones) {
+		return invalidZone;
+	}
+
+	auto zone = static_cast<uint32_t>(frame.zoneNames.size());
+	frame.zoneNames.push_back(name);
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, _queryPool,
+						(frameIndex * _maxZones + zone) * 2);
+	return zone;
+}
+
+void GpuProfiler::endZone(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t zone) {
+	if (zone == invalidZone) {
+		return;
+	}
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, _queryPool,
+						(frameIndex * _maxZones + zone) * 2 + 1);
+}
+
+void GpuProfiler::frameSubmitted(uint32_t frameIndex) {
+	FrameQueries &frame = _frames[frameIndex];
+	frame.submitTime = Logging::Profiler::now();
+	frame.pending = !frame.zoneNames.empty();
+}
+
+void GpuProfiler::_readResults(uint32_t frameIndex) {
+	FrameQueries &frame = _frames[frameIndex];
+	auto queryCount = static_cast<uint32_t>(frame.zoneNames.size() * 2);
+
+	std::vector<uint64_t> timestamps(queryCount);
+	VkResult result = vkGetQueryPoolResults(_device->getDevice(), _queryPool, frameIndex * _maxZones * 2, queryCount,
+											timestamps.size() * sizeof(uint64_t), timestamps.data(), sizeof(uint64_t),
+											VK_QUERY_RESULT_64_BIT);
+	if (result != VK_SUCCESS) {
+		return;
+	}
+
+	uint64_t origin = timestamps[0] & _timestampMask;
+	auto toProfilerClock = [&](uint64_t timestamp) {
+		uint64_t ticks = ((timestamp & _timestampMask) - origin) & _timestampMask;
+		return frame.submitTime + static_cast<uint64_t>(static_cast<double>(ticks) * _timestampPeriod);
+	};
+
+	for (size_t zone = 0; zone < frame.zoneNames.size(); ++zone) {
+		Logging::Profiler::instance().recordGpuEvent(frame.zoneNames[zone], toProfilerClock(timestamps[zone * 2]),
+													 toProfilerClock(timestamps[zone * 2 + 1]));
+	}
+}
+
+} // namespace Stone::Render::Vulkan
@@ -0,0 +1,78 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Stone::Render::Vulkan {
+
+class Device;
+
+/**
+ * @brief Measures zones of the frames on the GPU with timestamp queries and reports them to the profiler.
+ *
+ * Each frame slot owns its range of queries, read back the next time the slot is used, once its fence is signaled.
+ * GPU ticks are converted to the profiler clock by aligning the first timestamp of a frame on its submission.
+ */
+class GpuProfiler {
+public:
+	/** The zone returned when nothing is measured. */
+	static constexpr uint32_t invalidZone = UINT32_MAX;
+
+	GpuProfiler() = delete;
+	GpuProfiler(const std::shared_ptr<Device> &device, uint32_t frameCount, uint32_t maxZones = 16);
+	GpuProfiler(const GpuProfiler &) = delete;
+
+	virtual ~GpuProfiler();
+
+	/**
+	 * @brief Whether the graphics queue supports timestamps.
+	 */
+	[[nodiscard]] bool isSupported() const {
+		return _queryPool != VK_NULL_HANDLE;
+	}
+
+	/**
+	 * @brief Report the zones of the previous use of the frame slot and reset its queries.
+	 *
+	 * Must be recorded first in the command buffer, after the fence of the frame slot was waited on.
+	 */
+	void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+	/**
+	 * @brief Write the timestamp starting a zone, outside of a render pass using secondary command buffers.
+	 *
+	 * @param name A name outliving the profiler, usually a string literal.
+	 * @return The zone to end, or invalidZone when the profiler is disabled or the frame has no query left.
+	 */
+	uint32_t beginZone(VkCommandBuffer commandBuffer, uint32_t frameIndex, const char *name);
+
+	void endZone(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t zone);
+
+	/**
+	 * @brief Remember the submission time of the frame to align its timestamps on the CPU clock.
+	 */
+	void frameSubmitted(uint32_t frameIndex);
+
+private:
+	struct FrameQueries {
+		std::vector<const char *> zoneNames;
+		uint64_t submitTime = 0;
+		bool pending = false;
+	};
+
+	void _readResults(uint32_t frameIndex);
+
+	std::shared_ptr<Device> _device;
+
+	VkQueryPool _queryPool = VK_NULL_HANDLE;
+	uint32_t _maxZones;
+	double _timestampPeriod = 1.0; /**< Nanoseconds per tick. */
+	uint64_t _timestampMask = ~0ULL;
+
+	std::vector<FrameQueries> _frames;
+};
+
+} // namespace Stone::Render::Vulkan
@@ -0,0 +1,203 @@
+// Copyright 2024 Stone-Engine
+
+#include "OffscreenTarget.hpp"
+
+#include "Device.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace Stone::Render::Vulkan {
+
+/** The number of 8 bits channels of a format read back in RGBA order, 0 for the other formats */
+static uint32_t readableChannelCount(VkFormat format) {
+	switch (format) {
+	case VK_FORMAT_R8_UNORM:
+	case VK_FORMAT_R8_SRGB:
+		return 1;
+	case VK_FORMAT_R8G8_UNORM:
+	case VK_FORMAT_R8G8_SRGB:
+		return 2;
+	case VK_FORMAT_R8G8B8_UNORM:
+	case VK_FORMAT_R8G8B8_SRGB:
+		return 3;
+	case VK_FORMAT_R8G8B8A8_UNORM:
+	case VK_FORMAT_R8G8B8A8_SRGB:
+		return 4;
+	default:
+		return 0;
+	}
+}
+
+OffscreenTarget::OffscreenTarget(const std::shared_ptr<Device> &device, const VkRenderPass &renderPass,
+								 VkFormat format, VkExtent2D extent, uint32_t imageCount)
+	: _device(device), _imageFormat(format), _channelCount(readableChannelCount(format)), _extent(extent) {
+	if (_extent.width == 0 || _extent.height == 0) {
+		throw std::runtime_error("Offscreen target requires a frame size");
+	}
+	if (_channelCount == 0) {
+		throw std::runtime_error("Offscreen target format must have 8 bits channels in RGBA order");
+	}
+	_images.resize(std::max(imageCount, 1U), VK_NULL_HANDLE);
+	_createImages();
+	_createDepthResources();
+	_createFramebuffers(renderPass);
+}
+
+OffscreenTarget::~OffscreenTarget() {
+	if (_device) {
+		_device->waitIdle();
+	}
+
+	_destroyFramebuffers();
+	_destroyDepthResources();
+	_destroyImages();
+}
+
+void OffscreenTarget::acquireNextImage(ImageContext &imageContext) {
+	uint32_t index = _lastImageIndex.has_value() ? (*_lastImageIndex + 1) % getImageCount() : 0;
+	_lastImageIndex = index;
+
+	imageContext.index = index;
+	imageContext.image = _images[index];
+	imageContext.imageView = _imageViews[index];
+	imageContext.framebuffer = _framebuffers[index];
+}
+
+void OffscreenTarget::readImage(uint32_t index, std::vector<uint8_t> &pixels) const {
+	VkDeviceSize byteSize = static_cast<VkDeviceSize>(_extent.width) * _extent.height * _channelCount;
+
+	auto [stagingBuffer, stagingBufferMemory] =
+		_device->createBuffer(byteSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+							  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	_device->withSingleCommandBuffer([&](VkCommandBuffer commandBuffer) {
+		VkBufferImageCopy region = {};
+		region.bufferOffset = 0;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = 0;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageOffset = {0, 0, 0};
+		region.imageExtent = {_extent.width, _extent.height, 1};
+
+		vkCmdCopyImageToBuffer(commandBuffer, _images[index], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, stagingBuffer, 1,
+							   &region);
+
+		VkBufferMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.buffer = stagingBuffer;
+		barrier.offset = 0;
+		barrier.size = VK_WHOLE_SIZE;
+
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr,
+							 1, &barrier, 0, nullptr);
+	});
+
+	pixels.resize(static_cast<size_t>(byteSize));
+
+	void *data = nullptr;
+	vkMapMemory(_device->getDevice(), stagingBufferMemory, 0, byteSize, 0, &data);
+	std::memcpy(pixels.data(), data, static_cast<size_t>(byteSize));
+	vkUnmapMemory(_device->getDevice(), stagingBufferMemory);
+
+	_device->destroyBuffer(stagingBuffer, stagingBufferMemory);
+}
+
+
+/** Images */
+
+void OffscreenTarget::_createImages() {
+	_imageMemories.resize(_images.size(), VK_NULL_HANDLE);
+	_imageViews.resize(_images.size(), VK_NULL_HANDLE);
+
+	for (size_t i = 0; i < _images.size(); ++i) {
+		std::tie(_images[i], _imageMemories[i]) = _device->createImage(
+			_extent.width, _extent.height, 1, VK_SAMPLE_COUNT_1_BIT, _imageFormat, VK_IMAGE_TILING_OPTIMAL,
+			VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		_imageViews[i] = _device->createImageView(_images[i], _imageFormat);
+	}
+}
+
+void OffscreenTarget::_destroyImages() {
+	for (size_t i = 0; i < _images.size(); ++i) {
+		if (_imageViews[i] != VK_NULL_HANDLE) {
+			vkDestroyImageView(_device->getDevice(), _imageViews[i], nullptr);
+		}
+		if (_images[i] != VK_NULL_HANDLE) {
+			vkDestroyImage(_device->getDevice(), _images[i], nullptr);
+		}
+		if (_imageMemories[i] != VK_NULL_HANDLE) {
+			vkFreeMemory(_device->getDevice(), _imageMemories[i], nullptr);
+		}
+	}
+	_imageViews.clear();
+	_images.clear();
+	_imageMemories.clear();
+}
+
+
+/** Depth Resources */
+
+void OffscreenTarget::_createDepthResources() {
+	VkFormat depthFormat = _device->findDepthFormat();
+
+	std::tie(_depthImage, _depthImageMemory) = _device->createImage(
+		_extent.width, _extent.height, 1, VK_SAMPLE_COUNT_1_BIT, depthFormat, VK_IMAGE_TILING_OPTIMAL,
+		VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+	_depthImageView = _device->createImageView(_depthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT);
+	_device->transitionImageLayout(_depthImage, depthFormat, VK_IMAGE_LAYOUT_UNDEFINED,
+								   VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+}
+
+void OffscreenTarget::_destroyDepthResources() {
+	vkDestroyImageView(_device->getDevice(), _depthImageView, nullptr);
+	vkDestroyImage(_device->getDevice(), _depthImage, nullptr);
+	vkFreeMemory(_device->getDevice(), _depthImageMemory, nullptr);
+	_depthImageView = VK_NULL_HANDLE;
+	_depthImage = VK_NULL_HANDLE;
+	_depthImageMemory = VK_NULL_HANDLE;
+}
+
+
+/** Framebuffers */
+
+void OffscreenTarget::_createFramebuffers(const VkRenderPass &renderPass) {
+	_framebuffers.resize(_images.size());
+
+	for (size_t i = 0; i < _images.size(); ++i) {
+
+		std::array<VkImageView, 2> attachments = {_imageViews[i], _depthImageView};
+
+		VkFramebufferCreateInfo framebufferInfo = {};
+		framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebufferInfo.renderPass = renderPass;
+		framebufferInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+		framebufferInfo.pAttachments = attachments.data();
+		framebufferInfo.width = _extent.width;
+		framebufferInfo.height = _extent.height;
+		framebufferInfo.layers = 1;
+
+		if (vkCreateFramebuffer(_device->getDevice(), &framebufferInfo, nullptr, &_framebuffers[i]) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create framebuffer");
+		}
+	}
+}
+
+void OffscreenTarget::_destroyFramebuffers() {
+	for (auto framebuffer : _framebuffers) {
+		vkDestroyFramebuffer(_device->getDevice(), framebuffer, nullptr);
+	}
+	_framebuffers.clear();
+}
+
+
+} // namespace Stone::Render::Vulkan
@@ -0,0 +1,97 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "SwapChain.hpp"
+
+#include <memory>
+#include <optional>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Stone::Render::Vulkan {
+
+class Device;
+
+/**
+ * @brief Render target standing in for the swap chain when the renderer runs without surface.
+ *
+ * It owns one color image per frame in flight, used in turn, and a shared depth buffer.
+ * The color images end the render pass in TRANSFER_SRC_OPTIMAL so they can be copied back to the host.
+ */
+class OffscreenTarget {
+public:
+	OffscreenTarget() = delete;
+	OffscreenTarget(const std::shared_ptr<Device> &device, const VkRenderPass &renderPass, VkFormat format,
+					VkExtent2D extent, uint32_t imageCount);
+	OffscreenTarget(const OffscreenTarget &) = delete;
+
+	virtual ~OffscreenTarget();
+
+	[[nodiscard]] const VkFormat &getImageFormat() const {
+		return _imageFormat;
+	}
+
+	/**
+	 * @brief The number of channels of the pixels read back, one byte each in RGBA order.
+	 */
+	[[nodiscard]] uint32_t getChannelCount() const {
+		return _channelCount;
+	}
+
+	[[nodiscard]] const VkExtent2D &getExtent() const {
+		return _extent;
+	}
+
+	[[nodiscard]] uint32_t getImageCount() const {
+		return static_cast<uint32_t>(_images.size());
+	}
+
+	/**
+	 * @brief The image of the last frame returned by acquireNextImage, empty before the first frame.
+	 */
+	[[nodiscard]] const std::optional<uint32_t> &getLastImageIndex() const {
+		return _lastImageIndex;
+	}
+
+	/**
+	 * @brief Select the next image to render into, never blocks as nothing is presented.
+	 */
+	void acquireNextImage(ImageContext &imageContext);
+
+	/**
+	 * @brief Copy the pixels of an image to the host, tightly packed from the top row.
+	 *
+	 * The frame rendered in this image must have been submitted, this waits for the copy to complete.
+	 */
+	void readImage(uint32_t index, std::vector<uint8_t> &pixels) const;
+
+private:
+	void _createImages();
+	void _destroyImages();
+
+	void _createDepthResources();
+	void _destroyDepthResources();
+
+	void _createFramebuffers(const VkRenderPass &renderPass);
+	void _destroyFramebuffers();
+
+	std::shared_ptr<Device> _device;
+
+	VkFormat _imageFormat = VK_FORMAT_UNDEFINED;
+	uint32_t _channelCount = 0;
+	VkExtent2D _extent = {0, 0};
+	std::optional<uint32_t> _lastImageIndex = {};
+
+	std::vector<VkImage> _images = {};
+	std::vector<VkDeviceMemory> _imageMemories = {};
+	std::vector<VkImageView> _imageViews = {};
+
+	std::vector<VkFramebuffer> _framebuffers = {};
+
+	VkImage _depthImage = VK_NULL_HANDLE;
+	VkDeviceMemory _depthImageMemory = VK_NULL_HANDLE;
+	VkImageView _depthImageView = VK_NULL_HANDLE;
+};
+
+} // namespace Stone::Render::Vulkan
@@ -2,16 +2,60 @@
 
 #pragma once
 
+#include "Scene/Renderable/IRenderable.hpp"
 #include "Scene/RenderContext.hpp"
 
+#include <memory>
+#include <vector>
 #include <vulkan/vulkan.h>
 
+namespace Stone::Scene {
+class RenderableNode;
+} // namespace Stone::Scene
+
 namespace Stone::Render::Vulkan {
 
+/**
+ * @brief A draw collected from the scene, replayed later into a command buffer.
+ *
+ * The pipeline and material index are kept to sort the queue and limit state changes.
+ */
+struct RenderQueueItem {
+	std::shared_ptr<Scene::IRendererObject> object; /**< Kept alive until the draw is recorded. */
+	Scene::MvpMatrices mvp;
+	VkPipeline pipeline = VK_NULL_HANDLE;
+	uint32_t materialIndex = 0;
+};
+
+/**
+ * @brief Everything needed to record a frame, captured from the world so it can be drawn on another thread.
+ */
+struct FrameSnapshot {
+	std::vector<RenderQueueItem> renderQueue;
+	/** Renderables whose renderer data is updated on the render thread, before the frame is recorded. */
+	std::vector<std::shared_ptr<Scene::RenderableNode>> dirtyRenderables;
+	/** Whether the render thread still has to read the dirty renderables from the world. */
+	bool holdsWorld = false;
+};
+
 struct RenderContext : public Scene::RenderContext {
 	VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
 	VkExtent2D extent = {};
-	uint32_t imageIndex = 0;
+	uint32_t imageIndex = 0; /**< The swap chain image drawn into. */
+	uint32_t frameIndex = 0; /**< The frame in flight, index of the per-frame resources. */
+	/** Last pipeline bound on the command buffer, to skip redundant binds. */
+	VkPipeline boundPipeline = VK_NULL_HANDLE;
+
+	/** When set, renderer objects push their draw in the queue instead of recording it. */
+	std::vector<RenderQueueItem> *renderQueue = nullptr;
+	/** The queued draw being recorded, renderer objects read it instead of the scene. */
+	const RenderQueueItem *queueItem = nullptr;
+
+	/** Statistics of the recorded draws, added to the engine metrics once the recording is done. */
+	uint32_t drawCalls = 0;
+	uint32_t pipelineBinds = 0;
+	uint64_t triangles = 0;
+	uint64_t uploadedBytes = 0;
 };
 
 } // namespace Stone::Render::Vulkan
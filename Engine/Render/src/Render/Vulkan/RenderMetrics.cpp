@@ -0,0 +1,22 @@
+// Copyright 2024 Stone-Engine
+
+#include "RenderMetrics.hpp"
+
+namespace Stone::Render::Vulkan {
+
+RenderMetrics &RenderMetrics::instance() {
+	Logging::MetricsRegistry &registry = Logging::MetricsRegistry::instance();
+	static RenderMetrics metrics = {
+		registry.counter("render.draw_calls"),
+		registry.counter("render.pipeline_binds"),
+		registry.counter("render.descriptor_updates"),
+		registry.counter("render.triangles"),
+		registry.counter("render.uploaded_bytes"),
+		registry.counter("render.objects_created"),
+		registry.gauge("render.queue_size"),
+		registry.histogram("render.frame_time_ns"),
+	};
+	return metrics;
+}
+
+} // namespace Stone::Render::Vulkan
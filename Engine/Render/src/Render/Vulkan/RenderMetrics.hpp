@@ -0,0 +1,25 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Logging/Metrics.hpp"
+
+namespace Stone::Render::Vulkan {
+
+/**
+ * @brief The metrics fed by the Vulkan renderer, registered once in the engine metrics registry.
+ */
+struct RenderMetrics {
+	Logging::Counter &drawCalls;
+	Logging::Counter &pipelineBinds;
+	Logging::Counter &descriptorUpdates;
+	Logging::Counter &triangles;
+	Logging::Counter &uploadedBytes; /**< Bytes written by the CPU to buffers read by the GPU. */
+	Logging::Counter &objectsCreated;
+	Logging::Gauge &renderQueueSize;
+	Logging::Histogram &frameTime; /**< CPU time to record and submit a frame, in nanoseconds. */
+
+	static RenderMetrics &instance();
+};
+
+} // namespace Stone::Render::Vulkan
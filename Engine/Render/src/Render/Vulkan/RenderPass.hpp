@@ -12,7 +12,11 @@ class Device;
 class RenderPass {
 public:
 	RenderPass() = delete;
-	RenderPass(const std::shared_ptr<Device> &device, VkFormat format);
+	/**
+	 * @param finalLayout The layout of the color attachment after the pass, TRANSFER_SRC_OPTIMAL for offscreen images.
+	 */
+	RenderPass(const std::shared_ptr<Device> &device, VkFormat format,
+			   VkImageLayout finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
 	RenderPass(const RenderPass &) = delete;
 
 	virtual ~RenderPass();
@@ -33,6 +37,7 @@ private:
 
 	VkRenderPass _renderPass = VK_NULL_HANDLE;
 	VkFormat _format = VK_FORMAT_UNDEFINED;
+	VkImageLayout _finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 };
 
 } // namespace Stone::Render::Vulkan
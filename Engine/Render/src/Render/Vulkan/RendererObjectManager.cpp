@@ -2,8 +2,10 @@
 
 #include "RendererObjectManager.hpp"
 
+#include "Core/Memory/Pool.hpp"
 #include "Device.hpp"
 #include "Render/Vulkan/VulkanRenderer.hpp"
+#include "RenderMetrics.hpp"
 #include "Scene/Node/MeshNode.hpp"
 #include "Scene/Renderable/Material.hpp"
 #include "Scene/Renderable/Mesh.hpp"
@@ -28,19 +30,22 @@ void RendererObjectManager::updateMeshNode(const std::shared_ptr<Scene::MeshNode
 		return;
 	}
 
-	auto newMeshNode = std::make_shared<Vulkan::MeshNode>(meshNode, _renderer);
+	auto newMeshNode = Core::Memory::makePooled<Vulkan::MeshNode>(meshNode, _renderer);
 	setRendererObjectTo(meshNode.get(), newMeshNode);
+	RenderMetrics::instance().objectsCreated.add();
 }
 
 void RendererObjectManager::updateMaterial(const std::shared_ptr<Scene::Material> &material) {
 	Scene::RendererObjectManager::updateMaterial(material);
 
-	if (material->getRendererObject<Vulkan::Material>()) {
+	if (auto materialObject = material->getRendererObject<Vulkan::Material>()) {
+		materialObject->updateParameters(material);
 		return;
 	}
 
-	auto newMaterial = std::make_shared<Vulkan::Material>(material, _renderer);
+	auto newMaterial = Core::Memory::makePooled<Vulkan::Material>(material, _renderer);
 	setRendererObjectTo(material.get(), newMaterial);
+	RenderMetrics::instance().objectsCreated.add();
 }
 
 void RendererObjectManager::updateDynamicMesh(const std::shared_ptr<Scene::DynamicMesh> &mesh) {
@@ -50,8 +55,9 @@ void RendererObjectManager::updateDynamicMesh(const std::shared_ptr<Scene::Dynam
 		return;
 	}
 
-	auto newMesh = std::make_shared<Vulkan::Mesh>(mesh, _renderer);
+	auto newMesh = Core::Memory::makePooled<Vulkan::Mesh>(mesh, _renderer);
 	setRendererObjectTo(mesh.get(), newMesh);
+	RenderMetrics::instance().objectsCreated.add();
 }
 
 void RendererObjectManager::updateTexture(const std::shared_ptr<Scene::Texture> &texture) {
@@ -61,8 +67,9 @@ void RendererObjectManager::updateTexture(const std::shared_ptr<Scene::Texture>
 		return;
 	}
 
-	auto newTexture = std::make_shared<Vulkan::Texture>(texture, _renderer);
+	auto newTexture = Core::Memory::makePooled<Vulkan::Texture>(texture, _renderer);
 	setRendererObjectTo(texture.get(), newTexture);
+	RenderMetrics::instance().objectsCreated.add();
 }
 
 void RendererObjectManager::updateShader(const std::shared_ptr<Scene::Shader> &shader) {
@@ -72,8 +79,9 @@ void RendererObjectManager::updateShader(const std::shared_ptr<Scene::Shader> &s
 		return;
 	}
 
-	auto newShader = std::make_shared<Vulkan::Shader>(shader, _renderer);
+	auto newShader = Core::Memory::makePooled<Vulkan::Shader>(shader, _renderer);
 	setRendererObjectTo(shader.get(), newShader);
+	RenderMetrics::instance().objectsCreated.add();
 }
 
 } // namespace Stone::Render::Vulkan
@@ -2,6 +2,7 @@
 
 #include "Render/Vulkan/SwapChain.hpp"
 
+#include "Logging/Logger.hpp"
 #include "Render/Vulkan/Device.hpp"
 #include "Utilities/VulkanUtilities.hpp"
 
@@ -10,7 +11,7 @@ namespace Stone::Render::Vulkan {
 SwapChain::SwapChain(const std::shared_ptr<Device> &device, const VkRenderPass &renderPass,
 					 const SwapChainProperties &props)
 	: _device(device) {
-	std::cout << "Creating swap chain" << std::endl;
+	STONE_LOG_DEBUG("Render", "Creating swap chain");
 	_createSwapChain(props);
 	_createImageViews();
 	_createDepthResources();
@@ -26,7 +27,7 @@ SwapChain::~SwapChain() {
 	_destroyDepthResources();
 	_destroyImageViews();
 	_destroySwapChain();
-	std::cout << "Destroying swap chain" << std::endl;
+	STONE_LOG_DEBUG("Render", "Destroying swap chain");
 }
 
 VkResult SwapChain::acquireNextImage(const VkSemaphore &semaphore, ImageContext &imageContext) {
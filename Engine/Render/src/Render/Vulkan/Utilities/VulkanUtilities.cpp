@@ -81,10 +81,15 @@ QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surfa
 			indices.graphicsFamily = i;
 		}
 
-		VkBool32 presentSupport = false;
-		vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
-		if (presentSupport) {
-			indices.presentFamily = i;
+		if (surface == VK_NULL_HANDLE) {
+			// Nothing is presented without surface, the graphics queue stands in for the present queue
+			indices.presentFamily = indices.graphicsFamily;
+		} else {
+			VkBool32 presentSupport = false;
+			vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+			if (presentSupport) {
+				indices.presentFamily = i;
+			}
 		}
 
 		if (indices.isComplete()) {
@@ -2,18 +2,63 @@
 
 #include "Material.hpp"
 
+#include "../BindlessDescriptors.hpp"
+#include "Render/Vulkan/VulkanRenderer.hpp"
+#include "Scene/Renderable/Material.hpp"
+#include "Scene/Renderable/Texture.hpp"
+#include "Texture.hpp"
+
 namespace Stone::Render::Vulkan {
 
-Material::Material(const std::shared_ptr<Scene::Material> &material, const std::shared_ptr<VulkanRenderer> &renderer) {
-	(void)material;
-	(void)renderer;
+Material::Material(const std::shared_ptr<Scene::Material> &material, const std::shared_ptr<VulkanRenderer> &renderer)
+	: _bindlessDescriptors(renderer->getBindlessDescriptors()) {
+	if (_bindlessDescriptors) {
+		_bindlessIndex = _bindlessDescriptors->registerMaterial();
+		updateParameters(material);
+	}
 }
 
 Material::~Material() {
+	if (_bindlessDescriptors) {
+		_bindlessDescriptors->releaseMaterial(_bindlessIndex);
+	}
 }
 
 void Material::render(Scene::RenderContext &context) {
 	(void)context;
 }
 
+void Material::updateParameters(const std::shared_ptr<Scene::Material> &material) {
+	if (_bindlessDescriptors == nullptr) {
+		return;
+	}
+
+	// The bindless pipeline draws every material with the same shader, so the parameters follow its fixed layout
+	MaterialParameters parameters;
+	material->forEachTextures([&](std::pair<const StringId, std::shared_ptr<Scene::Texture>> &it) {
+		int slot = MaterialParameters::textureSlot(it.first);
+		if (slot < 0 || it.second == nullptr)
+			return;
+		auto textureObject = it.second->getRendererObject<Texture>();
+		if (textureObject)
+			parameters.textures[slot] = textureObject->getBindlessSlot();
+	});
+	material->forEachVectors([&](std::pair<const StringId, glm::vec3> &it) {
+		int slot = MaterialParameters::vectorSlot(it.first);
+		if (slot >= 0)
+			parameters.vectors[slot] = glm::vec4(it.second, 1.0f);
+	});
+	material->forEachScalars([&](std::pair<const StringId, float> &it) {
+		int slot = MaterialParameters::scalarSlot(it.first);
+		if (slot >= 0)
+			parameters.scalars[slot] = it.second;
+	});
+
+	_bindlessDescriptors->updateMaterial(_bindlessIndex, parameters);
+}
+
+uint32_t Material::getBindlessIndex() const {
+	return _bindlessIndex;
+}
+
 } // namespace Stone::Render::Vulkan
@@ -18,6 +18,7 @@ class VulkanRenderer;
 class Device;
 class RenderPass;
 class SwapChain;
+class BindlessDescriptors;
 
 class Material : public Scene::IRendererObject {
 public:
@@ -26,6 +27,24 @@ public:
 	~Material() override;
 
 	void render(Scene::RenderContext &context) override;
+
+	/**
+	 * @brief Write the textures, vectors and scalars of the material in its slot of the bindless material buffer.
+	 *
+	 * Each parameter is placed at the slot of its name in the fixed layout of `MaterialParameters`, parameters the
+	 * layout has no slot for are not drawn by the bindless pipeline.
+	 * Does nothing when bindless is off.
+	 */
+	void updateParameters(const std::shared_ptr<Scene::Material> &material);
+
+	/**
+	 * @brief The index of the material in the bindless material buffer, 0 (the default material) when bindless is off.
+	 */
+	[[nodiscard]] uint32_t getBindlessIndex() const;
+
+private:
+	std::shared_ptr<BindlessDescriptors> _bindlessDescriptors;
+	uint32_t _bindlessIndex = 0;
 };
 
 } // namespace Stone::Render::Vulkan
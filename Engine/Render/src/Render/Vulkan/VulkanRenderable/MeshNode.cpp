@@ -2,12 +2,16 @@
 
 #include "MeshNode.hpp"
 
+#include "../BindlessDescriptors.hpp"
 #include "../Device.hpp"
+#include "../FramesRenderer.hpp"
 #include "../RenderContext.hpp"
+#include "../RenderMetrics.hpp"
 #include "../RenderPass.hpp"
 #include "../SwapChain.hpp"
-#include "../Utilities/VertexBinding.hpp"
+#include "Material.hpp"
 #include "Render/Vulkan/VulkanRenderer.hpp"
+#include "RenderableUtils.hpp"
 #include "Scene/Node/MeshNode.hpp"
 #include "Scene/Renderable/Material.hpp"
 #include "Scene/Renderable/Mesh.hpp"
@@ -15,7 +19,6 @@
 #include "Scene/Renderable/Texture.hpp"
 #include "Scene/RenderContext.hpp"
 #include "Texture.hpp"
-#include "Utils/FileSystem.hpp"
 
 #include <cstring>
 #include <stdexcept>
@@ -24,14 +27,23 @@ namespace Stone::Render::Vulkan {
 
 
 MeshNode::MeshNode(const std::shared_ptr<Scene::MeshNode> &meshNode, const std::shared_ptr<VulkanRenderer> &renderer)
-	: _device(renderer->getDevice()), _sceneMeshNode(meshNode) {
-	_createDescriptorSetLayout();
-	_createGraphicPipeline(renderer->getRenderPass(), renderer->getSwapChain()->getExtent());
+	: _device(renderer->getDevice()), _bindlessDescriptors(renderer->getBindlessDescriptors()),
+	  _sceneMeshNode(meshNode) {
+	if (_bindlessDescriptors) {
+		// Layouts and pipeline are shared by every mesh node, textures are reached through the material index
+		_descriptorSetLayout = _bindlessDescriptors->getObjectSetLayout();
+		_pipelineLayout = _bindlessDescriptors->getPipelineLayout();
+		_graphicPipeline = _bindlessDescriptors->getPipeline();
+	} else {
+		_createDescriptorSetLayout();
+		_createGraphicPipeline(renderer->getRenderPass(), renderer->getFrameExtent());
+	}
 	_createVertexBuffer();
 	_createIndexBuffer();
-	_createUniformBuffers(renderer->getSwapChain());
-	_createDescriptorPool(renderer->getSwapChain());
-	_createDescriptorSets(renderer->getSwapChain());
+	uint32_t framesInFlight = renderer->getFramesRenderer()->getFramesInFlight();
+	_createUniformBuffers(framesInFlight);
+	_createDescriptorPool(framesInFlight);
+	_createDescriptorSets(framesInFlight);
 }
 
 MeshNode::~MeshNode() {
@@ -40,17 +52,33 @@ MeshNode::~MeshNode() {
 	_destroyUniformBuffers();
 	_destroyVertexBuffer();
 	_destroyIndexBuffer();
-	_destroyGraphicPipeline();
-	_destroyDescriptorSetLayout();
+	if (_bindlessDescriptors == nullptr) {
+		_destroyGraphicPipeline();
+		_destroyDescriptorSetLayout();
+	}
 }
 
 void MeshNode::render(Scene::RenderContext &context) {
 	assert(dynamic_cast<Vulkan::RenderContext *>(&context));
 	auto vulkanContext = reinterpret_cast<Vulkan::RenderContext *>(&context);
 
+	if (vulkanContext->renderQueue != nullptr) {
+		vulkanContext->renderQueue->push_back(
+			{shared_from_this(), context.mvp, _graphicPipeline, _getMaterialIndex()});
+		return;
+	}
+
 	_updateUniformBuffers(*vulkanContext);
 
-	vkCmdBindPipeline(vulkanContext->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _graphicPipeline);
+	if (vulkanContext->boundPipeline != _graphicPipeline) {
+		if (_bindlessDescriptors) {
+			_bindlessDescriptors->bind(vulkanContext->commandBuffer);
+		} else {
+			vkCmdBindPipeline(vulkanContext->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _graphicPipeline);
+		}
+		vulkanContext->boundPipeline = _graphicPipeline;
+		vulkanContext->pipelineBinds++;
+	}
 
 	VkBuffer vertexBuffers[] = {_vertexBuffer};
 	VkDeviceSize offsets[] = {0};
@@ -59,14 +87,34 @@ void MeshNode::render(Scene::RenderContext &context) {
 	vkCmdBindIndexBuffer(vulkanContext->commandBuffer, _indexBuffer, 0, VK_INDEX_TYPE_UINT32);
 
 	vkCmdBindDescriptorSets(vulkanContext->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _pipelineLayout, 0, 1,
-							&_descriptorSets[vulkanContext->imageIndex], 0, nullptr);
+							&_descriptorSets[vulkanContext->frameIndex], 0, nullptr);
+
+	if (_bindlessDescriptors) {
+		uint32_t materialIndex =
+			vulkanContext->queueItem != nullptr ? vulkanContext->queueItem->materialIndex : _getMaterialIndex();
+		BindlessDrawConstants constants = {
+			_bindlessDescriptors->getMaterialIndex(materialIndex, vulkanContext->frameIndex)};
+		vkCmdPushConstants(vulkanContext->commandBuffer, _pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+						   sizeof(BindlessDrawConstants), &constants);
+	}
 
-	auto mesh = std::dynamic_pointer_cast<Scene::DynamicMesh>(_sceneMeshNode.lock()->getMesh());
-	vkCmdDrawIndexed(vulkanContext->commandBuffer, mesh->getIndices().size(), 1, 0, 0, 0);
+	vkCmdDrawIndexed(vulkanContext->commandBuffer, _indexCount, 1, 0, 0, 0);
+	vulkanContext->drawCalls++;
+	vulkanContext->triangles += _indexCount / 3;
 }
 
 void MeshNode::_updateUniformBuffers(Vulkan::RenderContext &context) {
-	std::memcpy(_uniformBuffersMapped[context.imageIndex], &context.mvp, sizeof(Scene::MvpMatrices));
+	std::memcpy(_uniformBuffersMapped[context.frameIndex], &context.mvp, sizeof(Scene::MvpMatrices));
+	context.uploadedBytes += sizeof(Scene::MvpMatrices);
+}
+
+uint32_t MeshNode::_getMaterialIndex() const {
+	auto material = _sceneMeshNode.lock()->getMaterial();
+	if (material == nullptr) {
+		return 0;
+	}
+	auto materialObject = material->getRendererObject<Vulkan::Material>();
+	return materialObject ? materialObject->getBindlessIndex() : 0;
 }
 
 void MeshNode::_createDescriptorSetLayout() {
@@ -85,7 +133,7 @@ void MeshNode::_createDescriptorSetLayout() {
 		auto shader = material->getFragmentShader();
 		if (shader) {
 			material->forEachTextures(
-				[&](const std::pair<const std::string, std::shared_ptr<Scene::Texture>> &texture) {
+				[&](const std::pair<const StringId, std::shared_ptr<Scene::Texture>> &texture) {
 					VkDescriptorSetLayoutBinding samplerLayoutBinding;
 					samplerLayoutBinding.binding = shader->getLocation(texture.first);
 					samplerLayoutBinding.descriptorCount = 1;
@@ -114,114 +162,6 @@ void MeshNode::_destroyDescriptorSetLayout() {
 }
 
 void MeshNode::_createGraphicPipeline(const std::shared_ptr<RenderPass> &renderPass, VkExtent2D extent) {
-	auto vertShaderCode = Utils::readBinaryFile("shaders/vert.spv");
-	auto fragShaderCode = Utils::readBinaryFile("shaders/frag.spv");
-
-	auto vertShaderModule = _device->createShaderModule(vertShaderCode);
-	auto fragShaderModule = _device->createShaderModule(fragShaderCode);
-
-	VkPipelineShaderStageCreateInfo vertShaderStageInfo = {};
-	vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-	vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-	vertShaderStageInfo.module = vertShaderModule;
-	vertShaderStageInfo.pName = "main";
-
-	VkPipelineShaderStageCreateInfo fragShaderStageInfo = {};
-	fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-	fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-	fragShaderStageInfo.module = fragShaderModule;
-	fragShaderStageInfo.pName = "main";
-
-	VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
-
-	std::vector<VkDynamicState> dynamicStates = {
-		VK_DYNAMIC_STATE_VIEWPORT,
-		VK_DYNAMIC_STATE_SCISSOR,
-	};
-
-	VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo = {};
-	dynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-	dynamicStateCreateInfo.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
-	dynamicStateCreateInfo.pDynamicStates = dynamicStates.data();
-
-	auto bindingDescription = vertexBindingDescription<Scene::Vertex>();
-	auto attributeDescriptions = vertexAttributeDescriptions<Scene::Vertex, 5>();
-
-	VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
-	vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-	vertexInputInfo.vertexBindingDescriptionCount = 1;
-	vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-	vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-	vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
-
-	VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
-	inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-	inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-	inputAssembly.primitiveRestartEnable = VK_FALSE;
-
-	VkViewport viewport = {};
-	viewport.x = 0.0f;
-	viewport.y = 0.0f;
-	viewport.width = static_cast<float>(extent.width);
-	viewport.height = static_cast<float>(extent.height);
-	viewport.minDepth = 0.0f;
-	viewport.maxDepth = 1.0f;
-
-	VkRect2D scissor = {};
-	scissor.offset = {0, 0};
-	scissor.extent = extent;
-
-	VkPipelineViewportStateCreateInfo viewportState = {};
-	viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-	viewportState.viewportCount = 1;
-	viewportState.pViewports = &viewport;
-	viewportState.scissorCount = 1;
-	viewportState.pScissors = &scissor;
-
-	VkPipelineRasterizationStateCreateInfo rasterizer = {};
-	rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-	rasterizer.depthClampEnable = VK_FALSE;
-	rasterizer.rasterizerDiscardEnable = VK_FALSE;
-	rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
-	rasterizer.lineWidth = 1.0f;
-	rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-	rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
-	rasterizer.depthBiasEnable = VK_FALSE;
-	rasterizer.depthBiasConstantFactor = 0.0f;
-	rasterizer.depthBiasClamp = 0.0f;
-	rasterizer.depthBiasSlopeFactor = 0.0f;
-
-	VkPipelineMultisampleStateCreateInfo multisampling = {};
-	multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-	multisampling.sampleShadingEnable = VK_FALSE;
-	multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-	multisampling.minSampleShading = 1.0f;
-	multisampling.pSampleMask = nullptr;
-	multisampling.alphaToCoverageEnable = VK_FALSE;
-	multisampling.alphaToOneEnable = VK_FALSE;
-
-	VkPipelineColorBlendAttachmentState colorBlendAttachment = {};
-	colorBlendAttachment.colorWriteMask =
-		VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-	colorBlendAttachment.blendEnable = VK_TRUE;
-	colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-	colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-	colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
-	colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-	colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-	colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
-
-	VkPipelineColorBlendStateCreateInfo colorBlending = {};
-	colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-	colorBlending.logicOpEnable = VK_FALSE;
-	colorBlending.logicOp = VK_LOGIC_OP_COPY;
-	colorBlending.attachmentCount = 1;
-	colorBlending.pAttachments = &colorBlendAttachment;
-	colorBlending.blendConstants[0] = 0.0f;
-	colorBlending.blendConstants[1] = 0.0f;
-	colorBlending.blendConstants[2] = 0.0f;
-	colorBlending.blendConstants[3] = 0.0f;
-
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
 	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 	pipelineLayoutInfo.setLayoutCount = 1;
@@ -232,43 +172,8 @@ void MeshNode::_createGraphicPipeline(const std::shared_ptr<RenderPass> &renderP
 		throw std::runtime_error("Failed to create pipeline layout");
 	}
 
-	VkPipelineDepthStencilStateCreateInfo depthStencil = {};
-	depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-	depthStencil.depthTestEnable = VK_TRUE;
-	depthStencil.depthWriteEnable = VK_TRUE;
-	depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
-	depthStencil.depthBoundsTestEnable = VK_FALSE;
-	depthStencil.minDepthBounds = 0.0f;
-	depthStencil.maxDepthBounds = 1.0f;
-	depthStencil.stencilTestEnable = VK_FALSE;
-	depthStencil.front = {};
-	depthStencil.back = {};
-
-	VkGraphicsPipelineCreateInfo pipelineInfo = {};
-	pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-	pipelineInfo.stageCount = 2;
-	pipelineInfo.pStages = shaderStages;
-	pipelineInfo.pVertexInputState = &vertexInputInfo;
-	pipelineInfo.pInputAssemblyState = &inputAssembly;
-	pipelineInfo.pViewportState = &viewportState;
-	pipelineInfo.pRasterizationState = &rasterizer;
-	pipelineInfo.pMultisampleState = &multisampling;
-	pipelineInfo.pDepthStencilState = &depthStencil;
-	pipelineInfo.pColorBlendState = &colorBlending;
-	pipelineInfo.pDynamicState = &dynamicStateCreateInfo;
-	pipelineInfo.layout = _pipelineLayout;
-	pipelineInfo.renderPass = renderPass->getRenderPass();
-	pipelineInfo.subpass = 0;
-	pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
-	pipelineInfo.basePipelineIndex = -1;
-
-	if (vkCreateGraphicsPipelines(_device->getDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &_graphicPipeline) !=
-		VK_SUCCESS) {
-		throw std::runtime_error("Failed to create graphics pipeline");
-	}
-
-	vkDestroyShaderModule(_device->getDevice(), vertShaderModule, nullptr);
-	vkDestroyShaderModule(_device->getDevice(), fragShaderModule, nullptr);
+	_graphicPipeline = createMeshGraphicPipeline(_device, renderPass->getRenderPass(), _pipelineLayout, extent,
+												 "shaders/vert.spv", "shaders/frag.spv");
 }
 
 void MeshNode::_destroyGraphicPipeline() {
@@ -286,7 +191,7 @@ void MeshNode::_createVertexBuffer() {
 	std::shared_ptr<Scene::MeshNode> meshNode = _sceneMeshNode.lock();
 	assert(meshNode);
 
-	auto mesh = std::dynamic_pointer_cast<Scene::DynamicMesh>(meshNode->getMesh());
+	auto mesh = Core::objectCast<Scene::DynamicMesh>(meshNode->getMesh());
 	const std::vector<Scene::Vertex> &vertices = mesh->getVertices();
 
 	VkDeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
@@ -299,6 +204,7 @@ void MeshNode::_createVertexBuffer() {
 	vkMapMemory(_device->getDevice(), stagingBufferMemory, 0, bufferSize, 0, &data);
 	std::memcpy(data, vertices.data(), (size_t)bufferSize);
 	vkUnmapMemory(_device->getDevice(), stagingBufferMemory);
+	RenderMetrics::instance().uploadedBytes.add(bufferSize);
 
 	std::tie(_vertexBuffer, _vertexBufferMemory) =
 		_device->createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
@@ -319,8 +225,9 @@ void MeshNode::_createIndexBuffer() {
 	std::shared_ptr<Scene::MeshNode> meshNode = _sceneMeshNode.lock();
 	assert(meshNode);
 
-	auto mesh = std::dynamic_pointer_cast<Scene::DynamicMesh>(meshNode->getMesh());
+	auto mesh = Core::objectCast<Scene::DynamicMesh>(meshNode->getMesh());
 	const std::vector<uint32_t> &indices = mesh->getIndices();
+	_indexCount = static_cast<uint32_t>(indices.size());
 
 	VkDeviceSize bufferSize = sizeof(indices[0]) * indices.size();
 
@@ -332,6 +239,7 @@ void MeshNode::_createIndexBuffer() {
 	vkMapMemory(_device->getDevice(), stagingBufferMemory, 0, bufferSize, 0, &data);
 	std::memcpy(data, indices.data(), (size_t)bufferSize);
 	vkUnmapMemory(_device->getDevice(), stagingBufferMemory);
+	RenderMetrics::instance().uploadedBytes.add(bufferSize);
 
 	std::tie(_indexBuffer, _indexBufferMemory) =
 		_device->createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
@@ -348,18 +256,17 @@ void MeshNode::_destroyIndexBuffer() {
 	}
 }
 
-void MeshNode::_createUniformBuffers(const std::shared_ptr<SwapChain> &swapChain) {
+void MeshNode::_createUniformBuffers(uint32_t framesInFlight) {
 	std::shared_ptr<Scene::MeshNode> meshNode = _sceneMeshNode.lock();
 	assert(meshNode);
 
 	VkDeviceSize bufferSize = sizeof(Scene::MvpMatrices);
 
-	uint32_t imageCount = swapChain->getImageCount();
-	_uniformBuffers.resize(imageCount);
-	_uniformBuffersMemory.resize(imageCount);
-	_uniformBuffersMapped.resize(imageCount);
+	_uniformBuffers.resize(framesInFlight);
+	_uniformBuffersMemory.resize(framesInFlight);
+	_uniformBuffersMapped.resize(framesInFlight);
 
-	for (uint32_t i = 0; i < imageCount; i++) {
+	for (uint32_t i = 0; i < framesInFlight; i++) {
 		std::tie(_uniformBuffers[i], _uniformBuffersMemory[i]) =
 			_device->createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
 								  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
@@ -377,21 +284,21 @@ void MeshNode::_destroyUniformBuffers() {
 	}
 }
 
-void MeshNode::_createDescriptorPool(const std::shared_ptr<SwapChain> &swapChain) {
+void MeshNode::_createDescriptorPool(uint32_t framesInFlight) {
 	std::vector<VkDescriptorPoolSize> poolSizes = {};
 	poolSizes.push_back({});
 	poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-	poolSizes[0].descriptorCount = swapChain->getImageCount();
+	poolSizes[0].descriptorCount = framesInFlight;
 
 	auto material = _sceneMeshNode.lock()->getMaterial();
-	if (material) {
+	if (material && _bindlessDescriptors == nullptr) {
 		auto shader = material->getFragmentShader();
 		if (shader) {
 			material->forEachTextures(
-				[&](const std::pair<const std::string, std::shared_ptr<Scene::Texture>> &texture) {
+				[&](const std::pair<const StringId, std::shared_ptr<Scene::Texture>> &texture) {
 					VkDescriptorPoolSize poolSize = {};
 					poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-					poolSize.descriptorCount = swapChain->getImageCount();
+					poolSize.descriptorCount = framesInFlight;
 					poolSizes.push_back(poolSize);
 				});
 		}
@@ -401,7 +308,7 @@ void MeshNode::_createDescriptorPool(const std::shared_ptr<SwapChain> &swapChain
 	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 	poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
 	poolInfo.pPoolSizes = poolSizes.data();
-	poolInfo.maxSets = swapChain->getImageCount();
+	poolInfo.maxSets = framesInFlight;
 
 	if (vkCreateDescriptorPool(_device->getDevice(), &poolInfo, nullptr, &_descriptorPool) != VK_SUCCESS) {
 		throw std::runtime_error("failed to create descriptor pool!");
@@ -414,15 +321,15 @@ void MeshNode::_destroyDescriptorPool() {
 	}
 }
 
-void MeshNode::_createDescriptorSets(const std::shared_ptr<SwapChain> &swapChain) {
-	std::vector<VkDescriptorSetLayout> layouts(swapChain->getImageCount(), _descriptorSetLayout);
+void MeshNode::_createDescriptorSets(uint32_t framesInFlight) {
+	std::vector<VkDescriptorSetLayout> layouts(framesInFlight, _descriptorSetLayout);
 	VkDescriptorSetAllocateInfo allocInfo = {};
 	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
 	allocInfo.descriptorPool = _descriptorPool;
-	allocInfo.descriptorSetCount = swapChain->getImageCount();
+	allocInfo.descriptorSetCount = framesInFlight;
 	allocInfo.pSetLayouts = layouts.data();
 
-	_descriptorSets.resize(swapChain->getImageCount());
+	_descriptorSets.resize(framesInFlight);
 	if (vkAllocateDescriptorSets(_device->getDevice(), &allocInfo, _descriptorSets.data()) != VK_SUCCESS) {
 		throw std::runtime_error("failed to allocate descriptor sets!");
 	}
@@ -446,11 +353,11 @@ void MeshNode::_createDescriptorSets(const std::shared_ptr<SwapChain> &swapChain
 
 		std::vector<VkDescriptorImageInfo> imagesInfo;
 		auto material = _sceneMeshNode.lock()->getMaterial();
-		if (material) {
+		if (material && _bindlessDescriptors == nullptr) {
 			auto shader = material->getFragmentShader();
 			if (shader) {
 				material->forEachTextures(
-					[&](const std::pair<const std::string, std::shared_ptr<Scene::Texture>> &texture) {
+					[&](const std::pair<const StringId, std::shared_ptr<Scene::Texture>> &texture) {
 						auto textureObject = texture.second->getRendererObject<Texture>();
 
 						imagesInfo.push_back({});
@@ -474,6 +381,7 @@ void MeshNode::_createDescriptorSets(const std::shared_ptr<SwapChain> &swapChain
 
 		vkUpdateDescriptorSets(_device->getDevice(), static_cast<uint32_t>(descriptorWrites.size()),
 							   descriptorWrites.data(), 0, nullptr);
+		RenderMetrics::instance().descriptorUpdates.add(descriptorWrites.size());
 	}
 }
 
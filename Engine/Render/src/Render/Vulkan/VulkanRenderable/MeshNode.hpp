@@ -5,6 +5,7 @@
 #include "../RenderContext.hpp"
 #include "Scene/Renderable/IRenderable.hpp"
 
+#include <memory>
 #include <vector>
 #include <vulkan/vulkan.h>
 
@@ -18,8 +19,9 @@ class VulkanRenderer;
 class Device;
 class RenderPass;
 class SwapChain;
+class BindlessDescriptors;
 
-class MeshNode : public Scene::IRendererObject {
+class MeshNode : public Scene::IRendererObject, public std::enable_shared_from_this<MeshNode> {
 public:
 	MeshNode(const std::shared_ptr<Scene::MeshNode> &meshNode, const std::shared_ptr<VulkanRenderer> &renderer);
 
@@ -42,16 +44,19 @@ private:
 	void _createIndexBuffer();
 	void _destroyIndexBuffer();
 
-	void _createUniformBuffers(const std::shared_ptr<SwapChain> &swapChain);
+	void _createUniformBuffers(uint32_t framesInFlight);
 	void _destroyUniformBuffers();
 
-	void _createDescriptorPool(const std::shared_ptr<SwapChain> &swapChain);
+	void _createDescriptorPool(uint32_t framesInFlight);
 	void _destroyDescriptorPool();
 
-	void _createDescriptorSets(const std::shared_ptr<SwapChain> &swapChain);
+	void _createDescriptorSets(uint32_t framesInFlight);
 	void _destroyDescriptorSets();
 
+	[[nodiscard]] uint32_t _getMaterialIndex() const;
+
 	std::shared_ptr<Device> _device;
+	std::shared_ptr<BindlessDescriptors> _bindlessDescriptors; /**< nullptr when using per-material descriptors. */
 
 	std::weak_ptr<Scene::MeshNode> _sceneMeshNode;
 
@@ -64,6 +69,7 @@ private:
 	VkDeviceMemory _vertexBufferMemory = VK_NULL_HANDLE;
 	VkBuffer _indexBuffer = VK_NULL_HANDLE;
 	VkDeviceMemory _indexBufferMemory = VK_NULL_HANDLE;
+	uint32_t _indexCount = 0;
 	// TODO: Use only one buffer for vertices and indices and use offsets
 
 	std::vector<VkBuffer> _uniformBuffers;
@@ -5,14 +5,27 @@
 #include "Core/Image/ImageTypes.hpp"
 #include "Scene/Renderable/Texture.hpp"
 
+#include <memory>
+#include <string>
 #include <vulkan/vulkan.h>
 
 namespace Stone::Render::Vulkan {
 
+class Device;
+
 VkFormat imageChannelToVkFormat(Core::Image::Channel channel);
 
 VkFilter textureFilterToVkFilter(Scene::TextureFilter filter);
 
 VkSamplerAddressMode textureWrapToVkSamplerAddressMode(Scene::TextureWrap wrap);
 
+/**
+ * @brief Create the graphic pipeline used to draw Scene::Vertex meshes with the given layout and shaders.
+ *
+ * Viewport and scissor are dynamic states and must be set when recording the command buffer.
+ */
+VkPipeline createMeshGraphicPipeline(const std::shared_ptr<Device> &device, VkRenderPass renderPass,
+									  VkPipelineLayout pipelineLayout, VkExtent2D extent,
+									  const std::string &vertexShaderPath, const std::string &fragmentShaderPath);
+
 } // namespace Stone::Render::Vulkan
@@ -2,8 +2,10 @@
 
 #include "Texture.hpp"
 
+#include "../BindlessDescriptors.hpp"
 #include "../Device.hpp"
 #include "../RenderContext.hpp"
+#include "../RenderMetrics.hpp"
 #include "../RenderPass.hpp"
 #include "../SwapChain.hpp"
 #include "Core/Image/ImageData.hpp"
@@ -17,13 +19,20 @@
 namespace Stone::Render::Vulkan {
 
 Texture::Texture(const std::shared_ptr<Scene::Texture> &texture, const std::shared_ptr<VulkanRenderer> &renderer)
-	: _device(renderer->getDevice()), _sceneTexture(texture) {
+	: _device(renderer->getDevice()), _sceneTexture(texture),
+	  _bindlessDescriptors(renderer->getBindlessDescriptors()) {
 	_createTextureImage();
 	_createTextureImageView();
 	_createTextureSampler();
+	if (_bindlessDescriptors) {
+		_bindlessSlot = _bindlessDescriptors->registerTexture(_textureImageView, _textureSampler);
+	}
 }
 
 Texture::~Texture() {
+	if (_bindlessDescriptors) {
+		_bindlessDescriptors->releaseTexture(_bindlessSlot);
+	}
 	_destroyTextureImageView();
 	_destroyTextureImage();
 	_destroyTextureSampler();
@@ -40,6 +49,10 @@ VkSampler Texture::getSampler() const {
 	return _textureSampler;
 }
 
+uint32_t Texture::getBindlessSlot() const {
+	return _bindlessSlot;
+}
+
 
 void Texture::_createTextureImage() {
 	auto texture = _sceneTexture.lock();
@@ -54,6 +67,7 @@ void Texture::_createTextureImage() {
 	vkMapMemory(_device->getDevice(), stagingBufferMemory, 0, imageSize, 0, &data);
 	std::memcpy(data, image->getData(), static_cast<size_t>(imageSize));
 	vkUnmapMemory(_device->getDevice(), stagingBufferMemory);
+	RenderMetrics::instance().uploadedBytes.add(imageSize);
 
 	texture->getImage()->unloadData();
 
@@ -17,6 +17,7 @@ class VulkanRenderer;
 class Device;
 class RenderPass;
 class SwapChain;
+class BindlessDescriptors;
 
 class Texture : public Scene::IRendererObject {
 public:
@@ -29,6 +30,11 @@ public:
 	[[nodiscard]] VkImageView getImageView() const;
 	[[nodiscard]] VkSampler getSampler() const;
 
+	/**
+	 * @brief The slot of the texture in the bindless texture array, 0 (the default texture) when bindless is off.
+	 */
+	[[nodiscard]] uint32_t getBindlessSlot() const;
+
 private:
 	void _createTextureImage();
 	void _destroyTextureImage();
@@ -49,6 +55,9 @@ private:
 	VkImageView _textureImageView = VK_NULL_HANDLE;
 
 	VkSampler _textureSampler = VK_NULL_HANDLE;
+
+	std::shared_ptr<BindlessDescriptors> _bindlessDescriptors;
+	uint32_t _bindlessSlot = 0;
 };
 
 } // namespace Stone::Render::Vulkan
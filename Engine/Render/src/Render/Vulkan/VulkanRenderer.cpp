@@ -2,24 +2,60 @@
 
 #include "Render/Vulkan/VulkanRenderer.hpp"
 
+#include "BindlessDescriptors.hpp"
+#include "CommandRecorder.hpp"
+#include "Core/Image/ImageData.hpp"
 #include "Device.hpp"
 #include "FramesRenderer.hpp"
+#include "GpuProfiler.hpp"
+#include "Logging/Logger.hpp"
+#include "OffscreenTarget.hpp"
+#include "RenderContext.hpp"
 #include "RenderPass.hpp"
 #include "SwapChain.hpp"
 
+#include <algorithm>
+#include <thread>
+
 namespace Stone::Render::Vulkan {
 
-VulkanRenderer::VulkanRenderer(RendererSettings &settings) : Renderer() {
-	std::cout << "VulkanRenderer created" << std::endl;
+VulkanRenderer::VulkanRenderer(RendererSettings &settings)
+	: Renderer(), _headlessFormat(settings.headlessFormat), _recordingThreads(settings.recordingThreads),
+	  _drawsPerRecordingThread(settings.drawsPerRecordingThread) {
+	if (_recordingThreads == 0) {
+		_recordingThreads = std::max(std::thread::hardware_concurrency(), 1U);
+	}
+
+	STONE_LOG_DEBUG("Render", "VulkanRenderer created");
 
 	_device = std::make_shared<Device>(settings);
 
-	SwapChainProperties swapChainProperties = _device->createSwapChainProperties(settings.frame_size);
+	if (settings.headless) {
+		_renderPass = std::make_shared<RenderPass>(_device, _headlessFormat, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+		_offscreenTarget = std::make_shared<OffscreenTarget>(
+			_device, _renderPass->getRenderPass(), _headlessFormat,
+			VkExtent2D{settings.frame_size.first, settings.frame_size.second}, settings.framesInFlight);
+	} else {
+		SwapChainProperties swapChainProperties = _device->createSwapChainProperties(settings.frame_size);
+
+		_renderPass = std::make_shared<RenderPass>(_device, swapChainProperties.surfaceFormat.format);
+		_swapChain = std::make_shared<SwapChain>(_device, _renderPass->getRenderPass(), swapChainProperties);
+	}
+
+	uint32_t imageCount = _swapChain ? _swapChain->getImageCount() : _offscreenTarget->getImageCount();
+	_framesRenderer = std::make_shared<FramesRenderer>(_device, settings.framesInFlight, imageCount);
+
+	if (_device->isBindlessSupported()) {
+		_bindlessDescriptors =
+			std::make_shared<BindlessDescriptors>(_device, _renderPass, getFrameExtent(), settings.bindlessMaxMaterials,
+												  _framesRenderer->getFramesInFlight());
+	}
+
+	_createCommandRecorder();
 
-	_renderPass = std::make_shared<RenderPass>(_device, swapChainProperties.surfaceFormat.format);
-	_swapChain = std::make_shared<SwapChain>(_device, _renderPass->getRenderPass(), swapChainProperties);
-	_framesRenderer = std::make_shared<FramesRenderer>(_device, _swapChain->getImageCount());
-	assert(_framesRenderer->getImageCount() == _swapChain->getImageCount());
+#ifdef STONE_PROFILING
+	_gpuProfiler = std::make_unique<GpuProfiler>(_device, _framesRenderer->getFramesInFlight());
+#endif
 }
 
 VulkanRenderer::~VulkanRenderer() {
@@ -27,16 +63,24 @@ VulkanRenderer::~VulkanRenderer() {
 		_device->waitIdle();
 	}
 
+	_gpuProfiler.reset();
+	_commandRecorder.reset();
+	_bindlessDescriptors.reset();
 	_framesRenderer.reset();
+	_offscreenTarget.reset();
 	_swapChain.reset();
 	_renderPass.reset();
 	_device.reset();
 
-	std::cout << "VulkanRenderer destroyed" << std::endl;
+	STONE_LOG_DEBUG("Render", "VulkanRenderer destroyed");
 }
 
 void VulkanRenderer::updateFrameSize(std::pair<uint32_t, uint32_t> size) {
-	_recreateSwapChain(size);
+	if (isHeadless()) {
+		_recreateOffscreenTarget(size);
+	} else {
+		_recreateSwapChain(size);
+	}
 }
 
 void VulkanRenderer::_recreateSwapChain(std::pair<uint32_t, uint32_t> size) {
@@ -51,12 +95,57 @@ void VulkanRenderer::_recreateSwapChain(std::pair<uint32_t, uint32_t> size) {
 	SwapChainProperties swapChainSettings = _device->createSwapChainProperties(size);
 	_swapChain = std::make_shared<SwapChain>(_device, _renderPass->getRenderPass(), swapChainSettings);
 
-	if (_framesRenderer == nullptr || _framesRenderer->getImageCount() != _swapChain->getImageCount()) {
-		_framesRenderer.reset();
-		_framesRenderer = std::make_shared<FramesRenderer>(_device, _swapChain->getImageCount());
+	// Frames in flight do not depend on the swap chain, only the image tracking is reset
+	if (_framesRenderer) {
+		_framesRenderer->resetImagesInFlight(_swapChain->getImageCount());
+	}
+}
+
+void VulkanRenderer::_recreateOffscreenTarget(std::pair<uint32_t, uint32_t> size) {
+	if (_device == nullptr) {
+		return;
+	}
+
+	_device->waitIdle();
+
+	uint32_t imageCount = _offscreenTarget->getImageCount();
+	_offscreenTarget.reset();
+	_offscreenTarget = std::make_shared<OffscreenTarget>(_device, _renderPass->getRenderPass(), _headlessFormat,
+														 VkExtent2D{size.first, size.second}, imageCount);
+
+	if (_framesRenderer) {
+		_framesRenderer->resetImagesInFlight(_offscreenTarget->getImageCount());
+	}
+}
+
+std::shared_ptr<Core::Image::ImageData> VulkanRenderer::readFrame() const {
+	if (!isHeadless()) {
+		throw std::runtime_error("Frames can only be read back from a headless renderer");
 	}
+	const std::optional<uint32_t> &imageIndex = _offscreenTarget->getLastImageIndex();
+	if (!imageIndex.has_value()) {
+		throw std::runtime_error("No frame has been rendered yet");
+	}
+
+	// The image is only reused once every other frame in flight is recorded, idling is enough to see it complete
+	_device->waitIdle();
+
+	std::vector<uint8_t> pixels;
+	_offscreenTarget->readImage(*imageIndex, pixels);
 
-	assert(_framesRenderer->getImageCount() == _swapChain->getImageCount());
+	const VkExtent2D &extent = _offscreenTarget->getExtent();
+	// Channel values are the number of channels, the offscreen formats all have one byte per channel
+	auto channels = static_cast<Core::Image::Channel>(_offscreenTarget->getChannelCount());
+	return std::make_shared<Core::Image::ImageData>(
+		Core::Image::Size(static_cast<int>(extent.width), static_cast<int>(extent.height)), channels, pixels.data());
+}
+
+void VulkanRenderer::_createCommandRecorder() {
+	_commandRecorder.reset();
+	if (_recordingThreads > 1) {
+		_commandRecorder =
+			std::make_unique<CommandRecorder>(_device, _recordingThreads, _framesRenderer->getFramesInFlight());
+	}
 }
 
 const std::shared_ptr<Device> &VulkanRenderer::getDevice() const {
@@ -75,5 +164,17 @@ const std::shared_ptr<SwapChain> &VulkanRenderer::getSwapChain() const {
 	return _swapChain;
 }
 
+bool VulkanRenderer::isHeadless() const {
+	return _offscreenTarget != nullptr;
+}
+
+const VkExtent2D &VulkanRenderer::getFrameExtent() const {
+	return _swapChain ? _swapChain->getExtent() : _offscreenTarget->getExtent();
+}
+
+const std::shared_ptr<BindlessDescriptors> &VulkanRenderer::getBindlessDescriptors() const {
+	return _bindlessDescriptors;
+}
+
 
 } // namespace Stone::Render::Vulkan
@@ -1,72 +1,182 @@
 // Copyright 2024 Stone-Engine
 
+#include "BindlessDescriptors.hpp"
+#include "CommandRecorder.hpp"
+#include "Core/Memory/Pool.hpp"
 #include "Device.hpp"
 #include "FramesRenderer.hpp"
+#include "GpuProfiler.hpp"
+#include "Logging/Logger.hpp"
+#include "Logging/Profiler.hpp"
+#include "OffscreenTarget.hpp"
 #include "Render/Vulkan/VulkanRenderer.hpp"
 #include "RenderContext.hpp"
 #include "RendererObjectManager.hpp"
+#include "RenderMetrics.hpp"
 #include "RenderPass.hpp"
 #include "Scene.hpp"
 #include "Scene/ISceneRenderer.hpp"
 #include "SwapChain.hpp"
 
+#include <algorithm>
+#include <optional>
+
 namespace Stone::Render::Vulkan {
 
 void VulkanRenderer::updateDataForWorld(const std::shared_ptr<Scene::WorldNode> &world) {
+	STONE_PROFILE_FUNCTION();
+	_updateRenderables(world->takeDirtyRenderables());
+}
+
+void VulkanRenderer::_updateRenderables(const std::vector<std::shared_ptr<Scene::RenderableNode>> &renderables) {
 	RendererObjectManager manager(std::static_pointer_cast<VulkanRenderer>(shared_from_this()));
-	world->traverseTopDown([&manager](const std::shared_ptr<Scene::Node> &node) {
-		auto renderElement = std::dynamic_pointer_cast<Scene::IRenderable>(node);
-		if (renderElement && renderElement->isDirty()) {
+	for (const auto &node : renderables) {
+		if (node->isDirty()) {
 			manager.updateRenderable(node);
 		}
-	});
+	}
 }
 
 void VulkanRenderer::renderWorld(const std::shared_ptr<Scene::WorldNode> &world) {
+	STONE_PROFILE_FUNCTION();
+	if (_snapshots.empty()) {
+		_snapshots.resize(1);
+	}
+	_collectRenderQueue(world, _snapshots[0]);
+	renderSnapshot(0);
+}
+
+void VulkanRenderer::setSnapshotCount(uint32_t count) {
+	_snapshots.resize(std::max(count, 1U));
+}
+
+void VulkanRenderer::snapshotWorld(const std::shared_ptr<Scene::WorldNode> &world, uint32_t slot) {
+	assert(slot < _snapshots.size());
+	STONE_PROFILE_FUNCTION();
+	FrameSnapshot &snapshot = _snapshots[slot];
+
+	// GPU resources are created on the render thread, renderables appearing in this snapshot are drawn from the next
+	{
+		std::lock_guard lock(_snapshotMutex);
+		snapshot.dirtyRenderables = world->takeDirtyRenderables();
+		snapshot.holdsWorld = !snapshot.dirtyRenderables.empty();
+	}
+	_collectRenderQueue(world, snapshot);
+}
+
+void VulkanRenderer::waitSnapshotReleased(uint32_t slot) {
+	assert(slot < _snapshots.size());
+	STONE_PROFILE_FUNCTION();
+	std::unique_lock lock(_snapshotMutex);
+	_snapshotReleased.wait(lock, [this, slot] { return !_snapshots[slot].holdsWorld; });
+}
+
+void VulkanRenderer::_releaseSnapshot(FrameSnapshot &snapshot) {
+	{
+		std::lock_guard lock(_snapshotMutex);
+		snapshot.dirtyRenderables.clear();
+		snapshot.holdsWorld = false;
+	}
+	_snapshotReleased.notify_all();
+}
+
+void VulkanRenderer::renderSnapshot(uint32_t slot) {
+	assert(slot < _snapshots.size());
+	FrameSnapshot &snapshot = _snapshots[slot];
 
 	if (!_framesRenderer) {
+		_releaseSnapshot(snapshot);
 		return;
 	}
 
+	STONE_PROFILE_FUNCTION();
+
+	if (!snapshot.dirtyRenderables.empty()) {
+		STONE_PROFILE_SCOPE("Update renderables");
+		try {
+			_updateRenderables(snapshot.dirtyRenderables);
+		} catch (...) {
+			_releaseSnapshot(snapshot);
+			throw;
+		}
+	}
+	_releaseSnapshot(snapshot);
+
+	std::optional<Logging::ScopedTimer> frameTimer(std::in_place, RenderMetrics::instance().frameTime);
+
 	FrameContext frameContext = _framesRenderer->newFrameContext();
 	SyncronizedObjects &syncObject = frameContext.syncObject;
 
-	vkWaitForFences(_device->getDevice(), 1, &syncObject.inFlight, VK_TRUE, UINT64_MAX);
+	{
+		STONE_PROFILE_SCOPE("Wait frame fence");
+		vkWaitForFences(_device->getDevice(), 1, &syncObject.inFlight, VK_TRUE, UINT64_MAX);
+	}
 
 	ImageContext imageContext{};
-	VkResult result = _swapChain->acquireNextImage(syncObject.imageAvailable, imageContext);
+	if (_offscreenTarget) {
+		_offscreenTarget->acquireNextImage(imageContext);
+	} else {
+		STONE_PROFILE_SCOPE("Acquire image");
+		VkResult result = _swapChain->acquireNextImage(syncObject.imageAvailable, imageContext);
 
-	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
-		std::cout << "Must recreate swap chain" << std::endl;
-	} else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
-		throw std::runtime_error("failed to acquire swap chain image!");
+		if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+			STONE_LOG_DEBUG("Render", "Must recreate swap chain");
+		} else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+			throw std::runtime_error("failed to acquire swap chain image!");
+		}
 	}
 
+	_framesRenderer->waitForImage(imageContext.index, syncObject);
+
 	vkResetFences(_device->getDevice(), 1, &syncObject.inFlight);
 
 	vkResetCommandBuffer(frameContext.commandBuffer, 0);
 
-	_recordCommandBuffer(frameContext.commandBuffer, &imageContext, world);
+	if (_bindlessDescriptors) {
+		_bindlessDescriptors->beginFrame(frameContext.frameIndex);
+	}
+
+	_recordCommandBuffer(frameContext.commandBuffer, frameContext.frameIndex, &imageContext, snapshot);
 
 	VkSubmitInfo submitInfo{};
 	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
+	// Offscreen images are not acquired nor presented, the fence alone orders the frames
+	bool presenting = _swapChain != nullptr;
+
 	VkSemaphore waitSemaphores[] = {syncObject.imageAvailable};
 	VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-	submitInfo.waitSemaphoreCount = 1;
+	submitInfo.waitSemaphoreCount = presenting ? 1 : 0;
 	submitInfo.pWaitSemaphores = waitSemaphores;
 	submitInfo.pWaitDstStageMask = waitStages;
 	submitInfo.commandBufferCount = 1;
 	submitInfo.pCommandBuffers = &frameContext.commandBuffer;
 
-	VkSemaphore signalSemaphores[] = {syncObject.renderFinished};
-	submitInfo.signalSemaphoreCount = 1;
+	// One semaphore per image, the present of an image may still wait on it when the frame slot comes around again
+	VkSemaphore signalSemaphores[] = {_framesRenderer->getRenderFinished(imageContext.index)};
+	submitInfo.signalSemaphoreCount = presenting ? 1 : 0;
 	submitInfo.pSignalSemaphores = signalSemaphores;
 
+	STONE_PROFILE_SCOPE("Submit and present");
+
+	auto queueLock = _device->lockQueues();
+
 	if (vkQueueSubmit(_device->getGraphicsQueue(), 1, &submitInfo, syncObject.inFlight) != VK_SUCCESS) {
 		throw std::runtime_error("failed to submit draw command buffer!");
 	}
 
+	if (_gpuProfiler) {
+		_gpuProfiler->frameSubmitted(frameContext.frameIndex);
+	}
+
+	frameTimer.reset();
+	Core::Memory::Pool::publishMetrics();
+	Logging::MetricsRegistry::instance().endFrame();
+
+	if (!presenting) {
+		return;
+	}
+
 	VkPresentInfoKHR presentInfo{};
 	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 	presentInfo.waitSemaphoreCount = 1;
@@ -80,8 +190,37 @@ void VulkanRenderer::renderWorld(const std::shared_ptr<Scene::WorldNode> &world)
 	vkQueuePresentKHR(_device->getPresentQueue(), &presentInfo);
 }
 
-void VulkanRenderer::_recordCommandBuffer(VkCommandBuffer commandBuffer, ImageContext *imageContext,
-										  const std::shared_ptr<Scene::WorldNode> &world) {
+void VulkanRenderer::_collectRenderQueue(const std::shared_ptr<Scene::WorldNode> &world, FrameSnapshot &snapshot) {
+	STONE_PROFILE_FUNCTION();
+
+	// Collect the draws of the world, sorted so that consecutive draws share their pipeline and material
+	Vulkan::RenderContext queueContext;
+	queueContext.extent = getFrameExtent();
+	queueContext.renderQueue = &snapshot.renderQueue;
+
+	snapshot.renderQueue.clear();
+	world->initializeRenderContext(queueContext);
+	world->render(queueContext);
+
+	std::stable_sort(snapshot.renderQueue.begin(), snapshot.renderQueue.end(),
+					 [](const RenderQueueItem &lhs, const RenderQueueItem &rhs) {
+						 if (lhs.pipeline != rhs.pipeline) {
+							 return std::less<VkPipeline>()(lhs.pipeline, rhs.pipeline);
+						 }
+						 return lhs.materialIndex < rhs.materialIndex;
+					 });
+
+	RenderMetrics::instance().renderQueueSize.set(static_cast<double>(snapshot.renderQueue.size()));
+}
+
+void VulkanRenderer::_recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t frameIndex,
+										  ImageContext *imageContext, const FrameSnapshot &snapshot) {
+	STONE_PROFILE_FUNCTION();
+
+	const std::vector<RenderQueueItem> &renderQueue = snapshot.renderQueue;
+
+	bool parallelRecording = _commandRecorder != nullptr && renderQueue.size() >= 2 * _drawsPerRecordingThread;
+
 	VkCommandBufferBeginInfo beginInfo = {};
 	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
@@ -89,6 +228,12 @@ void VulkanRenderer::_recordCommandBuffer(VkCommandBuffer commandBuffer, ImageCo
 		throw std::runtime_error("Failed to begin recording command buffer");
 	}
 
+	uint32_t renderPassZone = GpuProfiler::invalidZone;
+	if (_gpuProfiler) {
+		_gpuProfiler->beginFrame(commandBuffer, frameIndex);
+		renderPassZone = _gpuProfiler->beginZone(commandBuffer, frameIndex, "Render pass");
+	}
+
 	std::array<VkClearValue, 2> clearValues = {};
 	clearValues[0].color = {0.0f, 0.0f, 0.0f, 1.0f};
 	clearValues[1].depthStencil = {1.0f, 0};
@@ -98,39 +243,78 @@ void VulkanRenderer::_recordCommandBuffer(VkCommandBuffer commandBuffer, ImageCo
 	renderPassInfo.renderPass = _renderPass->getRenderPass();
 	renderPassInfo.framebuffer = imageContext->framebuffer;
 	renderPassInfo.renderArea.offset = {0, 0};
-	renderPassInfo.renderArea.extent = _swapChain->getExtent();
+	renderPassInfo.renderArea.extent = getFrameExtent();
 	renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
 	renderPassInfo.pClearValues = clearValues.data();
 
-	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+	if (parallelRecording) {
+		vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+		VkCommandBufferInheritanceInfo inheritanceInfo = {};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.renderPass = _renderPass->getRenderPass();
+		inheritanceInfo.subpass = 0;
+		inheritanceInfo.framebuffer = imageContext->framebuffer;
 
+		std::vector<VkCommandBuffer> secondaryCommandBuffers = _commandRecorder->record(
+			frameIndex, inheritanceInfo, renderQueue.size(), _drawsPerRecordingThread,
+			[this, frameIndex, imageContext, &renderQueue](VkCommandBuffer secondaryCommandBuffer, size_t begin,
+														   size_t end) {
+				_recordRenderQueue(secondaryCommandBuffer, frameIndex, imageContext, renderQueue, begin, end);
+			});
+
+		vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(secondaryCommandBuffers.size()),
+							 secondaryCommandBuffers.data());
+	} else {
+		vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		_recordRenderQueue(commandBuffer, frameIndex, imageContext, renderQueue, 0, renderQueue.size());
+	}
+
+	vkCmdEndRenderPass(commandBuffer);
+
+	if (_gpuProfiler) {
+		_gpuProfiler->endZone(commandBuffer, frameIndex, renderPassZone);
+	}
+
+	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to record command buffer");
+	}
+}
+
+void VulkanRenderer::_recordRenderQueue(VkCommandBuffer commandBuffer, uint32_t frameIndex, ImageContext *imageContext,
+										const std::vector<RenderQueueItem> &renderQueue, size_t begin, size_t end) {
 	VkViewport viewport = {};
 	viewport.x = 0.0f;
 	viewport.y = 0.0f;
-	viewport.width = static_cast<float>(_swapChain->getExtent().width);
-	viewport.height = static_cast<float>(_swapChain->getExtent().height);
+	viewport.width = static_cast<float>(getFrameExtent().width);
+	viewport.height = static_cast<float>(getFrameExtent().height);
 	viewport.minDepth = 0.0f;
 	viewport.maxDepth = 1.0f;
 	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 
 	VkRect2D scissor = {};
 	scissor.offset = {0, 0};
-	scissor.extent = _swapChain->getExtent();
+	scissor.extent = getFrameExtent();
 	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
 	Vulkan::RenderContext context;
 	context.commandBuffer = commandBuffer;
-	context.extent = _swapChain->getExtent();
+	context.extent = getFrameExtent();
 	context.imageIndex = imageContext->index;
+	context.frameIndex = frameIndex;
 
-	world->initializeRenderContext(context);
-	world->render(context);
-
-	vkCmdEndRenderPass(commandBuffer);
-
-	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
-		throw std::runtime_error("Failed to record command buffer");
+	for (size_t i = begin; i < end; ++i) {
+		const RenderQueueItem &item = renderQueue[i];
+		context.mvp = item.mvp;
+		context.queueItem = &item;
+		item.object->render(context);
 	}
+
+	RenderMetrics &metrics = RenderMetrics::instance();
+	metrics.drawCalls.add(context.drawCalls);
+	metrics.pipelineBinds.add(context.pipelineBinds);
+	metrics.triangles.add(context.triangles);
+	metrics.uploadedBytes.add(context.uploadedBytes);
 }
 
 } // namespace Stone::Render::Vulkan
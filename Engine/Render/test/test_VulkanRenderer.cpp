@@ -1,5 +1,7 @@
+#include "Core/Image/ImageData.hpp"
 #include "Render/Vulkan/RendererSettings.hpp"
 #include "Render/Vulkan/VulkanRenderer.hpp"
+#include "Scene/Node/WorldNode.hpp"
 
 #include <gtest/gtest.h>
 
@@ -21,3 +23,37 @@ TEST(VulkanRender, InstanciateCore) {
 		FAIL() << e.what();
 	}
 }
+
+TEST(VulkanRender, HeadlessReadback) {
+	RendererSettings settings;
+	settings.headless = true;
+	settings.frame_size = {64, 32};
+
+	std::shared_ptr<VulkanRenderer> renderer;
+	try {
+		renderer = std::make_shared<VulkanRenderer>(settings);
+	} catch (const std::runtime_error &e) {
+		GTEST_SKIP() << "No Vulkan device available: " << e.what();
+	}
+
+	EXPECT_TRUE(renderer->isHeadless());
+	EXPECT_EQ(renderer->getSwapChain(), nullptr);
+	EXPECT_THROW((void)renderer->readFrame(), std::runtime_error);
+
+	auto world = WorldNode::create();
+	renderer->updateDataForWorld(world);
+	renderer->renderWorld(world);
+
+	auto image = renderer->readFrame();
+	ASSERT_NE(image, nullptr);
+	EXPECT_EQ(image->getSize().x, 64);
+	EXPECT_EQ(image->getSize().y, 32);
+	EXPECT_EQ(image->getChannels(), Stone::Core::Image::Channel::RGBA);
+
+	// An empty world is the clear color
+	const uint8_t *pixel = image->getData();
+	EXPECT_EQ(pixel[0], 0);
+	EXPECT_EQ(pixel[1], 0);
+	EXPECT_EQ(pixel[2], 0);
+	EXPECT_EQ(pixel[3], 255);
+}
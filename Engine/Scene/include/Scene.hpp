@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include "Scene/Component/ComponentBridge.hpp"
+#include "Scene/Component/Components.hpp"
+#include "Scene/Component/ComponentStore.hpp"
 #include "Scene/Node/CameraNode.hpp"
 #include "Scene/Node/InstancedMeshNode.hpp"
 #include "Scene/Node/LightNode.hpp"
@@ -17,5 +20,7 @@
 #include "Scene/Renderable/SkinMesh.hpp"
 #include "Scene/Renderable/Texture.hpp"
 #include "Scene/RenderContext.hpp"
+#include "Scene/SceneArchive.hpp"
+#include "Scene/ScenePatch.hpp"
 #include "Scene/Transform.hpp"
 #include "Scene/Vertex.hpp"
@@ -12,7 +12,7 @@ namespace Stone::Scene {
  * @brief Represents a resource that contains meshes, textures, and other assets.
  */
 class AssetResource : public Core::Assets::Resource {
-	STONE_OBJECT(AssetResource)
+	STONE_OBJECT(AssetResource, Core::Assets::Resource)
 
 public:
 	AssetResource() = delete;
@@ -0,0 +1,51 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Scene/Component/ComponentStore.hpp"
+
+#include <memory>
+#include <unordered_map>
+
+namespace Stone::Scene {
+
+class Node;
+
+/**
+ * @brief Mirrors the data of the nodes of a hierarchy into the components of a store.
+ *
+ * Each node but the plain `Node` groups is given an entity with a `NodeComponent` and a `TransformComponent` holding
+ * its world matrix, mesh nodes add a `MeshComponent` and a `BoundsComponent`, and light nodes a `LightComponent`.
+ * Systems can then query the store over contiguous arrays instead of visiting the hierarchy. The nodes stay the source
+ * of the data: the components are overwritten on each sync.
+ */
+class ComponentBridge {
+public:
+	explicit ComponentBridge(std::shared_ptr<ComponentStore> store = std::make_shared<ComponentStore>());
+	ComponentBridge(const ComponentBridge &) = delete;
+	ComponentBridge &operator=(const ComponentBridge &) = delete;
+
+	~ComponentBridge() = default;
+
+	/**
+	 * @brief Updates the components of the nodes of a hierarchy.
+	 *
+	 * Nodes that joined the hierarchy are given an entity, and the entities of the nodes that left it are destroyed.
+	 *
+	 * @param root The root of the hierarchy, its own transform is ignored.
+	 */
+	void sync(Node &root);
+
+	/**
+	 * @brief The entity mirroring a node, `nullEntity` if the node was not in the hierarchy at the last sync.
+	 */
+	[[nodiscard]] Entity getEntity(const Node &node) const;
+
+	[[nodiscard]] ComponentStore &getStore() const;
+
+private:
+	std::shared_ptr<ComponentStore> _store;
+	std::unordered_map<const Node *, Entity> _entities;
+};
+
+} // namespace Stone::Scene
@@ -0,0 +1,218 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace Stone::Scene {
+
+/**
+ * @brief An entity of a ComponentStore, the index of its components in the store.
+ */
+using Entity = uint32_t;
+
+inline constexpr Entity nullEntity = std::numeric_limits<Entity>::max();
+
+/**
+ * @brief The part of a component array used without knowing its component type.
+ */
+class IComponentArray {
+public:
+	virtual ~IComponentArray() = default;
+
+	virtual void remove(Entity entity) = 0;
+};
+
+/**
+ * @brief The components of one type, stored in a sparse set.
+ *
+ * Components are packed in a dense array, in no particular order, and the sparse array gives the position of the
+ * component of each entity. Removing a component moves the last one to its position.
+ */
+template <typename T>
+class ComponentArray : public IComponentArray {
+public:
+	[[nodiscard]] bool has(Entity entity) const {
+		return entity < _sparse.size() && _sparse[entity] != nullEntity;
+	}
+
+	[[nodiscard]] T *get(Entity entity) {
+		return has(entity) ? &_components[_sparse[entity]] : nullptr;
+	}
+
+	[[nodiscard]] const T *get(Entity entity) const {
+		return has(entity) ? &_components[_sparse[entity]] : nullptr;
+	}
+
+	/**
+	 * @brief Constructs the component of an entity, replacing its previous one.
+	 */
+	template <typename... Args>
+	T &emplace(Entity entity, Args &&...args) {
+		if (has(entity)) {
+			T &component = _components[_sparse[entity]];
+			component = T{std::forward<Args>(args)...};
+			return component;
+		}
+		if (entity >= _sparse.size())
+			_sparse.resize(static_cast<std::size_t>(entity) + 1, nullEntity);
+		_sparse[entity] = static_cast<Entity>(_components.size());
+		_entities.push_back(entity);
+		return _components.emplace_back(T{std::forward<Args>(args)...});
+	}
+
+	void remove(Entity entity) override {
+		if (!has(entity))
+			return;
+		Entity index = _sparse[entity];
+		if (index + 1 != _components.size()) {
+			_components[index] = std::move(_components.back());
+			_entities[index] = _entities.back();
+			_sparse[_entities[index]] = index;
+		}
+		_components.pop_back();
+		_entities.pop_back();
+		_sparse[entity] = nullEntity;
+	}
+
+	[[nodiscard]] std::size_t size() const {
+		return _components.size();
+	}
+
+	/**
+	 * @brief The components, contiguous, in the order of `entities()`.
+	 */
+	[[nodiscard]] std::span<T> components() {
+		return _components;
+	}
+
+	[[nodiscard]] std::span<const Entity> entities() const {
+		return _entities;
+	}
+
+private:
+	std::vector<Entity> _sparse;
+	std::vector<Entity> _entities;
+	std::vector<T> _components;
+};
+
+/**
+ * @brief Stores the components of entities by type, for systems iterating over contiguous data.
+ *
+ * Any type can be a component, each entity has at most one component of each type. The store is not thread-safe.
+ *
+ * @example
+ * store.each<TransformComponent, BoundsComponent>([](Entity entity, TransformComponent &transform,
+ *                                                   BoundsComponent &bounds) { ... });
+ */
+class ComponentStore {
+public:
+	ComponentStore() = default;
+	ComponentStore(const ComponentStore &) = delete;
+	ComponentStore &operator=(const ComponentStore &) = delete;
+
+	~ComponentStore() = default;
+
+	/**
+	 * @brief Creates an entity without components, reusing the index of a destroyed one if any.
+	 */
+	[[nodiscard]] Entity createEntity();
+
+	/**
+	 * @brief Destroys an entity and removes its components.
+	 */
+	void destroyEntity(Entity entity);
+
+	[[nodiscard]] bool isAlive(Entity entity) const;
+
+	[[nodiscard]] std::size_t getEntityCount() const;
+
+	template <typename T, typename... Args>
+	T &add(Entity entity, Args &&...args) {
+		return getArray<T>().emplace(entity, std::forward<Args>(args)...);
+	}
+
+	template <typename T>
+	void remove(Entity entity) {
+		if (auto *array = _findArray<T>())
+			array->remove(entity);
+	}
+
+	template <typename T>
+	[[nodiscard]] T *get(Entity entity) {
+		auto *array = _findArray<T>();
+		return array == nullptr ? nullptr : array->get(entity);
+	}
+
+	template <typename T>
+	[[nodiscard]] bool has(Entity entity) const {
+		const auto *array = _findArray<T>();
+		return array != nullptr && array->has(entity);
+	}
+
+	/**
+	 * @brief The array of the components of type T, created if there is none yet.
+	 */
+	template <typename T>
+	[[nodiscard]] ComponentArray<T> &getArray() {
+		std::size_t typeId = _typeId<T>();
+		if (typeId >= _arrays.size())
+			_arrays.resize(typeId + 1);
+		if (_arrays[typeId] == nullptr)
+			_arrays[typeId] = std::make_unique<ComponentArray<T>>();
+		return static_cast<ComponentArray<T> &>(*_arrays[typeId]);
+	}
+
+	/**
+	 * @brief Calls a function with each entity having components of all the given types.
+	 *
+	 * The entities are the ones of the T array, in its dense order, the function is given the entity and a reference
+	 * to each component. Components must not be added nor removed during the iteration.
+	 */
+	template <typename T, typename... Others, typename Function>
+	void each(Function &&function) {
+		auto *array = _findArray<T>();
+		if (array == nullptr)
+			return;
+		std::tuple<ComponentArray<Others> *...> others = {_findArray<Others>()...};
+		if (((std::get<ComponentArray<Others> *>(others) == nullptr) || ...))
+			return;
+		std::span<T> components = array->components();
+		std::span<const Entity> entities = array->entities();
+		for (std::size_t index = 0; index < components.size(); ++index) {
+			Entity entity = entities[index];
+			if ((std::get<ComponentArray<Others> *>(others)->has(entity) && ...))
+				function(entity, components[index], *std::get<ComponentArray<Others> *>(others)->get(entity)...);
+		}
+	}
+
+private:
+	std::vector<std::unique_ptr<IComponentArray>> _arrays; /**< Indexed by the type ids */
+	std::vector<bool> _alive;
+	std::vector<Entity> _freeEntities;
+	std::size_t _entityCount = 0;
+
+	static std::size_t _nextTypeId();
+
+	template <typename T>
+	static std::size_t _typeId() {
+		static const std::size_t typeId = _nextTypeId();
+		return typeId;
+	}
+
+	template <typename T>
+	[[nodiscard]] ComponentArray<T> *_findArray() const {
+		std::size_t typeId = _typeId<T>();
+		if (typeId >= _arrays.size())
+			return nullptr;
+		return static_cast<ComponentArray<T> *>(_arrays[typeId].get());
+	}
+};
+
+} // namespace Stone::Scene
@@ -0,0 +1,61 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Scene/Geometry.hpp"
+
+#include <glm/glm.hpp>
+#include <memory>
+
+namespace Stone::Scene {
+
+class Node;
+class IMeshInterface;
+class Material;
+
+/**
+ * @brief The node mirrored by an entity, to get back to the hierarchy from a component query.
+ */
+struct NodeComponent {
+	Node *node = nullptr;
+};
+
+/**
+ * @brief The world transform of a node, accumulated from the pivots above it.
+ */
+struct TransformComponent {
+	glm::mat4 worldMatrix = glm::mat4(1.0f);
+};
+
+/**
+ * @brief The mesh and the material drawn by a mesh node.
+ */
+struct MeshComponent {
+	std::shared_ptr<IMeshInterface> mesh;
+	std::shared_ptr<Material> material;
+};
+
+/**
+ * @brief The bounding boxes of the mesh of a mesh node, in the mesh space and in the world space.
+ */
+struct BoundsComponent {
+	Box localBox;
+	Box worldBox;
+	const IMeshInterface *boundMesh = nullptr; /**< The mesh `localBox` was computed from */
+};
+
+/**
+ * @brief The light emitted by a light node.
+ */
+struct LightComponent {
+	glm::vec3 color = glm::vec3(1.0f);
+	float intensity = 1.0f;
+	bool castingShadow = false;
+};
+
+/**
+ * @brief Computes the box containing a box transformed by a matrix.
+ */
+[[nodiscard]] Box transformBox(const Box &box, const glm::mat4 &matrix);
+
+} // namespace Stone::Scene
@@ -14,7 +14,7 @@ namespace Stone::Scene {
 class ISceneRenderer {
 public:
 	/**
-	 * @brief Request the renderer to update all rendering data in the world.
+	 * @brief Request the renderer to update the rendering data of the renderables marked dirty in the world.
 	 */
 	virtual void updateDataForWorld(const std::shared_ptr<WorldNode> &world) = 0;
 
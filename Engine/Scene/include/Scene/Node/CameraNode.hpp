@@ -15,7 +15,7 @@ namespace Stone::Scene {
  * This class is abstract and cannot be instantiated directly. Use `PerspectiveCameraNode` or `OrthographicCameraNode`
  */
 class CameraNode : public PivotNode {
-	STONE_ABSTRACT_NODE(CameraNode);
+	STONE_ABSTRACT_NODE(CameraNode, PivotNode);
 
 public:
 	explicit CameraNode(const std::string &name = "camera");
@@ -25,6 +25,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	[[nodiscard]] virtual glm::mat4 getProjectionMatrix() const = 0;
 
 	[[nodiscard]] float getNear() const;
@@ -41,7 +43,7 @@ protected:
 };
 
 class PerspectiveCameraNode : public CameraNode {
-	STONE_NODE(PerspectiveCameraNode);
+	STONE_NODE(PerspectiveCameraNode, CameraNode);
 
 public:
 	explicit PerspectiveCameraNode(const std::string &name = "perspective_camera");
@@ -51,6 +53,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	[[nodiscard]] glm::mat4 getProjectionMatrix() const override;
 
 	[[nodiscard]] float getFov() const;
@@ -65,7 +69,7 @@ protected:
 };
 
 class OrthographicCameraNode : public CameraNode {
-	STONE_NODE(OrthographicCameraNode);
+	STONE_NODE(OrthographicCameraNode, CameraNode);
 
 public:
 	explicit OrthographicCameraNode(const std::string &name = "orthographic_camera");
@@ -75,6 +79,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	[[nodiscard]] glm::mat4 getProjectionMatrix() const override;
 
 	[[nodiscard]] glm::vec2 getSize() const;
@@ -8,7 +8,7 @@
 namespace Stone::Scene {
 
 class InstancedMeshNode : public MeshNode {
-	STONE_NODE(InstancedMeshNode);
+	STONE_NODE(InstancedMeshNode, MeshNode);
 
 public:
 	explicit InstancedMeshNode(const std::string &name = "instancedmesh");
@@ -18,6 +18,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	void addInstance(const Transform3D &transform);
 	void removeInstance(int index);
 	void clearInstances();
@@ -7,7 +7,7 @@
 namespace Stone::Scene {
 
 class LightNode : public PivotNode {
-	STONE_ABSTRACT_NODE(LightNode);
+	STONE_ABSTRACT_NODE(LightNode, PivotNode);
 
 public:
 	explicit LightNode(const std::string &name = "light");
@@ -17,6 +17,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	[[nodiscard]] virtual bool isCastingShadow() const;
 
 	[[nodiscard]] float getIntensity() const;
@@ -33,7 +35,7 @@ protected:
 };
 
 class AmbientLightNode : public LightNode {
-	STONE_NODE(AmbientLightNode);
+	STONE_NODE(AmbientLightNode, LightNode);
 
 public:
 	explicit AmbientLightNode(const std::string &name = "ambientlight");
@@ -45,7 +47,7 @@ public:
 };
 
 class PointLightNode : public LightNode {
-	STONE_NODE(PointLightNode);
+	STONE_NODE(PointLightNode, LightNode);
 
 public:
 	explicit PointLightNode(const std::string &name = "pointlight");
@@ -61,13 +63,15 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 protected:
 	glm::vec3 _attenuation;
 	glm::vec3 _specular;
 };
 
 class CastingLightNode : public LightNode {
-	STONE_ABSTRACT_NODE(CastingLightNode);
+	STONE_ABSTRACT_NODE(CastingLightNode, LightNode);
 
 public:
 	explicit CastingLightNode(const std::string &name = "castinglight");
@@ -77,6 +81,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	[[nodiscard]] bool isCastingShadow() const override;
 	void setCastingShadow(bool castShadow);
 
@@ -104,7 +110,7 @@ protected:
 };
 
 class DirectionalLightNode : public CastingLightNode {
-	STONE_NODE(DirectionalLightNode);
+	STONE_NODE(DirectionalLightNode, CastingLightNode);
 
 public:
 	explicit DirectionalLightNode(const std::string &name = "directionallight");
@@ -114,6 +120,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	[[nodiscard]] bool isInfinite() const;
 	void setInfinite(bool infinite);
 
@@ -128,7 +136,7 @@ protected:
 };
 
 class SpotLightNode : public CastingLightNode {
-	STONE_NODE(SpotLightNode);
+	STONE_NODE(SpotLightNode, CastingLightNode);
 
 public:
 	explicit SpotLightNode(const std::string &name = "spotlight");
@@ -138,6 +146,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	[[nodiscard]] float getConeAngle() const;
 	void setConeAngle(float coneAngle);
 
@@ -10,7 +10,7 @@ class IMeshInterface;
 class Material;
 
 class MeshNode : public RenderableNode {
-	STONE_NODE(MeshNode);
+	STONE_NODE(MeshNode, RenderableNode);
 
 public:
 	explicit MeshNode(const std::string &name = "mesh");
@@ -20,6 +20,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	[[nodiscard]] std::shared_ptr<IMeshInterface> getMesh() const;
 	void setMesh(std::shared_ptr<IMeshInterface> mesh);
 
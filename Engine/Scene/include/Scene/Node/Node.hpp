@@ -2,18 +2,31 @@
 
 #pragma once
 
+#include "Core/Memory/Arena.hpp"
+#include "Core/Memory/Pool.hpp"
 #include "Core/Object.hpp"
 #include "Logging/TermColor.hpp"
 #include "Scene/Node/NodeMacros.hpp"
 #include "Scene/RenderContext.hpp"
 #include "Utils/Json.hpp"
+#include "Utils/SmallStack.hpp"
+#include "Utils/StringId.hpp"
 
 #include <functional>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace Stone::Scene {
 
+class SceneArchive;
+class ScenePatch;
 class WorldNode;
+class Node;
+
+template <typename T>
+T *nodeCast(Node &node);
 
 /**
  * @class Node
@@ -23,14 +36,30 @@ class WorldNode;
  * the node hierarchy, updating and rendering nodes, and accessing node properties.
  */
 class Node : public Core::Object {
-	STONE_NODE(Node);
+	STONE_NODE(Node, Core::Object);
 
 public:
 	explicit Node(const std::string &name = "node");
-	Node(const Node &other) = default;
+
+	/**
+	 * @brief Copies the name and the metadatas of a node.
+	 *
+	 * The copy has no parent, children nor world, and its own stable ID.
+	 */
+	Node(const Node &other);
+	Node &operator=(const Node &other) = delete;
 
 	~Node() override = default;
 
+	/**
+	 * @brief Creates a node from the name of its class, registered by `STONE_NODE_IMPLEMENTATION`.
+	 *
+	 * @param className The name of the node class.
+	 * @param name The name of the node.
+	 * @return The node, or nullptr if no node class has this name.
+	 */
+	static std::shared_ptr<Node> createOfClass(std::string_view className, const std::string &name);
+
 	/**
 	 * @brief Writes the node to the output stream.
 	 *
@@ -40,6 +69,16 @@ public:
 	 */
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	/**
+	 * @brief Writes or reads the fields of the node with a SceneArchive.
+	 *
+	 * Each node type saving fields overrides this method, calls the method of its parent class first, then gives its
+	 * fields to the archive in a fixed order. The name and the children are handled by the archive.
+	 *
+	 * @param archive The archive, writing the fields or assigning them depending on `archive.isReading()`.
+	 */
+	virtual void serializeFields(SceneArchive &archive);
+
 	/**
 	 * @brief Updates the node.
 	 *
@@ -62,12 +101,18 @@ public:
 	 * @brief Sets the name of the node.
 	 */
 	void setName(const std::string &name);
+	void setName(StringId name);
 
 	/**
 	 * @brief Gets the name of the node.
 	 */
 	[[nodiscard]] const std::string &getName() const;
 
+	/**
+	 * @brief Gets the interned name of the node.
+	 */
+	[[nodiscard]] StringId getNameId() const;
+
 	/**
 	 * @brief Gets the global name of the node.
 	 *
@@ -77,9 +122,24 @@ public:
 	 */
 	[[nodiscard]] std::string getGlobalName() const;
 
+	/**
+	 * @brief Gets the stable ID of the node.
+	 *
+	 * Unlike `getId()`, the stable ID is saved by the SceneArchive, so that a node keeps it when the scene is loaded
+	 * again. It identifies the node when comparing two states of a scene with a ScenePatch.
+	 */
+	[[nodiscard]] uint64_t getStableId() const;
+
+	/**
+	 * @brief Sets the stable ID of the node, which must be unique in its scene.
+	 */
+	void setStableId(uint64_t stableId);
+
 	/**
 	 * @brief Adds a child node to this node.
 	 *
+	 * The child and its descendants get the world of this node.
+	 *
 	 * @param child The child node to add.
 	 */
 	void addChild(const std::shared_ptr<Node> &child);
@@ -87,13 +147,19 @@ public:
 	/**
 	 * @brief Adds a child node of type T to this node.
 	 *
+	 * The child is created in the arena of the world when it has one, else in the pool of its class.
+	 *
 	 * @tparam T The type of the child node.
 	 * @param name The name of the child node.
 	 * @return The shared pointer to the child node.
 	 */
 	template <typename T, typename... Args>
 	std::shared_ptr<T> addChild(Args &&...arg) {
-		auto child = std::make_shared<T>(arg...);
+		std::shared_ptr<T> child;
+		if (auto arena = _getWorldArena())
+			child = Core::Memory::makeInArena<T>(arena, std::forward<Args>(arg)...);
+		else
+			child = Core::Memory::makePooled<T>(std::forward<Args>(arg)...);
 		addChild(child);
 		return child;
 	}
@@ -144,24 +210,29 @@ public:
 	/**
 	 * @brief Gets the child node with the given name.
 	 *
+	 * Children are indexed by name, when several children have the same name the first one is returned.
+	 *
 	 * @param name The name of the child node.
 	 * @return The child node with the given name, or nullptr if not found.
 	 */
-	[[nodiscard]] std::shared_ptr<Node> getChild(const std::string &name) const;
+	[[nodiscard]] std::shared_ptr<Node> getChild(std::string_view name) const;
+	[[nodiscard]] std::shared_ptr<Node> getChild(StringId name) const;
 
 	/**
 	 * @brief Get a child node with a given relative path.
 	 *
 	 * @param path The path to the child node.
 	 *
-	 * Path starting with '*\/' will look for any descendant with the given name
+	 * Path starting with '*\/' will look for any descendant with the given name, the first one in a top-down order.
+	 * Inside a world, only the nodes of the world with the name are compared, through their parents, instead of
+	 * visiting the hierarchy.
 	 *
 	 * @example getChildByPath("child1/child2/child3")
 	 * @example getChildByPath("*\/child3")
 	 *
 	 * @return The child node with the given path, or nullptr if not found.
 	 */
-	[[nodiscard]] std::shared_ptr<Node> getChildByPath(const std::string &path) const;
+	[[nodiscard]] std::shared_ptr<Node> getChildByPath(std::string_view path) const;
 
 	/**
 	 * @brief Gets the child node of type T with the given name.
@@ -171,7 +242,12 @@ public:
 	 * @return The child node of type T with the given name, or nullptr if not found.
 	 */
 	template <typename T>
-	[[nodiscard]] std::shared_ptr<T> getChild(const std::string &name) const {
+	[[nodiscard]] std::shared_ptr<T> getChild(std::string_view name) const {
+		return std::dynamic_pointer_cast<T>(getChild(name));
+	}
+
+	template <typename T>
+	[[nodiscard]] std::shared_ptr<T> getChild(StringId name) const {
 		return std::dynamic_pointer_cast<T>(getChild(name));
 	}
 
@@ -186,7 +262,7 @@ public:
 	 * @return The child node of type T with the given path, or nullptr if not found.
 	 */
 	template <typename T>
-	[[nodiscard]] std::shared_ptr<T> getChildByPath(const std::string &path) const {
+	[[nodiscard]] std::shared_ptr<T> getChildByPath(std::string_view path) const {
 		return std::dynamic_pointer_cast<T>(getChildByPath(path));
 	}
 
@@ -233,10 +309,56 @@ public:
 	 */
 	[[nodiscard]] glm::mat4 getTransformMatrixRelativeToNode(const std::shared_ptr<Node> &otherNode) const;
 
+	/**
+	 * @brief Applies a function to this node and its descendants, each node before its children.
+	 *
+	 * The function takes a `Node &` and may return a bool, false stopping the traversal. The hierarchy is visited with
+	 * an explicit stack, so deep hierarchies do not overflow the call stack. The function may change the children of
+	 * the node it is given, but not the rest of the hierarchy.
+	 *
+	 * @param function The function to apply to each node.
+	 * @return false if the function stopped the traversal.
+	 */
+	template <typename Function>
+	bool forEachTopDown(Function &&function) {
+		return _traverseTopDown<Node *>(this, [&function](Node *node) { return _visit(function, *node); });
+	}
+
+	/**
+	 * @brief Applies a function to this node and its descendants, each node after its children.
+	 *
+	 * The function takes a `Node &` and may return a bool, false stopping the traversal. The hierarchy must not be
+	 * changed during the traversal.
+	 *
+	 * @param function The function to apply to each node.
+	 * @return false if the function stopped the traversal.
+	 */
+	template <typename Function>
+	bool forEachBottomUp(Function &&function) {
+		return _traverseBottomUp<Node *>(this, [&function](Node *node) { return _visit(function, *node); });
+	}
+
+	/**
+	 * @brief Applies a function to this node and its descendants of type T, in a top-down order.
+	 *
+	 * The function takes a `T &` and may return a bool, false stopping the traversal. Nodes are cast with `nodeCast`.
+	 *
+	 * @tparam T The type of the nodes, a node class or an interface of node classes.
+	 * @return false if the function stopped the traversal.
+	 */
+	template <typename T, typename Function>
+	bool forEachOfType(Function &&function) {
+		return forEachTopDown([&function](Node &node) {
+			T *cast = nodeCast<T>(node);
+			return cast == nullptr || _visit(function, *cast);
+		});
+	}
+
 	/**
 	 * @brief Traverses the node hierarchy in a top-down order and applies the given function to each node.
 	 *
-	 * Top-down traversal means that the function is applied to the parent node before its children.
+	 * Top-down traversal means that the function is applied to the parent node before its children. Hot paths use
+	 * `forEachTopDown` instead, which does not type-erase the function.
 	 *
 	 * @param func The function to apply to each node.
 	 */
@@ -296,12 +418,114 @@ public:
 	Json::Object &getMetadatas();
 
 protected:
-	std::string _name;							  /**< The name of the node. */
+	friend class ScenePatch;
+	friend class WorldNode;
+
+	StringId _name;								  /**< The name of the node. */
 	std::vector<std::shared_ptr<Node>> _children; /**< The children nodes of this node. */
 	std::weak_ptr<Node> _parent;				  /**< The parent node of this node. */
 	std::weak_ptr<WorldNode> _world;			  /**< The world node that this node belongs to. */
 
+	/** The first child with each name. */
+	std::unordered_map<StringId, Node *> _childrenByName;
+	/** The position of the node in the name index of its world. */
+	std::size_t _worldNameSlot = 0;
+
 	Json::Object _metadatas; /**< Metadata of the node */
+	uint64_t _stableId;		 /**< The ID of the node kept by saving and loading the scene. */
+
+	/**
+	 * @brief Sets the world of the node and its descendants, and moves them to the name index of the new world.
+	 */
+	void _setWorld(const std::shared_ptr<WorldNode> &world);
+
+	/**
+	 * @brief Removes a child from the children without changing its parent or its world.
+	 *
+	 * @return Whether the node was a child of this node.
+	 */
+	bool _eraseChild(const Node &child);
+
+	/**
+	 * @brief Gets the arena of the world of the node, or nullptr.
+	 */
+	[[nodiscard]] std::shared_ptr<Core::Memory::Arena> _getWorldArena() const;
+
+	/**
+	 * @brief Indexes again the first child with the given name, after that child was removed or renamed.
+	 */
+	void _indexChildName(StringId name);
+
+	/**
+	 * @brief Calls a traversal function, which continues the traversal unless it returns false.
+	 */
+	template <typename Function, typename T>
+	static bool _visit(Function &function, T &node) {
+		if constexpr (std::is_void_v<std::invoke_result_t<Function &, T &>>) {
+			function(node);
+			return true;
+		} else {
+			return static_cast<bool>(function(node));
+		}
+	}
+
+	/**
+	 * @brief The traversals, on raw pointers or on the shared pointers held by the parents.
+	 */
+	template <typename Entry>
+	static Node &_entryNode(Entry entry) {
+		if constexpr (std::is_same_v<Entry, Node *>)
+			return *entry;
+		else
+			return **entry;
+	}
+
+	template <typename Entry>
+	static Entry _childEntry(const std::shared_ptr<Node> &child) {
+		if constexpr (std::is_same_v<Entry, Node *>)
+			return child.get();
+		else
+			return &child;
+	}
+
+	template <typename Entry, typename Visit>
+	static bool _traverseTopDown(Entry root, const Visit &visit) {
+		Utils::SmallStack<Entry, 64> stack;
+		stack.push(root);
+		while (!stack.empty()) {
+			Entry entry = stack.top();
+			stack.pop();
+			if (!visit(entry))
+				return false;
+			const auto &children = _entryNode(entry)._children;
+			for (auto it = children.rbegin(); it != children.rend(); ++it)
+				stack.push(_childEntry<Entry>(*it));
+		}
+		return true;
+	}
+
+	template <typename Entry, typename Visit>
+	static bool _traverseBottomUp(Entry root, const Visit &visit) {
+		struct Frame {
+			Entry entry;
+			std::size_t nextChild;
+		};
+		Utils::SmallStack<Frame, 32> stack;
+		stack.push({root, 0});
+		while (!stack.empty()) {
+			Frame &frame = stack.top();
+			const auto &children = _entryNode(frame.entry)._children;
+			if (frame.nextChild < children.size()) {
+				stack.push({_childEntry<Entry>(children[frame.nextChild++]), 0});
+				continue;
+			}
+			Entry entry = frame.entry;
+			stack.pop();
+			if (!visit(entry))
+				return false;
+		}
+		return true;
+	}
 
 	/**
 	 * @brief Gets the class color for terminal output.
@@ -309,4 +533,37 @@ protected:
 	[[nodiscard]] virtual const char *_termClassColor() const;
 };
 
+/**
+ * @brief Casts a node to T, a node class or an interface of node classes, without a dynamic_cast for most nodes.
+ *
+ * Node classes are checked with their type, every node class must use `STONE_NODE`. For interfaces, the result of the
+ * first dynamic_cast of each node class is cached by its class hash, the following nodes of that class are cast with
+ * the cached offset.
+ *
+ * @return The node as a T, or nullptr if it is not one.
+ */
+template <typename T>
+T *nodeCast(Node &node) {
+	if constexpr (std::is_base_of_v<Node, T>) {
+		return node.isA<T>() ? static_cast<T *>(&node) : nullptr;
+	} else {
+		struct CachedCast {
+			std::intptr_t classHash;
+			std::ptrdiff_t offset;
+			bool isType;
+		};
+		thread_local std::vector<CachedCast> cache;
+
+		std::intptr_t classHash = node.getClassHashCode();
+		for (const CachedCast &cached : cache) {
+			if (cached.classHash == classHash)
+				return cached.isType ? reinterpret_cast<T *>(reinterpret_cast<char *>(&node) + cached.offset) : nullptr;
+		}
+		T *cast = dynamic_cast<T *>(&node);
+		std::ptrdiff_t offset = cast == nullptr ? 0 : reinterpret_cast<char *>(cast) - reinterpret_cast<char *>(&node);
+		cache.push_back({classHash, offset, cast != nullptr});
+		return cast;
+	}
+}
+
 } // namespace Stone::Scene
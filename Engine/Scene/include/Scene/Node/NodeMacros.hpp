@@ -11,28 +11,28 @@ public:
 	virtual const char *getNodeClassName() const;
 
 /**
- * @brief Macro to use inside an abstract node class to make the engine reconize this class as a node.
+ * @brief Macro to use inside an abstract node class, with the node class it inherits from, to make the engine reconize
+ * this class as a node.
  */
-#define STONE_ABSTRACT_NODE(NewClassName)                                                                              \
-	STONE_ABSTRACT_OBJECT(NewClassName)                                                                                \
+#define STONE_ABSTRACT_NODE(NewClassName, ParentClassName)                                                             \
+	STONE_ABSTRACT_OBJECT(NewClassName, ParentClassName)                                                               \
 	__STONE_NODE_BASE(NewClassName)                                                                                    \
                                                                                                                        \
 private:
 
 
 /**
- * @brief Macro to use inside a node class to make the engine reconize this class as a node.
+ * @brief Macro to use inside a node class, with the node class it inherits from, to make the engine reconize this
+ * class as a node.
  */
-#define STONE_NODE(NewClassName)                                                                                       \
-	STONE_OBJECT(NewClassName)                                                                                         \
+#define STONE_NODE(NewClassName, ParentClassName)                                                                      \
+	STONE_OBJECT(NewClassName, ParentClassName)                                                                        \
 	__STONE_NODE_BASE(NewClassName)                                                                                    \
                                                                                                                        \
 private:
 
 /* Cpp Implementations */
 
-#include "Utils/DynamicObjectFactory.hpp"
-
 #define __STONE_NODE_IMPLEMENTATION_BASE(NewClassName)                                                                 \
 	const char *NewClassName::getNodeClassName() const {                                                               \
 		return NewClassName::nodeClassName.c_str();                                                                    \
@@ -40,18 +40,13 @@ private:
 
 /**
  * @brief Macro to use inside the cpp implementation of a node class that have used the STONE_NODE macro in its class.
+ *
+ * It registers the class to the type registry at startup, so that `Node::createOfClass` can create its nodes by name.
  */
 #define STONE_NODE_IMPLEMENTATION(NewClassName)                                                                        \
 	__STONE_NODE_IMPLEMENTATION_BASE(NewClassName)                                                                     \
                                                                                                                        \
-	const std::string NewClassName::nodeClassName = [] {                                                               \
-		auto constructor = [](const std::string &nodeName) {                                                           \
-			return std::make_shared<NewClassName>(nodeName);                                                           \
-		};                                                                                                             \
-		Stone::DynamicObjectFactory<Stone::Scene::Node, const std::string &>::getInstance().add(#NewClassName,         \
-																								constructor);          \
-		return #NewClassName;                                                                                          \
-	}();
+	const std::string NewClassName::nodeClassName = NewClassName::StaticTypeInfo().getName();
 
 /**
  * @brief Macro to use inside the cpp implementation of an abstract node class that have used the STONE_ABSTRACT_NODE
@@ -60,4 +55,4 @@ private:
 #define STONE_ABSTRACT_NODE_IMPLEMENTATION(NewClassName)                                                               \
 	__STONE_NODE_IMPLEMENTATION_BASE(NewClassName)                                                                     \
                                                                                                                        \
-	const std::string NewClassName::nodeClassName = #NewClassName;
+	const std::string NewClassName::nodeClassName = NewClassName::StaticTypeInfo().getName();
@@ -18,7 +18,7 @@ namespace Stone::Scene {
  * All transformations applied to the pivot node are also applied to its children but not to its parent.
  */
 class PivotNode : public Node {
-	STONE_NODE(PivotNode);
+	STONE_NODE(PivotNode, Node);
 
 public:
 	explicit PivotNode(const std::string &name = "pivot");
@@ -28,6 +28,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	void render(RenderContext &context) override;
 
 	void transformRelativeMatrix(glm::mat4 &relative) const override;
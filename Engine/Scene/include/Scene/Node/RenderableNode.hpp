@@ -5,22 +5,46 @@
 #include "Scene/Node/Node.hpp"
 #include "Scene/Renderable/IRenderable.hpp"
 
+#include <mutex>
+
 namespace Stone::Scene {
 
 /**
  * @class RenderableNode
  * @brief Represents a node that can be rendered.
+ *
+ * Inside a world, the node adds itself to the dirty renderables of the world when it joins it dirty, and each time
+ * it is marked dirty. The world that receives the marks is kept apart from the hierarchy under a mutex, since nodes can
+ * be marked dirty from any thread while the hierarchy changes.
  */
 class RenderableNode : public Node, public IRenderable {
-	STONE_ABSTRACT_NODE(RenderableNode)
+	STONE_ABSTRACT_NODE(RenderableNode, Node)
 
 public:
 	explicit RenderableNode(const std::string &name = "renderable");
-	RenderableNode(const RenderableNode &other) = default;
+	RenderableNode(const RenderableNode &other);
 
 	~RenderableNode() override = default;
 
 	void render(RenderContext &context) override;
+
+private:
+	friend class WorldNode;
+
+	/** Bound to the onDirty signal of the node, to report the marks to the world */
+	Slot<IRenderable *, bool> _dirtySlot;
+
+	std::mutex _dirtyWorldMutex;
+	/** The world receiving the dirty marks, set by the world when the node joins and leaves it */
+	std::weak_ptr<WorldNode> _dirtyWorld;
+
+	void _reportDirty(bool dirty);
+
+	/**
+	 * @brief Changes the world receiving the dirty marks, removing the node from the dirty renderables of the previous
+	 * one, so that no thread adds it back once it left.
+	 */
+	void _setDirtyWorld(const std::shared_ptr<WorldNode> &world);
 };
 
 } // namespace Stone::Scene
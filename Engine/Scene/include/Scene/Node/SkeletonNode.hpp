@@ -17,7 +17,7 @@ class PivotNode;
  * Each bone is represented by a pivot node and its rest pose.
  */
 class SkeletonNode : public Node {
-	STONE_NODE(SkeletonNode);
+	STONE_NODE(SkeletonNode, Node);
 
 public:
 	struct Bone {
@@ -25,6 +25,7 @@ public:
 		glm::mat4 inverseBindMatrix;
 		Transform3D restPose;
 
+		Bone();
 		explicit Bone(const std::shared_ptr<PivotNode> &pivot);
 	};
 
@@ -35,6 +36,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	[[nodiscard]] const std::vector<Bone> &getBones() const;
 	void addBone(const std::shared_ptr<PivotNode> &pivot);
 	void addBone(const std::shared_ptr<PivotNode> &pivot, const glm::mat4 &offset);
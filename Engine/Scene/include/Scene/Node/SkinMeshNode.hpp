@@ -11,7 +11,7 @@ class SkeletonNode;
 class Material;
 
 class SkinMeshNode : public RenderableNode {
-	STONE_NODE(SkinMeshNode);
+	STONE_NODE(SkinMeshNode, RenderableNode);
 
 public:
 	explicit SkinMeshNode(const std::string &name = "skinmesh");
@@ -21,6 +21,8 @@ public:
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	[[nodiscard]] std::shared_ptr<ISkinMeshInterface> getSkinMesh() const;
 	void setSkinMesh(std::shared_ptr<ISkinMeshInterface> mesh);
 
@@ -16,7 +16,7 @@ namespace Stone::Scene {
  * The color, line thickness, and lifespan of the wireframe shape can be customized.
  */
 class WireframeShape : public RenderableNode {
-	STONE_NODE(WireframeShape);
+	STONE_NODE(WireframeShape, RenderableNode);
 
 public:
 	/**
@@ -46,6 +46,8 @@ public:
 	 */
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	/**
 	 * @brief Retrieves the color
 	 *
@@ -4,29 +4,39 @@
 
 #include "Scene/Node/Node.hpp"
 
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace Stone::Scene {
 
 class CameraNode;
+class ComponentBridge;
+class RenderableNode;
 
 /**
  * @class WorldNode
  * @brief Represents the root node of the scene graph.
  *
- * The `WorldNode` class is the root node of the scene graph.
+ * The `WorldNode` class is the root node of the scene graph. It indexes every node of the world by name, so that
+ * `getChildByPath("*\/name")` only compares the nodes with the name instead of visiting the hierarchy.
  */
 class WorldNode : public Node {
-	STONE_NODE(WorldNode);
+	STONE_NODE(WorldNode, Node);
 
 public:
 	static std::shared_ptr<WorldNode> create();
 
 	explicit WorldNode(const std::string &name = "world");
-	WorldNode(const WorldNode &other) = default;
+	WorldNode(const WorldNode &other);
 
 	~WorldNode() override = default;
 
 	std::ostream &writeToStream(std::ostream &stream, bool closing_bracer) const override;
 
+	void serializeFields(SceneArchive &archive) override;
+
 	void setRenderer(const std::shared_ptr<ISceneRenderer> &renderer);
 	[[nodiscard]] std::shared_ptr<ISceneRenderer> getRenderer() const;
 
@@ -35,9 +45,58 @@ public:
 
 	void initializeRenderContext(RenderContext &context) const;
 
+	/**
+	 * @brief Sets the arena in which `addChild<T>` creates the nodes of the world.
+	 *
+	 * The nodes keep the arena alive, its memory is released once every node created in it is released. By default
+	 * the world has no arena and nodes are created in the pool of their class.
+	 */
+	void setArena(const std::shared_ptr<Core::Memory::Arena> &arena);
+	[[nodiscard]] const std::shared_ptr<Core::Memory::Arena> &getArena() const;
+
+	/**
+	 * @brief Sets the bridge mirroring the nodes of the world into a component store, synced by `updateNodes`.
+	 *
+	 * By default the world has no component store, and only the node hierarchy holds the scene data.
+	 */
+	void setComponentBridge(const std::shared_ptr<ComponentBridge> &bridge);
+	[[nodiscard]] const std::shared_ptr<ComponentBridge> &getComponentBridge() const;
+
+	/**
+	 * @brief Update every node of the world, then the components of its bridge if any, reporting the count of updated
+	 * nodes and the update time to the engine metrics.
+	 */
+	void updateNodes(float deltaTime);
+
+	/**
+	 * @brief Takes the renderable nodes of the world marked dirty since the last call.
+	 *
+	 * A renderable node is added when it joins the world dirty, and when it is marked dirty, from any thread. Each node
+	 * is given once, so that the renderer only visits the changed nodes. A node that left the world is never given.
+	 */
+	[[nodiscard]] std::vector<std::shared_ptr<RenderableNode>> takeDirtyRenderables();
+
 protected:
+	friend class Node;
+	friend class RenderableNode;
+
 	std::shared_ptr<ISceneRenderer> _renderer;
 	std::weak_ptr<CameraNode> _activeCamera;
+	std::shared_ptr<Core::Memory::Arena> _arena;
+	std::shared_ptr<ComponentBridge> _componentBridge;
+
+	/** The nodes of the world with each name, in no particular order */
+	std::unordered_map<StringId, std::vector<Node *>> _nodesByName;
+
+	std::mutex _dirtyMutex;
+	std::unordered_set<RenderableNode *> _dirtyRenderables;
+
+	void _addDirtyRenderable(RenderableNode &node);
+	void _removeDirtyRenderable(RenderableNode &node);
+
+	void _registerNode(Node &node);
+	void _unregisterNode(Node &node);
+	[[nodiscard]] const std::vector<Node *> &_findNodesByName(StringId name) const;
 
 	[[nodiscard]] const char *_termClassColor() const override;
 };
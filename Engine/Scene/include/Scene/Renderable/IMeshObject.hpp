@@ -17,7 +17,7 @@ class Material;
  * @see StaticMesh, DynamicMesh, SkinMesh, SkinMeshSource
  */
 class IMeshObject : public Core::Object, public IRenderable {
-	STONE_ABSTRACT_OBJECT(IMeshObject)
+	STONE_ABSTRACT_OBJECT(IMeshObject, Core::Object)
 
 public:
 	/**
@@ -5,6 +5,8 @@
 #include "Scene/RenderContext.hpp"
 #include "Utils/SigSlot.hpp"
 
+#include <atomic>
+
 namespace Stone::Scene {
 
 /**
@@ -40,7 +42,8 @@ class RendererObjectManager;
  */
 class IRenderable {
 public:
-	Signal<IRenderable *, bool> onDirty; /**< Signal that is emitted when the render element is marked as dirty */
+	/** Signal that is emitted when the render element is marked as dirty, from the thread marking it */
+	ConcurrentSignal<IRenderable *, bool> onDirty;
 
 	IRenderable() : _rendererObject(nullptr), _dirty(true) {
 	}
@@ -54,16 +57,17 @@ public:
 	 * @brief Check if the render element is dirty
 	 */
 	[[nodiscard]] bool isDirty() const {
-		return _dirty;
+		return _dirty.load(std::memory_order_acquire);
 	}
 
 	/**
 	 * @brief Mark the render element as dirty
 	 *
-	 * This function marks the render element as dirty, indicating that it needs to be updated.
+	 * This function marks the render element as dirty, indicating that it needs to be updated. It can be called from
+	 * any thread.
 	 */
 	void markDirty() {
-		_dirty = true;
+		_dirty.store(true, std::memory_order_release);
 		onDirty.broadcast(this, true);
 	}
 
@@ -100,12 +104,12 @@ protected:
 	 * This function marks the render element as cleaned up.
 	 */
 	void markUndirty() {
-		_dirty = false;
+		_dirty.store(false, std::memory_order_release);
 		onDirty.broadcast(this, false);
 	}
 
 	std::shared_ptr<IRendererObject> _rendererObject; /**< The renderer object associated with the render element */
-	bool _dirty;									  /**< Flag indicating whether the render element is dirty or not */
+	std::atomic<bool> _dirty; /**< Flag indicating whether the render element is dirty or not */
 };
 
 } // namespace Stone::Scene
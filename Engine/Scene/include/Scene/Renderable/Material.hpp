@@ -4,6 +4,7 @@
 
 #include "Core/Object.hpp"
 #include "Scene/Renderable/IRenderable.hpp"
+#include "Utils/StringId.hpp"
 
 #include <functional>
 #include <glm/vec3.hpp>
@@ -18,10 +19,11 @@ class Shader;
  * @brief The Material class represents a material used for rendering objects in the scene.
  *
  * It contains various parameters such as textures, vectors, and scalars that can be used
- * to configure the appearance of rendered objects.
+ * to configure the appearance of rendered objects. Parameters are keyed by interned names, the `StringId` overloads
+ * avoid hashing the name on each access.
  */
 class Material : public Core::Object, public IRenderable {
-	STONE_OBJECT(Material)
+	STONE_OBJECT(Material, Core::Object)
 
 public:
 	Material() = default;
@@ -45,6 +47,7 @@ public:
 	 * @param texture The texture to set.
 	 */
 	void setTextureParameter(const std::string &name, std::shared_ptr<Texture> texture);
+	void setTextureParameter(StringId name, std::shared_ptr<Texture> texture);
 
 	/**
 	 * @brief Get a texture parameter from the Material.
@@ -53,6 +56,7 @@ public:
 	 * @return The texture parameter as a shared pointer to Texture.
 	 */
 	[[nodiscard]] std::shared_ptr<Texture> getTextureParameter(const std::string &name) const;
+	[[nodiscard]] std::shared_ptr<Texture> getTextureParameter(StringId name) const;
 
 	/**
 	 * @brief Set a vector parameter for the Material.
@@ -61,6 +65,7 @@ public:
 	 * @param vector The vector to set.
 	 */
 	void setVectorParameter(const std::string &name, const glm::vec3 &vector);
+	void setVectorParameter(StringId name, const glm::vec3 &vector);
 
 	/**
 	 * @brief Get a vector parameter from the Material.
@@ -69,6 +74,7 @@ public:
 	 * @return The vector parameter as a glm::vec3.
 	 */
 	[[nodiscard]] glm::vec3 getVectorParameter(const std::string &name) const;
+	[[nodiscard]] glm::vec3 getVectorParameter(StringId name) const;
 
 	/**
 	 * @brief Set a scalar parameter for the Material.
@@ -77,6 +83,7 @@ public:
 	 * @param scalar The scalar value to set.
 	 */
 	void setScalarParameter(const std::string &name, float scalar);
+	void setScalarParameter(StringId name, float scalar);
 
 	/**
 	 * @brief Get a scalar parameter from the Material.
@@ -85,27 +92,28 @@ public:
 	 * @return The scalar parameter as a float.
 	 */
 	[[nodiscard]] float getScalarParameter(const std::string &name) const;
+	[[nodiscard]] float getScalarParameter(StringId name) const;
 
 	/**
 	 * @brief Iterate over all texture parameters in the Material.
 	 *
 	 * @param lambda The lambda function to call for each texture parameter.
 	 */
-	void forEachTextures(const std::function<void(std::pair<const std::string, std::shared_ptr<Texture>> &)> &lambda);
+	void forEachTextures(const std::function<void(std::pair<const StringId, std::shared_ptr<Texture>> &)> &lambda);
 
 	/**
 	 * @brief Iterate over all vector parameters in the Material.
 	 *
 	 * @param lambda The lambda function to call for each vector parameter.
 	 */
-	void forEachVectors(const std::function<void(std::pair<const std::string, glm::vec3> &)> &lambda);
+	void forEachVectors(const std::function<void(std::pair<const StringId, glm::vec3> &)> &lambda);
 
 	/**
 	 * @brief Iterate over all scalar parameters in the Material.
 	 *
 	 * @param lambda The lambda function to call for each scalar parameter.
 	 */
-	void forEachScalars(const std::function<void(std::pair<const std::string, float> &)> &lambda);
+	void forEachScalars(const std::function<void(std::pair<const StringId, float> &)> &lambda);
 
 	/**
 	 * @brief Set the vertex shader used by the Material.
@@ -136,9 +144,9 @@ public:
 	[[nodiscard]] std::shared_ptr<Shader> getFragmentShader() const;
 
 protected:
-	std::unordered_map<std::string, std::shared_ptr<Texture>> _textures; /**< Map of texture parameters. */
-	std::unordered_map<std::string, glm::vec3> _vectors;				 /**< Map of vector parameters. */
-	std::unordered_map<std::string, float> _scalars;					 /**< Map of scalar parameters. */
+	std::unordered_map<StringId, std::shared_ptr<Texture>> _textures; /**< Map of texture parameters. */
+	std::unordered_map<StringId, glm::vec3> _vectors;				  /**< Map of vector parameters. */
+	std::unordered_map<StringId, float> _scalars;					  /**< Map of scalar parameters. */
 
 	std::shared_ptr<Shader>
 		_vertexShader; /**< The vertex shader used by the material. nullptr means using the standard shader. */
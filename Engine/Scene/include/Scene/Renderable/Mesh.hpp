@@ -14,7 +14,9 @@
  */
 namespace Stone::Scene {
 
-class IMeshInterface : public IMeshObject {};
+class IMeshInterface : public IMeshObject {
+	STONE_ABSTRACT_OBJECT(IMeshInterface, IMeshObject)
+};
 
 /**
  * @brief Represents a dynamic mesh used for rendering in the scene.
@@ -23,7 +25,7 @@ class IMeshInterface : public IMeshObject {};
  * It provides functionality for managing vertices and indices of the mesh.
  */
 class DynamicMesh : public IMeshInterface {
-	STONE_OBJECT(DynamicMesh);
+	STONE_OBJECT(DynamicMesh, IMeshInterface);
 
 public:
 	DynamicMesh() = default;
@@ -74,7 +76,7 @@ protected:
  * It is generated from a dynamic mesh.
  */
 class StaticMesh : public IMeshInterface {
-	STONE_OBJECT(StaticMesh);
+	STONE_OBJECT(StaticMesh, IMeshInterface);
 
 public:
 	StaticMesh() = default;
@@ -4,6 +4,7 @@
 
 #include "Core/Object.hpp"
 #include "Scene/Renderable/IRenderable.hpp"
+#include "Utils/StringId.hpp"
 
 #include <unordered_map>
 
@@ -13,7 +14,7 @@ namespace Stone::Scene {
  * @brief The Shader class represents a shader used in rendering.
  */
 class Shader : public Core::Object, public IRenderable {
-	STONE_OBJECT(Shader);
+	STONE_OBJECT(Shader, Core::Object);
 
 public:
 	enum class ContentType {
@@ -69,6 +70,12 @@ public:
 	 * @return The location of the variable.
 	 */
 	[[nodiscard]] int getLocation(const std::string &name) const;
+	[[nodiscard]] int getLocation(StringId name) const;
+
+	/**
+	 * @brief Get the locations of every variable in the shader, by name.
+	 */
+	[[nodiscard]] const std::unordered_map<StringId, int> &getLocations() const;
 
 	/**
 	 * @brief Set the content of the shader paired with its type. See `Stone::Scene::Shader::ContentType` for more
@@ -86,14 +93,15 @@ public:
 	 * @param location The location of the variable.
 	 */
 	void setLocation(const std::string &name, int location);
+	void setLocation(StringId name, int location);
 
 private:
 	ContentType _contentType = ContentType::SourceCode; /** The type of the content. */
 	std::string _content = "#version 450 core\n";		/** The content of the shader. */
 	std::string _function = "main";						/** The function to call in the shader. */
 
-	std::unordered_map<std::string, int> _locations = {}; /** The binding locations of the variables in the shader. */
-	int _maxLocation = -1;								  /** The cached maximum value from the locations. */
+	std::unordered_map<StringId, int> _locations = {}; /** The binding locations of the variables in the shader. */
+	int _maxLocation = -1;							   /** The cached maximum value from the locations. */
 };
 
 } // namespace Stone::Scene
@@ -14,10 +14,12 @@
  */
 namespace Stone::Scene {
 
-class ISkinMeshInterface : public IMeshObject {};
+class ISkinMeshInterface : public IMeshObject {
+	STONE_ABSTRACT_OBJECT(ISkinMeshInterface, IMeshObject)
+};
 
 class DynamicSkinMesh : public ISkinMeshInterface {
-	STONE_OBJECT(DynamicSkinMesh);
+	STONE_OBJECT(DynamicSkinMesh, ISkinMeshInterface);
 
 public:
 	DynamicSkinMesh() = default;
@@ -62,7 +64,7 @@ protected:
 
 
 class StaticSkinMesh : public ISkinMeshInterface {
-	STONE_OBJECT(StaticSkinMesh);
+	STONE_OBJECT(StaticSkinMesh, ISkinMeshInterface);
 
 public:
 	StaticSkinMesh() = default;
@@ -28,7 +28,7 @@ enum class TextureWrap {
  * @brief The Texture class represents a texture used in rendering.
  */
 class Texture : public Core::Object, public IRenderable {
-	STONE_OBJECT(Texture);
+	STONE_OBJECT(Texture, Core::Object);
 
 public:
 	Texture() = default;
@@ -0,0 +1,237 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Core/Object.hpp"
+#include "Scene/Transform.hpp"
+#include "Utils/Json.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Stone::Core::Assets {
+class Bundle;
+} // namespace Stone::Core::Assets
+
+namespace Stone::Scene {
+
+class Node;
+
+/**
+ * @brief Binary save and load of a node hierarchy with the resources it uses.
+ *
+ * Every node type lists its fields in `Node::serializeFields`, with the same code for both directions: the archive
+ * writes the fields when saving, and assigns them when loading. Nodes are created back from their class name by
+ * `Node::createOfClass`, resources used by several nodes are written once, and references between nodes are kept when
+ * both nodes are in the archived hierarchy.
+ *
+ * Values are copied in the native byte order, and arrays of trivially copyable values like vertices in a single copy.
+ */
+class SceneArchive {
+public:
+	static constexpr uint32_t version = 2;
+	/** The deepest node hierarchy that can be written or read, so that nested nodes never overflow the stack */
+	static constexpr std::size_t maxDepth = 1024;
+
+	/** Write the fields of a resource, the class name of the resource is written by the archive. */
+	using ResourceWriter = std::function<void(SceneArchive &, Core::Object &)>;
+	/** Create a resource from the fields written by its ResourceWriter. */
+	using ResourceReader = std::function<std::shared_ptr<Core::Object>(SceneArchive &)>;
+
+	/**
+	 * @brief Append the archive of a node, its descendants and the resources they use to the output.
+	 *
+	 * Throws a `std::runtime_error` without writing anything if the hierarchy is deeper than `maxDepth`.
+	 */
+	static void write(const std::shared_ptr<Node> &root, std::vector<char> &out);
+
+	/**
+	 * @brief Create back the nodes and resources of an archive, throws if the data is not a valid archive.
+	 *
+	 * @param data The archive.
+	 * @param bundle The bundle loading the images of the textures, a new bundle is used when null.
+	 * @param resources If not null, receives every resource of the archive.
+	 * @return The root node of the archive.
+	 */
+	static std::shared_ptr<Node> read(std::string_view data,
+									  const std::shared_ptr<Core::Assets::Bundle> &bundle = nullptr,
+									  std::vector<std::shared_ptr<Core::Object>> *resources = nullptr);
+
+	static void writeFile(const std::string &path, const std::shared_ptr<Node> &root);
+	static std::shared_ptr<Node> readFile(const std::string &path,
+										  const std::shared_ptr<Core::Assets::Bundle> &bundle = nullptr,
+										  std::vector<std::shared_ptr<Core::Object>> *resources = nullptr);
+
+	/**
+	 * @brief Add the support of a resource class, given by its `getClassName()`.
+	 *
+	 * The meshes, materials, textures, shaders and images of the engine are already supported.
+	 */
+	static void registerResourceType(const std::string &className, ResourceWriter writer, ResourceReader reader);
+
+	/**
+	 * @brief Whether the archive is loading, and the fields are assigned instead of written.
+	 */
+	[[nodiscard]] bool isReading() const {
+		return _reading;
+	}
+
+	/**
+	 * @brief The bundle used to load resources, only set when reading.
+	 */
+	[[nodiscard]] const std::shared_ptr<Core::Assets::Bundle> &getBundle() const {
+		return _bundle;
+	}
+
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	void field(T &value) {
+		_bytes(&value, sizeof(T));
+	}
+
+	void field(std::string &value);
+	void field(Transform3D &transform);
+	void field(Json::Object &object);
+
+	template <typename T>
+	void field(std::vector<T> &values) {
+		uint32_t size = _size(values.size(), _isBulk<T>() ? sizeof(T) : 1);
+		if (_reading)
+			values.resize(size);
+		if constexpr (_isBulk<T>()) {
+			_bytes(values.data(), size * sizeof(T));
+		} else {
+			for (auto &value : values) {
+				field(value);
+			}
+		}
+	}
+
+	/**
+	 * @brief A vector of values made of several fields, given to the archive by a function called with each element.
+	 */
+	template <typename T, typename Function>
+	void field(std::vector<T> &values, const Function &elementFields) {
+		uint32_t size = _size(values.size(), 1);
+		if (_reading)
+			values.resize(size);
+		for (auto &value : values) {
+			elementFields(value);
+		}
+	}
+
+	/**
+	 * @brief A shared resource, written once whatever the number of references to it.
+	 */
+	template <typename T>
+	void resource(std::shared_ptr<T> &resource) {
+		if (!_reading) {
+			uint32_t index = _resourceIndex(resource);
+			field(index);
+			return;
+		}
+		uint32_t index = 0;
+		field(index);
+		std::shared_ptr<Core::Object> object = _loadResource(index);
+		resource = std::dynamic_pointer_cast<T>(object);
+		if (object != nullptr && resource == nullptr)
+			_error("Resource " + std::to_string(index) + " is a " + object->getClassName());
+	}
+
+	/**
+	 * @brief A reference to another node, kept when the node is also in the archive and null otherwise.
+	 *
+	 * The reference is assigned when loading once every node of the archive is created.
+	 */
+	template <typename T>
+	void node(std::weak_ptr<T> &node) {
+		if (!_reading) {
+			uint32_t index = _nodeIndex(node.lock().get());
+			field(index);
+			return;
+		}
+		uint32_t index = 0;
+		field(index);
+		node.reset();
+		if (index != 0) {
+			_nodeReferences.emplace_back(index, [&node](const std::shared_ptr<Node> &target) {
+				node = std::dynamic_pointer_cast<T>(target);
+			});
+		}
+	}
+
+private:
+	friend class ScenePatch;
+
+	struct ResourceRecord {
+		std::string_view className;
+		std::size_t offset;
+		std::size_t size;
+		bool loading;
+	};
+
+	explicit SceneArchive(bool reading);
+
+	bool _reading;
+
+	std::vector<char> *_out = nullptr;
+	/** The index of every archived node, 0 being the null reference */
+	std::unordered_map<const Node *, uint32_t> _nodeIndices;
+	std::unordered_map<const Core::Object *, uint32_t> _resourceIndices;
+	std::vector<std::shared_ptr<Core::Object>> _resources;
+
+	std::string_view _data;
+	std::size_t _pos = 0;
+	std::shared_ptr<Core::Assets::Bundle> _bundle;
+	std::vector<ResourceRecord> _resourceRecords;
+	std::vector<std::shared_ptr<Node>> _nodes;
+	std::vector<std::pair<uint32_t, std::function<void(const std::shared_ptr<Node> &)>>> _nodeReferences;
+	/** Kept between nodes, to not allocate the class name of each node */
+	std::string _className;
+
+	/** Set by ScenePatch, nodes are then referenced by stable ID and resources are matched by content */
+	bool _patch = false;
+	std::vector<uint64_t> _nodeIds;
+	std::unordered_map<uint64_t, uint32_t> _nodeIdIndices;
+	std::unordered_map<std::string, uint32_t> _contentIndices;
+
+	/** Transforms are written without their cached matrix */
+	template <typename T>
+	static constexpr bool _isBulk() {
+		return std::is_trivially_copyable_v<T> && !std::is_same_v<T, Transform3D>;
+	}
+
+	void _bytes(void *data, std::size_t size);
+	void _write(const void *data, std::size_t size);
+	void _writeString(std::string_view value);
+	/** Write the number of bytes written since the 32 bits size at the given position */
+	void _patchSize(std::size_t position);
+	/** Read or write the size of a vector, checking that the remaining data can hold its elements */
+	uint32_t _size(std::size_t size, std::size_t elementSize);
+	/** Read a string, as a view in the data */
+	std::string_view _view();
+
+	void _indexNodes(const Node &node, std::size_t depth);
+	void _writeNode(Node &node);
+	void _writeResources();
+	std::shared_ptr<Node> _readNode(Node *parent, std::size_t depth);
+	void _readResourceTable(std::size_t offset);
+	/** Assign the fields of a node from fields written alone, without the archive header */
+	void _readFields(Node &node, std::string_view fields);
+
+	uint32_t _nodeIndex(const Node *node);
+	uint32_t _resourceIndex(const std::shared_ptr<Core::Object> &resource);
+	/** The index of the first resource written with the same class and fields */
+	uint32_t _contentIndex(const std::shared_ptr<Core::Object> &resource);
+	std::shared_ptr<Core::Object> _loadResource(uint32_t index);
+
+	[[noreturn]] void _error(const std::string &message) const;
+};
+
+} // namespace Stone::Scene
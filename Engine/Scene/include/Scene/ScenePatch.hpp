@@ -0,0 +1,83 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Core/Object.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Stone::Scene {
+
+class Node;
+
+/**
+ * @brief The changes between two states of a scene, to apply them to a live scene without rebuilding it.
+ *
+ * Nodes are matched by their stable ID, and the roots of both states are matched whatever their ID. A node is
+ * updated when its name or the fields given to `Node::serializeFields` changed, like its transform, its metadatas or
+ * its material. Resources are compared by content: a reloaded mesh or material equal to the one of the live scene is
+ * not replaced, so that the renderer objects of unchanged nodes and resources are kept.
+ *
+ * @example ScenePatch::diff(world, SceneArchive::readFile(path)).apply(world);
+ */
+class ScenePatch {
+public:
+	enum class OperationType : uint8_t {
+		Remove,		 /**< The node is not in the new state */
+		Add,		 /**< The node is created with its class, name and fields */
+		Update,		 /**< The name or the fields of the node changed */
+		SetChildren, /**< The children of the node changed, or their order */
+	};
+
+	struct Operation {
+		OperationType type;
+		uint64_t nodeId;
+		std::string className;			/**< The class of an added node */
+		std::string name;				/**< The name of an added or updated node */
+		std::vector<char> fields;		/**< The fields of an added or updated node */
+		std::vector<uint64_t> children; /**< The stable IDs of the children, in order */
+	};
+
+	ScenePatch() = default;
+
+	/**
+	 * @brief Compute the changes from a state of a scene to another, throws if a stable ID is used twice in a state.
+	 *
+	 * The patch keeps the resources of the new state used by the changed nodes.
+	 */
+	static ScenePatch diff(const std::shared_ptr<Node> &from, const std::shared_ptr<Node> &to);
+
+	/**
+	 * @brief Apply the changes to the scene the patch was computed from, or to a scene with the same nodes.
+	 *
+	 * Updated renderable nodes are marked dirty, the others are not touched. Throws if a node of the patch is not in
+	 * the scene.
+	 *
+	 * @param root The root of the scene, with the stable ID of the `from` root.
+	 */
+	void apply(const std::shared_ptr<Node> &root) const;
+
+	/**
+	 * @brief Whether both states are the same.
+	 */
+	[[nodiscard]] bool isEmpty() const {
+		return _operations.empty();
+	}
+
+	[[nodiscard]] const std::vector<Operation> &getOperations() const {
+		return _operations;
+	}
+
+private:
+	uint64_t _rootId = 0;
+	/** The nodes referenced in the fields, by index - 1 */
+	std::vector<uint64_t> _nodeIds;
+	/** The resources referenced in the fields, by index - 1 */
+	std::vector<std::shared_ptr<Core::Object>> _resources;
+	std::vector<Operation> _operations;
+};
+
+} // namespace Stone::Scene
@@ -1,8 +1,10 @@
 // Copyright 2024 Stone-Engine
 
 #include "Core/Assets/Bundle.hpp"
+#include "Core/Memory/Pool.hpp"
 #include "Core/Exceptions.hpp"
 #include "Core/Image/ImageSource.hpp"
+#include "Logging/Logger.hpp"
 #include "Scene/Assets/AssetResource.hpp"
 #include "Scene/Node/MeshNode.hpp"
 #include "Scene/Node/Node.hpp"
@@ -90,21 +92,21 @@ void emplace_indices(std::vector<uint32_t> &indices, const aiMesh *mesh) {
 }
 
 void loadMesh(AssetResource &assetResource, const aiMesh *mesh) {
-	std::shared_ptr<DynamicMesh> newMesh = std::make_shared<DynamicMesh>();
+	std::shared_ptr<DynamicMesh> newMesh = Core::Memory::makePooled<DynamicMesh>();
 
 	newMesh->withElementsRef([mesh](auto vertices, auto indices) {
 		emplace_vertices(vertices, mesh);
 		emplace_indices(indices, mesh);
 	});
 
-	std::shared_ptr<StaticMesh> newStaticMesh = std::make_shared<StaticMesh>();
+	std::shared_ptr<StaticMesh> newStaticMesh = Core::Memory::makePooled<StaticMesh>();
 	newStaticMesh->setSourceMesh(newMesh);
 
 	assetResource.getMeshesRef().push_back(newStaticMesh);
 }
 
 void loadSkinMesh(AssetResource &assetResource, const aiMesh *mesh) {
-	std::shared_ptr<DynamicSkinMesh> newMesh = std::make_shared<DynamicSkinMesh>();
+	std::shared_ptr<DynamicSkinMesh> newMesh = Core::Memory::makePooled<DynamicSkinMesh>();
 
 	newMesh->withElementsRef([mesh](auto vertices, auto indices) {
 		emplace_vertices(vertices, mesh);
@@ -113,7 +115,7 @@ void loadSkinMesh(AssetResource &assetResource, const aiMesh *mesh) {
 
 	// TODO: Load bones and weights. REQUIREMENT: Skeleton must be loaded first.
 
-	std::shared_ptr<StaticSkinMesh> newStaticMesh = std::make_shared<StaticSkinMesh>();
+	std::shared_ptr<StaticSkinMesh> newStaticMesh = Core::Memory::makePooled<StaticSkinMesh>();
 	newStaticMesh->setSourceMesh(newMesh);
 
 	assetResource.getMeshesRef().push_back(newStaticMesh);
@@ -133,7 +135,7 @@ void loadMeshes(AssetResource &assetResource, const aiScene *scene) {
 void loadTexture(AssetResource &assetResource, const aiTexture *texture) {
 	auto image = assetResource.getBundle()->loadResource<Core::Image::ImageSource>(texture->mFilename.C_Str());
 
-	std::shared_ptr<Texture> newTexture = std::make_shared<Texture>();
+	std::shared_ptr<Texture> newTexture = Core::Memory::makePooled<Texture>();
 	newTexture->setImage(image);
 
 	assetResource.getTexturesRef().push_back(newTexture);
@@ -189,14 +191,14 @@ void addMaterialTexture(AssetResource &assetResource, const aiMaterial *material
 	} else {
 		std::shared_ptr<Core::Image::ImageSource> textureSource =
 			assetResource.getBundle()->loadResource<Core::Image::ImageSource>(texturePathStr);
-		std::shared_ptr<Texture> texture = std::make_shared<Texture>();
+		std::shared_ptr<Texture> texture = Core::Memory::makePooled<Texture>();
 		texture->setImage(textureSource);
 		newMaterial->setTextureParameter(name, texture);
 	}
 }
 
 void loadMaterial(AssetResource &assetResource, const aiMaterial *material) {
-	std::shared_ptr<Material> newMaterial = std::make_shared<Material>();
+	std::shared_ptr<Material> newMaterial = Core::Memory::makePooled<Material>();
 
 	addMaterialColor(material, newMaterial, AI_MATKEY_COLOR_DIFFUSE, "diffuse");
 	addMaterialColor(material, newMaterial, AI_MATKEY_COLOR_SPECULAR, "specular");
@@ -380,18 +382,11 @@ void AssetResource::loadFromAssimp() {
 
 	_rootNode = std::make_shared<PivotNode>(scene->mRootNode->mName.C_Str());
 
-	std::cout << "scene ";
-	std::cout << "validated: " << (scene->mFlags & AI_SCENE_FLAGS_VALIDATED) << " | ";
-	std::cout << "incomplete: " << (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) << " | ";
-	std::cout << "mNumMeshes " << scene->mNumMeshes << " | ";
-	std::cout << "mNumMaterials " << scene->mNumMaterials << " | ";
-	std::cout << "mNumAnimations " << scene->mNumAnimations << " | ";
-	std::cout << "mNumTextures " << scene->mNumTextures << " | ";
-	std::cout << "mNumLights " << scene->mNumLights << " | ";
-	std::cout << "mNumCameras " << scene->mNumCameras << " | ";
-	std::cout << "mNumSkeletons " << scene->mNumSkeletons << " | ";
-	std::cout << "mMetaData " << scene->mMetaData << " | ";
-	std::cout << "mName" << scene->mName.C_Str() << " | " << std::endl;
+	STONE_LOG_DEBUG("Scene", "scene {} | validated: {} | meshes: {} | materials: {} | animations: {} | textures: {}",
+					scene->mName.C_Str(), (scene->mFlags & AI_SCENE_FLAGS_VALIDATED) != 0, scene->mNumMeshes,
+					scene->mNumMaterials, scene->mNumAnimations, scene->mNumTextures);
+	STONE_LOG_DEBUG("Scene", "scene {} | lights: {} | cameras: {} | skeletons: {} | metadata: {}", scene->mName.C_Str(),
+					scene->mNumLights, scene->mNumCameras, scene->mNumSkeletons, scene->mMetaData);
 
 	loadMetadata(scene->mMetaData, _metadatas);
 
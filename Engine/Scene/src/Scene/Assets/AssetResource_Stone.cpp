@@ -2,9 +2,33 @@
 
 #include "Scene/Assets/AssetResource.hpp"
 
+#include "Scene/Node/PivotNode.hpp"
+#include "Scene/Renderable/IMeshObject.hpp"
+#include "Scene/Renderable/Material.hpp"
+#include "Scene/Renderable/Texture.hpp"
+#include "Scene/SceneArchive.hpp"
+
 namespace Stone::Scene {
 
 void AssetResource::loadFromStone() {
+	std::vector<std::shared_ptr<Core::Object>> resources;
+	std::shared_ptr<Node> root = SceneArchive::readFile(getFullPath(), getBundle(), &resources);
+
+	_rootNode = std::dynamic_pointer_cast<PivotNode>(root);
+	if (_rootNode == nullptr) {
+		_rootNode = std::make_shared<PivotNode>(root->getName());
+		_rootNode->addChild(root);
+	}
+
+	for (const auto &resource : resources) {
+		if (auto mesh = std::dynamic_pointer_cast<IMeshObject>(resource)) {
+			_meshes.push_back(mesh);
+		} else if (auto texture = std::dynamic_pointer_cast<Texture>(resource)) {
+			_textures.push_back(texture);
+		} else if (auto material = std::dynamic_pointer_cast<Material>(resource)) {
+			_materials.push_back(material);
+		}
+	}
 }
 
 } // namespace Stone::Scene
@@ -0,0 +1,135 @@
+// Copyright 2024 Stone-Engine
+
+#include "Scene/Component/ComponentBridge.hpp"
+
+#include "Scene/Component/Components.hpp"
+#include "Scene/Node/LightNode.hpp"
+#include "Scene/Node/MeshNode.hpp"
+#include "Scene/Renderable/Mesh.hpp"
+#include "Utils/SmallStack.hpp"
+
+#include <limits>
+
+namespace Stone::Scene {
+
+Box transformBox(const Box &box, const glm::mat4 &matrix) {
+	glm::vec3 center = glm::vec3(matrix * glm::vec4((box.min + box.max) * 0.5f, 1.0f));
+	glm::vec3 extent = (box.max - box.min) * 0.5f;
+	glm::vec3 worldExtent(0.0f);
+	for (int column = 0; column < 3; ++column) {
+		worldExtent += glm::abs(glm::vec3(matrix[column])) * extent[column];
+	}
+	return {center - worldExtent, center + worldExtent};
+}
+
+namespace {
+
+const DynamicMesh *findVertexSource(const IMeshInterface &mesh) {
+	if (const auto *dynamicMesh = dynamic_cast<const DynamicMesh *>(&mesh))
+		return dynamicMesh;
+	if (const auto *staticMesh = dynamic_cast<const StaticMesh *>(&mesh))
+		return staticMesh->getSourceMesh().get();
+	return nullptr;
+}
+
+void updateLocalBox(BoundsComponent &bounds, const IMeshInterface &mesh) {
+	const DynamicMesh *source = findVertexSource(mesh);
+	if (source == nullptr || source->getVertices().empty()) {
+		bounds.localBox = Box();
+		return;
+	}
+	glm::vec3 min(std::numeric_limits<float>::max());
+	glm::vec3 max(std::numeric_limits<float>::lowest());
+	for (const Vertex &vertex : source->getVertices()) {
+		min = glm::min(min, vertex.position);
+		max = glm::max(max, vertex.position);
+	}
+	bounds.localBox = Box(min, max);
+}
+
+struct SyncFrame {
+	Node *node = nullptr;
+	glm::mat4 parentMatrix = glm::mat4(1.0f);
+};
+
+} // namespace
+
+ComponentBridge::ComponentBridge(std::shared_ptr<ComponentStore> store) : _store(std::move(store)) {
+}
+
+void ComponentBridge::sync(Node &root) {
+	ComponentStore &store = *_store;
+	std::unordered_map<const Node *, Entity> previousEntities;
+	previousEntities.swap(_entities);
+	_entities.reserve(previousEntities.size());
+
+	Utils::SmallStack<SyncFrame, 32> stack;
+	for (const auto &child : root.getChildren()) {
+		stack.push({child.get(), glm::mat4(1.0f)});
+	}
+	while (!stack.empty()) {
+		SyncFrame frame = stack.top();
+		stack.pop();
+
+		glm::mat4 localMatrix(1.0f);
+		frame.node->transformRelativeMatrix(localMatrix);
+		glm::mat4 worldMatrix = frame.parentMatrix * localMatrix;
+		for (const auto &child : frame.node->getChildren()) {
+			stack.push({child.get(), worldMatrix});
+		}
+
+		// Plain nodes only group their children, they have no data to mirror
+		Node *node = frame.node;
+		if (node->getClassHashCode() == Node::StaticHashCode())
+			continue;
+
+		Entity entity;
+		auto previous = previousEntities.find(node);
+		if (previous != previousEntities.end()) {
+			entity = previous->second;
+			previousEntities.erase(previous);
+		} else {
+			entity = store.createEntity();
+			store.add<NodeComponent>(entity, node);
+		}
+		_entities.emplace(node, entity);
+		store.add<TransformComponent>(entity, worldMatrix);
+
+		auto *meshNode = nodeCast<MeshNode>(*node);
+		if (meshNode != nullptr && meshNode->getMesh() != nullptr) {
+			store.add<MeshComponent>(entity, meshNode->getMesh(), meshNode->getMaterial());
+			auto *bounds = store.get<BoundsComponent>(entity);
+			if (bounds == nullptr)
+				bounds = &store.add<BoundsComponent>(entity);
+			const IMeshInterface &mesh = *meshNode->getMesh();
+			if (bounds->boundMesh != &mesh || mesh.isDirty()) {
+				updateLocalBox(*bounds, mesh);
+				bounds->boundMesh = &mesh;
+			}
+			bounds->worldBox = transformBox(bounds->localBox, worldMatrix);
+		} else {
+			store.remove<MeshComponent>(entity);
+			store.remove<BoundsComponent>(entity);
+		}
+
+		if (auto *light = nodeCast<LightNode>(*node))
+			store.add<LightComponent>(entity, light->getColor(), light->getIntensity(), light->isCastingShadow());
+		else
+			store.remove<LightComponent>(entity);
+	}
+
+	for (const auto &[node, entity] : previousEntities) {
+		store.destroyEntity(entity);
+	}
+}
+
+Entity ComponentBridge::getEntity(const Node &node) const {
+	auto it = _entities.find(&node);
+	return it == _entities.end() ? nullEntity : it->second;
+}
+
+ComponentStore &ComponentBridge::getStore() const {
+	return *_store;
+}
+
+} // namespace Stone::Scene
@@ -0,0 +1,48 @@
+// Copyright 2024 Stone-Engine
+
+#include "Scene/Component/ComponentStore.hpp"
+
+#include <atomic>
+
+namespace Stone::Scene {
+
+std::size_t ComponentStore::_nextTypeId() {
+	static std::atomic<std::size_t> nextTypeId = 0;
+	return nextTypeId++;
+}
+
+Entity ComponentStore::createEntity() {
+	Entity entity;
+	if (_freeEntities.empty()) {
+		entity = static_cast<Entity>(_alive.size());
+		_alive.push_back(true);
+	} else {
+		entity = _freeEntities.back();
+		_freeEntities.pop_back();
+		_alive[entity] = true;
+	}
+	++_entityCount;
+	return entity;
+}
+
+void ComponentStore::destroyEntity(Entity entity) {
+	if (!isAlive(entity))
+		return;
+	for (auto &array : _arrays) {
+		if (array != nullptr)
+			array->remove(entity);
+	}
+	_alive[entity] = false;
+	_freeEntities.push_back(entity);
+	--_entityCount;
+}
+
+bool ComponentStore::isAlive(Entity entity) const {
+	return entity < _alive.size() && _alive[entity];
+}
+
+std::size_t ComponentStore::getEntityCount() const {
+	return _entityCount;
+}
+
+} // namespace Stone::Scene
@@ -2,6 +2,8 @@
 
 #include "Scene/Node/CameraNode.hpp"
 
+#include "Scene/SceneArchive.hpp"
+
 namespace Stone::Scene {
 
 STONE_ABSTRACT_NODE_IMPLEMENTATION(CameraNode)
@@ -18,6 +20,12 @@ std::ostream &CameraNode::writeToStream(std::ostream &stream, bool closing_brace
 	return stream;
 }
 
+void CameraNode::serializeFields(SceneArchive &archive) {
+	PivotNode::serializeFields(archive);
+	archive.field(_near);
+	archive.field(_far);
+}
+
 float CameraNode::getNear() const {
 	return _near;
 }
@@ -53,6 +61,12 @@ std::ostream &PerspectiveCameraNode::writeToStream(std::ostream &stream, bool cl
 	return stream;
 }
 
+void PerspectiveCameraNode::serializeFields(SceneArchive &archive) {
+	CameraNode::serializeFields(archive);
+	archive.field(_fov);
+	archive.field(_aspect);
+}
+
 glm::mat4 PerspectiveCameraNode::getProjectionMatrix() const {
 	return glm::perspective(_fov, _aspect, _near, _far);
 }
@@ -86,6 +100,11 @@ std::ostream &OrthographicCameraNode::writeToStream(std::ostream &stream, bool c
 	return stream;
 }
 
+void OrthographicCameraNode::serializeFields(SceneArchive &archive) {
+	CameraNode::serializeFields(archive);
+	archive.field(_size);
+}
+
 glm::mat4 OrthographicCameraNode::getProjectionMatrix() const {
 	return glm::ortho(-_size.x / 2, _size.x / 2, -_size.y / 2, _size.y / 2, _near, _far);
 }
@@ -3,6 +3,7 @@
 #include "Scene/Node/InstancedMeshNode.hpp"
 
 #include "Scene/RendererObjectManager.hpp"
+#include "Scene/SceneArchive.hpp"
 
 namespace Stone::Scene {
 
@@ -19,6 +20,11 @@ std::ostream &InstancedMeshNode::writeToStream(std::ostream &stream, bool closin
 	return stream;
 }
 
+void InstancedMeshNode::serializeFields(SceneArchive &archive) {
+	MeshNode::serializeFields(archive);
+	archive.field(_instancesTransforms);
+}
+
 void InstancedMeshNode::addInstance(const Transform3D &transform) {
 	_instancesTransforms.push_back(transform);
 	markDirty();
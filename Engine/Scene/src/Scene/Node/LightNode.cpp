@@ -2,6 +2,8 @@
 
 #include "Scene/Node/LightNode.hpp"
 
+#include "Scene/SceneArchive.hpp"
+
 namespace Stone::Scene {
 
 STONE_ABSTRACT_NODE_IMPLEMENTATION(LightNode);
@@ -18,6 +20,12 @@ std::ostream &LightNode::writeToStream(std::ostream &stream, bool closing_bracer
 	return stream;
 }
 
+void LightNode::serializeFields(SceneArchive &archive) {
+	PivotNode::serializeFields(archive);
+	archive.field(_intensity);
+	archive.field(_color);
+}
+
 bool LightNode::isCastingShadow() const {
 	return false;
 }
@@ -81,6 +89,12 @@ std::ostream &PointLightNode::writeToStream(std::ostream &stream, bool closing_b
 	return stream;
 }
 
+void PointLightNode::serializeFields(SceneArchive &archive) {
+	LightNode::serializeFields(archive);
+	archive.field(_attenuation);
+	archive.field(_specular);
+}
+
 STONE_ABSTRACT_NODE_IMPLEMENTATION(CastingLightNode);
 
 CastingLightNode::CastingLightNode(const std::string &name)
@@ -99,6 +113,14 @@ std::ostream &CastingLightNode::writeToStream(std::ostream &stream, bool closing
 	return stream;
 }
 
+void CastingLightNode::serializeFields(SceneArchive &archive) {
+	LightNode::serializeFields(archive);
+	archive.field(_castShadow);
+	archive.field(_shadowClipNear);
+	archive.field(_shadowClipFar);
+	archive.field(_shadowMapSize);
+}
+
 bool CastingLightNode::isCastingShadow() const {
 	return _castShadow;
 }
@@ -157,6 +179,14 @@ std::ostream &DirectionalLightNode::writeToStream(std::ostream &stream, bool clo
 	return stream;
 }
 
+void DirectionalLightNode::serializeFields(SceneArchive &archive) {
+	CastingLightNode::serializeFields(archive);
+	archive.field(_infinite);
+	archive.field(_shadowOrthoSize);
+	if (archive.isReading())
+		_updateProjectionMatrix();
+}
+
 bool DirectionalLightNode::isInfinite() const {
 	return _infinite;
 }
@@ -195,6 +225,14 @@ std::ostream &SpotLightNode::writeToStream(std::ostream &stream, bool closing_br
 	return stream;
 }
 
+void SpotLightNode::serializeFields(SceneArchive &archive) {
+	CastingLightNode::serializeFields(archive);
+	archive.field(_coneAngle);
+	archive.field(_coneAttenuation);
+	if (archive.isReading())
+		_updateProjectionMatrix();
+}
+
 float SpotLightNode::getConeAngle() const {
 	return _coneAngle;
 }
@@ -5,6 +5,7 @@
 #include "Scene/Renderable/Material.hpp"
 #include "Scene/Renderable/Mesh.hpp"
 #include "Scene/RendererObjectManager.hpp"
+#include "Scene/SceneArchive.hpp"
 
 namespace Stone::Scene {
 
@@ -22,6 +23,12 @@ std::ostream &MeshNode::writeToStream(std::ostream &stream, bool closing_bracer)
 	return stream;
 }
 
+void MeshNode::serializeFields(SceneArchive &archive) {
+	RenderableNode::serializeFields(archive);
+	archive.resource(_mesh);
+	archive.resource(_material);
+}
+
 std::shared_ptr<IMeshInterface> MeshNode::getMesh() const {
 	return _mesh;
 }
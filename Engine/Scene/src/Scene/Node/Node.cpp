@@ -2,18 +2,110 @@
 
 #include "Scene/Node/Node.hpp"
 
+#include "Scene/Node/WorldNode.hpp"
+#include "Scene/SceneArchive.hpp"
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <random>
+#include <utility>
 
 namespace Stone::Scene {
 
+namespace {
+
+/** Stable IDs start from a random value, so that the nodes created by different runs do not share an ID */
+uint64_t nextStableId() {
+	static std::atomic<uint64_t> id = [] {
+		std::random_device device;
+		return (static_cast<uint64_t>(device()) << 32) | device();
+	}();
+	uint64_t stableId = ++id;
+	return stableId == 0 ? ++id : stableId;
+}
+
+bool isDescendant(const Node *node, const Node *ancestor) {
+	for (auto parent = node->getParent(); parent != nullptr; parent = parent->getParent()) {
+		if (parent.get() == ancestor)
+			return true;
+	}
+	return false;
+}
+
+std::size_t depthOf(const Node *node) {
+	std::size_t depth = 0;
+	for (auto parent = node->getParent(); parent != nullptr; parent = parent->getParent())
+		++depth;
+	return depth;
+}
+
+/** Whether a node comes before another in a top-down traversal of their hierarchy */
+bool isBefore(Node *node, Node *other) {
+	std::size_t nodeDepth = depthOf(node);
+	std::size_t otherDepth = depthOf(other);
+	std::shared_ptr<Node> nodeAncestor = std::static_pointer_cast<Node>(node->shared_from_this());
+	std::shared_ptr<Node> otherAncestor = std::static_pointer_cast<Node>(other->shared_from_this());
+	for (; nodeDepth > otherDepth; --nodeDepth)
+		nodeAncestor = nodeAncestor->getParent();
+	for (; otherDepth > nodeDepth; --otherDepth)
+		otherAncestor = otherAncestor->getParent();
+
+	// An ancestor comes before its descendants
+	if (nodeAncestor == otherAncestor)
+		return nodeAncestor.get() == node;
+
+	std::shared_ptr<Node> parent;
+	while ((parent = nodeAncestor->getParent()) != otherAncestor->getParent()) {
+		nodeAncestor = parent;
+		otherAncestor = otherAncestor->getParent();
+	}
+	if (parent == nullptr)
+		return false;
+	for (const auto &child : parent->getChildren()) {
+		if (child == nodeAncestor)
+			return true;
+		if (child == otherAncestor)
+			return false;
+	}
+	return false;
+}
+
+std::shared_ptr<Node> searchDescendant(const Node &node, StringId name) {
+	for (const auto &child : node.getChildren()) {
+		if (child->getNameId() == name)
+			return child;
+		if (auto descendant = searchDescendant(*child, name))
+			return descendant;
+	}
+	return nullptr;
+}
+
+} // namespace
+
 STONE_NODE_IMPLEMENTATION(Node)
 
-Node::Node(const std::string &name) : Object(), _name(name), _children(), _parent(), _world() {
+Node::Node(const std::string &name)
+	: Object(), _name(name), _children(), _parent(), _world(), _stableId(nextStableId()) {
 	// LOG: Warning: Node name cannot contain '/'
 	assert(name.find('/') == std::string::npos);
 }
 
+Node::Node(const Node &other)
+	: Object(other), _name(other._name), _children(), _parent(), _world(), _metadatas(other._metadatas),
+	  _stableId(nextStableId()) {
+}
+
+std::shared_ptr<Node> Node::createOfClass(std::string_view className, const std::string &name) {
+	const Core::TypeInfo *type = Core::TypeRegistry::instance().find(className);
+	if (type == nullptr || !type->isA(Node::StaticTypeInfo()))
+		return nullptr;
+	auto node = std::static_pointer_cast<Node>(type->create());
+	if (node != nullptr)
+		node->setName(name);
+	return node;
+}
+
 std::ostream &Node::writeToStream(std::ostream &stream, bool closing_bracer) const {
 	Object::writeToStream(stream, false);
 	stream << ",name:\"" << _name << "\"";
@@ -23,6 +115,10 @@ std::ostream &Node::writeToStream(std::ostream &stream, bool closing_bracer) con
 	return stream;
 }
 
+void Node::serializeFields(SceneArchive &archive) {
+	archive.field(_metadatas);
+}
+
 void Node::update(float deltaTime) {
 	for (auto &child : _children) {
 		child->update(deltaTime);
@@ -37,10 +133,32 @@ void Node::render(RenderContext &context) {
 }
 
 void Node::setName(const std::string &name) {
-	_name = name;
+	setName(StringId(name));
+}
+
+void Node::setName(StringId name) {
+	if (name == _name)
+		return;
+
+	auto world = getWorld();
+	bool indexed = world != nullptr && world.get() != this;
+	if (indexed)
+		world->_unregisterNode(*this);
+
+	StringId previousName = std::exchange(_name, name);
+	if (auto parent = getParent()) {
+		parent->_indexChildName(previousName);
+		parent->_indexChildName(_name);
+	}
+	if (indexed)
+		world->_registerNode(*this);
 }
 
 const std::string &Node::getName() const {
+	return _name.str();
+}
+
+StringId Node::getNameId() const {
 	return _name;
 }
 
@@ -51,21 +169,29 @@ std::string Node::getGlobalName() const {
 	return "/" + getName();
 }
 
+uint64_t Node::getStableId() const {
+	return _stableId;
+}
+
+void Node::setStableId(uint64_t stableId) {
+	_stableId = stableId;
+}
+
 void Node::addChild(const std::shared_ptr<Node> &child) {
 	// LOG: Error: Cannot add a parent as a child
 	assert(!child->isAncestorOf(std::static_pointer_cast<Node>(shared_from_this())));
 	child->_parent = std::static_pointer_cast<Node>(shared_from_this());
-	child->_world = _world;
 	_children.push_back(child);
+	_childrenByName.emplace(child->_name, child.get());
+	auto world = _world.lock();
+	child->_setWorld(world);
 }
 
 void Node::removeChild(const std::shared_ptr<Node> &child) {
-	auto it = std::find(_children.begin(), _children.end(), child);
-	if (it != _children.end()) {
-		(*it)->_parent.reset();
-		(*it)->_world.reset();
-		_children.erase(it);
-	}
+	if (!_eraseChild(*child))
+		return;
+	child->_parent.reset();
+	child->_setWorld(nullptr);
 }
 
 void Node::removeFromParent() {
@@ -83,70 +209,62 @@ bool Node::hasParent() const {
 }
 
 bool Node::isAncestorOf(const std::shared_ptr<Node> &node) const {
-	if (auto parent = node->getParent()) {
-		if (parent.get() == this) {
-			return true;
-		}
-		return isAncestorOf(parent);
-	}
-	return false;
+	return isDescendant(node.get(), this);
 }
 
 bool Node::isDescendantOf(const std::shared_ptr<Node> &node) const {
-	if (auto parent = getParent()) {
-		if (parent == node) {
-			return true;
-		}
-		return parent->isDescendantOf(node);
-	}
-	return false;
+	return isDescendant(this, node.get());
 }
 
 const std::vector<std::shared_ptr<Node>> &Node::getChildren() const {
 	return _children;
 }
 
-std::shared_ptr<Node> Node::getChild(const std::string &name) const {
-	for (auto &child : _children) {
-		if (child->getName() == name) {
-			return child;
-		}
-	}
-	return nullptr;
+std::shared_ptr<Node> Node::getChild(std::string_view name) const {
+	std::optional<StringId> id = StringId::find(name);
+	return id ? getChild(*id) : nullptr;
 }
 
-std::shared_ptr<Node> Node::getChildByPath(const std::string &path) const {
-	if (path.size() <= 1) {
-		return getChild(path);
-	}
-
-	if (path[0] == '*' && path[1] == '/') {
-		std::string childName = path.substr(2);
-		for (auto &child : _children) {
-			if (child->getName() == childName) {
-				return child;
-			}
-			std::shared_ptr<Node> grandChild = child->getChildByPath(path);
-			if (grandChild) {
-				return grandChild;
-			}
-		}
+std::shared_ptr<Node> Node::getChild(StringId name) const {
+	auto it = _childrenByName.find(name);
+	if (it == _childrenByName.end())
 		return nullptr;
-	}
-
-	auto firstSlash = path.find('/');
+	return std::static_pointer_cast<Node>(it->second->shared_from_this());
+}
 
-	if (firstSlash != std::string::npos) {
-		std::string childName = path.substr(0, firstSlash);
-		auto childNode = getChild(childName);
-		if (!childNode) {
+std::shared_ptr<Node> Node::getChildByPath(std::string_view path) const {
+	const Node *node = this;
+	while (!path.starts_with("*/")) {
+		auto slash = path.find('/');
+		// A name that was never interned is the name of no node
+		std::optional<StringId> name = StringId::find(path.substr(0, slash));
+		if (!name)
 			return nullptr;
-		}
-		std::string subpath = path.substr(firstSlash + 1);
-		return childNode->getChildByPath(subpath);
+		auto it = node->_childrenByName.find(*name);
+		if (it == node->_childrenByName.end())
+			return nullptr;
+		if (slash == std::string_view::npos)
+			return std::static_pointer_cast<Node>(it->second->shared_from_this());
+		node = it->second;
+		path.remove_prefix(slash + 1);
 	}
 
-	return getChild(path);
+	std::optional<StringId> name = StringId::find(path.substr(2));
+	if (!name)
+		return nullptr;
+	auto world = node->getWorld();
+	if (world == nullptr)
+		return searchDescendant(*node, *name);
+
+	// Every node of a world but the world itself is in its name index, only the nodes with the name are compared
+	Node *found = nullptr;
+	for (Node *candidate : world->_findNodesByName(*name)) {
+		if (candidate == node || (node != world.get() && !isDescendant(candidate, node)))
+			continue;
+		if (found == nullptr || isBefore(candidate, found))
+			found = candidate;
+	}
+	return found == nullptr ? nullptr : std::static_pointer_cast<Node>(found->shared_from_this());
 }
 
 std::shared_ptr<WorldNode> Node::getWorld() const {
@@ -187,57 +305,31 @@ glm::mat4 Node::getTransformMatrixRelativeToNode(const std::shared_ptr<Node> &ot
 }
 
 void Node::traverseTopDown(const std::function<void(const std::shared_ptr<Node> &)> &func) {
-	std::function<void(const std::shared_ptr<Node> &)> traverseRecursive;
-	traverseRecursive = [&](const std::shared_ptr<Node> &node) {
-		func(node);
-		for (auto &child : node->getChildren()) {
-			traverseRecursive(child);
-		}
-	};
-
-	traverseRecursive(std::static_pointer_cast<Node>(shared_from_this()));
+	auto self = std::static_pointer_cast<Node>(shared_from_this());
+	_traverseTopDown<const std::shared_ptr<Node> *>(&self, [&func](const std::shared_ptr<Node> *node) {
+		func(*node);
+		return true;
+	});
 }
 
 void Node::traverseBottomUp(const std::function<void(const std::shared_ptr<Node> &)> &func) {
-	std::function<void(const std::shared_ptr<Node> &)> traverseRecursive;
-	traverseRecursive = [&](const std::shared_ptr<Node> &node) {
-		for (auto &child : node->getChildren()) {
-			traverseRecursive(child);
-		}
-		func(node);
-	};
-
-	traverseRecursive(std::static_pointer_cast<Node>(shared_from_this()));
+	auto self = std::static_pointer_cast<Node>(shared_from_this());
+	_traverseBottomUp<const std::shared_ptr<Node> *>(&self, [&func](const std::shared_ptr<Node> *node) {
+		func(*node);
+		return true;
+	});
 }
 
 void Node::traverseTopDownBreakable(const std::function<bool(const std::shared_ptr<Node> &)> &func) {
-	std::function<bool(const std::shared_ptr<Node> &)> traverseRecursive;
-	traverseRecursive = [&](const std::shared_ptr<Node> &node) {
-		if (!func(node))
-			return false;
-		for (auto &child : node->getChildren()) {
-			if (!traverseRecursive(child))
-				return false;
-		}
-		return true;
-	};
-
-	traverseRecursive(std::static_pointer_cast<Node>(shared_from_this()));
+	auto self = std::static_pointer_cast<Node>(shared_from_this());
+	_traverseTopDown<const std::shared_ptr<Node> *>(
+		&self, [&func](const std::shared_ptr<Node> *node) { return func(*node); });
 }
 
 void Node::traverseBottomUpBreakable(const std::function<bool(const std::shared_ptr<Node> &)> &func) {
-	std::function<bool(const std::shared_ptr<Node> &)> traverseRecursive;
-	traverseRecursive = [&](const std::shared_ptr<Node> &node) {
-		for (auto &child : node->getChildren()) {
-			if (!traverseRecursive(child))
-				return false;
-		}
-		if (!func(node))
-			return false;
-		return true;
-	};
-
-	traverseRecursive(std::static_pointer_cast<Node>(shared_from_this()));
+	auto self = std::static_pointer_cast<Node>(shared_from_this());
+	_traverseBottomUp<const std::shared_ptr<Node> *>(
+		&self, [&func](const std::shared_ptr<Node> *node) { return func(*node); });
 }
 
 void Node::writeHierarchy(std::ostream &stream, bool colored, const std::string &linePrefix,
@@ -267,6 +359,49 @@ Json::Object &Node::getMetadatas() {
 	return _metadatas;
 }
 
+void Node::_setWorld(const std::shared_ptr<WorldNode> &world) {
+	// The descendants of a node are always in the world of the node
+	auto previous = _world.lock();
+	if (previous == world)
+		return;
+	if (previous != nullptr && previous.get() != this)
+		previous->_unregisterNode(*this);
+	_world = world;
+	if (world != nullptr && world.get() != this)
+		world->_registerNode(*this);
+	for (auto &child : _children) {
+		child->_setWorld(world);
+	}
+}
+
+bool Node::_eraseChild(const Node &child) {
+	auto it = std::find_if(_children.begin(), _children.end(),
+						   [&child](const std::shared_ptr<Node> &node) { return node.get() == &child; });
+	if (it == _children.end())
+		return false;
+	std::shared_ptr<Node> erased = std::move(*it);
+	_children.erase(it);
+	auto indexed = _childrenByName.find(erased->_name);
+	if (indexed != _childrenByName.end() && indexed->second == erased.get())
+		_indexChildName(erased->_name);
+	return true;
+}
+
+std::shared_ptr<Core::Memory::Arena> Node::_getWorldArena() const {
+	auto world = getWorld();
+	return world == nullptr ? nullptr : world->getArena();
+}
+
+void Node::_indexChildName(StringId name) {
+	_childrenByName.erase(name);
+	for (const auto &child : _children) {
+		if (child->_name == name) {
+			_childrenByName.emplace(child->_name, child.get());
+			return;
+		}
+	}
+}
+
 const char *Node::_termClassColor() const {
 	return TERM_COLOR_BOLD TERM_COLOR_GRAY;
 }
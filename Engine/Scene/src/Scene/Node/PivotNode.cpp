@@ -2,6 +2,8 @@
 
 #include "Scene/Node/PivotNode.hpp"
 
+#include "Scene/SceneArchive.hpp"
+
 #include <sstream>
 
 namespace Stone::Scene {
@@ -19,6 +21,11 @@ std::ostream &PivotNode::writeToStream(std::ostream &stream, bool closing_bracer
 	return stream;
 }
 
+void PivotNode::serializeFields(SceneArchive &archive) {
+	Node::serializeFields(archive);
+	archive.field(_transform);
+}
+
 void PivotNode::render(RenderContext &context) {
 	glm::mat4 previousModelMatrix = context.mvp.modelMatrix;
 
@@ -2,11 +2,20 @@
 
 #include "Scene/Node/RenderableNode.hpp"
 
+#include "Scene/Node/WorldNode.hpp"
+
 namespace Stone::Scene {
 
 STONE_ABSTRACT_NODE_IMPLEMENTATION(RenderableNode)
 
-RenderableNode::RenderableNode(const std::string &name) : Node(name), IRenderable() {
+RenderableNode::RenderableNode(const std::string &name)
+	: Node(name), IRenderable(), _dirtySlot([this](IRenderable *, bool dirty) { _reportDirty(dirty); }) {
+	onDirty.bind(_dirtySlot);
+}
+
+RenderableNode::RenderableNode(const RenderableNode &other)
+	: Node(other), IRenderable(other), _dirtySlot([this](IRenderable *, bool dirty) { _reportDirty(dirty); }) {
+	onDirty.bind(_dirtySlot);
 }
 
 void RenderableNode::render(RenderContext &context) {
@@ -16,6 +25,24 @@ void RenderableNode::render(RenderContext &context) {
 	Node::render(context);
 }
 
+void RenderableNode::_reportDirty(bool dirty) {
+	if (!dirty)
+		return;
+	// Added while holding the mutex, so that the node cannot leave the world in between
+	std::lock_guard lock(_dirtyWorldMutex);
+	if (auto world = _dirtyWorld.lock())
+		world->_addDirtyRenderable(*this);
+}
+
+void RenderableNode::_setDirtyWorld(const std::shared_ptr<WorldNode> &world) {
+	std::lock_guard lock(_dirtyWorldMutex);
+	if (auto previous = _dirtyWorld.lock())
+		previous->_removeDirtyRenderable(*this);
+	_dirtyWorld = world;
+	if (world != nullptr && isDirty())
+		world->_addDirtyRenderable(*this);
+}
+
 // TODO: Benchmark diamond inheritance with PivotNode vs pivot usage
 
 } // namespace Stone::Scene
@@ -3,11 +3,15 @@
 #include "Scene/Node/SkeletonNode.hpp"
 
 #include "Scene/Node/PivotNode.hpp"
+#include "Scene/SceneArchive.hpp"
 
 namespace Stone::Scene {
 
 STONE_NODE_IMPLEMENTATION(SkeletonNode)
 
+SkeletonNode::Bone::Bone() : pivot(), inverseBindMatrix(1.0f), restPose() {
+}
+
 SkeletonNode::Bone::Bone(const std::shared_ptr<PivotNode> &pivot)
 	: pivot(pivot), inverseBindMatrix(1.0f), restPose(pivot->getTransform()) {
 }
@@ -27,6 +31,15 @@ std::ostream &SkeletonNode::writeToStream(std::ostream &stream, bool closing_bra
 	return stream;
 }
 
+void SkeletonNode::serializeFields(SceneArchive &archive) {
+	Node::serializeFields(archive);
+	archive.field(_bones, [&archive](Bone &bone) {
+		archive.node(bone.pivot);
+		archive.field(bone.inverseBindMatrix);
+		archive.field(bone.restPose);
+	});
+}
+
 const std::vector<SkeletonNode::Bone> &SkeletonNode::getBones() const {
 	return _bones;
 }
@@ -6,6 +6,7 @@
 #include "Scene/Renderable/Material.hpp"
 #include "Scene/Renderable/SkinMesh.hpp"
 #include "Scene/RendererObjectManager.hpp"
+#include "Scene/SceneArchive.hpp"
 
 namespace Stone::Scene {
 
@@ -24,6 +25,13 @@ std::ostream &SkinMeshNode::writeToStream(std::ostream &stream, bool closing_bra
 	return stream;
 }
 
+void SkinMeshNode::serializeFields(SceneArchive &archive) {
+	RenderableNode::serializeFields(archive);
+	archive.resource(_mesh);
+	archive.resource(_material);
+	archive.node(_skeleton);
+}
+
 std::shared_ptr<ISkinMeshInterface> SkinMeshNode::getSkinMesh() const {
 	return _mesh;
 }
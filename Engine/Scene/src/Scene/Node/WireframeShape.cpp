@@ -2,6 +2,8 @@
 
 #include "Scene/Node/WireframeShape.hpp"
 
+#include "Scene/SceneArchive.hpp"
+
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/io.hpp>
 
@@ -36,6 +38,15 @@ std::ostream &WireframeShape::writeToStream(std::ostream &stream, bool closing_b
 	return stream;
 }
 
+void WireframeShape::serializeFields(SceneArchive &archive) {
+	RenderableNode::serializeFields(archive);
+	archive.field(_color);
+	archive.field(_thickness);
+	archive.field(_points);
+	archive.field(_drawLine);
+	archive.field(_ignoreDepth);
+}
+
 glm::vec3 WireframeShape::getColor() const {
 	return _color;
 }
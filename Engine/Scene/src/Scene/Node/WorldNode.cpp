@@ -2,14 +2,18 @@
 
 #include "Scene/Node/WorldNode.hpp"
 
+#include "Logging/Metrics.hpp"
+#include "Scene/Component/ComponentBridge.hpp"
 #include "Scene/Node/CameraNode.hpp"
+#include "Scene/Node/RenderableNode.hpp"
+#include "Scene/SceneArchive.hpp"
 
 namespace Stone::Scene {
 
 STONE_NODE_IMPLEMENTATION(WorldNode)
 
 std::shared_ptr<WorldNode> WorldNode::create() {
-	auto new_world = std::make_shared<WorldNode>();
+	auto new_world = Core::Memory::makePooled<WorldNode>();
 	new_world->_world = new_world;
 	return new_world;
 }
@@ -17,6 +21,10 @@ std::shared_ptr<WorldNode> WorldNode::create() {
 WorldNode::WorldNode(const std::string &name) : Node(name), _activeCamera() {
 }
 
+WorldNode::WorldNode(const WorldNode &other)
+	: Node(other), _renderer(other._renderer), _activeCamera(other._activeCamera), _arena(other._arena) {
+}
+
 std::ostream &WorldNode::writeToStream(std::ostream &stream, bool closing_bracer) const {
 	Node::writeToStream(stream, false);
 	stream << ",active_camera:" << (_activeCamera.expired() ? "null" : _activeCamera.lock()->getGlobalName());
@@ -25,6 +33,30 @@ std::ostream &WorldNode::writeToStream(std::ostream &stream, bool closing_bracer
 	return stream;
 }
 
+void WorldNode::serializeFields(SceneArchive &archive) {
+	Node::serializeFields(archive);
+	archive.node(_activeCamera);
+	// A loaded world is its own world, as the one of WorldNode::create
+	if (archive.isReading())
+		_setWorld(std::static_pointer_cast<WorldNode>(shared_from_this()));
+}
+
+void WorldNode::setArena(const std::shared_ptr<Core::Memory::Arena> &arena) {
+	_arena = arena;
+}
+
+const std::shared_ptr<Core::Memory::Arena> &WorldNode::getArena() const {
+	return _arena;
+}
+
+void WorldNode::setComponentBridge(const std::shared_ptr<ComponentBridge> &bridge) {
+	_componentBridge = bridge;
+}
+
+const std::shared_ptr<ComponentBridge> &WorldNode::getComponentBridge() const {
+	return _componentBridge;
+}
+
 void WorldNode::setRenderer(const std::shared_ptr<ISceneRenderer> &renderer) {
 	_renderer = renderer;
 }
@@ -48,6 +80,82 @@ void WorldNode::initializeRenderContext(RenderContext &context) const {
 	}
 }
 
+void WorldNode::updateNodes(float deltaTime) {
+	static Logging::Counter &nodesUpdated = Logging::MetricsRegistry::instance().counter("scene.nodes_updated");
+	static Logging::Histogram &updateTime = Logging::MetricsRegistry::instance().histogram("scene.update_time_ns");
+
+	Logging::ScopedTimer timer(updateTime);
+	uint64_t nodeCount = 0;
+	forEachTopDown([deltaTime, &nodeCount](Node &node) {
+		node.update(deltaTime);
+		++nodeCount;
+	});
+	nodesUpdated.add(nodeCount);
+	if (_componentBridge != nullptr)
+		_componentBridge->sync(*this);
+}
+
+std::vector<std::shared_ptr<RenderableNode>> WorldNode::takeDirtyRenderables() {
+	std::unordered_set<RenderableNode *> dirtyRenderables;
+	{
+		std::lock_guard lock(_dirtyMutex);
+		if (_dirtyRenderables.empty())
+			return {};
+		dirtyRenderables.swap(_dirtyRenderables);
+	}
+	std::vector<std::shared_ptr<RenderableNode>> nodes;
+	nodes.reserve(dirtyRenderables.size());
+	for (RenderableNode *node : dirtyRenderables) {
+		nodes.push_back(std::static_pointer_cast<RenderableNode>(node->shared_from_this()));
+	}
+	return nodes;
+}
+
+void WorldNode::_addDirtyRenderable(RenderableNode &node) {
+	std::lock_guard lock(_dirtyMutex);
+	_dirtyRenderables.insert(&node);
+}
+
+void WorldNode::_removeDirtyRenderable(RenderableNode &node) {
+	std::lock_guard lock(_dirtyMutex);
+	_dirtyRenderables.erase(&node);
+}
+
+void WorldNode::_registerNode(Node &node) {
+	if (auto *renderable = nodeCast<RenderableNode>(node))
+		renderable->_setDirtyWorld(std::static_pointer_cast<WorldNode>(shared_from_this()));
+
+	auto it = _nodesByName.find(node._name);
+	if (it == _nodesByName.end())
+		it = _nodesByName.emplace(node._name, std::vector<Node *>()).first;
+	node._worldNameSlot = it->second.size();
+	it->second.push_back(&node);
+}
+
+void WorldNode::_unregisterNode(Node &node) {
+	if (auto *renderable = nodeCast<RenderableNode>(node))
+		renderable->_setDirtyWorld(nullptr);
+
+	auto it = _nodesByName.find(node._name);
+	if (it == _nodesByName.end())
+		return;
+	std::vector<Node *> &nodes = it->second;
+	if (node._worldNameSlot >= nodes.size() || nodes[node._worldNameSlot] != &node)
+		return;
+	// Swapped with the last node, so that the slots of the other nodes stay valid
+	nodes[node._worldNameSlot] = nodes.back();
+	nodes[node._worldNameSlot]->_worldNameSlot = node._worldNameSlot;
+	nodes.pop_back();
+	if (nodes.empty())
+		_nodesByName.erase(it);
+}
+
+const std::vector<Node *> &WorldNode::_findNodesByName(StringId name) const {
+	static const std::vector<Node *> none;
+	auto it = _nodesByName.find(name);
+	return it == _nodesByName.end() ? none : it->second;
+}
+
 const char *WorldNode::_termClassColor() const {
 	return TERM_COLOR_RED;
 }
@@ -26,11 +26,20 @@ std::ostream &Material::writeToStream(std::ostream &stream, bool closing_bracer)
 }
 
 void Material::setTextureParameter(const std::string &name, std::shared_ptr<Texture> texture) {
+	setTextureParameter(StringId(name), std::move(texture));
+}
+
+void Material::setTextureParameter(StringId name, std::shared_ptr<Texture> texture) {
 	_textures[name] = std::move(texture);
 	markDirty();
 }
 
 std::shared_ptr<Texture> Material::getTextureParameter(const std::string &name) const {
+	std::optional<StringId> id = StringId::find(name);
+	return id ? getTextureParameter(*id) : nullptr;
+}
+
+std::shared_ptr<Texture> Material::getTextureParameter(StringId name) const {
 	auto it = _textures.find(name);
 	if (it != _textures.end()) {
 		return it->second;
@@ -39,11 +48,20 @@ std::shared_ptr<Texture> Material::getTextureParameter(const std::string &name)
 }
 
 void Material::setVectorParameter(const std::string &name, const glm::vec3 &vector) {
+	setVectorParameter(StringId(name), vector);
+}
+
+void Material::setVectorParameter(StringId name, const glm::vec3 &vector) {
 	_vectors[name] = vector;
 	markDirty();
 }
 
 glm::vec3 Material::getVectorParameter(const std::string &name) const {
+	std::optional<StringId> id = StringId::find(name);
+	return id ? getVectorParameter(*id) : glm::vec3(0.0f);
+}
+
+glm::vec3 Material::getVectorParameter(StringId name) const {
 	auto it = _vectors.find(name);
 	if (it != _vectors.end()) {
 		return it->second;
@@ -52,11 +70,20 @@ glm::vec3 Material::getVectorParameter(const std::string &name) const {
 }
 
 void Material::setScalarParameter(const std::string &name, float scalar) {
+	setScalarParameter(StringId(name), scalar);
+}
+
+void Material::setScalarParameter(StringId name, float scalar) {
 	_scalars[name] = scalar;
 	markDirty();
 }
 
 float Material::getScalarParameter(const std::string &name) const {
+	std::optional<StringId> id = StringId::find(name);
+	return id ? getScalarParameter(*id) : 0.0f;
+}
+
+float Material::getScalarParameter(StringId name) const {
 	auto it = _scalars.find(name);
 	if (it != _scalars.end()) {
 		return it->second;
@@ -65,21 +92,20 @@ float Material::getScalarParameter(const std::string &name) const {
 }
 
 void Material::forEachTextures(
-	const std::function<void(std::pair<const std::string, std::shared_ptr<Texture>> &)> &lambda) {
+	const std::function<void(std::pair<const StringId, std::shared_ptr<Texture>> &)> &lambda) {
 	for (auto &it : _textures) {
 		lambda(it);
 	}
 }
 
-void Material::forEachVectors(const std::function<void(std::pair<const std::string, glm::vec3> &)> &lambda) {
+void Material::forEachVectors(const std::function<void(std::pair<const StringId, glm::vec3> &)> &lambda) {
 	for (auto &it : _vectors) {
 		lambda(it);
 	}
 }
 
-void Material::forEachScalars(const std::function<void(std::pair<const std::string, float> &)> &lambda) {
+void Material::forEachScalars(const std::function<void(std::pair<const StringId, float> &)> &lambda) {
 	for (auto &it : _scalars) {
-		it.second += 1;
 		lambda(it);
 	}
 }
@@ -65,6 +65,11 @@ int Shader::getMaxLocation() const {
 }
 
 int Shader::getLocation(const std::string &name) const {
+	std::optional<StringId> id = StringId::find(name);
+	return id ? getLocation(*id) : -1;
+}
+
+int Shader::getLocation(StringId name) const {
 	auto it = _locations.find(name);
 	if (it == _locations.end()) {
 		return -1;
@@ -72,6 +77,10 @@ int Shader::getLocation(const std::string &name) const {
 	return it->second;
 }
 
+const std::unordered_map<StringId, int> &Shader::getLocations() const {
+	return _locations;
+}
+
 void Shader::setContent(ContentType contentType, std::string content) {
 	_contentType = contentType;
 	_content = std::move(content);
@@ -79,6 +88,10 @@ void Shader::setContent(ContentType contentType, std::string content) {
 }
 
 void Shader::setLocation(const std::string &name, int location) {
+	setLocation(StringId(name), location);
+}
+
+void Shader::setLocation(StringId name, int location) {
 	_locations[name] = location;
 	if (location > _maxLocation) {
 		_maxLocation = location;
@@ -62,7 +62,7 @@ void RendererObjectManager::updateMaterial(const std::shared_ptr<Material> &mate
 	if (fragmentShader && fragmentShader->isDirty()) {
 		updateShader(fragmentShader);
 	}
-	material->forEachTextures([this](std::pair<const std::string, std::shared_ptr<Texture>> &it) {
+	material->forEachTextures([this](std::pair<const StringId, std::shared_ptr<Texture>> &it) {
 		if (it.second->isDirty())
 			updateTexture(it.second);
 	});
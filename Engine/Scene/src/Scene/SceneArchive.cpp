@@ -0,0 +1,673 @@
+// Copyright 2024 Stone-Engine
+
+#include "Scene/SceneArchive.hpp"
+
+#include "Core/Assets/Bundle.hpp"
+#include "Core/Memory/Pool.hpp"
+#include "Core/Image/ImageSource.hpp"
+#include "Logging/Logger.hpp"
+#include "Scene/Node/Node.hpp"
+#include "Scene/Renderable/Material.hpp"
+#include "Scene/Renderable/Mesh.hpp"
+#include "Scene/Renderable/Shader.hpp"
+#include "Scene/Renderable/SkinMesh.hpp"
+#include "Scene/Renderable/Texture.hpp"
+#include "Utils/FileSystem.hpp"
+#include "Utils/JsonMessagePack.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace Stone::Scene {
+
+static_assert(std::endian::native == std::endian::little, "Scene archives are read and written in little-endian");
+
+namespace {
+
+constexpr char archiveMagic[4] = {'S', 'T', 'N', 'S'};
+/** The magic, the version and the offset of the resource table */
+constexpr std::size_t headerSize = 16;
+
+struct ResourceType {
+	SceneArchive::ResourceWriter writer;
+	SceneArchive::ResourceReader reader;
+};
+
+struct StringHash {
+	using is_transparent = void;
+
+	std::size_t operator()(std::string_view str) const {
+		return std::hash<std::string_view>()(str);
+	}
+};
+
+/** The archive only reads the fields given when writing */
+template <typename T>
+T &writable(const T &value) {
+	return const_cast<T &>(value);
+}
+
+/** Meshes */
+
+template <typename MeshType>
+void writeDynamicMesh(SceneArchive &archive, Core::Object &object) {
+	auto &mesh = static_cast<MeshType &>(object);
+	archive.field(writable(mesh.getVertices()));
+	archive.field(writable(mesh.getIndices()));
+	archive.resource(writable(mesh.getDefaultMaterial()));
+}
+
+template <typename MeshType>
+std::shared_ptr<Core::Object> readDynamicMesh(SceneArchive &archive) {
+	auto mesh = Core::Memory::makePooled<MeshType>();
+	mesh->withElementsRef([&archive](auto &vertices, auto &indices) {
+		archive.field(vertices);
+		archive.field(indices);
+	});
+	std::shared_ptr<Material> material;
+	archive.resource(material);
+	mesh->setDefaultMaterial(material);
+	return mesh;
+}
+
+/** Static meshes are written with their source mesh, they are empty if the renderer released it */
+template <typename MeshType>
+void writeStaticMesh(SceneArchive &archive, Core::Object &object) {
+	auto &mesh = static_cast<MeshType &>(object);
+	archive.resource(writable(mesh.getSourceMesh()));
+	archive.resource(writable(mesh.getDefaultMaterial()));
+}
+
+template <typename MeshType, typename SourceMeshType>
+std::shared_ptr<Core::Object> readStaticMesh(SceneArchive &archive) {
+	auto mesh = Core::Memory::makePooled<MeshType>();
+	std::shared_ptr<SourceMeshType> sourceMesh;
+	archive.resource(sourceMesh);
+	mesh->setSourceMesh(sourceMesh);
+	std::shared_ptr<Material> material;
+	archive.resource(material);
+	mesh->setDefaultMaterial(material);
+	return mesh;
+}
+
+/**
+ * Hashed parameters are written sorted by name, so that equal resources are written the same whatever the order of
+ * their hash map, which ScenePatch relies on to match them.
+ */
+template <typename Pair>
+std::vector<Pair *> sortedByName(std::vector<Pair *> parameters) {
+	std::sort(parameters.begin(), parameters.end(),
+			  [](const Pair *a, const Pair *b) { return a->first.str() < b->first.str(); });
+	return parameters;
+}
+
+/** Materials */
+
+void writeMaterial(SceneArchive &archive, Core::Object &object) {
+	auto &material = static_cast<Material &>(object);
+
+	std::vector<std::pair<const StringId, std::shared_ptr<Texture>> *> textures;
+	material.forEachTextures([&textures](auto &parameter) { textures.push_back(&parameter); });
+	auto count = static_cast<uint32_t>(textures.size());
+	archive.field(count);
+	for (auto *parameter : sortedByName(std::move(textures))) {
+		archive.field(writable(parameter->first.str()));
+		archive.resource(parameter->second);
+	}
+
+	std::vector<std::pair<const StringId, glm::vec3> *> vectors;
+	material.forEachVectors([&vectors](auto &parameter) { vectors.push_back(&parameter); });
+	count = static_cast<uint32_t>(vectors.size());
+	archive.field(count);
+	for (auto *parameter : sortedByName(std::move(vectors))) {
+		archive.field(writable(parameter->first.str()));
+		archive.field(parameter->second);
+	}
+
+	std::vector<std::pair<const StringId, float> *> scalars;
+	material.forEachScalars([&scalars](auto &parameter) { scalars.push_back(&parameter); });
+	count = static_cast<uint32_t>(scalars.size());
+	archive.field(count);
+	for (auto *parameter : sortedByName(std::move(scalars))) {
+		archive.field(writable(parameter->first.str()));
+		archive.field(parameter->second);
+	}
+
+	std::shared_ptr<Shader> vertexShader = material.getVertexShader();
+	std::shared_ptr<Shader> fragmentShader = material.getFragmentShader();
+	archive.resource(vertexShader);
+	archive.resource(fragmentShader);
+}
+
+std::shared_ptr<Core::Object> readMaterial(SceneArchive &archive) {
+	auto material = Core::Memory::makePooled<Material>();
+	std::string name;
+	uint32_t count = 0;
+
+	archive.field(count);
+	for (; count > 0; --count) {
+		std::shared_ptr<Texture> texture;
+		archive.field(name);
+		archive.resource(texture);
+		material->setTextureParameter(name, texture);
+	}
+
+	archive.field(count);
+	for (; count > 0; --count) {
+		glm::vec3 vector;
+		archive.field(name);
+		archive.field(vector);
+		material->setVectorParameter(name, vector);
+	}
+
+	archive.field(count);
+	for (; count > 0; --count) {
+		float scalar = 0;
+		archive.field(name);
+		archive.field(scalar);
+		material->setScalarParameter(name, scalar);
+	}
+
+	std::shared_ptr<Shader> shader;
+	archive.resource(shader);
+	material->setVertexShader(shader);
+	archive.resource(shader);
+	material->setFragmentShader(shader);
+	return material;
+}
+
+/** Textures and images */
+
+void writeTexture(SceneArchive &archive, Core::Object &object) {
+	auto &texture = static_cast<Texture &>(object);
+	TextureWrap wrap = texture.getWrap();
+	TextureFilter minFilter = texture.getMinFilter();
+	TextureFilter magFilter = texture.getMagFilter();
+	archive.resource(writable(texture.getImage()));
+	archive.field(wrap);
+	archive.field(minFilter);
+	archive.field(magFilter);
+}
+
+std::shared_ptr<Core::Object> readTexture(SceneArchive &archive) {
+	auto texture = Core::Memory::makePooled<Texture>();
+	std::shared_ptr<Core::Image::ImageSource> image;
+	TextureWrap wrap = TextureWrap::Repeat;
+	TextureFilter minFilter = TextureFilter::Linear;
+	TextureFilter magFilter = TextureFilter::Linear;
+	archive.resource(image);
+	archive.field(wrap);
+	archive.field(minFilter);
+	archive.field(magFilter);
+	texture->setImage(image);
+	texture->setWrap(wrap);
+	texture->setMinFilter(minFilter);
+	texture->setMagFilter(magFilter);
+	return texture;
+}
+
+/** Images are written as their path in the bundle, the pixels are loaded from the bundle of the reading archive */
+void writeImageSource(SceneArchive &archive, Core::Object &object) {
+	auto &image = static_cast<Core::Image::ImageSource &>(object);
+	Core::Image::Channel channels = image.getChannels();
+	archive.field(writable(image.getFilePath()));
+	archive.field(channels);
+}
+
+std::shared_ptr<Core::Object> readImageSource(SceneArchive &archive) {
+	std::string filepath;
+	Core::Image::Channel channels = Core::Image::Channel::RGBA;
+	archive.field(filepath);
+	archive.field(channels);
+	return archive.getBundle()->loadResource<Core::Image::ImageSource>(filepath, channels);
+}
+
+/** Shaders */
+
+void writeShader(SceneArchive &archive, Core::Object &object) {
+	auto &shader = static_cast<Shader &>(object);
+	auto [contentType, content] = shader.getContent();
+	std::vector<const std::pair<const StringId, int> *> locations;
+	for (const auto &location : shader.getLocations()) {
+		locations.push_back(&location);
+	}
+	auto count = static_cast<uint32_t>(locations.size());
+	archive.field(contentType);
+	archive.field(writable(content));
+	archive.field(writable(shader.getFunction()));
+	archive.field(count);
+	for (const auto *location : sortedByName(std::move(locations))) {
+		archive.field(writable(location->first.str()));
+		archive.field(writable(location->second));
+	}
+}
+
+std::shared_ptr<Core::Object> readShader(SceneArchive &archive) {
+	Shader::ContentType contentType = Shader::ContentType::SourceCode;
+	std::string content;
+	std::string function;
+	uint32_t count = 0;
+	archive.field(contentType);
+	archive.field(content);
+	archive.field(function);
+
+	auto shader = Core::Memory::makePooled<Shader>(contentType, std::move(content));
+	shader->setFunction(function);
+	archive.field(count);
+	for (; count > 0; --count) {
+		std::string name;
+		int location = 0;
+		archive.field(name);
+		archive.field(location);
+		shader->setLocation(name, location);
+	}
+	return shader;
+}
+
+using ResourceTypes = std::unordered_map<std::string, ResourceType, StringHash, std::equal_to<>>;
+
+ResourceTypes &resourceTypes() {
+	static ResourceTypes types = {
+		{DynamicMesh::StaticClassName(), {writeDynamicMesh<DynamicMesh>, readDynamicMesh<DynamicMesh>}},
+		{StaticMesh::StaticClassName(), {writeStaticMesh<StaticMesh>, readStaticMesh<StaticMesh, DynamicMesh>}},
+		{DynamicSkinMesh::StaticClassName(), {writeDynamicMesh<DynamicSkinMesh>, readDynamicMesh<DynamicSkinMesh>}},
+		{StaticSkinMesh::StaticClassName(),
+		 {writeStaticMesh<StaticSkinMesh>, readStaticMesh<StaticSkinMesh, DynamicSkinMesh>}},
+		{Material::StaticClassName(), {writeMaterial, readMaterial}},
+		{Texture::StaticClassName(), {writeTexture, readTexture}},
+		{Core::Image::ImageSource::StaticClassName(), {writeImageSource, readImageSource}},
+		{Shader::StaticClassName(), {writeShader, readShader}},
+	};
+	return types;
+}
+
+const ResourceType *findResourceType(std::string_view className) {
+	auto &types = resourceTypes();
+	auto it = types.find(className);
+	return it == types.end() ? nullptr : &it->second;
+}
+
+} // namespace
+
+SceneArchive::SceneArchive(bool reading) : _reading(reading) {
+}
+
+void SceneArchive::write(const std::shared_ptr<Node> &root, std::vector<char> &out) {
+	if (root == nullptr)
+		throw std::runtime_error("Cannot archive a null node");
+
+	SceneArchive archive(false);
+	archive._out = &out;
+	// Indexing checks the depth before anything is written, so that writing recurses at most maxDepth times
+	archive._indexNodes(*root, 0);
+
+	std::size_t start = out.size();
+	uint32_t fileVersion = version;
+	uint64_t resourcesOffset = 0;
+	archive._write(archiveMagic, sizeof(archiveMagic));
+	archive.field(fileVersion);
+	archive.field(resourcesOffset);
+
+	archive._writeNode(*root);
+
+	resourcesOffset = out.size() - start;
+	std::memcpy(out.data() + start + headerSize - sizeof(resourcesOffset), &resourcesOffset, sizeof(resourcesOffset));
+	archive._writeResources();
+}
+
+std::shared_ptr<Node> SceneArchive::read(std::string_view data, const std::shared_ptr<Core::Assets::Bundle> &bundle,
+										 std::vector<std::shared_ptr<Core::Object>> *resources) {
+	SceneArchive archive(true);
+	archive._data = data;
+	archive._bundle = bundle != nullptr ? bundle : std::make_shared<Core::Assets::Bundle>();
+
+	char fileMagic[sizeof(archiveMagic)];
+	uint32_t fileVersion = 0;
+	uint64_t resourcesOffset = 0;
+	archive._bytes(fileMagic, sizeof(fileMagic));
+	if (std::memcmp(fileMagic, archiveMagic, sizeof(archiveMagic)) != 0)
+		throw std::runtime_error("The data is not a scene archive");
+	archive.field(fileVersion);
+	if (fileVersion != version)
+		throw std::runtime_error("Unsupported scene archive version " + std::to_string(fileVersion));
+	archive.field(resourcesOffset);
+	if (resourcesOffset < headerSize || resourcesOffset > data.size())
+		archive._error("Invalid resource table offset");
+
+	archive._readResourceTable(resourcesOffset);
+	std::shared_ptr<Node> root = archive._readNode(nullptr, 0);
+	if (archive._pos != resourcesOffset)
+		archive._error("Unexpected bytes after the nodes");
+
+	for (const auto &[index, assign] : archive._nodeReferences) {
+		if (index > archive._nodes.size())
+			archive._error("Invalid node reference " + std::to_string(index));
+		assign(archive._nodes[index - 1]);
+	}
+
+	if (resources != nullptr) {
+		for (uint32_t index = 1; index <= archive._resourceRecords.size(); ++index) {
+			if (auto resource = archive._loadResource(index))
+				resources->push_back(std::move(resource));
+		}
+	}
+	return root;
+}
+
+void SceneArchive::writeFile(const std::string &path, const std::shared_ptr<Node> &root) {
+	std::vector<char> data;
+	write(root, data);
+	Utils::writeFile(path, data);
+}
+
+std::shared_ptr<Node> SceneArchive::readFile(const std::string &path,
+											 const std::shared_ptr<Core::Assets::Bundle> &bundle,
+											 std::vector<std::shared_ptr<Core::Object>> *resources) {
+	std::vector<char> data = Utils::readBinaryFile(path);
+	return read(std::string_view(data.data(), data.size()), bundle, resources);
+}
+
+void SceneArchive::registerResourceType(const std::string &className, ResourceWriter writer, ResourceReader reader) {
+	resourceTypes()[className] = {std::move(writer), std::move(reader)};
+}
+
+void SceneArchive::field(std::string &value) {
+	if (_reading) {
+		value.assign(_view());
+	} else {
+		_writeString(value);
+	}
+}
+
+void SceneArchive::field(Transform3D &transform) {
+	glm::vec3 position = transform.getPosition();
+	glm::quat rotation = transform.getRotation();
+	glm::vec3 scale = transform.getScale();
+	field(position);
+	field(rotation);
+	field(scale);
+	if (_reading) {
+		transform.setPosition(position);
+		transform.setRotation(rotation);
+		transform.setScale(scale);
+	}
+}
+
+void SceneArchive::field(Json::Object &object) {
+	if (!_reading) {
+		std::size_t position = _out->size();
+		uint32_t size = 0;
+		field(size);
+		Json::toMessagePack(object, *_out);
+		_patchSize(position);
+		return;
+	}
+	Json::Value value;
+	Json::fromMessagePack(_view(), value);
+	if (!value.is<Json::Object>())
+		_error("Node metadatas are not an object");
+	object = std::move(value.get<Json::Object>());
+}
+
+void SceneArchive::_bytes(void *data, std::size_t size) {
+	if (!_reading) {
+		_write(data, size);
+		return;
+	}
+	if (_data.size() - _pos < size)
+		_error("Truncated scene archive");
+	if (size > 0)
+		std::memcpy(data, _data.data() + _pos, size);
+	_pos += size;
+}
+
+void SceneArchive::_write(const void *data, std::size_t size) {
+	const char *bytes = static_cast<const char *>(data);
+	_out->insert(_out->end(), bytes, bytes + size);
+}
+
+void SceneArchive::_writeString(std::string_view value) {
+	_size(value.size(), 1);
+	_write(value.data(), value.size());
+}
+
+void SceneArchive::_patchSize(std::size_t position) {
+	std::size_t size = _out->size() - position - sizeof(uint32_t);
+	if (size > UINT32_MAX)
+		_error("A node or a resource is larger than 4 GiB");
+	auto size32 = static_cast<uint32_t>(size);
+	std::memcpy(_out->data() + position, &size32, sizeof(size32));
+}
+
+uint32_t SceneArchive::_size(std::size_t size, std::size_t elementSize) {
+	if (!_reading) {
+		if (size > UINT32_MAX)
+			_error("A vector has more than 2^32 elements");
+		auto size32 = static_cast<uint32_t>(size);
+		_write(&size32, sizeof(size32));
+		return size32;
+	}
+	uint32_t size32 = 0;
+	field(size32);
+	// Checked before resizing, to not allocate for a size read from corrupted data
+	if ((_data.size() - _pos) / elementSize < size32)
+		_error("Truncated scene archive");
+	return size32;
+}
+
+std::string_view SceneArchive::_view() {
+	uint32_t size = _size(0, 1);
+	std::string_view view = _data.substr(_pos, size);
+	_pos += size;
+	return view;
+}
+
+void SceneArchive::_indexNodes(const Node &node, std::size_t depth) {
+	if (depth >= maxDepth)
+		throw std::runtime_error("Cannot archive a node hierarchy deeper than " + std::to_string(maxDepth));
+
+	_nodeIndices.emplace(&node, static_cast<uint32_t>(_nodeIndices.size() + 1));
+	for (const auto &child : node.getChildren()) {
+		_indexNodes(*child, depth + 1);
+	}
+}
+
+void SceneArchive::_writeNode(Node &node) {
+	uint64_t stableId = node.getStableId();
+	_writeString(node.getNodeClassName());
+	_writeString(node.getName());
+	field(stableId);
+
+	// The size of the fields lets a reader skip the fields of an unknown node class
+	std::size_t position = _out->size();
+	uint32_t fieldsSize = 0;
+	field(fieldsSize);
+	node.serializeFields(*this);
+	_patchSize(position);
+
+	auto childCount = static_cast<uint32_t>(node.getChildren().size());
+	field(childCount);
+	for (const auto &child : node.getChildren()) {
+		_writeNode(*child);
+	}
+}
+
+void SceneArchive::_writeResources() {
+	std::size_t countPosition = _out->size();
+	uint32_t count = 0;
+	field(count);
+
+	// Resources referenced by resources are added while writing
+	for (std::size_t index = 0; index < _resources.size(); ++index) {
+		Core::Object &resource = *_resources[index];
+		const ResourceType *type = findResourceType(resource.getClassName());
+		_writeString(resource.getClassName());
+
+		std::size_t position = _out->size();
+		uint32_t size = 0;
+		field(size);
+		type->writer(*this, resource);
+		_patchSize(position);
+	}
+
+	count = static_cast<uint32_t>(_resources.size());
+	std::memcpy(_out->data() + countPosition, &count, sizeof(count));
+}
+
+std::shared_ptr<Node> SceneArchive::_readNode(Node *parent, std::size_t depth) {
+	if (depth >= maxDepth)
+		_error("The node hierarchy is deeper than " + std::to_string(maxDepth));
+
+	const std::string &className = _className.assign(_view());
+	std::string name(_view());
+	uint64_t stableId = 0;
+	field(stableId);
+	uint32_t fieldsSize = _size(0, 1);
+	std::size_t fieldsEnd = _pos + fieldsSize;
+
+	auto node = Node::createOfClass(className, name);
+	if (node != nullptr) {
+		node->serializeFields(*this);
+	} else {
+		STONE_LOG_WARNING("Scene", "unknown node class {} for node {}, loaded as a Node", className, name);
+		node = std::make_shared<Node>(name);
+		node->Node::serializeFields(*this);
+		_pos = fieldsEnd;
+	}
+	if (_pos != fieldsEnd)
+		_error("The fields of the " + className + " " + name + " do not match the archive");
+	node->setStableId(stableId);
+	_nodes.push_back(node);
+
+	// Added before reading the children, so that they get the world of the parent
+	if (parent != nullptr)
+		parent->addChild(node);
+
+	uint32_t childCount = _size(0, 1);
+	for (uint32_t index = 0; index < childCount; ++index) {
+		_readNode(node.get(), depth + 1);
+	}
+	return node;
+}
+
+void SceneArchive::_readResourceTable(std::size_t offset) {
+	std::size_t nodesPosition = _pos;
+	_pos = offset;
+
+	uint32_t count = _size(0, 1);
+	_resourceRecords.reserve(count);
+	for (uint32_t index = 0; index < count; ++index) {
+		ResourceRecord record = {};
+		record.className = _view();
+		record.size = _size(0, 1);
+		record.offset = _pos;
+		_pos += record.size;
+		_resourceRecords.push_back(record);
+	}
+	if (_pos != _data.size())
+		_error("Unexpected bytes after the resources");
+	_resources.resize(count);
+
+	_pos = nodesPosition;
+}
+
+void SceneArchive::_readFields(Node &node, std::string_view fields) {
+	_data = fields;
+	_pos = 0;
+	node.serializeFields(*this);
+	if (_pos != _data.size())
+		_error("The fields of the " + std::string(node.getNodeClassName()) + " " + node.getName() +
+			   " do not match the patch");
+}
+
+uint32_t SceneArchive::_nodeIndex(const Node *node) {
+	if (!_patch) {
+		auto it = _nodeIndices.find(node);
+		return it == _nodeIndices.end() ? 0 : it->second;
+	}
+	if (node == nullptr)
+		return 0;
+	auto [it, inserted] = _nodeIdIndices.try_emplace(node->getStableId(), static_cast<uint32_t>(_nodeIds.size() + 1));
+	if (inserted)
+		_nodeIds.push_back(node->getStableId());
+	return it->second;
+}
+
+uint32_t SceneArchive::_resourceIndex(const std::shared_ptr<Core::Object> &resource) {
+	if (resource == nullptr)
+		return 0;
+
+	auto it = _resourceIndices.find(resource.get());
+	if (it != _resourceIndices.end())
+		return it->second;
+
+	uint32_t index = 0;
+	if (findResourceType(resource->getClassName()) == nullptr) {
+		STONE_LOG_WARNING("Scene", "resources of class {} cannot be archived, written as null",
+						  resource->getClassName());
+	} else if (_patch) {
+		index = _contentIndex(resource);
+	} else {
+		_resources.push_back(resource);
+		index = static_cast<uint32_t>(_resources.size());
+	}
+	_resourceIndices.emplace(resource.get(), index);
+	return index;
+}
+
+uint32_t SceneArchive::_contentIndex(const std::shared_ptr<Core::Object> &resource) {
+	// Resources referenced by this one are indexed while writing its content, before it
+	std::vector<char> content;
+	std::vector<char> *out = std::exchange(_out, &content);
+	_writeString(resource->getClassName());
+	findResourceType(resource->getClassName())->writer(*this, *resource);
+	_out = out;
+
+	auto [it, inserted] = _contentIndices.try_emplace(std::string(content.data(), content.size()),
+													  static_cast<uint32_t>(_resources.size() + 1));
+	if (inserted)
+		_resources.push_back(resource);
+	return it->second;
+}
+
+std::shared_ptr<Core::Object> SceneArchive::_loadResource(uint32_t index) {
+	if (index == 0)
+		return nullptr;
+	if (index > _resources.size())
+		_error("Invalid resource reference " + std::to_string(index));
+
+	// The resources of a patch are all set, without record
+	std::shared_ptr<Core::Object> &resource = _resources[index - 1];
+	if (resource != nullptr)
+		return resource;
+	ResourceRecord &record = _resourceRecords[index - 1];
+	if (record.loading)
+		_error("The resource " + std::to_string(index) + " references itself");
+
+	const ResourceType *type = findResourceType(record.className);
+	if (type == nullptr) {
+		STONE_LOG_WARNING("Scene", "unknown resource class {}, loaded as null", record.className);
+		return nullptr;
+	}
+
+	std::size_t position = _pos;
+	_pos = record.offset;
+	record.loading = true;
+	std::shared_ptr<Core::Object> loaded = type->reader(*this);
+	record.loading = false;
+	if (_pos != record.offset + record.size)
+		_error("The fields of the resource " + std::to_string(index) + " do not match the archive");
+	_pos = position;
+
+	_resources[index - 1] = loaded;
+	return loaded;
+}
+
+void SceneArchive::_error(const std::string &message) const {
+	throw std::runtime_error(message + " at offset " + std::to_string(_pos));
+}
+
+} // namespace Stone::Scene
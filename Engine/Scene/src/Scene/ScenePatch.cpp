@@ -0,0 +1,221 @@
+// Copyright 2024 Stone-Engine
+
+#include "Scene/ScenePatch.hpp"
+
+#include "Scene/Node/WorldNode.hpp"
+#include "Scene/Renderable/IRenderable.hpp"
+#include "Scene/SceneArchive.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Stone::Scene {
+
+namespace {
+
+/** A node of the previous state, with its fields written in a shared buffer */
+struct PreviousNode {
+	Node *node;
+	std::size_t offset;
+	std::size_t size;
+	bool matched;
+};
+
+/** Pre-order, with a stack to not recurse on deep hierarchies */
+template <typename Function>
+void forEachNode(const std::shared_ptr<Node> &root, const Function &function) {
+	std::vector<const std::shared_ptr<Node> *> stack = {&root};
+	while (!stack.empty()) {
+		const std::shared_ptr<Node> &node = *stack.back();
+		stack.pop_back();
+		function(node);
+		const auto &children = node->getChildren();
+		for (auto it = children.rbegin(); it != children.rend(); ++it) {
+			stack.push_back(&*it);
+		}
+	}
+}
+
+/** A child whose class changed is a new node, which has to be added to the parent */
+bool sameChildren(const Node &previous, const Node &node) {
+	const auto &previousChildren = previous.getChildren();
+	const auto &children = node.getChildren();
+	if (previousChildren.size() != children.size())
+		return false;
+	for (std::size_t index = 0; index < children.size(); ++index) {
+		if (previousChildren[index]->getStableId() != children[index]->getStableId() ||
+			std::strcmp(previousChildren[index]->getNodeClassName(), children[index]->getNodeClassName()) != 0)
+			return false;
+	}
+	return true;
+}
+
+[[noreturn]] void duplicateId(uint64_t id) {
+	throw std::runtime_error("Two nodes of the scene have the stable ID " + std::to_string(id));
+}
+
+} // namespace
+
+ScenePatch ScenePatch::diff(const std::shared_ptr<Node> &from, const std::shared_ptr<Node> &to) {
+	if (from == nullptr || to == nullptr)
+		throw std::runtime_error("Cannot compare a null scene");
+	if (std::strcmp(from->getNodeClassName(), to->getNodeClassName()) != 0)
+		throw std::runtime_error("The roots of the scenes are of different classes");
+
+	ScenePatch patch;
+	patch._rootId = from->getStableId();
+
+	// The previous state is written first, so that its resources are kept when the new state has equal ones
+	SceneArchive archive(false);
+	archive._patch = true;
+	std::vector<char> previousFields;
+	archive._out = &previousFields;
+	std::unordered_map<uint64_t, PreviousNode> previousNodes;
+	forEachNode(from, [&](const std::shared_ptr<Node> &node) {
+		PreviousNode previous = {node.get(), previousFields.size(), 0, false};
+		node->serializeFields(archive);
+		previous.size = previousFields.size() - previous.offset;
+		if (!previousNodes.emplace(node->getStableId(), previous).second)
+			duplicateId(node->getStableId());
+	});
+
+	std::vector<char> fields;
+	archive._out = &fields;
+	std::unordered_set<uint64_t> ids;
+	forEachNode(to, [&](const std::shared_ptr<Node> &node) {
+		uint64_t id = node == to ? patch._rootId : node->getStableId();
+		if (!ids.insert(id).second)
+			duplicateId(id);
+		fields.clear();
+		node->serializeFields(archive);
+
+		// A node whose class changed is removed, then added again
+		auto it = previousNodes.find(id);
+		PreviousNode *previous = nullptr;
+		if (it != previousNodes.end() &&
+			std::strcmp(it->second.node->getNodeClassName(), node->getNodeClassName()) == 0) {
+			previous = &it->second;
+			previous->matched = true;
+		}
+
+		if (previous == nullptr) {
+			patch._operations.push_back(
+				{OperationType::Add, id, node->getNodeClassName(), node->getName(), fields, {}});
+		} else if (previous->node->getName() != node->getName() || previous->size != fields.size() ||
+				   std::memcmp(previousFields.data() + previous->offset, fields.data(), fields.size()) != 0) {
+			patch._operations.push_back({OperationType::Update, id, {}, node->getName(), fields, {}});
+		}
+
+		if (previous == nullptr ? !node->getChildren().empty() : !sameChildren(*previous->node, *node)) {
+			std::vector<uint64_t> children;
+			children.reserve(node->getChildren().size());
+			for (const auto &child : node->getChildren()) {
+				children.push_back(child->getStableId());
+			}
+			patch._operations.push_back({OperationType::SetChildren, id, {}, {}, {}, std::move(children)});
+		}
+	});
+
+	for (const auto &[id, previous] : previousNodes) {
+		if (!previous.matched)
+			patch._operations.push_back({OperationType::Remove, id, {}, {}, {}, {}});
+	}
+
+	// References to the new root are references to the root the patch is applied to
+	patch._nodeIds = std::move(archive._nodeIds);
+	for (uint64_t &id : patch._nodeIds) {
+		if (id == to->getStableId())
+			id = patch._rootId;
+	}
+	patch._resources = std::move(archive._resources);
+	return patch;
+}
+
+void ScenePatch::apply(const std::shared_ptr<Node> &root) const {
+	if (root == nullptr || root->getStableId() != _rootId)
+		throw std::runtime_error("The patch was not computed from this scene");
+
+	std::unordered_map<uint64_t, std::shared_ptr<Node>> nodes;
+	forEachNode(root, [&nodes](const std::shared_ptr<Node> &node) { nodes.emplace(node->getStableId(), node); });
+	auto find = [&nodes](uint64_t id) -> const std::shared_ptr<Node> & {
+		auto it = nodes.find(id);
+		if (it == nodes.end())
+			throw std::runtime_error("The node " + std::to_string(id) + " of the patch is not in the scene");
+		return it->second;
+	};
+
+	// Removed first, as a node whose class changed is added back with the same ID
+	for (const auto &operation : _operations) {
+		if (operation.type == OperationType::Remove) {
+			find(operation.nodeId)->removeFromParent();
+			nodes.erase(operation.nodeId);
+		}
+	}
+
+	SceneArchive archive(true);
+	archive._patch = true;
+	archive._resources = _resources;
+	for (const auto &operation : _operations) {
+		std::shared_ptr<Node> node;
+		if (operation.type == OperationType::Add) {
+			node = Node::createOfClass(operation.className, operation.name);
+			if (node == nullptr)
+				throw std::runtime_error("Unknown node class " + operation.className);
+			node->setStableId(operation.nodeId);
+			nodes[operation.nodeId] = node;
+		} else if (operation.type == OperationType::Update) {
+			node = find(operation.nodeId);
+			node->setName(operation.name);
+		} else {
+			continue;
+		}
+		archive._readFields(*node, std::string_view(operation.fields.data(), operation.fields.size()));
+	}
+
+	// In pre-order of the new state, so that the ancestors of a node are in place when adding its children
+	std::vector<std::shared_ptr<Node>> children;
+	for (const auto &operation : _operations) {
+		if (operation.type != OperationType::SetChildren)
+			continue;
+		const std::shared_ptr<Node> &parent = find(operation.nodeId);
+		std::shared_ptr<WorldNode> world = parent->getWorld();
+		for (const auto &child : parent->_children) {
+			child->_parent.reset();
+		}
+		parent->_childrenByName.clear();
+		children.clear();
+		// Moved nodes stay in the name index of the world, only added nodes are indexed
+		for (uint64_t id : operation.children) {
+			const std::shared_ptr<Node> &child = find(id);
+			if (auto previousParent = child->getParent())
+				previousParent->_eraseChild(*child);
+			child->_parent = parent;
+			child->_setWorld(world);
+			parent->_childrenByName.emplace(child->_name, child.get());
+			children.push_back(child);
+		}
+		parent->_children.swap(children);
+		for (const auto &child : children) {
+			if (!child->hasParent())
+				child->_setWorld(nullptr);
+		}
+	}
+
+	for (const auto &[index, assign] : archive._nodeReferences) {
+		if (index > _nodeIds.size())
+			throw std::runtime_error("Invalid node reference " + std::to_string(index) + " in the patch");
+		auto it = nodes.find(_nodeIds[index - 1]);
+		assign(it == nodes.end() ? nullptr : it->second);
+	}
+
+	for (const auto &operation : _operations) {
+		if (operation.type != OperationType::Update)
+			continue;
+		if (auto *renderable = dynamic_cast<IRenderable *>(find(operation.nodeId).get()))
+			renderable->markDirty();
+	}
+}
+
+} // namespace Stone::Scene
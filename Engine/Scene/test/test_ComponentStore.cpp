@@ -0,0 +1,110 @@
+#include "Scene.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace Stone::Scene;
+
+struct Position {
+	int value = 0;
+};
+
+struct Velocity {
+	int value = 0;
+};
+
+TEST(ComponentStore, AddRemove) {
+	ComponentStore store;
+
+	Entity first = store.createEntity();
+	Entity second = store.createEntity();
+	Entity third = store.createEntity();
+	store.add<Position>(first, 1);
+	store.add<Position>(second, 2);
+	store.add<Position>(third, 3);
+	EXPECT_EQ(store.getArray<Position>().size(), 3);
+
+	// Removing moves the last component, the others stay reachable from their entity
+	store.remove<Position>(first);
+	EXPECT_FALSE(store.has<Position>(first));
+	EXPECT_EQ(store.get<Position>(second)->value, 2);
+	EXPECT_EQ(store.get<Position>(third)->value, 3);
+	EXPECT_EQ(store.get<Velocity>(second), nullptr);
+
+	store.add<Position>(second, 20);
+	EXPECT_EQ(store.get<Position>(second)->value, 20);
+	EXPECT_EQ(store.getArray<Position>().size(), 2);
+
+	store.destroyEntity(third);
+	EXPECT_FALSE(store.isAlive(third));
+	EXPECT_FALSE(store.has<Position>(third));
+	EXPECT_EQ(store.getEntityCount(), 2);
+	EXPECT_EQ(store.createEntity(), third);
+}
+
+TEST(ComponentStore, Each) {
+	ComponentStore store;
+
+	for (int i = 0; i < 10; i++) {
+		Entity entity = store.createEntity();
+		store.add<Position>(entity, i);
+		if (i % 2 == 0)
+			store.add<Velocity>(entity, 10 * i);
+	}
+
+	int visited = 0;
+	store.each<Position, Velocity>([&visited](Entity, Position &position, Velocity &velocity) {
+		EXPECT_EQ(velocity.value, 10 * position.value);
+		position.value += velocity.value;
+		++visited;
+	});
+	EXPECT_EQ(visited, 5);
+	EXPECT_EQ(store.get<Position>(4)->value, 44);
+	EXPECT_EQ(store.get<Position>(5)->value, 5);
+}
+
+TEST(ComponentStore, BridgeMirrorsNodes) {
+	std::shared_ptr<WorldNode> world = WorldNode::create();
+	auto bridge = std::make_shared<ComponentBridge>();
+	world->setComponentBridge(bridge);
+
+	auto mesh = std::make_shared<DynamicMesh>();
+	mesh->withElementsRef([](std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) {
+		vertices.resize(2);
+		vertices[0].position = glm::vec3(-1.0f, 0.0f, 0.0f);
+		vertices[1].position = glm::vec3(1.0f, 2.0f, 0.0f);
+		indices = {0, 1, 0};
+	});
+
+	auto pivot = world->addChild<PivotNode>("pivot");
+	pivot->getTransform().translate(glm::vec3(10.0f, 0.0f, 0.0f));
+	auto meshNode = pivot->addChild<MeshNode>("mesh");
+	meshNode->setMesh(mesh);
+	auto light = world->addChild<PointLightNode>("light");
+	world->addChild<Node>("group");
+
+	world->updateNodes(0.0f);
+	ComponentStore &store = bridge->getStore();
+	EXPECT_EQ(store.getEntityCount(), 3);
+
+	Entity meshEntity = bridge->getEntity(*meshNode);
+	ASSERT_NE(meshEntity, nullEntity);
+	EXPECT_EQ(store.get<NodeComponent>(meshEntity)->node, meshNode.get());
+	EXPECT_EQ(store.get<MeshComponent>(meshEntity)->mesh, mesh);
+	const BoundsComponent *bounds = store.get<BoundsComponent>(meshEntity);
+	ASSERT_NE(bounds, nullptr);
+	EXPECT_EQ(bounds->worldBox.min, glm::vec3(9.0f, 0.0f, 0.0f));
+	EXPECT_EQ(bounds->worldBox.max, glm::vec3(11.0f, 2.0f, 0.0f));
+	EXPECT_EQ(store.get<TransformComponent>(meshEntity)->worldMatrix, meshNode->getWorldTransformMatrix());
+
+	Entity lightEntity = bridge->getEntity(*light);
+	ASSERT_NE(lightEntity, nullEntity);
+	EXPECT_EQ(store.get<LightComponent>(lightEntity)->intensity, light->getIntensity());
+	EXPECT_FALSE(store.has<MeshComponent>(lightEntity));
+
+	// Nodes leaving the world lose their entity
+	pivot->removeFromParent();
+	world->updateNodes(0.0f);
+	EXPECT_EQ(store.getEntityCount(), 1);
+	EXPECT_EQ(bridge->getEntity(*meshNode), nullEntity);
+	EXPECT_FALSE(store.isAlive(meshEntity));
+}
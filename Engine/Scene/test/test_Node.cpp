@@ -1,8 +1,10 @@
 
 #include "Scene/Node/Node.hpp"
+#include "Scene/Node/WorldNode.hpp"
 
 #include <gtest/gtest.h>
 
+using namespace Stone;
 using namespace Stone::Scene;
 
 TEST(Node, GetGlobalName) {
@@ -23,3 +25,180 @@ TEST(Node, GetGlobalName) {
 	EXPECT_EQ(child2->getGlobalName(), "/Root/Child2");
 	EXPECT_EQ(grandchild->getGlobalName(), "/Root/Child2/Grandchild");
 }
+
+TEST(Node, GetChildAfterRenameAndRemove) {
+	auto root = std::make_shared<Node>("Root");
+	auto first = root->addChild<Node>("Child");
+	auto second = root->addChild<Node>("Child");
+
+	EXPECT_EQ(root->getChild("Child"), first);
+	first->setName("Renamed");
+	EXPECT_EQ(root->getChild("Child"), second);
+	EXPECT_EQ(root->getChild("Renamed"), first);
+
+	first->setName("Child");
+	EXPECT_EQ(root->getChild("Child"), first);
+	root->removeChild(first);
+	EXPECT_EQ(root->getChild("Child"), second);
+	EXPECT_EQ(root->getChild("Child"_id), second);
+	EXPECT_EQ(root->getChild("Renamed"), nullptr);
+	EXPECT_EQ(root->getChildByPath("Child/Missing"), nullptr);
+}
+
+TEST(Node, GetChildByPathWithWorldIndex) {
+	auto world = WorldNode::create();
+	auto a = world->addChild<Node>("a");
+	auto b = world->addChild<Node>("b");
+	auto deep = a->addChild<Node>("x")->addChild<Node>("target");
+	auto shallow = b->addChild<Node>("target");
+
+	// The first descendant in a top-down order, whatever the order of the index
+	EXPECT_EQ(world->getChildByPath("*/target"), deep);
+	EXPECT_EQ(world->getChildByPath("b/*/target"), shallow);
+	EXPECT_EQ(world->getChildByPath("a/x/target"), deep);
+	EXPECT_EQ(a->getChildByPath("*/target"), deep);
+
+	// A subtree built outside of the world is indexed when added to it
+	auto subtree = std::make_shared<Node>("c");
+	auto added = subtree->addChild<Node>("added");
+	EXPECT_EQ(added->getWorld(), nullptr);
+	world->addChild(subtree);
+	EXPECT_EQ(added->getWorld(), world);
+	EXPECT_EQ(world->getChildByPath("*/added"), added);
+
+	a->removeFromParent();
+	EXPECT_EQ(deep->getWorld(), nullptr);
+	EXPECT_EQ(world->getChildByPath("*/target"), shallow);
+	EXPECT_EQ(a->getChildByPath("*/target"), deep);
+
+	shallow->setName("renamed");
+	EXPECT_EQ(world->getChildByPath("*/target"), nullptr);
+	EXPECT_EQ(world->getChildByPath("*/renamed"), shallow);
+}
+
+TEST(Node, GetChildByPathWithCommonName) {
+	// More nodes with the name than are compared, found by visiting the descendants
+	auto world = WorldNode::create();
+	std::vector<std::shared_ptr<Node>> groups;
+	for (int i = 0; i < 40; i++)
+		groups.push_back(world->addChild<Node>("group" + std::to_string(i)));
+	for (int i = 39; i >= 0; i--)
+		groups[i]->addChild<Node>("item");
+
+	EXPECT_EQ(world->getChildByPath("*/item"), groups[0]->getChild("item"));
+	EXPECT_EQ(groups[7]->getChildByPath("*/item"), groups[7]->getChild("item"));
+	EXPECT_EQ(world->getChildByPath("*/item"), groups[0]->getChild("item"));
+
+	// Cached results are dropped when the hierarchy changes
+	groups[0]->removeFromParent();
+	EXPECT_EQ(world->getChildByPath("*/item"), groups[1]->getChild("item"));
+	groups[1]->getChild("item")->setName("other");
+	EXPECT_EQ(world->getChildByPath("*/item"), groups[2]->getChild("item"));
+}
+
+TEST(Node, CopyIsDetached) {
+	auto world = WorldNode::create();
+	auto original = world->addChild<Node>("original");
+	original->addChild<Node>("child");
+	original->getMetadatas()["key"] = Json::number(1.0);
+
+	auto copy = std::make_shared<Node>(*original);
+	EXPECT_EQ(copy->getName(), "original");
+	EXPECT_EQ(copy->getMetadatas().size(), 1);
+	EXPECT_EQ(copy->getWorld(), nullptr);
+	EXPECT_EQ(copy->getParent(), nullptr);
+	EXPECT_TRUE(copy->getChildren().empty());
+	EXPECT_NE(copy->getStableId(), original->getStableId());
+
+	// The copy is indexed once added, without touching the index entry of the original
+	auto holder = world->addChild<Node>("holder");
+	holder->addChild(copy);
+	EXPECT_EQ(holder->getChildByPath("*/original"), copy);
+	copy->removeFromParent();
+	EXPECT_EQ(world->getChildByPath("*/original"), original);
+	EXPECT_EQ(world->getChildByPath("original/child"), original->getChild("child"));
+}
+
+TEST(Node, AddChildInWorldArena) {
+	auto world = WorldNode::create();
+	auto arena = std::make_shared<Core::Memory::Arena>();
+	world->setArena(arena);
+
+	auto child = world->addChild<Node>("child");
+	auto grandChild = child->addChild<Node>("grandChild");
+	EXPECT_EQ(arena->getStatistics().liveAllocations, 2);
+	EXPECT_EQ(world->getChildByPath("child/grandChild"), grandChild);
+
+	child->removeFromParent();
+	grandChild.reset();
+	child.reset();
+	EXPECT_EQ(arena->getStatistics().liveAllocations, 0);
+}
+
+TEST(Node, ForEachOrder) {
+	auto root = std::make_shared<Node>("root");
+	auto a = root->addChild<Node>("a");
+	a->addChild<Node>("a1");
+	a->addChild<Node>("a2");
+	root->addChild<Node>("b");
+
+	std::string topDown;
+	root->forEachTopDown([&topDown](Node &node) { topDown += node.getName() + " "; });
+	EXPECT_EQ(topDown, "root a a1 a2 b ");
+
+	std::string bottomUp;
+	root->forEachBottomUp([&bottomUp](Node &node) { bottomUp += node.getName() + " "; });
+	EXPECT_EQ(bottomUp, "a1 a2 a b root ");
+
+	std::string stopped;
+	EXPECT_FALSE(root->forEachTopDown([&stopped](Node &node) {
+		stopped += node.getName() + " ";
+		return node.getName() != "a1";
+	}));
+	EXPECT_EQ(stopped, "root a a1 ");
+
+	// The std::function traversals give the same orders
+	std::string traversed;
+	root->traverseBottomUp([&traversed](const std::shared_ptr<Node> &node) { traversed += node->getName() + " "; });
+	EXPECT_EQ(traversed, bottomUp);
+}
+
+TEST(Node, ForEachDeepHierarchy) {
+	auto root = std::make_shared<Node>("root");
+	auto node = root;
+	for (int i = 0; i < 1000; i++)
+		node = node->addChild<Node>("child");
+
+	int topDownCount = 0;
+	root->forEachTopDown([&topDownCount](Node &) { ++topDownCount; });
+	EXPECT_EQ(topDownCount, 1001);
+
+	Node *first = nullptr;
+	root->forEachBottomUp([&first](Node &visited) {
+		first = &visited;
+		return false;
+	});
+	EXPECT_EQ(first, node.get());
+
+	// Released from the leaf, not recursively from the root
+	while (node->hasParent()) {
+		auto parent = node->getParent();
+		node->removeFromParent();
+		node = parent;
+	}
+}
+
+TEST(Node, ForEachOfType) {
+	auto world = WorldNode::create();
+	auto first = world->addChild<WorldNode>("first");
+	world->addChild<Node>("node");
+	auto second = world->addChild<Node>("parent")->addChild<WorldNode>("second");
+
+	std::vector<WorldNode *> worlds;
+	world->forEachOfType<WorldNode>([&worlds](WorldNode &node) { worlds.push_back(&node); });
+	EXPECT_EQ(worlds, (std::vector<WorldNode *>{world.get(), first.get(), second.get()}));
+
+	Node &node = *world->getChild("node");
+	EXPECT_EQ(nodeCast<WorldNode>(node), nullptr);
+	EXPECT_EQ(nodeCast<Node>(*second), second.get());
+}
@@ -1,6 +1,9 @@
 #include "Scene.hpp"
+#include "Scene/RendererObjectManager.hpp"
 
+#include <atomic>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace Stone::Scene;
 
@@ -96,8 +99,7 @@ TEST(Scene, Nodes) {
 
 template <typename T, typename... Args>
 std::shared_ptr<T> makeNode(const std::string &type, Args... args) {
-	return std::dynamic_pointer_cast<T>(
-		Stone::DynamicObjectFactory<Node, const std::string &>::getInstance().create(type, args...));
+	return std::dynamic_pointer_cast<T>(Node::createOfClass(type, args...));
 }
 
 void testNodeDynamic() {
@@ -164,3 +166,71 @@ void testNodeDynamic() {
 	auto none = makeNode<Node>("Node", "none");
 	EXPECT_EQ(none, nullptr);
 }
+
+TEST(Scene, DirtyRenderables) {
+	std::shared_ptr<WorldNode> world = WorldNode::create();
+	RendererObjectManager manager;
+
+	// Renderables join the world dirty
+	auto pivot = world->addChild<PivotNode>("pivot");
+	auto first = pivot->addChild<MeshNode>("first");
+	auto second = world->addChild<MeshNode>("second");
+	auto renderables = world->takeDirtyRenderables();
+	EXPECT_EQ(renderables.size(), 2);
+	for (const auto &renderable : renderables)
+		manager.updateRenderable(renderable);
+	EXPECT_FALSE(first->isDirty());
+
+	// A static world has nothing to update
+	EXPECT_TRUE(world->takeDirtyRenderables().empty());
+
+	// Each marked node is given once
+	first->markDirty();
+	first->markDirty();
+	renderables = world->takeDirtyRenderables();
+	ASSERT_EQ(renderables.size(), 1);
+	EXPECT_EQ(renderables[0], first);
+
+	// Nodes leaving the world are not given anymore
+	second->markDirty();
+	second->removeFromParent();
+	EXPECT_TRUE(world->takeDirtyRenderables().empty());
+	second->markDirty();
+	EXPECT_TRUE(world->takeDirtyRenderables().empty());
+}
+
+TEST(Scene, DirtyRenderablesDetachedWhileMarked) {
+	std::shared_ptr<WorldNode> world = WorldNode::create();
+	std::vector<std::shared_ptr<MeshNode>> nodes;
+	for (int i = 0; i < 64; i++)
+		nodes.push_back(world->addChild<MeshNode>("mesh" + std::to_string(i)));
+	(void)world->takeDirtyRenderables();
+
+	// Threads mark the nodes dirty while they leave the world
+	std::atomic<bool> stop = false;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++) {
+		threads.emplace_back([&nodes, &stop] {
+			while (!stop) {
+				for (const auto &node : nodes)
+					node->markDirty();
+			}
+		});
+	}
+	for (std::size_t i = 0; i < nodes.size(); i += 2) {
+		nodes[i]->removeFromParent();
+		for (const auto &renderable : world->takeDirtyRenderables())
+			EXPECT_TRUE(renderable->getWorld() == world);
+	}
+	stop = true;
+	for (auto &thread : threads)
+		thread.join();
+
+	// Only the nodes still in the world are given
+	for (const auto &node : nodes)
+		node->markDirty();
+	auto renderables = world->takeDirtyRenderables();
+	EXPECT_EQ(renderables.size(), nodes.size() / 2);
+	for (const auto &renderable : renderables)
+		EXPECT_EQ(renderable->getWorld(), world);
+}
@@ -0,0 +1,217 @@
+#include "Scene.hpp"
+#include "Scene/Node/WireframeShape.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace Stone;
+using namespace Stone::Scene;
+
+namespace {
+
+std::shared_ptr<Node> roundTrip(const std::shared_ptr<Node> &root,
+								std::vector<std::shared_ptr<Core::Object>> *resources = nullptr) {
+	std::vector<char> data;
+	SceneArchive::write(root, data);
+	return SceneArchive::read(std::string_view(data.data(), data.size()), nullptr, resources);
+}
+
+} // namespace
+
+TEST(SceneArchive, HierarchyAndFields) {
+	auto world = WorldNode::create();
+	world->getMetadatas()["author"] = Json::string("stone");
+	world->getMetadatas()["version"] = 3.0;
+
+	auto pivot = world->addChild<PivotNode>("pivot");
+	pivot->getTransform().setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+	pivot->getTransform().setScale(glm::vec3(2.0f));
+
+	auto camera = pivot->addChild<PerspectiveCameraNode>("camera");
+	camera->setFov(1.2f);
+	camera->setFar(500.0f);
+	world->setActiveCamera(camera);
+
+	auto light = world->addChild<SpotLightNode>("light");
+	light->setIntensity(4.0f);
+	light->setConeAngle(0.5f);
+	light->setShadowMapSize(glm::ivec2(2048, 1024));
+
+	auto shape = pivot->addChild<WireframeShape>("shape");
+	shape->setThickness(3.0f);
+	shape->withPointsRef([](std::vector<std::vector<glm::vec3>> &points) {
+		points = {{glm::vec3(0.0f), glm::vec3(1.0f)}, {glm::vec3(2.0f, 3.0f, 4.0f)}};
+	});
+
+	auto loaded = std::dynamic_pointer_cast<WorldNode>(roundTrip(world));
+	ASSERT_NE(loaded, nullptr);
+	EXPECT_EQ(loaded->getMetadatas()["author"].get<std::string>(), "stone");
+	EXPECT_EQ(loaded->getMetadatas()["version"].get<double>(), 3.0);
+	ASSERT_EQ(loaded->getChildren().size(), 2);
+
+	auto loadedPivot = loaded->getChild<PivotNode>("pivot");
+	ASSERT_NE(loadedPivot, nullptr);
+	EXPECT_EQ(loadedPivot->getTransform().getPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+	EXPECT_EQ(loadedPivot->getTransform().getScale(), glm::vec3(2.0f));
+	EXPECT_EQ(loadedPivot->getWorld(), loaded);
+	EXPECT_EQ(loadedPivot->getStableId(), pivot->getStableId());
+
+	auto loadedCamera = loaded->getChildByPath<PerspectiveCameraNode>("pivot/camera");
+	ASSERT_NE(loadedCamera, nullptr);
+	EXPECT_EQ(loadedCamera->getFov(), 1.2f);
+	EXPECT_EQ(loadedCamera->getFar(), 500.0f);
+	EXPECT_EQ(loadedCamera->getWorld(), loaded);
+	EXPECT_EQ(loaded->getActiveCamera(), loadedCamera);
+
+	auto loadedLight = loaded->getChild<SpotLightNode>("light");
+	ASSERT_NE(loadedLight, nullptr);
+	EXPECT_EQ(loadedLight->getIntensity(), 4.0f);
+	EXPECT_EQ(loadedLight->getConeAngle(), 0.5f);
+	EXPECT_EQ(loadedLight->getShadowMapSize(), glm::ivec2(2048, 1024));
+	EXPECT_EQ(loadedLight->getProjectionMatrix(), light->getProjectionMatrix());
+
+	auto loadedShape = loaded->getChildByPath<WireframeShape>("pivot/shape");
+	ASSERT_NE(loadedShape, nullptr);
+	EXPECT_EQ(loadedShape->getThickness(), 3.0f);
+	EXPECT_EQ(loadedShape->getPoints(), shape->getPoints());
+}
+
+TEST(SceneArchive, SharedResourcesAreWrittenOnce) {
+	auto mesh = std::make_shared<DynamicMesh>();
+	mesh->withElementsRef([](std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) {
+		vertices = {Vertex(glm::vec3(0.0f), glm::vec2(0.0f)), Vertex(glm::vec3(1.0f, 0.0f, 0.0f), glm::vec2(1.0f)),
+					Vertex(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.0f, 1.0f))};
+		indices = {0, 1, 2};
+	});
+
+	auto shader = std::make_shared<Shader>(Shader::ContentType::SourceFile, "shaders/lit.glsl");
+	shader->setLocation("albedo", 2);
+
+	auto texture = std::make_shared<Texture>();
+	texture->setWrap(TextureWrap::ClampToEdge);
+
+	auto material = std::make_shared<Material>();
+	material->setTextureParameter("diffuse", texture);
+	material->setVectorParameter("tint", glm::vec3(0.5f, 0.25f, 1.0f));
+	material->setScalarParameter("roughness", 0.75f);
+	material->setFragmentShader(shader);
+	mesh->setDefaultMaterial(material);
+
+	auto root = std::make_shared<Node>("root");
+	for (int index = 0; index < 10; ++index) {
+		auto meshNode = root->addChild<MeshNode>("mesh_" + std::to_string(index));
+		meshNode->setMesh(mesh);
+		meshNode->setMaterial(material);
+	}
+
+	std::vector<char> single;
+	SceneArchive::write(root->getChild<MeshNode>("mesh_0"), single);
+	std::vector<char> all;
+	SceneArchive::write(root, all);
+	// The nine other nodes only add their own record, not a copy of the resources
+	EXPECT_LT(all.size(), single.size() + 9 * 100);
+
+	std::vector<std::shared_ptr<Core::Object>> resources;
+	auto loaded = roundTrip(root, &resources);
+	EXPECT_EQ(resources.size(), 4);
+	ASSERT_EQ(loaded->getChildren().size(), 10);
+
+	auto first = loaded->getChild<MeshNode>("mesh_0");
+	auto last = loaded->getChild<MeshNode>("mesh_9");
+	ASSERT_NE(first->getMesh(), nullptr);
+	EXPECT_EQ(first->getMesh(), last->getMesh());
+	EXPECT_EQ(first->getMaterial(), last->getMaterial());
+	EXPECT_EQ(first->getMesh()->getDefaultMaterial(), first->getMaterial());
+
+	auto loadedMesh = std::dynamic_pointer_cast<DynamicMesh>(first->getMesh());
+	ASSERT_NE(loadedMesh, nullptr);
+	ASSERT_EQ(loadedMesh->getVertices().size(), 3);
+	EXPECT_EQ(loadedMesh->getVertices()[1].position, glm::vec3(1.0f, 0.0f, 0.0f));
+	EXPECT_EQ(loadedMesh->getVertices()[2].uv, glm::vec2(0.0f, 1.0f));
+	EXPECT_EQ(loadedMesh->getIndices(), mesh->getIndices());
+
+	auto loadedMaterial = first->getMaterial();
+	EXPECT_EQ(loadedMaterial->getVectorParameter("tint"), glm::vec3(0.5f, 0.25f, 1.0f));
+	EXPECT_EQ(loadedMaterial->getScalarParameter("roughness"), 0.75f);
+	EXPECT_EQ(loadedMaterial->getScalarParameter("roughness"_id), 0.75f);
+	ASSERT_NE(loadedMaterial->getTextureParameter("diffuse"), nullptr);
+	EXPECT_EQ(loadedMaterial->getTextureParameter("diffuse")->getWrap(), TextureWrap::ClampToEdge);
+	EXPECT_EQ(loadedMaterial->getVertexShader(), nullptr);
+	ASSERT_NE(loadedMaterial->getFragmentShader(), nullptr);
+	EXPECT_EQ(loadedMaterial->getFragmentShader()->getContent().second, "shaders/lit.glsl");
+	EXPECT_EQ(loadedMaterial->getFragmentShader()->getLocation("albedo"), 2);
+}
+
+TEST(SceneArchive, NodeReferences) {
+	auto root = std::make_shared<PivotNode>("root");
+	auto skinMesh = root->addChild<SkinMeshNode>("skin");
+	auto skeleton = root->addChild<SkeletonNode>("skeleton");
+	auto hip = skeleton->addChild<PivotNode>("hip");
+	auto knee = hip->addChild<PivotNode>("knee");
+	knee->getTransform().setPosition(glm::vec3(0.0f, -1.0f, 0.0f));
+	skeleton->addBone(hip);
+	skeleton->addBone(knee);
+	skinMesh->setSkeleton(skeleton);
+
+	auto outside = std::make_shared<SkeletonNode>("outside");
+	auto other = root->addChild<SkinMeshNode>("other");
+	other->setSkeleton(outside);
+
+	auto loaded = roundTrip(root);
+	auto loadedSkeleton = loaded->getChild<SkeletonNode>("skeleton");
+	ASSERT_NE(loadedSkeleton, nullptr);
+	EXPECT_EQ(loaded->getChild<SkinMeshNode>("skin")->getSkeleton(), loadedSkeleton);
+	// Nodes outside of the archive are not kept
+	EXPECT_EQ(loaded->getChild<SkinMeshNode>("other")->getSkeleton(), nullptr);
+
+	const auto &bones = loadedSkeleton->getBones();
+	ASSERT_EQ(bones.size(), 2);
+	EXPECT_EQ(bones[0].pivot.lock(), loadedSkeleton->getChild<PivotNode>("hip"));
+	EXPECT_EQ(bones[1].pivot.lock(), loadedSkeleton->getChildByPath<PivotNode>("hip/knee"));
+	EXPECT_EQ(bones[1].inverseBindMatrix, skeleton->getBones()[1].inverseBindMatrix);
+	EXPECT_EQ(bones[1].restPose.getPosition(), glm::vec3(0.0f, -1.0f, 0.0f));
+}
+
+TEST(SceneArchive, FileRoundTrip) {
+	auto root = std::make_shared<PivotNode>("root");
+	root->addChild<DirectionalLightNode>("sun")->setInfinite(true);
+
+	std::string path = testing::TempDir() + "scene_archive_test.stone";
+	SceneArchive::writeFile(path, root);
+	auto loaded = SceneArchive::readFile(path);
+
+	EXPECT_EQ(loaded->getName(), "root");
+	ASSERT_NE(loaded->getChild<DirectionalLightNode>("sun"), nullptr);
+	EXPECT_TRUE(loaded->getChild<DirectionalLightNode>("sun")->isInfinite());
+	std::remove(path.c_str());
+}
+
+TEST(SceneArchive, InvalidDataThrowsException) {
+	auto root = std::make_shared<PivotNode>("root");
+	root->addChild<PivotNode>("child")->getMetadatas()["key"] = Json::string("value");
+	std::vector<char> data;
+	SceneArchive::write(root, data);
+
+	EXPECT_THROW(SceneArchive::read(""), std::runtime_error);
+	EXPECT_THROW(SceneArchive::read("not an archive at all"), std::runtime_error);
+	for (std::size_t size = 0; size < data.size(); ++size) {
+		EXPECT_THROW(SceneArchive::read(std::string_view(data.data(), size)), std::runtime_error) << size;
+	}
+
+	std::vector<char> wrongVersion = data;
+	wrongVersion[4] = static_cast<char>(SceneArchive::version + 1);
+	EXPECT_THROW(SceneArchive::read(std::string_view(wrongVersion.data(), wrongVersion.size())), std::runtime_error);
+}
+
+TEST(SceneArchive, TooDeepHierarchyThrowsException) {
+	auto root = std::make_shared<PivotNode>("root");
+	std::shared_ptr<Node> leaf = root;
+	for (std::size_t depth = 1; depth < SceneArchive::maxDepth; ++depth) {
+		leaf = leaf->addChild<PivotNode>("child");
+	}
+	EXPECT_NE(roundTrip(root), nullptr);
+
+	leaf->addChild<PivotNode>("child");
+	std::vector<char> data;
+	EXPECT_THROW(SceneArchive::write(root, data), std::runtime_error);
+	EXPECT_TRUE(data.empty());
+}
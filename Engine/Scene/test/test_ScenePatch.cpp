@@ -0,0 +1,176 @@
+#include "Scene.hpp"
+#include "Scene/RendererObjectManager.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace Stone;
+using namespace Stone::Scene;
+
+namespace {
+
+std::shared_ptr<Node> roundTrip(const std::shared_ptr<Node> &root) {
+	std::vector<char> data;
+	SceneArchive::write(root, data);
+	return SceneArchive::read(std::string_view(data.data(), data.size()));
+}
+
+/** Marks the renderables as up to date, like a renderer after creating their renderer objects */
+class CleanRendererObjectManager : public RendererObjectManager {
+public:
+	static void clean(IRenderable *renderable) {
+		markElementUndirty(renderable);
+	}
+};
+
+std::shared_ptr<Material> makeMaterial(float roughness) {
+	auto material = std::make_shared<Material>();
+	material->setVectorParameter("tint", glm::vec3(1.0f, 0.5f, 0.25f));
+	material->setScalarParameter("metallic", 0.0f);
+	material->setScalarParameter("roughness", roughness);
+	return material;
+}
+
+std::shared_ptr<WorldNode> makeWorld() {
+	auto world = WorldNode::create();
+	auto mesh = std::make_shared<DynamicMesh>();
+	mesh->withElementsRef([](std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) {
+		vertices = {Vertex(glm::vec3(0.0f), glm::vec2(0.0f)), Vertex(glm::vec3(1.0f, 0.0f, 0.0f), glm::vec2(1.0f)),
+					Vertex(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.0f, 1.0f))};
+		indices = {0, 1, 2};
+	});
+
+	auto pivot = world->addChild<PivotNode>("pivot");
+	for (int index = 0; index < 3; ++index) {
+		auto meshNode = pivot->addChild<MeshNode>("mesh_" + std::to_string(index));
+		meshNode->setMesh(mesh);
+		meshNode->setMaterial(makeMaterial(0.5f));
+	}
+	auto camera = world->addChild<PerspectiveCameraNode>("camera");
+	world->setActiveCamera(camera);
+	world->addChild<PivotNode>("other")->addChild<PointLightNode>("light");
+	return world;
+}
+
+/** The stable IDs of the nodes with the stable ID of their parent, in pre-order */
+std::vector<std::pair<uint64_t, uint64_t>> hierarchy(const std::shared_ptr<Node> &root) {
+	std::vector<std::pair<uint64_t, uint64_t>> nodes;
+	root->traverseTopDown([&nodes](const std::shared_ptr<Node> &node) {
+		auto parent = node->getParent();
+		nodes.emplace_back(node->getStableId(), parent ? parent->getStableId() : 0);
+	});
+	return nodes;
+}
+
+} // namespace
+
+TEST(ScenePatch, ReloadedSceneIsUnchanged) {
+	auto world = roundTrip(makeWorld());
+	EXPECT_TRUE(ScenePatch::diff(world, roundTrip(world)).isEmpty());
+}
+
+TEST(ScenePatch, UpdatesChangedNodesOnly) {
+	auto world = std::static_pointer_cast<WorldNode>(roundTrip(makeWorld()));
+	auto pivot = world->getChild<PivotNode>("pivot");
+	auto kept = pivot->getChild<MeshNode>("mesh_0");
+	auto changed = pivot->getChild<MeshNode>("mesh_1");
+	auto keptMaterial = kept->getMaterial();
+	auto mesh = kept->getMesh();
+	world->traverseTopDown([](const std::shared_ptr<Node> &node) {
+		if (auto meshNode = std::dynamic_pointer_cast<MeshNode>(node)) {
+			CleanRendererObjectManager::clean(meshNode.get());
+			CleanRendererObjectManager::clean(meshNode->getMaterial().get());
+		}
+	});
+
+	auto edited = std::static_pointer_cast<WorldNode>(roundTrip(world));
+	edited->getChild<PivotNode>("pivot")->getTransform().setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+	edited->getChildByPath<MeshNode>("pivot/mesh_1")->setMaterial(makeMaterial(0.9f));
+	edited->getChildByPath("pivot/mesh_2")->getMetadatas()["tag"] = Json::string("door");
+	edited->getChild("camera")->setName("main_camera");
+
+	ScenePatch patch = ScenePatch::diff(world, edited);
+	ASSERT_EQ(patch.getOperations().size(), 4);
+	for (const auto &operation : patch.getOperations()) {
+		EXPECT_EQ(operation.type, ScenePatch::OperationType::Update);
+	}
+	patch.apply(world);
+
+	EXPECT_EQ(world->getChild<PivotNode>("pivot"), pivot);
+	EXPECT_EQ(pivot->getTransform().getPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+	EXPECT_EQ(pivot->getChild("mesh_2")->getMetadatas()["tag"].get<std::string>(), "door");
+	EXPECT_NE(world->getChild<CameraNode>("main_camera"), nullptr);
+
+	// Equal resources of the edited scene are not swapped in, so the renderer objects are kept
+	EXPECT_FALSE(kept->isDirty());
+	EXPECT_EQ(kept->getMaterial(), keptMaterial);
+	EXPECT_EQ(changed->getMesh(), mesh);
+	EXPECT_TRUE(changed->isDirty());
+	EXPECT_EQ(changed->getMaterial()->getScalarParameter("roughness"), 0.9f);
+	EXPECT_FALSE(keptMaterial->isDirty());
+
+	EXPECT_TRUE(ScenePatch::diff(world, edited).isEmpty());
+}
+
+TEST(ScenePatch, AddsRemovesAndMovesNodes) {
+	auto world = std::static_pointer_cast<WorldNode>(roundTrip(makeWorld()));
+	auto light = world->getChildByPath<PointLightNode>("other/light");
+
+	auto edited = std::static_pointer_cast<WorldNode>(roundTrip(world));
+	auto editedPivot = edited->getChild<PivotNode>("pivot");
+	auto editedLight = edited->getChildByPath("other/light");
+	editedLight->removeFromParent();
+	editedPivot->addChild(editedLight);
+	edited->getChild("other")->removeFromParent();
+	editedPivot->removeChild(editedPivot->getChild("mesh_0"));
+	auto added = editedPivot->addChild<PivotNode>("added");
+	added->getTransform().setScale(glm::vec3(2.0f));
+	added->addChild<SpotLightNode>("spot")->setIntensity(3.0f);
+	auto camera = edited->addChild<OrthographicCameraNode>("ortho");
+	edited->setActiveCamera(camera);
+
+	ScenePatch::diff(world, edited).apply(world);
+
+	EXPECT_EQ(hierarchy(world), hierarchy(edited));
+	auto pivot = world->getChild<PivotNode>("pivot");
+	EXPECT_EQ(pivot->getChild<PointLightNode>("light"), light);
+	EXPECT_EQ(light->getParent(), pivot);
+	EXPECT_EQ(light->getWorld(), world);
+
+	auto spot = world->getChildByPath<SpotLightNode>("pivot/added/spot");
+	ASSERT_NE(spot, nullptr);
+	EXPECT_EQ(spot->getIntensity(), 3.0f);
+	EXPECT_EQ(spot->getWorld(), world);
+	EXPECT_NE(spot, edited->getChildByPath("pivot/added/spot"));
+	EXPECT_EQ(pivot->getChild<PivotNode>("added")->getTransform().getScale(), glm::vec3(2.0f));
+
+	EXPECT_EQ(world->getActiveCamera(), world->getChild<OrthographicCameraNode>("ortho"));
+	EXPECT_TRUE(ScenePatch::diff(world, edited).isEmpty());
+}
+
+TEST(ScenePatch, ClassChangeReplacesNode) {
+	auto world = roundTrip(makeWorld());
+	auto edited = roundTrip(world);
+
+	auto camera = edited->getChild("camera");
+	auto replacement = std::make_shared<OrthographicCameraNode>("camera");
+	replacement->setStableId(camera->getStableId());
+	camera->removeFromParent();
+	edited->addChild(replacement);
+
+	ScenePatch::diff(world, edited).apply(world);
+	EXPECT_NE(world->getChild<OrthographicCameraNode>("camera"), nullptr);
+	EXPECT_EQ(hierarchy(world), hierarchy(edited));
+}
+
+TEST(ScenePatch, InvalidScenesThrowException) {
+	auto world = roundTrip(makeWorld());
+	auto edited = roundTrip(world);
+	edited->getChild("camera")->setStableId(edited->getChild("pivot")->getStableId());
+	EXPECT_THROW(ScenePatch::diff(world, edited), std::runtime_error);
+	EXPECT_THROW(ScenePatch::diff(world, std::make_shared<PivotNode>()), std::runtime_error);
+
+	edited = roundTrip(world);
+	edited->getChild("other")->removeFromParent();
+	ScenePatch patch = ScenePatch::diff(world, edited);
+	EXPECT_THROW(patch.apply(makeWorld()), std::runtime_error);
+}
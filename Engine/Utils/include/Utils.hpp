@@ -4,6 +4,10 @@
 
 #include "Utils/CurveFunction.hpp"
 #include "Utils/Delegate.hpp"
-#include "Utils/DynamicObjectFactory.hpp"
 #include "Utils/Glm.hpp"
+#include "Utils/JsonDocument.hpp"
+#include "Utils/JsonMessagePack.hpp"
+#include "Utils/JsonStream.hpp"
 #include "Utils/SigSlot.hpp"
+#include "Utils/SmallStack.hpp"
+#include "Utils/StringId.hpp"
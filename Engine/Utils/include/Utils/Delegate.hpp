@@ -0,0 +1,127 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Stone {
+
+template <typename Signature, std::size_t Capacity = 4 * sizeof(void *)>
+class Delegate;
+
+/**
+ * @brief A move-only callable wrapper storing small callables inline.
+ *
+ * Unlike `std::function`, callables up to `Capacity` bytes, like lambdas capturing a few references or a bound member
+ * function, never allocate. Larger callables are stored on the heap.
+ *
+ * @tparam R The return type of the callable.
+ * @tparam Args The argument types of the callable.
+ * @tparam Capacity The size of the inline storage.
+ */
+template <typename R, typename... Args, std::size_t Capacity>
+class Delegate<R(Args...), Capacity> {
+public:
+	Delegate() = default;
+
+	template <typename F>
+		requires(!std::is_same_v<std::decay_t<F>, Delegate> && std::is_invocable_r_v<R, std::decay_t<F> &, Args...>)
+	Delegate(F &&fn) { // NOLINT(google-explicit-constructor)
+		using Callable = std::decay_t<F>;
+		if constexpr (_storedInline<Callable>()) {
+			new (_buffer) Callable(std::forward<F>(fn));
+			_operations = &_inlineOperations<Callable>;
+		} else {
+			*reinterpret_cast<Callable **>(_buffer) = new Callable(std::forward<F>(fn));
+			_operations = &_heapOperations<Callable>;
+		}
+	}
+
+	Delegate(const Delegate &) = delete;
+	Delegate &operator=(const Delegate &) = delete;
+
+	Delegate(Delegate &&other) noexcept {
+		_moveFrom(other);
+	}
+
+	Delegate &operator=(Delegate &&other) noexcept {
+		if (this != &other) {
+			_reset();
+			_moveFrom(other);
+		}
+		return *this;
+	}
+
+	~Delegate() {
+		_reset();
+	}
+
+	explicit operator bool() const {
+		return _operations != nullptr;
+	}
+
+	R operator()(Args... args) const {
+		return _operations->invoke(const_cast<std::byte *>(_buffer), std::forward<Args>(args)...);
+	}
+
+private:
+	struct Operations {
+		R (*invoke)(std::byte *buffer, Args &&...args);
+		void (*move)(std::byte *from, std::byte *to);
+		void (*destroy)(std::byte *buffer);
+	};
+
+	template <typename Callable>
+	static constexpr bool _storedInline() {
+		return sizeof(Callable) <= Capacity && alignof(Callable) <= alignof(std::max_align_t) &&
+			   std::is_nothrow_move_constructible_v<Callable>;
+	}
+
+	template <typename Callable>
+	static constexpr Operations _inlineOperations = {
+		[](std::byte *buffer, Args &&...args) -> R {
+			return std::invoke(*std::launder(reinterpret_cast<Callable *>(buffer)), std::forward<Args>(args)...);
+		},
+		[](std::byte *from, std::byte *to) {
+			auto *callable = std::launder(reinterpret_cast<Callable *>(from));
+			new (to) Callable(std::move(*callable));
+			callable->~Callable();
+		},
+		[](std::byte *buffer) { std::launder(reinterpret_cast<Callable *>(buffer))->~Callable(); },
+	};
+
+	template <typename Callable>
+	static constexpr Operations _heapOperations = {
+		[](std::byte *buffer, Args &&...args) -> R {
+			return std::invoke(**reinterpret_cast<Callable **>(buffer), std::forward<Args>(args)...);
+		},
+		[](std::byte *from, std::byte *to) {
+			*reinterpret_cast<Callable **>(to) = *reinterpret_cast<Callable **>(from);
+		},
+		[](std::byte *buffer) { delete *reinterpret_cast<Callable **>(buffer); },
+	};
+
+	alignas(std::max_align_t) std::byte _buffer[Capacity < sizeof(void *) ? sizeof(void *) : Capacity] = {};
+	const Operations *_operations = nullptr;
+
+	void _moveFrom(Delegate &other) {
+		if (other._operations != nullptr) {
+			other._operations->move(other._buffer, _buffer);
+			_operations = other._operations;
+			other._operations = nullptr;
+		}
+	}
+
+	void _reset() {
+		if (_operations != nullptr) {
+			_operations->destroy(_buffer);
+			_operations = nullptr;
+		}
+	}
+};
+
+} // namespace Stone
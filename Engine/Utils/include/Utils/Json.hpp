@@ -5,6 +5,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -47,7 +48,7 @@ struct Value {
 		return std::get<T>(value);
 	}
 
-	static void parseString(const std::string &input, Value &out);
+	static void parseString(std::string_view input, Value &out);
 	static void parseFile(const std::string &path, Value &out);
 	std::string serialize() const;
 };
@@ -77,41 +78,78 @@ enum class TokenType {
 
 std::string to_string(TokenType type);
 
+/**
+ * @brief A token of the input, its value is a view in the input and is not decoded.
+ *
+ * The value of a string token is its content without the quotes, escaped is set when it holds escape sequences.
+ */
 struct Token {
-	TokenType type;
-	std::string value;
+	TokenType type = TokenType::EndOfFile;
+	std::string_view value;
+	bool escaped = false;
 };
 
+/**
+ * @brief Split a Json text in tokens, in a single pass and without allocation.
+ */
 class Lexer {
 public:
-	explicit Lexer(const std::string &input);
+	explicit Lexer(std::string_view input);
 
 	Token nextToken();
 
+	/**
+	 * @brief The offset in the input of the next character to read.
+	 */
+	[[nodiscard]] std::size_t position() const {
+		return _pos;
+	}
+
 private:
-	const std::string &_input;
+	std::string_view _input;
 	std::size_t _pos = 0;
 
 	Token _stringToken();
-	Token _otherTokens();
+	Token _keywordToken(std::string_view keyword, TokenType type);
 	Token _numberToken();
+
+	[[noreturn]] void _error(const std::string &message) const;
 };
 
+/**
+ * @brief Build a Value from a Json text, numbers are read with std::from_chars and escapes are decoded to UTF-8.
+ */
 class Parser {
 public:
-	explicit Parser(const std::string &input);
+	/** The deepest nesting of arrays and objects accepted, deeper inputs throw instead of overflowing the stack. */
+	static constexpr std::size_t maxDepth = 512;
+
+	explicit Parser(std::string_view input);
 
 	void parse(Value &out);
 
+	/**
+	 * @brief Decode the escape sequences of the value of a string token.
+	 */
+	static void decodeString(const Token &token, std::string &out);
+
+	/**
+	 * @brief Read the value of a number token.
+	 */
+	static double decodeNumber(const Token &token);
+
 private:
 	Lexer _lexer;
 	Token _currentToken;
+	std::size_t _depth = 0;
 
 	void _parseValue(Value &out);
 	void _parseObject(Value &out);
 	void _parseArray(Value &out);
 	void _parsePrimitive(Value &out);
 	void _consume(TokenType expected);
+
+	[[noreturn]] void _unexpectedToken(const std::string &expected) const;
 };
 
 class Serializer {
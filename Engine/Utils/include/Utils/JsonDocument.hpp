@@ -0,0 +1,388 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Utils/Json.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace Stone::Json {
+
+/**
+ * @brief The process wide set of the keys of Json documents.
+ *
+ * A key is stored once whatever the number of documents and objects using it, documents keep views to it.
+ * Interned keys are never released, which suits the small and stable key sets of metadata and configuration files.
+ */
+class KeyPool {
+public:
+	/**
+	 * @brief Get the interned copy of a key, adding it to the pool if it is not in yet.
+	 * @return A view valid until the end of the program.
+	 */
+	static std::string_view intern(std::string_view key);
+
+	/**
+	 * @brief The number of distinct keys in the pool.
+	 */
+	static std::size_t size();
+};
+
+/**
+ * @brief The kind of a value of a Document.
+ */
+enum class Kind : uint8_t {
+	Object,
+	Array,
+	String,
+	Number,
+	Boolean,
+	Null,
+};
+
+class Document;
+class DocumentBuilder;
+class ValueView;
+class ArrayView;
+class ObjectView;
+
+/**
+ * @brief The read-only view returned by ValueView::get for each type accepted by Value::get.
+ */
+template <typename T>
+struct ViewTraits;
+
+/**
+ * @brief A compact and immutable Json DOM.
+ *
+ * Values are stored in a few contiguous arrays instead of one allocation per node: the elements of an array are
+ * contiguous, the members of an object are contiguous and sorted by key, strings are packed in a single buffer and keys
+ * are interned in the KeyPool. A document is built once, from a Json text or from a Value, and read through views.
+ *
+ * Views point into the document, they are invalidated when it is destroyed, moved or assigned.
+ */
+class Document {
+public:
+	Document();
+
+	/**
+	 * @brief Build a document holding a copy of the given value.
+	 */
+	explicit Document(const Value &value);
+
+	static void parseString(std::string_view input, Document &out);
+	static void parseFile(const std::string &path, Document &out);
+
+	/**
+	 * @brief Get the root value of the document.
+	 */
+	[[nodiscard]] ValueView getRoot() const;
+
+	/**
+	 * @brief Convert the document to a mutable Value.
+	 */
+	[[nodiscard]] Value toValue() const;
+
+	/**
+	 * @brief The number of bytes allocated by the document, without the interned keys.
+	 */
+	[[nodiscard]] std::size_t getMemoryUsage() const;
+
+private:
+	friend class DocumentBuilder;
+	friend class ValueView;
+	friend class ArrayView;
+	friend class ObjectView;
+
+	struct Entry {
+		Kind kind = Kind::Null;
+		/** Number of elements of an array or members of an object, length of a string */
+		uint32_t size = 0;
+		union {
+			double number;
+			/** First element of an array in _values, first member of an object in _members, offset of a string in
+			 * _strings, 0 or 1 for a boolean */
+			uint64_t index = 0;
+		};
+	};
+
+	struct Member {
+		std::string_view key;
+		Entry value;
+	};
+
+	Entry _root;
+	std::vector<Entry> _values;
+	std::vector<Member> _members;
+	std::vector<char> _strings;
+};
+
+/**
+ * @brief A read-only view of a value of a Document, with the same getters as Value.
+ *
+ * get<Object>() returns an ObjectView, get<Array>() an ArrayView and get<std::string>() a std::string_view.
+ */
+class ValueView {
+public:
+	ValueView() = default;
+
+	[[nodiscard]] Kind getKind() const {
+		return _entry == nullptr ? Kind::Null : _entry->kind;
+	}
+
+	template <typename T>
+	[[nodiscard]] bool is() const {
+		return getKind() == ViewTraits<T>::kind;
+	}
+
+	[[nodiscard]] bool isNull() const {
+		return getKind() == Kind::Null;
+	}
+
+	/**
+	 * @brief Get the value as T, throws std::bad_variant_access when it holds another type, like Value::get.
+	 */
+	template <typename T>
+	[[nodiscard]] typename ViewTraits<T>::Type get() const;
+
+	/**
+	 * @brief Copy the value and its children to a mutable Value.
+	 */
+	[[nodiscard]] Value toValue() const;
+
+private:
+	friend class Document;
+	friend class ArrayView;
+	friend class ObjectView;
+
+	ValueView(const Document *document, const Document::Entry *entry) : _document(document), _entry(entry) {
+	}
+
+	const Document *_document = nullptr;
+	const Document::Entry *_entry = nullptr;
+};
+
+/**
+ * @brief A read-only view of an array of a Document.
+ */
+class ArrayView {
+public:
+	class Iterator {
+	public:
+		using difference_type = std::ptrdiff_t;
+		using value_type = ValueView;
+
+		Iterator() = default;
+
+		ValueView operator*() const {
+			return {_document, _entry};
+		}
+
+		Iterator &operator++() {
+			++_entry;
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator previous = *this;
+			++_entry;
+			return previous;
+		}
+
+		bool operator==(const Iterator &other) const {
+			return _entry == other._entry;
+		}
+
+	private:
+		friend class ArrayView;
+
+		Iterator(const Document *document, const Document::Entry *entry) : _document(document), _entry(entry) {
+		}
+
+		const Document *_document = nullptr;
+		const Document::Entry *_entry = nullptr;
+	};
+
+	[[nodiscard]] std::size_t size() const {
+		return _size;
+	}
+
+	[[nodiscard]] bool empty() const {
+		return _size == 0;
+	}
+
+	ValueView operator[](std::size_t index) const {
+		return {_document, _elements + index};
+	}
+
+	/**
+	 * @brief Get an element, throws std::out_of_range when the index is not in the array.
+	 */
+	[[nodiscard]] ValueView at(std::size_t index) const;
+
+	[[nodiscard]] Iterator begin() const {
+		return {_document, _elements};
+	}
+
+	[[nodiscard]] Iterator end() const {
+		return {_document, _elements + _size};
+	}
+
+private:
+	friend class ValueView;
+
+	ArrayView(const Document *document, const Document::Entry *elements, std::size_t size)
+		: _document(document), _elements(elements), _size(size) {
+	}
+
+	const Document *_document;
+	const Document::Entry *_elements;
+	std::size_t _size;
+};
+
+/**
+ * @brief A read-only view of an object of a Document, members are iterated in the order of their keys.
+ */
+class ObjectView {
+public:
+	class Iterator {
+	public:
+		using difference_type = std::ptrdiff_t;
+		using value_type = std::pair<std::string_view, ValueView>;
+
+		Iterator() = default;
+
+		value_type operator*() const {
+			return {_member->key, ValueView(_document, &_member->value)};
+		}
+
+		Iterator &operator++() {
+			++_member;
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator previous = *this;
+			++_member;
+			return previous;
+		}
+
+		bool operator==(const Iterator &other) const {
+			return _member == other._member;
+		}
+
+	private:
+		friend class ObjectView;
+
+		Iterator(const Document *document, const Document::Member *member) : _document(document), _member(member) {
+		}
+
+		const Document *_document = nullptr;
+		const Document::Member *_member = nullptr;
+	};
+
+	[[nodiscard]] std::size_t size() const {
+		return _size;
+	}
+
+	[[nodiscard]] bool empty() const {
+		return _size == 0;
+	}
+
+	/**
+	 * @brief Find a member with a binary search on the sorted keys, returns end() when there is none.
+	 */
+	[[nodiscard]] Iterator find(std::string_view key) const;
+
+	[[nodiscard]] bool contains(std::string_view key) const {
+		return find(key) != end();
+	}
+
+	/**
+	 * @brief Get a member, throws std::out_of_range when the key is not in the object.
+	 */
+	[[nodiscard]] ValueView at(std::string_view key) const;
+
+	[[nodiscard]] Iterator begin() const {
+		return {_document, _members};
+	}
+
+	[[nodiscard]] Iterator end() const {
+		return {_document, _members + _size};
+	}
+
+private:
+	friend class ValueView;
+
+	ObjectView(const Document *document, const Document::Member *members, std::size_t size)
+		: _document(document), _members(members), _size(size) {
+	}
+
+	const Document *_document;
+	const Document::Member *_members;
+	std::size_t _size;
+};
+
+template <>
+struct ViewTraits<Object> {
+	using Type = ObjectView;
+	static constexpr Kind kind = Kind::Object;
+};
+
+template <>
+struct ViewTraits<Array> {
+	using Type = ArrayView;
+	static constexpr Kind kind = Kind::Array;
+};
+
+template <>
+struct ViewTraits<std::string> {
+	using Type = std::string_view;
+	static constexpr Kind kind = Kind::String;
+};
+
+template <>
+struct ViewTraits<double> {
+	using Type = double;
+	static constexpr Kind kind = Kind::Number;
+};
+
+template <>
+struct ViewTraits<bool> {
+	using Type = bool;
+	static constexpr Kind kind = Kind::Boolean;
+};
+
+template <>
+struct ViewTraits<std::nullptr_t> {
+	using Type = std::nullptr_t;
+	static constexpr Kind kind = Kind::Null;
+};
+
+template <typename T>
+typename ViewTraits<T>::Type ValueView::get() const {
+	if (!is<T>()) {
+		throw std::bad_variant_access();
+	}
+	if constexpr (std::is_same_v<T, Object>) {
+		return ObjectView(_document, _document->_members.data() + _entry->index, _entry->size);
+	} else if constexpr (std::is_same_v<T, Array>) {
+		return ArrayView(_document, _document->_values.data() + _entry->index, _entry->size);
+	} else if constexpr (std::is_same_v<T, std::string>) {
+		return {_document->_strings.data() + _entry->index, _entry->size};
+	} else if constexpr (std::is_same_v<T, double>) {
+		return _entry->number;
+	} else if constexpr (std::is_same_v<T, bool>) {
+		return _entry->index != 0;
+	} else {
+		return nullptr;
+	}
+}
+
+} // namespace Stone::Json
@@ -0,0 +1,48 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Utils/Json.hpp"
+#include "Utils/JsonStream.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Stone::Json {
+
+/**
+ * @brief Encode a value in MessagePack, appending to the output.
+ *
+ * Numbers holding an integer are written as the smallest MessagePack integer, others as a float32 when it keeps the
+ * exact value and as a float64 otherwise.
+ */
+void toMessagePack(const Value &value, std::vector<char> &out);
+
+/**
+ * @brief Encode an object in MessagePack, appending to the output, without copying it in a Value.
+ */
+void toMessagePack(const Object &object, std::vector<char> &out);
+
+/**
+ * @brief Encode a value in MessagePack.
+ */
+std::vector<char> toMessagePack(const Value &value);
+
+/**
+ * @brief Decode a MessagePack value, throws if the data is truncated, has trailing bytes or holds types Json has not.
+ *
+ * Integers are converted to double, binary data to string, and map keys must be strings.
+ */
+void fromMessagePack(std::string_view data, Value &out);
+
+/**
+ * @brief Report a MessagePack value to a handler, without copying it.
+ *
+ * The views given to the handler point in the data.
+ *
+ * @return The number of bytes read, a value can be followed by others.
+ */
+std::size_t readMessagePack(std::string_view data, Handler &handler);
+
+} // namespace Stone::Json
@@ -0,0 +1,199 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Utils/Json.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Stone::Json {
+
+/**
+ * @brief Receive the events of a StreamReader, in the order of the Json text.
+ *
+ * Every event is ignored by default. Views given to the events are only valid during the call.
+ * Throwing from an event stops the reading.
+ */
+class Handler {
+public:
+	virtual ~Handler() = default;
+
+	virtual void startObject() {
+	}
+
+	virtual void key(std::string_view key) {
+		(void)key;
+	}
+
+	virtual void endObject() {
+	}
+
+	virtual void startArray() {
+	}
+
+	virtual void endArray() {
+	}
+
+	virtual void string(std::string_view value) {
+		(void)value;
+	}
+
+	virtual void number(double value) {
+		(void)value;
+	}
+
+	virtual void boolean(bool value) {
+		(void)value;
+	}
+
+	virtual void null() {
+	}
+};
+
+/**
+ * @brief Parse a Json text given in chunks of any size, and report it to a Handler as it goes.
+ *
+ * Nothing is kept from the parsed values: the memory used is bounded by the size of a chunk, the size of the largest
+ * string or number and the nesting depth, whatever the size of the input.
+ */
+class StreamReader {
+public:
+	static constexpr std::size_t defaultChunkSize = 64 * 1024;
+
+	/**
+	 * @param handler The handler receiving the events.
+	 * @param multipleValues Accept a sequence of root values, as in Json Lines logs, instead of a single one.
+	 */
+	explicit StreamReader(Handler &handler, bool multipleValues = false);
+
+	/**
+	 * @brief Parse the next chunk of the input, a token may be split between several chunks.
+	 */
+	void feed(std::string_view chunk);
+
+	/**
+	 * @brief Parse the end of the input, throws if the Json text is not complete.
+	 */
+	void finish();
+
+	/**
+	 * @brief The number of bytes of the input parsed so far, without the partial token kept for the next chunk.
+	 */
+	[[nodiscard]] std::size_t getOffset() const {
+		return _offset;
+	}
+
+	static void parseStream(std::istream &stream, Handler &handler, bool multipleValues = false,
+							std::size_t chunkSize = defaultChunkSize);
+	static void parseFile(const std::string &path, Handler &handler, bool multipleValues = false,
+						  std::size_t chunkSize = defaultChunkSize);
+
+private:
+	enum class State : uint8_t {
+		Value,
+		FirstValueOrEnd,
+		FirstKeyOrEnd,
+		Key,
+		Colon,
+		CommaOrEnd,
+		Done,
+	};
+
+	Handler &_handler;
+	bool _multipleValues;
+	State _state = State::Value;
+	/** The open containers, LeftBrace or LeftBracket */
+	std::vector<TokenType> _containers;
+
+	/** The start of a token split between chunks */
+	std::string _buffer;
+	/** Where to continue searching the end of a split string, to not scan it again with each chunk */
+	std::size_t _scanned = 0;
+	std::size_t _offset = 0;
+	std::string _decoded;
+
+	std::size_t _parse(std::string_view input, bool last);
+	bool _nextToken(std::string_view input, std::size_t &pos, Token &token, bool last);
+	void _handleToken(const Token &token, std::size_t tokenOffset);
+	void _handleValue(const Token &token, std::size_t tokenOffset);
+	void _afterValue();
+	void _close();
+	std::string_view _decode(const Token &token);
+
+	[[noreturn]] void _error(const std::string &message, std::size_t offset) const;
+};
+
+/**
+ * @brief Write a Json text piece by piece to a stream or a string, without building a Value.
+ *
+ * Output to a stream goes through a buffer of fixed size. The writer is also a Handler, so that a StreamReader can be
+ * piped to it. Calls breaking the structure of the document, like a value without a key in an object, throw.
+ */
+class StreamWriter : public Handler {
+public:
+	static constexpr std::size_t defaultBufferSize = 64 * 1024;
+
+	explicit StreamWriter(std::ostream &stream, std::size_t bufferSize = defaultBufferSize);
+
+	/**
+	 * @brief Append the Json text to a string.
+	 */
+	explicit StreamWriter(std::string &output);
+
+	StreamWriter(const StreamWriter &) = delete;
+
+	~StreamWriter() override;
+
+	StreamWriter &operator=(const StreamWriter &) = delete;
+
+	void startObject() override;
+	void key(std::string_view key) override;
+	void endObject() override;
+	void startArray() override;
+	void endArray() override;
+	void string(std::string_view value) override;
+	void number(double value) override;
+	void boolean(bool value) override;
+	void null() override;
+
+	/**
+	 * @brief Write a whole value.
+	 */
+	void value(const Value &value);
+
+	/**
+	 * @brief Write the buffered text to the stream.
+	 */
+	void flush();
+
+	/**
+	 * @brief Whether the root value is written and every object and array is closed.
+	 */
+	[[nodiscard]] bool isComplete() const;
+
+private:
+	struct Scope {
+		bool object;
+		bool empty = true;
+		bool hasKey = false;
+	};
+
+	std::ostream *_stream = nullptr;
+	std::string _buffer;
+	std::size_t _bufferSize = 0;
+	/** The buffer, or the output string */
+	std::string *_out;
+
+	std::vector<Scope> _scopes;
+	bool _rootWritten = false;
+
+	void _beforeValue();
+	void _afterValue();
+	void _writeString(std::string_view value);
+};
+
+} // namespace Stone::Json
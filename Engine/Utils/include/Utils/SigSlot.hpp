@@ -2,22 +2,69 @@
 
 #pragma once
 
-#include <functional>
-#include <unordered_set>
+#include "Utils/Delegate.hpp"
+#include "Utils/DispatchQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
 
 namespace Stone {
 
+template <typename... Args>
+struct Slot;
+
 template <typename... Args>
 struct Signal;
 
+template <typename... Args>
+struct ConcurrentSignal;
+
+/**
+ * @brief How a slot bound with a dispatch queue receives the events broadcast while its delivery is pending.
+ */
+enum class QueuedDelivery {
+	All,   ///< Every event is delivered, in broadcast order.
+	Latest ///< Only the latest event is delivered, the previous ones are dropped.
+};
+
+/**
+ * @brief The part of a signal used by its slots, to unbind from it without knowing its kind.
+ *
+ * @tparam Args The argument types of the event.
+ */
+template <typename... Args>
+struct ISignal {
+	virtual ~ISignal() = default;
+
+	/**
+	 * @brief Unbinds a slot from this signal.
+	 *
+	 * If the slot is not bound to this signal, nothing will happen.
+	 *
+	 * @param sub The slot to be unbound.
+	 */
+	virtual void unbind(Slot<Args...> &sub) = 0;
+};
+
 /**
  * @brief A class template representing a slot in an event system.
  *
  * This class template is used to create slots that can be bound to signals in an event system.
- * Slots are instancied with a callback like functions, lambda expressions, or member functions of a class.
+ * Slots are instancied with a callback like functions, lambda expressions, or member functions of a class. The callback
+ * is stored in a `Delegate`, small callbacks do not allocate.
  *
  * Slots can be bind to a (single) signal and will trigger its callback when the signal broadcasts an event.
  *
+ * A slot constructed with a dispatch queue is queued: a broadcast copies the event arguments and its callback is
+ * called later, by the thread executing the queue. The events broadcast before the queue executes are delivered by a
+ * single task. A queued slot must be destroyed by the thread executing its queue, it then receives no more events.
+ *
  * @tparam Args The argument types of the slot's callback function.
  */
 template <typename... Args>
@@ -27,20 +74,39 @@ struct Slot {
 	Slot &operator=(const Slot &) = delete;
 
 	/**
-	 * @brief Constructs a slot with a lambda expression as the callback.
+	 * @brief Constructs a slot with a callable as the callback.
+	 *
+	 * @param fn A function, a lambda expression or any callable taking the arguments of the slot.
+	 */
+	template <typename F>
+		requires(!std::is_same_v<std::decay_t<F>, Slot> && std::is_invocable_v<std::decay_t<F> &, Args...>)
+	explicit Slot(F &&fn) : _fn(std::forward<F>(fn)) {
+	}
+
+	/**
+	 * @brief Constructs a queued slot, whose callback is called by the thread executing a dispatch queue.
 	 *
-	 * @param fn A lambda expression representing the callback function.
+	 * @param fn A function, a lambda expression or any callable taking the arguments of the slot.
+	 * @param queue The dispatch queue executing the callback, it must outlive the slot.
+	 * @param delivery Whether the events broadcast while a delivery is pending are all delivered or only the latest.
 	 */
-	explicit Slot(std::function<void(Args...)> fn) : _fn(std::move(fn)), _signal(nullptr) {
+	template <typename F>
+		requires(std::is_invocable_v<std::decay_t<F> &, Args...>)
+	Slot(F &&fn, DispatchQueue &queue, QueuedDelivery delivery = QueuedDelivery::All)
+		: _fn(std::forward<F>(fn)), _queued(std::make_shared<Queued>(*this, queue, delivery)) {
 	}
 
 	/**
 	 * @brief Destructor.
 	 *
-	 * Unbinds the slot from the signal.
+	 * Unbinds the slot from the signal, and drops its pending queued events.
 	 */
 	virtual ~Slot() {
 		unbind();
+		if (_queued != nullptr) {
+			std::lock_guard lock(_queued->mutex);
+			_queued->slot = nullptr;
+		}
 	}
 
 	/**
@@ -71,23 +137,99 @@ struct Slot {
 		}
 	}
 
+	/**
+	 * @brief Checks whether the slot is bound to a signal.
+	 */
+	[[nodiscard]] bool isBound() const {
+		return _signal != nullptr;
+	}
+
+	/**
+	 * @brief Checks whether the slot receives the events through a dispatch queue.
+	 */
+	[[nodiscard]] bool isQueued() const {
+		return _queued != nullptr;
+	}
+
 private:
-	std::function<void(Args...)> _fn; ///< The callback function of the slot.
+	/** The events waiting for the dispatch queue of a queued slot, shared with the task delivering them. */
+	struct Queued {
+		Queued(Slot &slot, DispatchQueue &queue, QueuedDelivery delivery)
+			: slot(&slot), queue(queue), delivery(delivery) {
+		}
+
+		std::mutex mutex;
+		Slot *slot; ///< Null once the slot is destroyed.
+		DispatchQueue &queue;
+		QueuedDelivery delivery;
+		std::vector<std::tuple<std::decay_t<Args>...>> events;
+		bool scheduled = false; ///< Whether a task delivering the events is in the queue.
+	};
 
-	Signal<Args...> *_signal; ///< The signal that the slot is bound to.
+	Delegate<void(Args...)> _fn; ///< The callback function of the slot.
+
+	ISignal<Args...> *_signal = nullptr; ///< The signal that the slot is bound to.
+	std::size_t _index = 0;				 ///< The position of the slot in the slots of its Signal.
+	std::shared_ptr<Queued> _queued;	 ///< The pending events, if the slot is queued.
 	friend Signal<Args...>;
+	friend ConcurrentSignal<Args...>;
+
+	/**
+	 * @brief Receives an event broadcast by the signal, calling the callback now or from the dispatch queue.
+	 *
+	 * The arguments are only copied for queued slots, to be delivered later.
+	 */
+	void _receive(const Args &...args) {
+		if (_queued == nullptr) {
+			perform(args...);
+			return;
+		}
+		bool schedule;
+		{
+			std::lock_guard lock(_queued->mutex);
+			if (_queued->delivery == QueuedDelivery::Latest)
+				_queued->events.clear();
+			_queued->events.emplace_back(args...);
+			schedule = !std::exchange(_queued->scheduled, true);
+		}
+		if (schedule)
+			_queued->queue.async(DispatchQueue::TaskType([queued = _queued] { _deliver(*queued); }));
+	}
+
+	static void _deliver(Queued &queued) {
+		std::vector<std::tuple<std::decay_t<Args>...>> events;
+		{
+			std::lock_guard lock(queued.mutex);
+			events.swap(queued.events);
+			queued.scheduled = false;
+		}
+		for (auto &event : events) {
+			// Checked for each event, as the callback may destroy the slot
+			Slot *slot;
+			{
+				std::lock_guard lock(queued.mutex);
+				slot = queued.slot;
+			}
+			if (slot == nullptr)
+				return;
+			std::apply([slot](auto &...values) { slot->perform(values...); }, event);
+		}
+	}
 };
 
 /**
  * @brief The Signal class is responsible for managing slots and broadcasting events.
  *
  * A signal can bind multiple slots.
- * When broadcasting a signal, it will trigger all bound slots once.
+ * When broadcasting a signal, it will trigger all bound slots once, in the order they were bound.
+ *
+ * Slots can be bound and unbound while the signal broadcasts: an unbound slot is not triggered anymore, and a bound
+ * slot is triggered from the next broadcast. The signal must only be used from one thread, see `ConcurrentSignal`.
  *
  * @tparam Args The argument types of the event.
  */
 template <typename... Args>
-struct Signal {
+struct Signal : ISignal<Args...> {
 
 	Signal(const Signal &) = delete;
 	Signal &operator=(const Signal &) = delete;
@@ -98,7 +240,7 @@ struct Signal {
 	 * @brief Destructor to clean up the Signal object.
 	 *        It removes the Signal reference from all slots.
 	 */
-	virtual ~Signal() {
+	~Signal() override {
 		for (auto &slot : _slots) {
 			if (slot != nullptr && slot->_signal == this)
 				slot->_signal = nullptr;
@@ -111,9 +253,15 @@ struct Signal {
 	 * @param args The arguments to be passed to the slots.
 	 */
 	void broadcast(Args... args) const {
-		for (auto &slot : _slots) {
+		if (_slots.empty())
+			return;
+		EmissionScope scope(*this);
+		// Slots bound during the broadcast are added after this count
+		const std::size_t count = _slots.size();
+		for (std::size_t index = 0; index < count; ++index) {
+			Slot<Args...> *slot = _slots[index];
 			if (slot != nullptr)
-				slot->perform(std::forward<Args>(args)...);
+				slot->_receive(args...);
 		}
 	}
 
@@ -133,9 +281,12 @@ struct Signal {
 	 * @param sub The slot to be bound.
 	 */
 	void bind(Slot<Args...> &sub) {
+		if (sub._signal == this)
+			return;
 		sub.unbind();
 		sub._signal = this;
-		_slots.insert(&sub);
+		sub._index = _slots.size();
+		_slots.push_back(&sub);
 	}
 
 	/**
@@ -145,15 +296,280 @@ struct Signal {
 	 *
 	 * @param sub The slot to be unbound.
 	 */
-	void unbind(Slot<Args...> &sub) {
-		if (sub._signal == this) {
+	void unbind(Slot<Args...> &sub) override {
+		if (sub._signal != this)
+			return;
+		sub._signal = nullptr;
+		_slots[sub._index] = nullptr;
+		++_tombstones;
+		_compactIfNeeded();
+	}
+
+	/**
+	 * @brief Counts the slots bound to this Signal.
+	 */
+	[[nodiscard]] std::size_t getSlotCount() const {
+		return _slots.size() - _tombstones;
+	}
+
+private:
+	/** The slots bound to this Signal in binding order, null for the slots unbound since the last compaction. */
+	mutable std::vector<Slot<Args...> *> _slots;
+	mutable std::size_t _tombstones = 0; ///< The count of null slots.
+	mutable int _emissions = 0;			 ///< The count of broadcasts in progress, nested in slots.
+
+	struct EmissionScope {
+		explicit EmissionScope(const Signal &signal) : signal(signal) {
+			++signal._emissions;
+		}
+
+		~EmissionScope() {
+			--signal._emissions;
+			signal._compactIfNeeded();
+		}
+
+		const Signal &signal;
+	};
+
+	/** Removes the null slots once they are half of the slots, unless a broadcast iterates them. */
+	void _compactIfNeeded() const {
+		if (_emissions > 0 || _tombstones == 0 || _tombstones * 2 < _slots.size())
+			return;
+		std::size_t count = 0;
+		for (Slot<Args...> *slot : _slots) {
+			if (slot != nullptr) {
+				slot->_index = count;
+				_slots[count++] = slot;
+			}
+		}
+		_slots.resize(count);
+		_tombstones = 0;
+	}
+};
+
+/**
+ * @brief A signal that can broadcast from any thread.
+ *
+ * Broadcasting never locks: it iterates an immutable snapshot of the bindings, read through a raw atomic pointer, after
+ * registering in one of the two reader counters of the signal. It is lock-free but not wait-free, a broadcast retries
+ * its registration when the epoch advances at the same time, and every broadcast updates counters shared by the
+ * threads. Binding and unbinding publish a new snapshot under the mutex of the signal. The replaced snapshots are
+ * reclaimed by later publications, once the broadcasts that may still read them have ended, without waiting for them.
+ *
+ * Unbinding a slot, which its destructor does, waits for the calls of this slot's callback running on other threads,
+ * so that a slot is never triggered once destroyed. A callback must therefore not wait for a thread unbinding its own
+ * slot, which would deadlock. Callbacks may bind and unbind any slot, including their own.
+ *
+ * A slot callback runs on the broadcasting thread, it must be thread-safe when the signal is broadcast from several
+ * threads. A given slot must not be bound nor unbound from several threads at once.
+ *
+ * @tparam Args The argument types of the event.
+ */
+template <typename... Args>
+struct ConcurrentSignal : ISignal<Args...> {
+
+	ConcurrentSignal(const ConcurrentSignal &) = delete;
+	ConcurrentSignal &operator=(const ConcurrentSignal &) = delete;
+
+	ConcurrentSignal() = default;
+
+	~ConcurrentSignal() override {
+		std::lock_guard lock(_mutex);
+		BindingList *bindings = _bindings.load(std::memory_order_relaxed);
+		for (Binding *binding : *bindings) {
+			Slot<Args...> *slot = binding->slot.load(std::memory_order_relaxed);
+			if (slot != nullptr && slot->_signal == this)
+				slot->_signal = nullptr;
+			delete binding;
+		}
+		delete bindings;
+		_reclaim(std::numeric_limits<uint64_t>::max());
+	}
+
+	/**
+	 * @brief Broadcasts an event to all slots, from any thread.
+	 *
+	 * @param args The arguments to be passed to the slots.
+	 */
+	void broadcast(Args... args) const {
+		if (_count.load(std::memory_order_acquire) == 0)
+			return;
+		ReadScope scope(*this);
+		for (Binding *binding : *scope.bindings) {
+			CallScope call(*binding);
+			if (Slot<Args...> *slot = binding->slot.load(std::memory_order_seq_cst))
+				slot->_receive(args...);
+		}
+	}
+
+	/**
+	 * @brief Calls the broadcast function.
+	 */
+	void operator()(Args... args) {
+		broadcast(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Binds a slot to the signal, it is triggered by the broadcasts starting after this call.
+	 *        It unbinds the slot from any previous signal.
+	 *
+	 * @param sub The slot to be bound.
+	 */
+	void bind(Slot<Args...> &sub) {
+		if (sub._signal == this)
+			return;
+		sub.unbind();
+		std::lock_guard lock(_mutex);
+		sub._signal = this;
+		BindingList bindings = *_bindings.load(std::memory_order_relaxed);
+		bindings.push_back(new Binding(&sub));
+		_publish(std::move(bindings));
+	}
+
+	/**
+	 * @brief Unbinds a slot from the signal, waiting for the calls of its callback running on other threads.
+	 *
+	 * If the slot is not bound to this signal, nothing will happen.
+	 *
+	 * @param sub The slot to be unbound.
+	 */
+	void unbind(Slot<Args...> &sub) override {
+		Binding *binding;
+		{
+			std::lock_guard lock(_mutex);
+			if (sub._signal != this)
+				return;
 			sub._signal = nullptr;
-			_slots.erase(&sub);
+			BindingList bindings = *_bindings.load(std::memory_order_relaxed);
+			auto it = std::find_if(bindings.begin(), bindings.end(), [&sub](const Binding *binding) {
+				return binding->slot.load(std::memory_order_relaxed) == &sub;
+			});
+			binding = *it;
+			bindings.erase(it);
+			// Broadcasts still iterating an older snapshot read the null slot and skip it
+			binding->slot.store(nullptr, std::memory_order_seq_cst);
+			binding->unbinding.store(true, std::memory_order_seq_cst);
+			_publish(std::move(bindings));
+		}
+
+		// Retired only after the wait, so that it is reclaimed after the broadcasts that read it
+		const auto own = std::count(_callingBindings.begin(), _callingBindings.end(), binding);
+		for (int calls = binding->calls.load(std::memory_order_seq_cst); calls > own;
+			 calls = binding->calls.load(std::memory_order_seq_cst)) {
+			binding->calls.wait(calls, std::memory_order_seq_cst);
 		}
+
+		std::lock_guard lock(_mutex);
+		_retiredBindings.push_back({binding, _epoch.load(std::memory_order_relaxed)});
+	}
+
+	/**
+	 * @brief Counts the slots bound to the signal.
+	 */
+	[[nodiscard]] std::size_t getSlotCount() const {
+		return _count.load(std::memory_order_acquire);
 	}
 
 private:
-	std::unordered_set<Slot<Args...> *> _slots; ///< The set of slots bound to this Signal.
+	/** A bound slot, shared by the snapshots listing it and reclaimed with them. */
+	struct Binding {
+		explicit Binding(Slot<Args...> *slot) : slot(slot) {
+		}
+
+		std::atomic<Slot<Args...> *> slot; ///< Null once unbound.
+		std::atomic<int> calls = 0;		   ///< The broadcasts calling the slot.
+		std::atomic<bool> unbinding = false;
+	};
+
+	using BindingList = std::vector<Binding *>;
+
+	template <typename T>
+	struct Retired {
+		T *pointer;
+		uint64_t epoch; ///< The epoch when it was replaced, it is reclaimed two epochs later.
+	};
+
+	/** The bindings whose callback this thread is calling, to not wait for them when unbinding from a callback. */
+	static inline thread_local std::vector<const Binding *> _callingBindings;
+
+	/** Registers a broadcast in the reader counter of the current epoch, while it reads a snapshot. */
+	struct ReadScope {
+		explicit ReadScope(const ConcurrentSignal &signal) : signal(signal) {
+			for (;;) {
+				epoch = signal._epoch.load(std::memory_order_seq_cst);
+				signal._readers[epoch & 1].fetch_add(1, std::memory_order_seq_cst);
+				// Once registered in the epoch still current, the epoch cannot advance twice before this scope ends
+				if (signal._epoch.load(std::memory_order_seq_cst) == epoch)
+					break;
+				signal._readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+			}
+			bindings = signal._bindings.load(std::memory_order_acquire);
+		}
+
+		~ReadScope() {
+			signal._readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+		}
+
+		const ConcurrentSignal &signal;
+		uint64_t epoch;
+		const BindingList *bindings;
+	};
+
+	/** Counts a call of a slot, so that unbinding it waits for the call. */
+	struct CallScope {
+		explicit CallScope(Binding &binding) : binding(binding) {
+			binding.calls.fetch_add(1, std::memory_order_seq_cst);
+			_callingBindings.push_back(&binding);
+		}
+
+		~CallScope() {
+			_callingBindings.pop_back();
+			binding.calls.fetch_sub(1, std::memory_order_seq_cst);
+			if (binding.unbinding.load(std::memory_order_seq_cst))
+				binding.calls.notify_all();
+		}
+
+		Binding &binding;
+	};
+
+	static_assert(std::atomic<BindingList *>::is_always_lock_free);
+
+	std::atomic<BindingList *> _bindings{new BindingList()}; ///< The current snapshot.
+	std::atomic<std::size_t> _count = 0;					  ///< The size of the current snapshot.
+	std::atomic<uint64_t> _epoch = 0;
+	mutable std::atomic<int> _readers[2]; ///< The broadcasts in progress, by parity of their epoch.
+	std::mutex _mutex;					  ///< Locked to publish a new snapshot.
+	std::vector<Retired<BindingList>> _retiredLists;
+	std::vector<Retired<Binding>> _retiredBindings;
+
+	void _publish(BindingList &&bindings) {
+		_count.store(bindings.size(), std::memory_order_release);
+		BindingList *previous = _bindings.exchange(new BindingList(std::move(bindings)), std::memory_order_acq_rel);
+		uint64_t epoch = _epoch.load(std::memory_order_relaxed);
+		_retiredLists.push_back({previous, epoch});
+		// Each advance needs the broadcasts of the epoch before the current one to have ended
+		for (int advance = 0; advance < 2 && _readers[(epoch + 1) & 1].load(std::memory_order_seq_cst) == 0;
+			 ++advance) {
+			_epoch.store(++epoch, std::memory_order_seq_cst);
+		}
+		_reclaim(epoch);
+	}
+
+	/** Deletes what was replaced two epochs before the given one, no broadcast can still read it. */
+	void _reclaim(uint64_t epoch) {
+		std::erase_if(_retiredLists, [epoch](const Retired<BindingList> &retired) {
+			if (retired.epoch + 2 > epoch)
+				return false;
+			delete retired.pointer;
+			return true;
+		});
+		std::erase_if(_retiredBindings, [epoch](const Retired<Binding> &retired) {
+			if (retired.epoch + 2 > epoch)
+				return false;
+			delete retired.pointer;
+			return true;
+		});
+	}
 };
 
 } // namespace Stone
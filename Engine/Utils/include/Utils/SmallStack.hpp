@@ -0,0 +1,65 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace Stone::Utils {
+
+/**
+ * @brief A stack storing its first elements inline, and the following ones on the heap.
+ *
+ * Iterative algorithms use it as their explicit stack: the common shallow cases do not allocate, and the deep ones do
+ * not overflow the call stack.
+ *
+ * @tparam T A default constructible and copyable type, like a pointer.
+ * @tparam N The number of elements stored inline.
+ */
+template <typename T, std::size_t N>
+class SmallStack {
+public:
+	SmallStack() = default;
+	SmallStack(const SmallStack &) = delete;
+	SmallStack &operator=(const SmallStack &) = delete;
+
+	void push(const T &value) {
+		if (_size < N)
+			_inline[_size] = value;
+		else
+			_overflow.push_back(value);
+		++_size;
+	}
+
+	void pop() {
+		assert(_size > 0);
+		if (_size > N)
+			_overflow.pop_back();
+		--_size;
+	}
+
+	/**
+	 * @brief The last pushed element, invalidated by the next push.
+	 */
+	[[nodiscard]] T &top() {
+		assert(_size > 0);
+		return _size > N ? _overflow.back() : _inline[_size - 1];
+	}
+
+	[[nodiscard]] bool empty() const {
+		return _size == 0;
+	}
+
+	[[nodiscard]] std::size_t size() const {
+		return _size;
+	}
+
+private:
+	std::array<T, N> _inline = {};
+	std::vector<T> _overflow;
+	std::size_t _size = 0;
+};
+
+} // namespace Stone::Utils
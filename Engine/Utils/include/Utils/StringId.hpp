@@ -0,0 +1,137 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace Stone {
+
+class StringId;
+
+/**
+ * @brief A string literal given as a template argument, to hash it at compile time.
+ */
+template <std::size_t N>
+struct StringLiteral {
+	constexpr StringLiteral(const char (&string)[N]) { // NOLINT(google-explicit-constructor)
+		std::copy_n(string, N, data);
+	}
+
+	[[nodiscard]] constexpr std::string_view view() const {
+		return {data, N - 1};
+	}
+
+	char data[N] = {};
+};
+
+inline namespace literals {
+
+template <StringLiteral Literal>
+StringId operator""_id();
+
+} // namespace literals
+
+/**
+ * @brief A handle to a string of the global interning table.
+ *
+ * Every distinct string is stored once in the table, and ids of the same string are equal, so comparing and hashing
+ * ids are integer operations. The table is thread-safe, and interned strings are never released: ids suit names and
+ * keys, not arbitrary text.
+ *
+ * The default id is the empty string. Literals are hashed at compile time and interned once with `"diffuse"_id`.
+ */
+class StringId {
+public:
+	StringId() = default;
+
+	/**
+	 * @brief Intern a string, adding it to the table if it is not in yet.
+	 */
+	explicit StringId(std::string_view string);
+
+	/**
+	 * @brief The id of a string already in the table, without adding it.
+	 *
+	 * Lookups use it so that unknown names do not grow the table.
+	 */
+	[[nodiscard]] static std::optional<StringId> find(std::string_view string);
+
+	/**
+	 * @brief The 64 bits FNV-1a hash of a string, as used by the table.
+	 */
+	[[nodiscard]] static constexpr uint64_t hash(std::string_view string) {
+		uint64_t value = 0xcbf29ce484222325ull;
+		for (char c : string) {
+			value ^= static_cast<unsigned char>(c);
+			value *= 0x100000001b3ull;
+		}
+		return value;
+	}
+
+	/**
+	 * @brief The number of strings in the table.
+	 */
+	[[nodiscard]] static std::size_t count();
+
+	/**
+	 * @brief The interned string, valid until the end of the program.
+	 */
+	[[nodiscard]] const std::string &str() const;
+
+	[[nodiscard]] uint64_t getHash() const;
+
+	[[nodiscard]] bool empty() const {
+		return _entry == nullptr;
+	}
+
+	bool operator==(const StringId &other) const = default;
+
+private:
+	template <StringLiteral Literal>
+	friend StringId literals::operator""_id();
+
+	struct Entry {
+		uint64_t hash;
+		std::string string;
+	};
+	struct Table;
+
+	explicit StringId(const Entry *entry) : _entry(entry) {
+	}
+
+	static Table &_table();
+	static StringId _intern(std::string_view string, uint64_t hash);
+
+	const Entry *_entry = nullptr;
+};
+
+inline namespace literals {
+
+/**
+ * @brief The id of a literal, hashed at compile time and interned on its first use only.
+ */
+template <StringLiteral Literal>
+StringId operator""_id() {
+	static constexpr uint64_t hash = StringId::hash(Literal.view());
+	static const StringId id = StringId::_intern(Literal.view(), hash);
+	return id;
+}
+
+} // namespace literals
+
+} // namespace Stone
+
+std::ostream &operator<<(std::ostream &stream, const Stone::StringId &id);
+
+template <>
+struct std::hash<Stone::StringId> {
+	std::size_t operator()(const Stone::StringId &id) const {
+		return static_cast<std::size_t>(id.getHash());
+	}
+};
@@ -20,7 +20,10 @@ void DispatchQueue::execute() {
 	while (!_tasks.empty()) {
 		Task task = _tasks.top();
 		_tasks.pop();
+		// Unlocked, so that the task can enqueue other tasks
+		lock.unlock();
 		task.task();
+		lock.lock();
 	}
 	_running = false;
 }
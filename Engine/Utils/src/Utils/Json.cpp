@@ -5,13 +5,26 @@
 #include "Utils/FileSystem.hpp"
 #include "Utils/StringExt.hpp"
 
+#include <bit>
 #include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <sstream>
+#include <stdexcept>
+
+#if defined(__SSE2__) && !defined(STONE_JSON_NO_SIMD)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON) && !defined(STONE_JSON_NO_SIMD)
+#include <arm_neon.h>
+#endif
 
 
 namespace Stone::Json {
 
-void Value::parseString(const std::string &input, Value &out) {
+void Value::parseString(std::string_view input, Value &out) {
 	Parser parser(input);
 	parser.parse(out);
 }
@@ -68,82 +81,269 @@ std::string to_string(TokenType type) {
 	}
 }
 
-Lexer::Lexer(const std::string &input) : _input(input) {
+// Pointer to the first quote or backslash in [begin, end), or end
+static const char *findStringDelimiter(const char *begin, const char *end) {
+#if defined(__SSE2__) && !defined(STONE_JSON_NO_SIMD)
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	while (end - begin >= 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+		int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+		if (mask != 0) {
+			return begin + std::countr_zero(static_cast<unsigned int>(mask));
+		}
+		begin += 16;
+	}
+#elif defined(__aarch64__) && defined(__ARM_NEON) && !defined(STONE_JSON_NO_SIMD)
+	const uint8x16_t quote = vdupq_n_u8('"');
+	const uint8x16_t backslash = vdupq_n_u8('\\');
+	while (end - begin >= 16) {
+		uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(begin));
+		if (vmaxvq_u8(vorrq_u8(vceqq_u8(chunk, quote), vceqq_u8(chunk, backslash))) != 0) {
+			break; // The scalar loop finds the exact position within these 16 bytes
+		}
+		begin += 16;
+	}
+#endif
+	while (begin < end && *begin != '"' && *begin != '\\') {
+		begin++;
+	}
+	return begin;
+}
+
+static bool isDigit(char c) {
+	return '0' <= c && c <= '9';
+}
+
+Lexer::Lexer(std::string_view input) : _input(input) {
 }
 
 Token Lexer::nextToken() {
-	while (_pos < _input.size() && std::isspace(_input[_pos]))
+	while (_pos < _input.size()) {
+		char c = _input[_pos];
+		if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+			break;
+		}
 		_pos++;
+	}
 
 	if (_pos >= _input.size())
-		return {TokenType::EndOfFile, ""};
+		return {TokenType::EndOfFile, {}};
 
-	char current = _input[_pos];
+	std::string_view current = _input.substr(_pos, 1);
 
-	switch (current) {
-	case '{': _pos++; return {TokenType::LeftBrace, "{"};
-	case '}': _pos++; return {TokenType::RightBrace, "}"};
-	case '[': _pos++; return {TokenType::LeftBracket, "["};
-	case ']': _pos++; return {TokenType::RightBracket, "]"};
-	case ':': _pos++; return {TokenType::Colon, ":"};
-	case ',': _pos++; return {TokenType::Comma, ","};
+	switch (current[0]) {
+	case '{': _pos++; return {TokenType::LeftBrace, current};
+	case '}': _pos++; return {TokenType::RightBrace, current};
+	case '[': _pos++; return {TokenType::LeftBracket, current};
+	case ']': _pos++; return {TokenType::RightBracket, current};
+	case ':': _pos++; return {TokenType::Colon, current};
+	case ',': _pos++; return {TokenType::Comma, current};
 	case '"': return _stringToken();
-	default: return _otherTokens();
+	case 't': return _keywordToken("true", TokenType::True);
+	case 'f': return _keywordToken("false", TokenType::False);
+	case 'n': return _keywordToken("null", TokenType::Null);
+	default:
+		if (current[0] == '-' || isDigit(current[0])) {
+			return _numberToken();
+		}
+		_error("Unexpected character '" + std::string(current) + "'");
 	}
 }
 
 Token Lexer::_stringToken() {
-	std::stringstream ss;
-	_pos++; // Skip the opening quote
-	while (_pos < _input.size() && _input[_pos] != '"') {
-		if (_input[_pos] == '\\')
-			_pos++; // Handle escape sequences
-		ss << _input[_pos++];
+	const char *begin = _input.data() + _pos + 1; // Skip the opening quote
+	const char *end = _input.data() + _input.size();
+	const char *cursor = begin;
+	bool escaped = false;
+	while (true) {
+		cursor = findStringDelimiter(cursor, end);
+		if (cursor == end) {
+			_error("Unterminated string");
+		}
+		if (*cursor == '"') {
+			break;
+		}
+		// Skip the backslash and the escaped character, it is validated when decoding
+		if (end - cursor < 2) {
+			_error("Unterminated string");
+		}
+		escaped = true;
+		cursor += 2;
 	}
-	_pos++; // Skip the closing quote
-	return {TokenType::String, ss.str()};
-}
-
-Token Lexer::_otherTokens() {
-	if (std::isdigit(_input[_pos]) || _input[_pos] == '-') {
-		return _numberToken();
-	} else if (_input.substr(_pos, 4) == "true") {
-		_pos += 4;
-		return {TokenType::True, "true"};
-	} else if (_input.substr(_pos, 5) == "false") {
-		_pos += 5;
-		return {TokenType::False, "false"};
-	} else if (_input.substr(_pos, 4) == "null") {
-		_pos += 4;
-		return {TokenType::Null, "null"};
-	} else {
-		throw std::runtime_error("Unexpected character in input");
+	_pos = static_cast<std::size_t>(cursor - _input.data()) + 1; // Skip the closing quote
+	return {TokenType::String, std::string_view(begin, static_cast<std::size_t>(cursor - begin)), escaped};
+}
+
+Token Lexer::_keywordToken(std::string_view keyword, TokenType type) {
+	if (_input.compare(_pos, keyword.size(), keyword) != 0) {
+		_error("Unexpected character '" + std::string(1, _input[_pos]) + "'");
 	}
+	std::string_view value = _input.substr(_pos, keyword.size());
+	_pos += keyword.size();
+	return {type, value};
 }
 
 Token Lexer::_numberToken() {
-	std::stringstream ss;
+	const std::size_t start = _pos;
+	auto skipDigits = [this]() {
+		if (_pos >= _input.size() || !isDigit(_input[_pos])) {
+			_error("Invalid number");
+		}
+		while (_pos < _input.size() && isDigit(_input[_pos])) {
+			_pos++;
+		}
+	};
+
 	if (_input[_pos] == '-')
-		ss << _input[_pos++];
-	while (_pos < _input.size() && std::isdigit(_input[_pos])) {
-		ss << _input[_pos++];
+		_pos++;
+	if (_pos < _input.size() && _input[_pos] == '0') {
+		_pos++; // No leading zeros, a following digit is reported by the parser
+	} else {
+		skipDigits();
 	}
 	if (_pos < _input.size() && _input[_pos] == '.') {
-		ss << _input[_pos++];
-		while (_pos < _input.size() && std::isdigit(_input[_pos])) {
-			ss << _input[_pos++];
-		}
+		_pos++;
+		skipDigits();
+	}
+	if (_pos < _input.size() && (_input[_pos] == 'e' || _input[_pos] == 'E')) {
+		_pos++;
+		if (_pos < _input.size() && (_input[_pos] == '+' || _input[_pos] == '-'))
+			_pos++;
+		skipDigits();
 	}
-	return {TokenType::Number, ss.str()};
+	return {TokenType::Number, _input.substr(start, _pos - start)};
+}
+
+void Lexer::_error(const std::string &message) const {
+	throw std::runtime_error(message + " at offset " + std::to_string(_pos));
 }
 
 
-Parser::Parser(const std::string &input) : _lexer(input) {
+Parser::Parser(std::string_view input) : _lexer(input) {
 	_currentToken = _lexer.nextToken();
 }
 
 void Parser::parse(Value &out) {
-	return _parseValue(out);
+	_parseValue(out);
+	if (_currentToken.type != TokenType::EndOfFile) {
+		_unexpectedToken(to_string(TokenType::EndOfFile));
+	}
+}
+
+static uint32_t readHexQuad(std::string_view input, std::size_t pos) {
+	if (pos + 4 > input.size()) {
+		throw std::runtime_error("Invalid unicode escape sequence");
+	}
+	uint32_t value = 0;
+	for (std::size_t i = pos; i < pos + 4; ++i) {
+		char c = input[i];
+		value <<= 4;
+		if (isDigit(c)) {
+			value |= static_cast<uint32_t>(c - '0');
+		} else if ('a' <= c && c <= 'f') {
+			value |= static_cast<uint32_t>(c - 'a' + 10);
+		} else if ('A' <= c && c <= 'F') {
+			value |= static_cast<uint32_t>(c - 'A' + 10);
+		} else {
+			throw std::runtime_error("Invalid unicode escape sequence");
+		}
+	}
+	return value;
+}
+
+static void appendUtf8(std::string &out, uint32_t codePoint) {
+	if (codePoint < 0x80) {
+		out += static_cast<char>(codePoint);
+	} else if (codePoint < 0x800) {
+		out += static_cast<char>(0xC0 | (codePoint >> 6));
+		out += static_cast<char>(0x80 | (codePoint & 0x3F));
+	} else if (codePoint < 0x10000) {
+		out += static_cast<char>(0xE0 | (codePoint >> 12));
+		out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (codePoint & 0x3F));
+	} else {
+		out += static_cast<char>(0xF0 | (codePoint >> 18));
+		out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+		out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+}
+
+void Parser::decodeString(const Token &token, std::string &out) {
+	std::string_view input = token.value;
+	if (!token.escaped) {
+		out.assign(input);
+		return;
+	}
+
+	out.clear();
+	out.reserve(input.size());
+	std::size_t pos = 0;
+	while (pos < input.size()) {
+		std::size_t backslash = input.find('\\', pos);
+		if (backslash == std::string_view::npos) {
+			out.append(input.substr(pos));
+			break;
+		}
+		out.append(input.substr(pos, backslash - pos));
+		pos = backslash + 1;
+		if (pos >= input.size()) {
+			throw std::runtime_error("Invalid escape sequence");
+		}
+
+		switch (input[pos++]) {
+		case '"': out += '"'; break;
+		case '\\': out += '\\'; break;
+		case '/': out += '/'; break;
+		case 'b': out += '\b'; break;
+		case 'f': out += '\f'; break;
+		case 'n': out += '\n'; break;
+		case 'r': out += '\r'; break;
+		case 't': out += '\t'; break;
+		case 'u': {
+			uint32_t codePoint = readHexQuad(input, pos);
+			pos += 4;
+			if (0xD800 <= codePoint && codePoint <= 0xDBFF) {
+				// A high surrogate must be followed by the escaped low surrogate of the pair
+				if (input.compare(pos, 2, "\\u") != 0) {
+					throw std::runtime_error("Unpaired surrogate in unicode escape sequence");
+				}
+				uint32_t low = readHexQuad(input, pos + 2);
+				if (low < 0xDC00 || low > 0xDFFF) {
+					throw std::runtime_error("Unpaired surrogate in unicode escape sequence");
+				}
+				codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+				pos += 6;
+			} else if (0xDC00 <= codePoint && codePoint <= 0xDFFF) {
+				throw std::runtime_error("Unpaired surrogate in unicode escape sequence");
+			}
+			appendUtf8(out, codePoint);
+			break;
+		}
+		default: throw std::runtime_error("Invalid escape sequence '\\" + std::string(1, input[pos - 1]) + "'");
+		}
+	}
+}
+
+double Parser::decodeNumber(const Token &token) {
+	std::string_view text = token.value;
+	double number = 0;
+#if defined(__cpp_lib_to_chars)
+	auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number);
+	if (error != std::errc() || end != text.data() + text.size()) {
+		throw std::runtime_error("Invalid number '" + std::string(text) + "'");
+	}
+#else
+	// Standard libraries without floating point from_chars, the token is short and already validated by the lexer
+	std::string copy(text);
+	char *end = nullptr;
+	number = std::strtod(copy.c_str(), &end);
+	if (end != copy.c_str() + copy.size()) {
+		throw std::runtime_error("Invalid number '" + copy + "'");
+	}
+#endif
+	return number;
 }
 
 void Parser::_parseValue(Value &out) {
@@ -155,64 +355,79 @@ void Parser::_parseValue(Value &out) {
 	case TokenType::True:
 	case TokenType::False:
 	case TokenType::Null: return _parsePrimitive(out);
-	default: throw std::runtime_error("Unexpected token in input");
+	default: _unexpectedToken("a value");
 	}
 }
 
 void Parser::_parseObject(Value &out) {
+	if (++_depth > maxDepth)
+		throw std::runtime_error("Json nesting is deeper than " + std::to_string(maxDepth));
 	out.value = Object();
 	auto &object(std::get<Object>(out.value));
 	_consume(TokenType::LeftBrace);
-	while (_currentToken.type != TokenType::RightBrace) {
-		const std::string key = _currentToken.value; // Store the key before consuming the tokens
-		_consume(TokenType::String);
-		_consume(TokenType::Colon);
-		Value value;
-		_parseValue(value);
-		object[key] = std::move(value);
-		if (_currentToken.type == TokenType::Comma) {
+	if (_currentToken.type != TokenType::RightBrace) {
+		while (true) {
+			if (_currentToken.type != TokenType::String) {
+				_unexpectedToken(to_string(TokenType::String));
+			}
+			std::string key;
+			decodeString(_currentToken, key);
+			_currentToken = _lexer.nextToken();
+			_consume(TokenType::Colon);
+			// Parse in place, a duplicated key keeps the last value
+			_parseValue(object.try_emplace(std::move(key)).first->second);
+			if (_currentToken.type != TokenType::Comma)
+				break;
 			_consume(TokenType::Comma);
-		} else {
-			break;
 		}
 	}
 	_consume(TokenType::RightBrace);
+	--_depth;
 }
 
 void Parser::_parseArray(Value &out) {
+	if (++_depth > maxDepth)
+		throw std::runtime_error("Json nesting is deeper than " + std::to_string(maxDepth));
 	out.value = Array();
 	auto &array(std::get<Array>(out.value));
 	_consume(TokenType::LeftBracket);
-	while (_currentToken.type != TokenType::RightBracket) {
-		_parseValue(array.emplace_back());
-		if (_currentToken.type == TokenType::Comma) {
+	if (_currentToken.type != TokenType::RightBracket) {
+		while (true) {
+			_parseValue(array.emplace_back());
+			if (_currentToken.type != TokenType::Comma)
+				break;
 			_consume(TokenType::Comma);
-		} else {
-			break;
 		}
 	}
 	_consume(TokenType::RightBracket);
+	--_depth;
 }
 
 void Parser::_parsePrimitive(Value &out) {
 	switch (_currentToken.type) {
-	case TokenType::String: out.value = _currentToken.value; break;
-	case TokenType::Number: out.value = std::stod(_currentToken.value); break;
+	case TokenType::String: decodeString(_currentToken, out.value.emplace<std::string>()); break;
+	case TokenType::Number: out.value = decodeNumber(_currentToken); break;
 	case TokenType::True: out.value = true; break;
 	case TokenType::False: out.value = false; break;
 	case TokenType::Null: out.value = std::nullptr_t(); break;
-	default: throw std::runtime_error("Unexpected token in input");
+	default: _unexpectedToken("a value");
 	}
 	_currentToken = _lexer.nextToken();
 }
 
 void Parser::_consume(TokenType expected) {
 	if (_currentToken.type != expected) {
-		throw std::runtime_error("Expected " + to_string(expected) + ", but got " + _currentToken.value);
+		_unexpectedToken(to_string(expected));
 	}
 	_currentToken = _lexer.nextToken();
 }
 
+void Parser::_unexpectedToken(const std::string &expected) const {
+	std::string got = _currentToken.type == TokenType::EndOfFile ? "end of input" : std::string(_currentToken.value);
+	throw std::runtime_error("Expected " + expected + ", but got " + got + " before offset " +
+							 std::to_string(_lexer.position()));
+}
+
 
 std::string Serializer::serialize(const Value &value) {
 	std::visit(*this, value.value);
@@ -225,7 +440,7 @@ void Serializer::operator()(const Object &object) {
 	for (const auto &pair : object) {
 		if (!first)
 			_ss << ",";
-		_ss << "\"" << pair.first << "\":";
+		_ss << "\"" << escape_string(pair.first) << "\":";
 		std::visit(*this, pair.second.value);
 		first = false;
 	}
@@ -249,7 +464,20 @@ void Serializer::operator()(const std::string &str) {
 }
 
 void Serializer::operator()(double num) {
-	_ss << num;
+	if (!std::isfinite(num)) {
+		// Json has no infinity nor NaN
+		_ss << "null";
+		return;
+	}
+	char text[32];
+#if defined(__cpp_lib_to_chars)
+	// The shortest text read back to the same double, the stream default keeps 6 digits only
+	auto [end, error] = std::to_chars(text, text + sizeof(text), num);
+	_ss.write(text, end - text);
+#else
+	int size = std::snprintf(text, sizeof(text), "%.17g", num);
+	_ss.write(text, size);
+#endif
 }
 
 void Serializer::operator()(bool b) {
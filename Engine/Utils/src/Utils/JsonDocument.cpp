@@ -0,0 +1,369 @@
+// Copyright 2024 Stone-Engine
+
+#include "Utils/JsonDocument.hpp"
+
+#include "Utils/FileSystem.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_set>
+
+
+namespace Stone::Json {
+
+/** KeyPool */
+
+namespace {
+
+struct KeyHash {
+	using is_transparent = void;
+
+	std::size_t operator()(std::string_view key) const {
+		return std::hash<std::string_view>()(key);
+	}
+};
+
+struct KeySet {
+	std::mutex mutex;
+	// Nodes of an unordered_set are never moved, the views to the keys stay valid
+	std::unordered_set<std::string, KeyHash, std::equal_to<>> keys;
+};
+
+KeySet &keySet() {
+	static KeySet set;
+	return set;
+}
+
+} // namespace
+
+std::string_view KeyPool::intern(std::string_view key) {
+	KeySet &set = keySet();
+	std::unique_lock<std::mutex> lock(set.mutex);
+	auto it = set.keys.find(key);
+	if (it == set.keys.end()) {
+		it = set.keys.emplace(key).first;
+	}
+	return *it;
+}
+
+std::size_t KeyPool::size() {
+	KeySet &set = keySet();
+	std::unique_lock<std::mutex> lock(set.mutex);
+	return set.keys.size();
+}
+
+/** DocumentBuilder */
+
+/**
+ * Values are built bottom-up: the children of an open container wait on a stack, and are copied contiguously to the
+ * document when it closes. Their own children were copied before, so the stack only holds direct children.
+ */
+class DocumentBuilder {
+public:
+	explicit DocumentBuilder(Document &document) : _document(document) {
+	}
+
+	void build(const Value &value) {
+		_document._root = _fromValue(value);
+		_finish();
+	}
+
+	void parse(std::string_view input) {
+		Lexer lexer(input);
+		_lexer = &lexer;
+		_token = lexer.nextToken();
+		_document._root = _parseValue();
+		if (_token.type != TokenType::EndOfFile) {
+			_unexpectedToken(to_string(TokenType::EndOfFile));
+		}
+		_finish();
+	}
+
+private:
+	using Entry = Document::Entry;
+	using Member = Document::Member;
+
+	Document &_document;
+	std::vector<Entry> _values;
+	std::vector<Member> _members;
+	std::size_t _depth = 0;
+
+	Lexer *_lexer = nullptr;
+	Token _token;
+	std::string _decoded;
+
+	static Entry _entry(Kind kind, std::size_t size = 0, uint64_t index = 0) {
+		Entry entry;
+		entry.kind = kind;
+		entry.size = static_cast<uint32_t>(size);
+		entry.index = index;
+		return entry;
+	}
+
+	Entry _string(std::string_view str) {
+		Entry entry = _entry(Kind::String, str.size(), _document._strings.size());
+		_document._strings.insert(_document._strings.end(), str.begin(), str.end());
+		return entry;
+	}
+
+	static Entry _number(double number) {
+		Entry entry = _entry(Kind::Number);
+		entry.number = number;
+		return entry;
+	}
+
+	static Entry _boolean(bool boolean) {
+		return _entry(Kind::Boolean, 0, boolean ? 1 : 0);
+	}
+
+	Entry _closeArray(std::size_t start) {
+		Entry entry = _entry(Kind::Array, _values.size() - start, _document._values.size());
+		_document._values.insert(_document._values.end(), _values.begin() + static_cast<std::ptrdiff_t>(start),
+								 _values.end());
+		_values.resize(start);
+		return entry;
+	}
+
+	Entry _closeObject(std::size_t start) {
+		auto first = _members.begin() + static_cast<std::ptrdiff_t>(start);
+		auto byKey = [](const Member &a, const Member &b) { return a.key < b.key; };
+		if (_members.end() - first <= 16) {
+			// Objects are usually small, an insertion sort is stable too and does not allocate a buffer
+			for (auto it = first; it != _members.end(); ++it) {
+				std::rotate(std::upper_bound(first, it, *it, byKey), it, std::next(it));
+			}
+		} else {
+			std::stable_sort(first, _members.end(), byKey);
+		}
+
+		// A duplicated key keeps its last value, as when parsing to a Value
+		auto last = first;
+		for (auto it = first; it != _members.end(); ++it) {
+			if (std::next(it) != _members.end() && std::next(it)->key == it->key) {
+				continue;
+			}
+			*last++ = *it;
+		}
+
+		Entry entry = _entry(Kind::Object, static_cast<std::size_t>(last - first), _document._members.size());
+		_document._members.insert(_document._members.end(), first, last);
+		_members.resize(start);
+		return entry;
+	}
+
+	void _finish() {
+		_document._values.shrink_to_fit();
+		_document._members.shrink_to_fit();
+		_document._strings.shrink_to_fit();
+	}
+
+	void _enter() {
+		if (++_depth > Parser::maxDepth) {
+			throw std::runtime_error("Json nesting is deeper than " + std::to_string(Parser::maxDepth));
+		}
+	}
+
+	/** Value */
+
+	Entry _fromValue(const Value &value) {
+		if (value.is<Object>()) {
+			_enter();
+			std::size_t start = _members.size();
+			for (const auto &[key, member] : value.get<Object>()) {
+				Entry entry = _fromValue(member);
+				_members.push_back({KeyPool::intern(key), entry});
+			}
+			--_depth;
+			return _closeObject(start);
+		}
+		if (value.is<Array>()) {
+			_enter();
+			std::size_t start = _values.size();
+			for (const auto &element : value.get<Array>()) {
+				Entry entry = _fromValue(element);
+				_values.push_back(entry);
+			}
+			--_depth;
+			return _closeArray(start);
+		}
+		if (value.is<std::string>())
+			return _string(value.get<std::string>());
+		if (value.is<double>())
+			return _number(value.get<double>());
+		if (value.is<bool>())
+			return _boolean(value.get<bool>());
+		return {};
+	}
+
+	/** Json text */
+
+	void _next() {
+		_token = _lexer->nextToken();
+	}
+
+	void _consume(TokenType expected) {
+		if (_token.type != expected) {
+			_unexpectedToken(to_string(expected));
+		}
+		_next();
+	}
+
+	[[noreturn]] void _unexpectedToken(const std::string &expected) const {
+		std::string got = _token.type == TokenType::EndOfFile ? "end of input" : std::string(_token.value);
+		throw std::runtime_error("Expected " + expected + ", but got " + got + " before offset " +
+								 std::to_string(_lexer->position()));
+	}
+
+	std::string_view _decodedString() {
+		if (!_token.escaped) {
+			return _token.value;
+		}
+		Parser::decodeString(_token, _decoded);
+		return _decoded;
+	}
+
+	Entry _parseValue() {
+		Entry entry;
+		switch (_token.type) {
+		case TokenType::LeftBrace: return _parseObject();
+		case TokenType::LeftBracket: return _parseArray();
+		case TokenType::String: entry = _string(_decodedString()); break;
+		case TokenType::Number: entry = _number(Parser::decodeNumber(_token)); break;
+		case TokenType::True: entry = _boolean(true); break;
+		case TokenType::False: entry = _boolean(false); break;
+		case TokenType::Null: break;
+		default: _unexpectedToken("a value");
+		}
+		_next();
+		return entry;
+	}
+
+	Entry _parseObject() {
+		_enter();
+		std::size_t start = _members.size();
+		_consume(TokenType::LeftBrace);
+		if (_token.type != TokenType::RightBrace) {
+			while (true) {
+				if (_token.type != TokenType::String) {
+					_unexpectedToken(to_string(TokenType::String));
+				}
+				std::string_view key = KeyPool::intern(_decodedString());
+				_next();
+				_consume(TokenType::Colon);
+				Entry entry = _parseValue();
+				_members.push_back({key, entry});
+				if (_token.type != TokenType::Comma)
+					break;
+				_consume(TokenType::Comma);
+			}
+		}
+		_consume(TokenType::RightBrace);
+		--_depth;
+		return _closeObject(start);
+	}
+
+	Entry _parseArray() {
+		_enter();
+		std::size_t start = _values.size();
+		_consume(TokenType::LeftBracket);
+		if (_token.type != TokenType::RightBracket) {
+			while (true) {
+				Entry entry = _parseValue();
+				_values.push_back(entry);
+				if (_token.type != TokenType::Comma)
+					break;
+				_consume(TokenType::Comma);
+			}
+		}
+		_consume(TokenType::RightBracket);
+		--_depth;
+		return _closeArray(start);
+	}
+};
+
+/** Document */
+
+Document::Document() = default;
+
+Document::Document(const Value &value) {
+	DocumentBuilder(*this).build(value);
+}
+
+void Document::parseString(std::string_view input, Document &out) {
+	Document document;
+	DocumentBuilder(document).parse(input);
+	out = std::move(document);
+}
+
+void Document::parseFile(const std::string &path, Document &out) {
+	parseString(Utils::readTextFile(path), out);
+}
+
+ValueView Document::getRoot() const {
+	return {this, &_root};
+}
+
+Value Document::toValue() const {
+	return getRoot().toValue();
+}
+
+std::size_t Document::getMemoryUsage() const {
+	return sizeof(Document) + _values.capacity() * sizeof(Entry) + _members.capacity() * sizeof(Member) +
+		   _strings.capacity();
+}
+
+/** Views */
+
+Value ValueView::toValue() const {
+	switch (getKind()) {
+	case Kind::Object: {
+		Object object;
+		ObjectView view = get<Object>();
+		object.reserve(view.size());
+		for (const auto &[key, member] : view) {
+			object.emplace(key, member.toValue());
+		}
+		return object;
+	}
+	case Kind::Array: {
+		Array array;
+		ArrayView view = get<Array>();
+		array.reserve(view.size());
+		for (ValueView element : view) {
+			array.push_back(element.toValue());
+		}
+		return array;
+	}
+	case Kind::String: return std::string(get<std::string>());
+	case Kind::Number: return get<double>();
+	case Kind::Boolean: return get<bool>();
+	default: return {};
+	}
+}
+
+ValueView ArrayView::at(std::size_t index) const {
+	if (index >= _size) {
+		throw std::out_of_range("Json array index " + std::to_string(index) + " out of range");
+	}
+	return (*this)[index];
+}
+
+ObjectView::Iterator ObjectView::find(std::string_view key) const {
+	const Document::Member *last = _members + _size;
+	const Document::Member *member = std::lower_bound(
+		_members, last, key, [](const Document::Member &member, std::string_view key) { return member.key < key; });
+	if (member == last || member->key != key) {
+		return end();
+	}
+	return {_document, member};
+}
+
+ValueView ObjectView::at(std::string_view key) const {
+	Iterator it = find(key);
+	if (it == end()) {
+		throw std::out_of_range("Json object has no key '" + std::string(key) + "'");
+	}
+	return (*it).second;
+}
+
+} // namespace Stone::Json
@@ -0,0 +1,356 @@
+// Copyright 2024 Stone-Engine
+
+#include "Utils/JsonMessagePack.hpp"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+
+namespace Stone::Json {
+
+namespace {
+
+/** Encoder */
+
+class Encoder {
+public:
+	explicit Encoder(std::vector<char> &out) : _out(out) {
+	}
+
+	void write(const Value &value) {
+		if (value.is<Object>()) {
+			write(value.get<Object>());
+		} else if (value.is<Array>()) {
+			const Array &array = value.get<Array>();
+			_header(array.size(), 0x90, 0xdc);
+			for (const auto &element : array) {
+				write(element);
+			}
+		} else if (value.is<std::string>()) {
+			_string(value.get<std::string>());
+		} else if (value.is<double>()) {
+			_number(value.get<double>());
+		} else if (value.is<bool>()) {
+			_byte(value.get<bool>() ? 0xc3 : 0xc2);
+		} else {
+			_byte(0xc0);
+		}
+	}
+
+	void write(const Object &object) {
+		_header(object.size(), 0x80, 0xde);
+		for (const auto &[key, member] : object) {
+			_string(key);
+			write(member);
+		}
+	}
+
+private:
+	std::vector<char> &_out;
+
+	void _byte(uint8_t byte) {
+		_out.push_back(static_cast<char>(byte));
+	}
+
+	template <typename T>
+	void _bigEndian(uint8_t code, T value) {
+		_byte(code);
+		for (int shift = (static_cast<int>(sizeof(T)) - 1) * 8; shift >= 0; shift -= 8) {
+			_byte(static_cast<uint8_t>(value >> shift));
+		}
+	}
+
+	/** Arrays and maps, code16 is followed by the code of the 32 bits size */
+	void _header(std::size_t size, uint8_t fixCode, uint8_t code16) {
+		if (size < 16) {
+			_byte(static_cast<uint8_t>(fixCode | size));
+		} else if (size <= UINT16_MAX) {
+			_bigEndian(code16, static_cast<uint16_t>(size));
+		} else {
+			_bigEndian(static_cast<uint8_t>(code16 + 1), static_cast<uint32_t>(size));
+		}
+	}
+
+	void _string(std::string_view str) {
+		if (str.size() < 32) {
+			_byte(static_cast<uint8_t>(0xa0 | str.size()));
+		} else if (str.size() <= UINT8_MAX) {
+			_bigEndian(0xd9, static_cast<uint8_t>(str.size()));
+		} else if (str.size() <= UINT16_MAX) {
+			_bigEndian(0xda, static_cast<uint16_t>(str.size()));
+		} else {
+			_bigEndian(0xdb, static_cast<uint32_t>(str.size()));
+		}
+		_out.insert(_out.end(), str.begin(), str.end());
+	}
+
+	void _number(double number) {
+		bool integer = std::trunc(number) == number && !(number == 0 && std::signbit(number));
+		if (integer && number >= 0 && number < 18446744073709551616.0) {
+			auto value = static_cast<uint64_t>(number);
+			if (value < 128) {
+				_byte(static_cast<uint8_t>(value));
+			} else if (value <= UINT8_MAX) {
+				_bigEndian(0xcc, static_cast<uint8_t>(value));
+			} else if (value <= UINT16_MAX) {
+				_bigEndian(0xcd, static_cast<uint16_t>(value));
+			} else if (value <= UINT32_MAX) {
+				_bigEndian(0xce, static_cast<uint32_t>(value));
+			} else {
+				_bigEndian(0xcf, value);
+			}
+		} else if (integer && number < 0 && number >= -9223372036854775808.0) {
+			auto value = static_cast<int64_t>(number);
+			if (value >= -32) {
+				_byte(static_cast<uint8_t>(value));
+			} else if (value >= INT8_MIN) {
+				_bigEndian(0xd0, static_cast<uint8_t>(value));
+			} else if (value >= INT16_MIN) {
+				_bigEndian(0xd1, static_cast<uint16_t>(value));
+			} else if (value >= INT32_MIN) {
+				_bigEndian(0xd2, static_cast<uint32_t>(value));
+			} else {
+				_bigEndian(0xd3, static_cast<uint64_t>(value));
+			}
+		} else if (static_cast<double>(static_cast<float>(number)) == number) {
+			_bigEndian(0xca, std::bit_cast<uint32_t>(static_cast<float>(number)));
+		} else {
+			_bigEndian(0xcb, std::bit_cast<uint64_t>(number));
+		}
+	}
+};
+
+/** Decoder */
+
+enum class ItemKind : uint8_t {
+	Object,
+	Array,
+	String,
+	Number,
+	Boolean,
+	Null,
+};
+
+struct Item {
+	ItemKind kind = ItemKind::Null;
+	uint32_t size = 0;
+	double number = 0;
+	bool boolean = false;
+	std::string_view string;
+};
+
+class Decoder {
+public:
+	explicit Decoder(std::string_view data) : _data(data) {
+	}
+
+	[[nodiscard]] std::size_t position() const {
+		return _pos;
+	}
+
+	void readValue(Value &out, std::size_t depth) {
+		Item item = _readItem();
+		switch (item.kind) {
+		case ItemKind::Object: {
+			_checkDepth(depth);
+			auto &object = out.value.emplace<Object>();
+			object.reserve(item.size);
+			for (uint32_t index = 0; index < item.size; ++index) {
+				std::string_view key = _readKey();
+				readValue(object.try_emplace(std::string(key)).first->second, depth + 1);
+			}
+			break;
+		}
+		case ItemKind::Array: {
+			_checkDepth(depth);
+			auto &array = out.value.emplace<Array>(item.size);
+			for (auto &element : array) {
+				readValue(element, depth + 1);
+			}
+			break;
+		}
+		case ItemKind::String: out.value.emplace<std::string>(item.string); break;
+		case ItemKind::Number: out.value = item.number; break;
+		case ItemKind::Boolean: out.value = item.boolean; break;
+		case ItemKind::Null: out.value = nullptr; break;
+		}
+	}
+
+	void readEvents(Handler &handler, std::size_t depth) {
+		Item item = _readItem();
+		switch (item.kind) {
+		case ItemKind::Object:
+			_checkDepth(depth);
+			handler.startObject();
+			for (uint32_t index = 0; index < item.size; ++index) {
+				handler.key(_readKey());
+				readEvents(handler, depth + 1);
+			}
+			handler.endObject();
+			break;
+		case ItemKind::Array:
+			_checkDepth(depth);
+			handler.startArray();
+			for (uint32_t index = 0; index < item.size; ++index) {
+				readEvents(handler, depth + 1);
+			}
+			handler.endArray();
+			break;
+		case ItemKind::String: handler.string(item.string); break;
+		case ItemKind::Number: handler.number(item.number); break;
+		case ItemKind::Boolean: handler.boolean(item.boolean); break;
+		case ItemKind::Null: handler.null(); break;
+		}
+	}
+
+private:
+	std::string_view _data;
+	std::size_t _pos = 0;
+
+	[[noreturn]] void _error(const std::string &message) const {
+		throw std::runtime_error(message + " at offset " + std::to_string(_pos));
+	}
+
+	static void _checkDepth(std::size_t depth) {
+		if (depth >= Parser::maxDepth) {
+			throw std::runtime_error("MessagePack nesting is deeper than " + std::to_string(Parser::maxDepth));
+		}
+	}
+
+	std::string_view _bytes(std::size_t size) {
+		if (_data.size() - _pos < size) {
+			_error("Truncated MessagePack data");
+		}
+		std::string_view bytes = _data.substr(_pos, size);
+		_pos += size;
+		return bytes;
+	}
+
+	template <typename T>
+	T _bigEndian() {
+		std::string_view bytes = _bytes(sizeof(T));
+		T value = 0;
+		for (char byte : bytes) {
+			value = static_cast<T>((static_cast<uint64_t>(value) << 8) | static_cast<uint8_t>(byte));
+		}
+		return value;
+	}
+
+	static Item _item(ItemKind kind, uint32_t size = 0) {
+		Item item;
+		item.kind = kind;
+		item.size = size;
+		return item;
+	}
+
+	Item _container(ItemKind kind, uint32_t size) {
+		// Every element takes a byte at least, this rejects sizes which would allocate before the data runs out
+		if (_data.size() - _pos < size) {
+			_error("Truncated MessagePack data");
+		}
+		return _item(kind, size);
+	}
+
+	Item _string(std::size_t size) {
+		Item item = _item(ItemKind::String);
+		item.string = _bytes(size);
+		return item;
+	}
+
+	static Item _number(double number) {
+		Item item = _item(ItemKind::Number);
+		item.number = number;
+		return item;
+	}
+
+	static Item _boolean(bool boolean) {
+		Item item = _item(ItemKind::Boolean);
+		item.boolean = boolean;
+		return item;
+	}
+
+	std::string_view _readKey() {
+		Item key = _readItem();
+		if (key.kind != ItemKind::String) {
+			_error("MessagePack map keys must be strings");
+		}
+		return key.string;
+	}
+
+	Item _readItem() {
+		auto code = _bigEndian<uint8_t>();
+		if (code <= 0x7f) {
+			return _number(code);
+		} else if (code <= 0x8f) {
+			return _container(ItemKind::Object, code & 0x0f);
+		} else if (code <= 0x9f) {
+			return _container(ItemKind::Array, code & 0x0f);
+		} else if (code <= 0xbf) {
+			return _string(code & 0x1f);
+		} else if (code >= 0xe0) {
+			return _number(static_cast<int8_t>(code));
+		}
+
+		switch (code) {
+		case 0xc0: return _item(ItemKind::Null);
+		case 0xc2: return _boolean(false);
+		case 0xc3: return _boolean(true);
+		case 0xc4:
+		case 0xd9: return _string(_bigEndian<uint8_t>());
+		case 0xc5:
+		case 0xda: return _string(_bigEndian<uint16_t>());
+		case 0xc6:
+		case 0xdb: return _string(_bigEndian<uint32_t>());
+		case 0xca: return _number(std::bit_cast<float>(_bigEndian<uint32_t>()));
+		case 0xcb: return _number(std::bit_cast<double>(_bigEndian<uint64_t>()));
+		case 0xcc: return _number(_bigEndian<uint8_t>());
+		case 0xcd: return _number(_bigEndian<uint16_t>());
+		case 0xce: return _number(_bigEndian<uint32_t>());
+		case 0xcf: return _number(static_cast<double>(_bigEndian<uint64_t>()));
+		case 0xd0: return _number(static_cast<int8_t>(_bigEndian<uint8_t>()));
+		case 0xd1: return _number(static_cast<int16_t>(_bigEndian<uint16_t>()));
+		case 0xd2: return _number(static_cast<int32_t>(_bigEndian<uint32_t>()));
+		case 0xd3: return _number(static_cast<double>(static_cast<int64_t>(_bigEndian<uint64_t>())));
+		case 0xdc: return _container(ItemKind::Array, _bigEndian<uint16_t>());
+		case 0xdd: return _container(ItemKind::Array, _bigEndian<uint32_t>());
+		case 0xde: return _container(ItemKind::Object, _bigEndian<uint16_t>());
+		case 0xdf: return _container(ItemKind::Object, _bigEndian<uint32_t>());
+		default: _error("Unsupported MessagePack type " + std::to_string(code));
+		}
+	}
+};
+
+} // namespace
+
+void toMessagePack(const Value &value, std::vector<char> &out) {
+	Encoder(out).write(value);
+}
+
+void toMessagePack(const Object &object, std::vector<char> &out) {
+	Encoder(out).write(object);
+}
+
+std::vector<char> toMessagePack(const Value &value) {
+	std::vector<char> out;
+	toMessagePack(value, out);
+	return out;
+}
+
+void fromMessagePack(std::string_view data, Value &out) {
+	Decoder decoder(data);
+	decoder.readValue(out, 0);
+	if (decoder.position() != data.size()) {
+		throw std::runtime_error("Unexpected bytes after the MessagePack value at offset " +
+								 std::to_string(decoder.position()));
+	}
+}
+
+std::size_t readMessagePack(std::string_view data, Handler &handler) {
+	Decoder decoder(data);
+	decoder.readEvents(handler, 0);
+	return decoder.position();
+}
+
+} // namespace Stone::Json
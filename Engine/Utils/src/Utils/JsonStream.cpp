@@ -0,0 +1,438 @@
+// Copyright 2024 Stone-Engine
+
+#include "Utils/JsonStream.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+
+namespace Stone::Json {
+
+/** StreamReader */
+
+StreamReader::StreamReader(Handler &handler, bool multipleValues) : _handler(handler), _multipleValues(multipleValues) {
+}
+
+void StreamReader::feed(std::string_view chunk) {
+	if (_buffer.empty()) {
+		// Most tokens end in the chunk they start in, only the split one is copied
+		std::size_t consumed = _parse(chunk, false);
+		_buffer.assign(chunk.substr(consumed));
+		_offset += consumed;
+		_scanned = _scanned > consumed ? _scanned - consumed : 0;
+		return;
+	}
+
+	_buffer.append(chunk);
+	std::size_t consumed = _parse(_buffer, false);
+	_buffer.erase(0, consumed);
+	_offset += consumed;
+	_scanned = _scanned > consumed ? _scanned - consumed : 0;
+}
+
+void StreamReader::finish() {
+	std::size_t consumed = _parse(_buffer, true);
+	_buffer.erase(0, consumed);
+	_offset += consumed;
+	_scanned = 0;
+
+	if (!_buffer.empty()) {
+		_error("Unterminated string", _offset);
+	}
+	if (!_containers.empty() || (!_multipleValues && _state != State::Done)) {
+		_error("Unexpected end of input", _offset);
+	}
+}
+
+void StreamReader::parseStream(std::istream &stream, Handler &handler, bool multipleValues, std::size_t chunkSize) {
+	StreamReader reader(handler, multipleValues);
+	std::vector<char> chunk(chunkSize);
+	while (stream) {
+		stream.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+		reader.feed(std::string_view(chunk.data(), static_cast<std::size_t>(stream.gcount())));
+	}
+	reader.finish();
+}
+
+void StreamReader::parseFile(const std::string &path, Handler &handler, bool multipleValues, std::size_t chunkSize) {
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+	if (!file.is_open()) {
+		throw std::runtime_error("Failed to open file: " + path);
+	}
+	parseStream(file, handler, multipleValues, chunkSize);
+}
+
+std::size_t StreamReader::_parse(std::string_view input, bool last) {
+	std::size_t pos = 0;
+	Token token;
+	while (_nextToken(input, pos, token, last)) {
+		_handleToken(token, _offset + static_cast<std::size_t>(token.value.data() - input.data()));
+	}
+	return pos;
+}
+
+static bool isLiteralCharacter(char c) {
+	return ('0' <= c && c <= '9') || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || c == '-' || c == '+' ||
+		   c == '.';
+}
+
+bool StreamReader::_nextToken(std::string_view input, std::size_t &pos, Token &token, bool last) {
+	while (pos < input.size()) {
+		char c = input[pos];
+		if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+			break;
+		}
+		pos++;
+	}
+	if (pos >= input.size()) {
+		return false;
+	}
+
+	const std::size_t start = pos;
+	std::size_t end = start + 1;
+	char first = input[start];
+	if (first == '"') {
+		std::size_t cursor = std::max(_scanned, start + 1);
+		while (true) {
+			cursor = input.find_first_of("\"\\", cursor);
+			if (cursor == std::string_view::npos) {
+				_scanned = input.size();
+				return false;
+			}
+			if (input[cursor] == '"') {
+				break;
+			}
+			if (cursor + 1 >= input.size()) {
+				_scanned = cursor; // Continue from the backslash once its escaped character is known
+				return false;
+			}
+			cursor += 2;
+		}
+		end = cursor + 1;
+	} else if (isLiteralCharacter(first)) {
+		end = start;
+		while (end < input.size() && isLiteralCharacter(input[end])) {
+			end++;
+		}
+		if (end == input.size() && !last) {
+			return false; // The next chunk may continue the number or keyword
+		}
+	}
+
+	// The token is complete, the lexer validates it
+	std::string_view text = input.substr(start, end - start);
+	try {
+		Lexer lexer(text);
+		token = lexer.nextToken();
+		if (lexer.position() != text.size()) {
+			throw std::runtime_error("Unexpected character '" + std::string(1, text[lexer.position()]) + "'");
+		}
+	} catch (const std::runtime_error &error) {
+		_error(error.what(), _offset + start);
+	}
+	_scanned = 0;
+	pos = end;
+	return true;
+}
+
+void StreamReader::_handleToken(const Token &token, std::size_t tokenOffset) {
+	switch (_state) {
+	case State::Value: return _handleValue(token, tokenOffset);
+	case State::FirstValueOrEnd:
+		if (token.type == TokenType::RightBracket) {
+			return _close();
+		}
+		return _handleValue(token, tokenOffset);
+	case State::FirstKeyOrEnd:
+		if (token.type == TokenType::RightBrace) {
+			return _close();
+		}
+		[[fallthrough]];
+	case State::Key:
+		if (token.type != TokenType::String) {
+			_error("Expected " + to_string(TokenType::String) + ", but got " + std::string(token.value), tokenOffset);
+		}
+		_handler.key(_decode(token));
+		_state = State::Colon;
+		return;
+	case State::Colon:
+		if (token.type != TokenType::Colon) {
+			_error("Expected " + to_string(TokenType::Colon) + ", but got " + std::string(token.value), tokenOffset);
+		}
+		_state = State::Value;
+		return;
+	case State::CommaOrEnd: {
+		TokenType closing =
+			_containers.back() == TokenType::LeftBrace ? TokenType::RightBrace : TokenType::RightBracket;
+		if (token.type == TokenType::Comma) {
+			_state = _containers.back() == TokenType::LeftBrace ? State::Key : State::Value;
+		} else if (token.type == closing) {
+			_close();
+		} else {
+			_error("Expected " + to_string(TokenType::Comma) + " or " + to_string(closing) + ", but got " +
+					   std::string(token.value),
+				   tokenOffset);
+		}
+		return;
+	}
+	case State::Done: _error("Unexpected content after the Json value", tokenOffset);
+	}
+}
+
+void StreamReader::_handleValue(const Token &token, std::size_t tokenOffset) {
+	switch (token.type) {
+	case TokenType::LeftBrace:
+		_containers.push_back(TokenType::LeftBrace);
+		_handler.startObject();
+		_state = State::FirstKeyOrEnd;
+		return;
+	case TokenType::LeftBracket:
+		_containers.push_back(TokenType::LeftBracket);
+		_handler.startArray();
+		_state = State::FirstValueOrEnd;
+		return;
+	case TokenType::String: _handler.string(_decode(token)); break;
+	case TokenType::Number: _handler.number(Parser::decodeNumber(token)); break;
+	case TokenType::True: _handler.boolean(true); break;
+	case TokenType::False: _handler.boolean(false); break;
+	case TokenType::Null: _handler.null(); break;
+	default: _error("Expected a value, but got " + std::string(token.value), tokenOffset);
+	}
+	_afterValue();
+}
+
+void StreamReader::_afterValue() {
+	if (!_containers.empty()) {
+		_state = State::CommaOrEnd;
+	} else {
+		_state = _multipleValues ? State::Value : State::Done;
+	}
+}
+
+void StreamReader::_close() {
+	TokenType container = _containers.back();
+	_containers.pop_back();
+	if (container == TokenType::LeftBrace) {
+		_handler.endObject();
+	} else {
+		_handler.endArray();
+	}
+	_afterValue();
+}
+
+std::string_view StreamReader::_decode(const Token &token) {
+	if (!token.escaped) {
+		return token.value;
+	}
+	Parser::decodeString(token, _decoded);
+	return _decoded;
+}
+
+void StreamReader::_error(const std::string &message, std::size_t offset) const {
+	throw std::runtime_error(message + " at offset " + std::to_string(offset));
+}
+
+/** StreamWriter */
+
+StreamWriter::StreamWriter(std::ostream &stream, std::size_t bufferSize)
+	: _stream(&stream), _bufferSize(bufferSize), _out(&_buffer) {
+	_buffer.reserve(bufferSize);
+}
+
+StreamWriter::StreamWriter(std::string &output) : _out(&output) {
+}
+
+StreamWriter::~StreamWriter() {
+	flush();
+}
+
+void StreamWriter::startObject() {
+	_beforeValue();
+	*_out += '{';
+	_scopes.push_back({true});
+}
+
+void StreamWriter::key(std::string_view key) {
+	if (_scopes.empty() || !_scopes.back().object || _scopes.back().hasKey) {
+		throw std::runtime_error("A Json key can only be written in an object, before its value");
+	}
+	Scope &scope = _scopes.back();
+	if (!scope.empty) {
+		*_out += ',';
+	}
+	scope.empty = false;
+	scope.hasKey = true;
+	_writeString(key);
+	*_out += ':';
+}
+
+void StreamWriter::endObject() {
+	if (_scopes.empty() || !_scopes.back().object || _scopes.back().hasKey) {
+		throw std::runtime_error("No Json object to end");
+	}
+	_scopes.pop_back();
+	*_out += '}';
+	_afterValue();
+}
+
+void StreamWriter::startArray() {
+	_beforeValue();
+	*_out += '[';
+	_scopes.push_back({false});
+}
+
+void StreamWriter::endArray() {
+	if (_scopes.empty() || _scopes.back().object) {
+		throw std::runtime_error("No Json array to end");
+	}
+	_scopes.pop_back();
+	*_out += ']';
+	_afterValue();
+}
+
+void StreamWriter::string(std::string_view value) {
+	_beforeValue();
+	_writeString(value);
+	_afterValue();
+}
+
+void StreamWriter::number(double value) {
+	_beforeValue();
+	if (!std::isfinite(value)) {
+		// Json has no infinity nor NaN
+		*_out += "null";
+	} else {
+		char text[32];
+#if defined(__cpp_lib_to_chars)
+		// The shortest text read back to the same double
+		auto [end, error] = std::to_chars(text, text + sizeof(text), value);
+		_out->append(text, end);
+#else
+		int size = std::snprintf(text, sizeof(text), "%.17g", value);
+		_out->append(text, static_cast<std::size_t>(size));
+#endif
+	}
+	_afterValue();
+}
+
+void StreamWriter::boolean(bool value) {
+	_beforeValue();
+	*_out += value ? "true" : "false";
+	_afterValue();
+}
+
+void StreamWriter::null() {
+	_beforeValue();
+	*_out += "null";
+	_afterValue();
+}
+
+void StreamWriter::value(const Value &value) {
+	if (value.is<Object>()) {
+		startObject();
+		for (const auto &[memberKey, member] : value.get<Object>()) {
+			key(memberKey);
+			this->value(member);
+		}
+		endObject();
+	} else if (value.is<Array>()) {
+		startArray();
+		for (const auto &element : value.get<Array>()) {
+			this->value(element);
+		}
+		endArray();
+	} else if (value.is<std::string>()) {
+		string(value.get<std::string>());
+	} else if (value.is<double>()) {
+		number(value.get<double>());
+	} else if (value.is<bool>()) {
+		boolean(value.get<bool>());
+	} else {
+		null();
+	}
+}
+
+void StreamWriter::flush() {
+	if (_stream == nullptr || _buffer.empty()) {
+		return;
+	}
+	_stream->write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+	_buffer.clear();
+}
+
+bool StreamWriter::isComplete() const {
+	return _rootWritten && _scopes.empty();
+}
+
+void StreamWriter::_beforeValue() {
+	if (_scopes.empty()) {
+		if (_rootWritten) {
+			throw std::runtime_error("A Json document has a single root value");
+		}
+		_rootWritten = true;
+		return;
+	}
+
+	Scope &scope = _scopes.back();
+	if (scope.object) {
+		if (!scope.hasKey) {
+			throw std::runtime_error("A value in a Json object needs a key");
+		}
+		scope.hasKey = false;
+	} else {
+		if (!scope.empty) {
+			*_out += ',';
+		}
+		scope.empty = false;
+	}
+}
+
+void StreamWriter::_afterValue() {
+	if (_stream != nullptr && _buffer.size() >= _bufferSize) {
+		flush();
+	}
+}
+
+void StreamWriter::_writeString(std::string_view value) {
+	static const char hexDigits[] = "0123456789ABCDEF";
+
+	*_out += '"';
+	std::size_t run = 0;
+	for (std::size_t i = 0; i < value.size(); ++i) {
+		auto c = static_cast<unsigned char>(value[i]);
+		if (c >= 0x20 && c != '"' && c != '\\') {
+			continue;
+		}
+		_out->append(value.data() + run, i - run);
+		run = i + 1;
+		switch (c) {
+		case '"': *_out += "\\\""; break;
+		case '\\': *_out += "\\\\"; break;
+		case '\b': *_out += "\\b"; break;
+		case '\f': *_out += "\\f"; break;
+		case '\n': *_out += "\\n"; break;
+		case '\r': *_out += "\\r"; break;
+		case '\t': *_out += "\\t"; break;
+		default:
+			*_out += "\\u00";
+			*_out += hexDigits[c >> 4];
+			*_out += hexDigits[c & 0xF];
+			break;
+		}
+	}
+	_out->append(value.data() + run, value.size() - run);
+	*_out += '"';
+
+	// A long string is written to the stream without waiting for the end of its value
+	if (_stream != nullptr && _buffer.size() >= _bufferSize) {
+		flush();
+	}
+}
+
+} // namespace Stone::Json
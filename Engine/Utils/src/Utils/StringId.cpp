@@ -0,0 +1,97 @@
+// Copyright 2024 Stone-Engine
+
+#include "Utils/StringId.hpp"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace Stone {
+
+namespace {
+
+/** The ids are already hashed */
+struct IdentityHash {
+	std::size_t operator()(uint64_t hash) const {
+		return static_cast<std::size_t>(hash);
+	}
+};
+
+} // namespace
+
+struct StringId::Table {
+	std::shared_mutex mutex;
+	// Entries of a deque are never moved, the ids pointing to them stay valid
+	std::deque<Entry> entries;
+	// Several entries have the same hash only on a collision
+	std::unordered_multimap<uint64_t, const Entry *, IdentityHash> byHash;
+
+	const Entry *find(std::string_view string, uint64_t hash) const {
+		auto [begin, end] = byHash.equal_range(hash);
+		for (auto it = begin; it != end; ++it) {
+			if (it->second->string == string)
+				return it->second;
+		}
+		return nullptr;
+	}
+};
+
+StringId::StringId(std::string_view string) : StringId(_intern(string, hash(string))) {
+}
+
+std::optional<StringId> StringId::find(std::string_view string) {
+	if (string.empty())
+		return StringId();
+	uint64_t stringHash = hash(string);
+	Table &table = _table();
+	std::shared_lock<std::shared_mutex> lock(table.mutex);
+	const Entry *entry = table.find(string, stringHash);
+	if (entry == nullptr)
+		return std::nullopt;
+	return StringId(entry);
+}
+
+std::size_t StringId::count() {
+	Table &table = _table();
+	std::shared_lock<std::shared_mutex> lock(table.mutex);
+	return table.entries.size();
+}
+
+const std::string &StringId::str() const {
+	static const std::string empty;
+	return _entry == nullptr ? empty : _entry->string;
+}
+
+uint64_t StringId::getHash() const {
+	return _entry == nullptr ? 0 : _entry->hash;
+}
+
+StringId::Table &StringId::_table() {
+	static Table table;
+	return table;
+}
+
+StringId StringId::_intern(std::string_view string, uint64_t hash) {
+	if (string.empty())
+		return {};
+	Table &table = _table();
+	{
+		std::shared_lock<std::shared_mutex> lock(table.mutex);
+		if (const Entry *entry = table.find(string, hash))
+			return StringId(entry);
+	}
+	std::unique_lock<std::shared_mutex> lock(table.mutex);
+	// Another thread may have added it between both locks
+	if (const Entry *entry = table.find(string, hash))
+		return StringId(entry);
+	const Entry &entry = table.entries.emplace_back(Entry{hash, std::string(string)});
+	table.byHash.emplace(hash, &entry);
+	return StringId(&entry);
+}
+
+} // namespace Stone
+
+std::ostream &operator<<(std::ostream &stream, const Stone::StringId &id) {
+	return stream << id.str();
+}
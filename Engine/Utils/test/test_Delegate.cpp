@@ -0,0 +1,38 @@
+#include "Utils/Delegate.hpp"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace Stone;
+
+static int multiply(int a, int b) {
+	return a * b;
+}
+
+TEST(Delegate, CallFunction) {
+	Delegate<int(int, int)> delegate(multiply);
+	EXPECT_TRUE(delegate);
+	EXPECT_EQ(delegate(6, 7), 42);
+}
+
+TEST(Delegate, CallLargeLambda) {
+	std::array<int, 32> values = {};
+	values[31] = 5;
+	Delegate<int(int)> delegate([values](int index) { return values[index]; });
+	EXPECT_EQ(delegate(31), 5);
+}
+
+TEST(Delegate, MoveKeepsCallable) {
+	auto counter = std::make_shared<int>(0);
+	Delegate<void()> delegate([counter] { ++*counter; });
+	EXPECT_EQ(counter.use_count(), 2);
+
+	Delegate<void()> moved(std::move(delegate));
+	EXPECT_FALSE(delegate);
+	moved();
+	EXPECT_EQ(*counter, 1);
+
+	moved = Delegate<void()>();
+	EXPECT_EQ(counter.use_count(), 1);
+}
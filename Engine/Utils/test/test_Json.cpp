@@ -97,6 +97,103 @@ TEST(Json, MalformedJsonThrowsException2) {
 		std::runtime_error);
 }
 
+TEST(Json, ParseNumbers) {
+	std::string jsonString = R"([0, -12, 3.25, 1e3, -2.5E-2, 6.02e+23])";
+
+	Json::Value json;
+	Json::Value::parseString(jsonString, json);
+
+	auto arr = json.get<Json::Array>();
+	ASSERT_EQ(arr.size(), 6);
+	ASSERT_EQ(arr[0].get<double>(), 0);
+	ASSERT_EQ(arr[1].get<double>(), -12);
+	ASSERT_EQ(arr[2].get<double>(), 3.25);
+	ASSERT_EQ(arr[3].get<double>(), 1000);
+	ASSERT_DOUBLE_EQ(arr[4].get<double>(), -0.025);
+	ASSERT_DOUBLE_EQ(arr[5].get<double>(), 6.02e23);
+}
+
+TEST(Json, ParseEscapedString) {
+	std::string jsonString = R"({"say \"hi\"": "line\nbreak\t\\ \/", "unicode": "é€😀"})";
+
+	Json::Value json;
+	Json::Value::parseString(jsonString, json);
+
+	auto obj = json.get<Json::Object>();
+	ASSERT_EQ(obj["say \"hi\""].get<std::string>(), "line\nbreak\t\\ /");
+	ASSERT_EQ(obj["unicode"].get<std::string>(), "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+}
+
+TEST(Json, ParseUnicodeEscapes) {
+	std::string jsonString = R"(["\u00e9", "\u20AC", "\ud83d\ude00", "a\u0000b", "\u007f\u0080\u07ff\u0800\uffff"])";
+
+	Json::Value json;
+	Json::Value::parseString(jsonString, json);
+
+	auto arr = json.get<Json::Array>();
+	ASSERT_EQ(arr[0].get<std::string>(), "\xC3\xA9");
+	ASSERT_EQ(arr[1].get<std::string>(), "\xE2\x82\xAC");
+	ASSERT_EQ(arr[2].get<std::string>(), "\xF0\x9F\x98\x80");
+	ASSERT_EQ(arr[3].get<std::string>(), std::string("a\0b", 3));
+	ASSERT_EQ(arr[4].get<std::string>(), "\x7F\xC2\x80\xDF\xBF\xE0\xA0\x80\xEF\xBF\xBF");
+}
+
+TEST(Json, ParseLongString) {
+	// Long enough to go through the vectorized scan, with delimiters on both sides of a 16 bytes boundary
+	std::string content(1000, 'a');
+	content[15] = '\n';
+	content[16] = '"';
+	content[500] = '\\';
+
+	Json::Value json;
+	Json::Value::parseString(Json::string(content).serialize(), json);
+
+	ASSERT_EQ(json.get<std::string>(), content);
+}
+
+TEST(Json, SerializeEscapedRoundTrip) {
+	std::string content = std::string("control \x01 quote \" backslash \\ ") + "\xC3\xA9";
+	auto value = Json::object({{"key \"quoted\"", Json::string(content)}});
+
+	Json::Value json;
+	Json::Value::parseString(value.serialize(), json);
+
+	ASSERT_EQ(json.get<Json::Object>()["key \"quoted\""].get<std::string>(), content);
+}
+
+TEST(Json, InvalidInputsThrowException) {
+	for (const char *jsonString : {
+			 "",
+			 "[1, 2,]",
+			 R"({"a": 1,})",
+			 "{} {}",
+			 "[01]",
+			 "[1.]",
+			 "[-]",
+			 "[tru]",
+			 R"(["unterminated)",
+			 R"(["bad \x escape"])",
+			 R"(["\ud83d alone"])",
+			 R"(["\u12G4"])",
+		 }) {
+		Json::Value json;
+		EXPECT_THROW(Json::Value::parseString(jsonString, json), std::runtime_error) << jsonString;
+	}
+}
+
+TEST(Json, DeepNestingThrowsException) {
+	std::string jsonString(Json::Parser::maxDepth + 1, '[');
+	jsonString.append(Json::Parser::maxDepth + 1, ']');
+
+	Json::Value json;
+	ASSERT_THROW(Json::Value::parseString(jsonString, json), std::runtime_error);
+
+	std::string accepted(Json::Parser::maxDepth, '[');
+	accepted.append(Json::Parser::maxDepth, ']');
+	Json::Value::parseString(accepted, json);
+	ASSERT_TRUE(json.is<Json::Array>());
+}
+
 /*
  * Serializer tests
  */
@@ -249,3 +346,17 @@ TEST(JsonSerializer, SerializeComplexObject) {
 	ASSERT_EQ(address["city"].get<std::string>(), "New York");
 	ASSERT_EQ(address["zip"].get<std::string>(), "10001");
 }
+
+TEST(JsonSerializer, SerializeNumbersRoundTrip) {
+	auto value = Json::array({0.1 + 0.2, 1.0 / 3.0, 123456789.125, -1e-300, 30.0});
+
+	Json::Value json;
+	Json::Value::parseString(value.serialize(), json);
+
+	auto arr = json.get<Json::Array>();
+	ASSERT_EQ(arr[0].get<double>(), 0.1 + 0.2);
+	ASSERT_EQ(arr[1].get<double>(), 1.0 / 3.0);
+	ASSERT_EQ(arr[2].get<double>(), 123456789.125);
+	ASSERT_EQ(arr[3].get<double>(), -1e-300);
+	ASSERT_EQ(Json::number(30.0).serialize(), "30");
+}
@@ -0,0 +1,173 @@
+#include "Utils/JsonDocument.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace Stone;
+
+TEST(JsonDocument, DefaultIsNull) {
+	Json::Document document;
+
+	ASSERT_TRUE(document.getRoot().isNull());
+	ASSERT_TRUE(document.toValue().isNull());
+}
+
+TEST(JsonDocument, ParseSimpleObject) {
+	Json::Document document;
+	Json::Document::parseString(R"({"name": "John", "age": 30, "isStudent": false, "parent": null})", document);
+
+	Json::ValueView root = document.getRoot();
+	ASSERT_TRUE(root.is<Json::Object>());
+
+	Json::ObjectView obj = root.get<Json::Object>();
+	ASSERT_EQ(obj.size(), 4);
+
+	ASSERT_TRUE(obj.at("name").is<std::string>());
+	ASSERT_EQ(obj.at("name").get<std::string>(), "John");
+
+	ASSERT_TRUE(obj.at("age").is<double>());
+	ASSERT_EQ(obj.at("age").get<double>(), 30);
+
+	ASSERT_TRUE(obj.at("isStudent").is<bool>());
+	ASSERT_EQ(obj.at("isStudent").get<bool>(), false);
+
+	ASSERT_TRUE(obj.at("parent").isNull());
+
+	ASSERT_FALSE(obj.contains("missing"));
+	ASSERT_THROW((void)obj.at("missing"), std::out_of_range);
+	ASSERT_THROW((void)obj.at("name").get<double>(), std::bad_variant_access);
+}
+
+TEST(JsonDocument, ParseNestedArrays) {
+	Json::Document document;
+	Json::Document::parseString(R"([[1, 2], [], ["three", [4]], "escaped \"quote\""])", document);
+
+	Json::ArrayView arr = document.getRoot().get<Json::Array>();
+	ASSERT_EQ(arr.size(), 4);
+
+	Json::ArrayView first = arr[0].get<Json::Array>();
+	ASSERT_EQ(first.size(), 2);
+	ASSERT_EQ(first[0].get<double>(), 1);
+	ASSERT_EQ(first[1].get<double>(), 2);
+
+	ASSERT_TRUE(arr[1].get<Json::Array>().empty());
+
+	Json::ArrayView third = arr[2].get<Json::Array>();
+	ASSERT_EQ(third[0].get<std::string>(), "three");
+	ASSERT_EQ(third[1].get<Json::Array>()[0].get<double>(), 4);
+
+	ASSERT_EQ(arr[3].get<std::string>(), "escaped \"quote\"");
+	ASSERT_THROW((void)arr.at(4), std::out_of_range);
+
+	double sum = 0;
+	for (Json::ValueView element : first) {
+		sum += element.get<double>();
+	}
+	ASSERT_EQ(sum, 3);
+}
+
+TEST(JsonDocument, ObjectMembersAreSorted) {
+	Json::Document document;
+	Json::Document::parseString(R"({"b": 2, "c": 3, "a": 1, "b": 4})", document);
+
+	Json::ObjectView obj = document.getRoot().get<Json::Object>();
+	ASSERT_EQ(obj.size(), 3);
+
+	std::vector<std::string_view> keys;
+	for (const auto &[key, value] : obj) {
+		keys.push_back(key);
+	}
+	ASSERT_EQ(keys, (std::vector<std::string_view>{"a", "b", "c"}));
+
+	// The last duplicated key wins, as with Value
+	ASSERT_EQ(obj.at("b").get<double>(), 4);
+}
+
+TEST(JsonDocument, LargeObjectMembersAreSorted) {
+	std::string jsonString = "{";
+	for (int index = 39; index >= 0; --index) {
+		jsonString += "\"key_" + std::to_string(100 + index) + "\": " + std::to_string(index) + ", ";
+	}
+	jsonString += R"("key_100": -1})";
+
+	Json::Document document;
+	Json::Document::parseString(jsonString, document);
+
+	Json::ObjectView obj = document.getRoot().get<Json::Object>();
+	ASSERT_EQ(obj.size(), 40);
+	ASSERT_TRUE(std::is_sorted(obj.begin(), obj.end(), [](const auto &a, const auto &b) { return a.first < b.first; }));
+	ASSERT_EQ(obj.at("key_100").get<double>(), -1);
+	ASSERT_EQ(obj.at("key_139").get<double>(), 39);
+}
+
+TEST(JsonDocument, KeysAreInterned) {
+	Json::Document first;
+	Json::Document second;
+	Json::Document::parseString(R"([{"interned_key": 1}, {"interned_key": 2}])", first);
+	Json::Document::parseString(R"({"interned_key": 3})", second);
+
+	auto firstKey = (*first.getRoot().get<Json::Array>()[0].get<Json::Object>().begin()).first;
+	auto secondKey = (*first.getRoot().get<Json::Array>()[1].get<Json::Object>().begin()).first;
+	auto thirdKey = (*second.getRoot().get<Json::Object>().begin()).first;
+
+	ASSERT_EQ(firstKey.data(), secondKey.data());
+	ASSERT_EQ(firstKey.data(), thirdKey.data());
+	ASSERT_EQ(Json::KeyPool::intern("interned_key").data(), firstKey.data());
+}
+
+TEST(JsonDocument, ConvertFromAndToValue) {
+	Json::Object address;
+	address["city"] = Json::string("New York");
+	address["zip"] = Json::string("10001");
+
+	Json::Object obj;
+	obj["name"] = "John";
+	obj["age"] = 30.0;
+	obj["isStudent"] = false;
+	obj["scores"] = Json::array({85.5, 92.0, 78.5});
+	obj["address"] = address;
+	obj["nothing"] = Json::null();
+
+	Json::Document document(Json::object(obj));
+
+	Json::ObjectView view = document.getRoot().get<Json::Object>();
+	ASSERT_EQ(view.size(), obj.size());
+	ASSERT_EQ(view.at("address").get<Json::Object>().at("city").get<std::string>(), "New York");
+	ASSERT_EQ(view.at("scores").get<Json::Array>()[2].get<double>(), 78.5);
+
+	Json::Value value = document.toValue();
+	auto &result = value.get<Json::Object>();
+	ASSERT_EQ(result.size(), obj.size());
+	ASSERT_EQ(result["name"].get<std::string>(), "John");
+	ASSERT_EQ(result["age"].get<double>(), 30);
+	ASSERT_EQ(result["isStudent"].get<bool>(), false);
+	ASSERT_TRUE(result["nothing"].isNull());
+	ASSERT_EQ(result["scores"].get<Json::Array>().size(), 3);
+	ASSERT_EQ(result["address"].get<Json::Object>()["zip"].get<std::string>(), "10001");
+}
+
+TEST(JsonDocument, MalformedJsonThrowsException) {
+	for (const char *jsonString : {"", R"({"name": "John")", R"({"name": John})", "[1, 2,]", "[1] 2"}) {
+		Json::Document document;
+		EXPECT_THROW(Json::Document::parseString(jsonString, document), std::runtime_error) << jsonString;
+	}
+}
+
+TEST(JsonDocument, ParseGeneratedDocument) {
+	std::string jsonString = "{\"objects\":[";
+	for (int index = 0; index < 100; ++index) {
+		if (index > 0)
+			jsonString += ",";
+		jsonString += R"({"name":"object_)" + std::to_string(index) + R"(","value":)" + std::to_string(index) + "}";
+	}
+	jsonString += "]}";
+
+	Json::Document document;
+	Json::Document::parseString(jsonString, document);
+
+	Json::ArrayView objects = document.getRoot().get<Json::Object>().at("objects").get<Json::Array>();
+	ASSERT_EQ(objects.size(), 100);
+	ASSERT_EQ(objects[42].get<Json::Object>().at("name").get<std::string>(), "object_42");
+	ASSERT_EQ(objects[99].get<Json::Object>().at("value").get<double>(), 99);
+	ASSERT_GT(document.getMemoryUsage(), sizeof(Json::Document));
+}
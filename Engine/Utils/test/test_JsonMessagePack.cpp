@@ -0,0 +1,192 @@
+#include "Utils/JsonMessagePack.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace Stone;
+
+static bool equal(const Json::Value &a, const Json::Value &b) {
+	if (a.value.index() != b.value.index()) {
+		return false;
+	}
+	if (a.is<Json::Object>()) {
+		const auto &objectA = a.get<Json::Object>();
+		const auto &objectB = b.get<Json::Object>();
+		if (objectA.size() != objectB.size()) {
+			return false;
+		}
+		for (const auto &[key, value] : objectA) {
+			auto it = objectB.find(key);
+			if (it == objectB.end() || !equal(value, it->second)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	if (a.is<Json::Array>()) {
+		const auto &arrayA = a.get<Json::Array>();
+		const auto &arrayB = b.get<Json::Array>();
+		if (arrayA.size() != arrayB.size()) {
+			return false;
+		}
+		for (size_t index = 0; index < arrayA.size(); ++index) {
+			if (!equal(arrayA[index], arrayB[index])) {
+				return false;
+			}
+		}
+		return true;
+	}
+	if (a.is<double>()) {
+		double numberA = a.get<double>();
+		double numberB = b.get<double>();
+		return numberA == numberB && std::signbit(numberA) == std::signbit(numberB);
+	}
+	if (a.is<std::string>()) {
+		return a.get<std::string>() == b.get<std::string>();
+	}
+	if (a.is<bool>()) {
+		return a.get<bool>() == b.get<bool>();
+	}
+	return true;
+}
+
+static std::vector<char> bytes(std::initializer_list<int> values) {
+	std::vector<char> result;
+	for (int value : values) {
+		result.push_back(static_cast<char>(value));
+	}
+	return result;
+}
+
+static std::string_view view(const std::vector<char> &data) {
+	return {data.data(), data.size()};
+}
+
+TEST(JsonMessagePack, EncodeScalars) {
+	ASSERT_EQ(Json::toMessagePack(Json::null()), bytes({0xc0}));
+	ASSERT_EQ(Json::toMessagePack(Json::boolean(true)), bytes({0xc3}));
+	ASSERT_EQ(Json::toMessagePack(Json::number(5)), bytes({0x05}));
+	ASSERT_EQ(Json::toMessagePack(Json::number(-1)), bytes({0xff}));
+	ASSERT_EQ(Json::toMessagePack(Json::number(300)), bytes({0xcd, 0x01, 0x2c}));
+	ASSERT_EQ(Json::toMessagePack(Json::number(-200)), bytes({0xd1, 0xff, 0x38}));
+	ASSERT_EQ(Json::toMessagePack(Json::number(1.5)), bytes({0xca, 0x3f, 0xc0, 0x00, 0x00}));
+	ASSERT_EQ(Json::toMessagePack(Json::number(0.1)).size(), 9);
+	ASSERT_EQ(Json::toMessagePack(Json::string("abc")), bytes({0xa3, 'a', 'b', 'c'}));
+	ASSERT_EQ(Json::toMessagePack(Json::array({1.0, true})), bytes({0x92, 0x01, 0xc3}));
+	ASSERT_EQ(Json::toMessagePack(Json::object({{"a", Json::null()}})), bytes({0x81, 0xa1, 'a', 0xc0}));
+}
+
+TEST(JsonMessagePack, RoundTripNumbers) {
+	std::vector<double> numbers = {0.0, -0.0, 1.0, 127.0, 128.0, 255.0, 256.0, 65535.0, 65536.0, 4294967295.0,
+								   4294967296.0, -32.0, -33.0, -128.0, -129.0, -32768.0, -32769.0, -2147483648.0,
+								   -2147483649.0, 0.1, -2.5, 1e300, 9007199254740993.0, 18446744073709551616.0,
+								   INFINITY};
+	for (double number : numbers) {
+		Json::Value decoded;
+		Json::fromMessagePack(view(Json::toMessagePack(Json::number(number))), decoded);
+
+		ASSERT_TRUE(decoded.is<double>()) << number;
+		ASSERT_EQ(decoded.get<double>(), number);
+		ASSERT_EQ(std::signbit(decoded.get<double>()), std::signbit(number));
+	}
+}
+
+TEST(JsonMessagePack, RoundTripLongContainers) {
+	Json::Array array;
+	Json::Object object;
+	for (int index = 0; index < 70000; ++index) {
+		array.emplace_back(static_cast<double>(index));
+	}
+	for (int index = 0; index < 20; ++index) {
+		object["key_" + std::to_string(index)] = std::string(300, static_cast<char>('a' + index));
+	}
+	Json::Value value = Json::object({{"array", Json::array(array)}, {"object", Json::object(object)}});
+
+	Json::Value decoded;
+	Json::fromMessagePack(view(Json::toMessagePack(value)), decoded);
+	ASSERT_TRUE(equal(value, decoded));
+}
+
+TEST(JsonMessagePack, RoundTripTextJson) {
+	std::string jsonString = R"({
+		"name": "John \"Doe\" é",
+		"age": 30,
+		"height": 1.83,
+		"isStudent": false,
+		"parent": null,
+		"scores": [85.5, 92, -78.25, 1e-7],
+		"address": {"city": "New York", "zip": "10001", "location": [40.7128, -74.006]}
+	})";
+
+	Json::Value text;
+	Json::Value::parseString(jsonString, text);
+
+	Json::Value binary;
+	Json::fromMessagePack(view(Json::toMessagePack(text)), binary);
+	ASSERT_TRUE(equal(text, binary));
+
+	// Back to text, then to binary again
+	Json::Value reparsed;
+	Json::Value::parseString(binary.serialize(), reparsed);
+	ASSERT_TRUE(equal(text, reparsed));
+	ASSERT_LT(Json::toMessagePack(text).size(), text.serialize().size());
+}
+
+TEST(JsonMessagePack, ReadEventsWithoutCopy) {
+	std::vector<char> data = Json::toMessagePack(Json::array({Json::string("first"), Json::object({{"key", 2.0}})}));
+
+	class StringViews : public Json::Handler {
+	public:
+		std::vector<std::string_view> views;
+
+		void key(std::string_view key) override {
+			views.push_back(key);
+		}
+
+		void string(std::string_view value) override {
+			views.push_back(value);
+		}
+	} handler;
+
+	ASSERT_EQ(Json::readMessagePack(view(data), handler), data.size());
+	ASSERT_EQ(handler.views.size(), 2);
+	ASSERT_EQ(handler.views[0], "first");
+	ASSERT_EQ(handler.views[1], "key");
+	for (std::string_view str : handler.views) {
+		ASSERT_GE(str.data(), data.data());
+		ASSERT_LE(str.data() + str.size(), data.data() + data.size());
+	}
+}
+
+TEST(JsonMessagePack, ConvertToText) {
+	Json::Value value = Json::object({{"list", Json::array({1.0, 0.5, Json::string("x")})}});
+
+	std::string text;
+	{
+		Json::StreamWriter writer(text);
+		Json::readMessagePack(view(Json::toMessagePack(value)), writer);
+	}
+	ASSERT_EQ(text, R"({"list":[1,0.5,"x"]})");
+}
+
+TEST(JsonMessagePack, MalformedDataThrowsException) {
+	for (const auto &data : {
+			 bytes({}),
+			 bytes({0xa3, 'a'}),
+			 bytes({0x92, 0x01}),
+			 bytes({0x81, 0x01, 0x01}),
+			 bytes({0xcd, 0x01}),
+			 bytes({0xc1}),
+			 bytes({0xd4, 0x01, 0x01}),
+			 bytes({0xdd, 0x7f, 0xff, 0xff, 0xff}),
+			 bytes({0xc0, 0xc0}),
+		 }) {
+		Json::Value value;
+		EXPECT_THROW(Json::fromMessagePack(view(data), value), std::runtime_error);
+	}
+
+	std::vector<char> deep(Json::Parser::maxDepth + 1, static_cast<char>(0x91));
+	deep.push_back(static_cast<char>(0xc0));
+	Json::Value value;
+	EXPECT_THROW(Json::fromMessagePack(view(deep), value), std::runtime_error);
+}
@@ -0,0 +1,214 @@
+#include "Utils/JsonStream.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace Stone;
+
+/**
+ * Records the events as a compact text, to compare them in one assertion.
+ */
+class RecordingHandler : public Json::Handler {
+public:
+	std::string events;
+
+	void startObject() override {
+		events += "{ ";
+	}
+
+	void key(std::string_view key) override {
+		events += "key:" + std::string(key) + " ";
+	}
+
+	void endObject() override {
+		events += "} ";
+	}
+
+	void startArray() override {
+		events += "[ ";
+	}
+
+	void endArray() override {
+		events += "] ";
+	}
+
+	void string(std::string_view value) override {
+		events += "string:" + std::string(value) + " ";
+	}
+
+	void number(double value) override {
+		std::ostringstream stream;
+		stream << value;
+		events += "number:" + stream.str() + " ";
+	}
+
+	void boolean(bool value) override {
+		events += value ? "true " : "false ";
+	}
+
+	void null() override {
+		events += "null ";
+	}
+};
+
+static const std::string sampleJson =
+	R"({"name": "John \"Doe\"", "age": 30, "scores": [85.5, -1e2, true, false, null], "empty": {}, "list": []})";
+static const std::string sampleEvents = "{ key:name string:John \"Doe\" key:age number:30 key:scores [ number:85.5 "
+										"number:-100 true false null ] key:empty { } key:list [ ] } ";
+
+TEST(JsonStreamReader, ParseWholeInput) {
+	RecordingHandler handler;
+	Json::StreamReader reader(handler);
+	reader.feed(sampleJson);
+	reader.finish();
+
+	ASSERT_EQ(handler.events, sampleEvents);
+	ASSERT_EQ(reader.getOffset(), sampleJson.size());
+}
+
+TEST(JsonStreamReader, ParseEveryChunkSize) {
+	// Every token is split at every possible position
+	for (std::size_t chunkSize = 1; chunkSize <= sampleJson.size(); ++chunkSize) {
+		RecordingHandler handler;
+		Json::StreamReader reader(handler);
+		for (std::size_t pos = 0; pos < sampleJson.size(); pos += chunkSize) {
+			reader.feed(std::string_view(sampleJson).substr(pos, chunkSize));
+		}
+		reader.finish();
+
+		ASSERT_EQ(handler.events, sampleEvents) << "chunk size " << chunkSize;
+	}
+}
+
+TEST(JsonStreamReader, NumberAtTheEndOfTheInput) {
+	RecordingHandler handler;
+	Json::StreamReader reader(handler);
+	reader.feed("12");
+	reader.feed("34");
+	ASSERT_TRUE(handler.events.empty());
+	reader.finish();
+
+	ASSERT_EQ(handler.events, "number:1234 ");
+}
+
+TEST(JsonStreamReader, ParseMultipleValues) {
+	RecordingHandler handler;
+	Json::StreamReader reader(handler, true);
+	reader.feed("{\"frame\": 1}\n{\"frame\": 2}\n");
+	reader.feed("[]");
+	reader.finish();
+
+	ASSERT_EQ(handler.events, "{ key:frame number:1 } { key:frame number:2 } [ ] ");
+}
+
+TEST(JsonStreamReader, MalformedJsonThrowsException) {
+	for (const char *jsonString : {"", R"({"name": "John")", R"({"name": John})", "[1, 2,]", "[1] 2", R"(["open)",
+								   "[1 2]", R"({"a" 1})", "[}", "[tru]", "[01]"}) {
+		RecordingHandler handler;
+		Json::StreamReader reader(handler);
+		EXPECT_THROW(
+			{
+				reader.feed(jsonString);
+				reader.finish();
+			},
+			std::runtime_error)
+			<< jsonString;
+	}
+}
+
+TEST(JsonStreamReader, ParseFile) {
+	const std::string path = testing::TempDir() + "stone_json_stream.json";
+	{
+		std::ofstream file(path, std::ios::trunc);
+		file << sampleJson;
+	}
+
+	RecordingHandler handler;
+	Json::StreamReader::parseFile(path, handler, false, 7);
+	ASSERT_EQ(handler.events, sampleEvents);
+
+	std::remove(path.c_str());
+}
+
+TEST(JsonStreamWriter, WriteToString) {
+	std::string output;
+	{
+		Json::StreamWriter writer(output);
+		writer.startObject();
+		writer.key("name");
+		writer.string("John \"Doe\"\n");
+		writer.key("values");
+		writer.startArray();
+		writer.number(1);
+		writer.number(0.1);
+		writer.boolean(true);
+		writer.null();
+		writer.endArray();
+		writer.endObject();
+		ASSERT_TRUE(writer.isComplete());
+	}
+
+	ASSERT_EQ(output, R"({"name":"John \"Doe\"\n","values":[1,0.1,true,null]})");
+}
+
+TEST(JsonStreamWriter, WriteValue) {
+	auto value = Json::object({
+		{"person", Json::object({{"name", Json::string("John")}, {"scores", Json::array({85.5, 92.0})}})},
+	});
+
+	std::string output;
+	Json::StreamWriter(output).value(value);
+
+	Json::Value json;
+	Json::Value::parseString(output, json);
+	auto &person = json.get<Json::Object>()["person"].get<Json::Object>();
+	ASSERT_EQ(person["name"].get<std::string>(), "John");
+	ASSERT_EQ(person["scores"].get<Json::Array>()[1].get<double>(), 92);
+}
+
+TEST(JsonStreamWriter, InvalidStructureThrowsException) {
+	std::string output;
+	Json::StreamWriter writer(output);
+	writer.startObject();
+	ASSERT_THROW(writer.number(1), std::runtime_error);
+	ASSERT_THROW(writer.endArray(), std::runtime_error);
+	writer.key("a");
+	ASSERT_THROW(writer.key("b"), std::runtime_error);
+	writer.number(1);
+	writer.endObject();
+	ASSERT_THROW(writer.number(2), std::runtime_error);
+}
+
+TEST(JsonStreamWriter, StreamWithSmallBuffer) {
+	std::ostringstream stream;
+	{
+		Json::StreamWriter writer(stream, 16);
+		writer.startArray();
+		for (int index = 0; index < 100; ++index) {
+			writer.string("element_" + std::to_string(index));
+		}
+		writer.endArray();
+
+		// At most one buffer is waiting to be written
+		ASSERT_GT(stream.str().size(), 1000);
+	}
+
+	Json::Value json;
+	Json::Value::parseString(stream.str(), json);
+	ASSERT_EQ(json.get<Json::Array>().size(), 100);
+	ASSERT_EQ(json.get<Json::Array>()[99].get<std::string>(), "element_99");
+}
+
+TEST(JsonStream, PipeReaderToWriter) {
+	std::string output;
+	{
+		Json::StreamWriter writer(output);
+		Json::StreamReader reader(writer);
+		reader.feed(sampleJson);
+		reader.finish();
+	}
+
+	ASSERT_EQ(output, R"({"name":"John \"Doe\"","age":30,"scores":[85.5,-100,true,false,null],"empty":{},"list":[]})");
+}
@@ -1,6 +1,9 @@
 #include "Utils/SigSlot.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace Stone;
 
@@ -220,3 +223,203 @@ TEST(Signal, BulletGame) {
 	EXPECT_LE(character.health, 0);
 	EXPECT_TRUE(character_died);
 }
+
+TEST(Signal, BroadcastInBindingOrder) {
+	std::vector<int> order;
+	Signal<> signal;
+	Slot<> first([&order] { order.push_back(1); });
+	Slot<> second([&order] { order.push_back(2); });
+	Slot<> third([&order] { order.push_back(3); });
+	signal.bind(second);
+	signal.bind(first);
+	signal.bind(third);
+	signal.unbind(first);
+	signal.bind(first);
+
+	signal.broadcast();
+	EXPECT_EQ(order, std::vector<int>({2, 3, 1}));
+	EXPECT_EQ(signal.getSlotCount(), 3);
+}
+
+TEST(Signal, UnbindDuringBroadcast) {
+	int count = 0;
+	Signal<int> signal;
+	auto last = std::make_unique<Slot<int>>([&count](int value) { count += value; });
+	Slot<int> first([&last, &count](int value) {
+		count += value;
+		last.reset();
+	});
+	Slot<int> bound_later([&count](int value) { count += 100 * value; });
+	Slot<int> binder([&signal, &bound_later](int) { signal.bind(bound_later); });
+	signal.bind(first);
+	signal.bind(binder);
+	signal.bind(*last);
+
+	// The destroyed slot is skipped, the slot bound during the broadcast only gets the next one
+	signal.broadcast(1);
+	EXPECT_EQ(count, 1);
+	EXPECT_EQ(signal.getSlotCount(), 3);
+
+	signal.broadcast(1);
+	EXPECT_EQ(count, 102);
+}
+
+TEST(ConcurrentSignal, BroadcastFromThreads) {
+	std::atomic<int> count = 0;
+	ConcurrentSignal<int> signal;
+	Slot<int> slot([&count](int value) { count += value; });
+	signal.bind(slot);
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; i++) {
+		threads.emplace_back([&signal] {
+			for (int j = 0; j < 1000; j++)
+				signal.broadcast(1);
+		});
+	}
+	// Slots come and go while the threads broadcast
+	for (int i = 0; i < 100; i++) {
+		Slot<int> transient([](int) {});
+		signal.bind(transient);
+	}
+	for (auto &thread : threads)
+		thread.join();
+
+	EXPECT_EQ(count, 4000);
+	EXPECT_EQ(signal.getSlotCount(), 1);
+}
+
+TEST(ConcurrentSignal, UnbindDuringBroadcast) {
+	int count = 0;
+	ConcurrentSignal<> signal;
+	auto last = std::make_unique<Slot<>>([&count] { ++count; });
+	Slot<> first([&last, &count] {
+		++count;
+		last.reset();
+	});
+	signal.bind(first);
+	signal.bind(*last);
+
+	signal.broadcast();
+	EXPECT_EQ(count, 1);
+	EXPECT_EQ(signal.getSlotCount(), 1);
+}
+
+TEST(Signal, QueuedSlot) {
+	DispatchQueue queue;
+	std::vector<int> received;
+	Signal<int> signal;
+	Slot<int> slot([&received](int value) { received.push_back(value); }, queue);
+	signal.bind(slot);
+	EXPECT_TRUE(slot.isQueued());
+
+	signal.broadcast(1);
+	signal.broadcast(2);
+	signal.broadcast(3);
+	EXPECT_TRUE(received.empty());
+
+	queue.execute();
+	EXPECT_EQ(received, std::vector<int>({1, 2, 3}));
+}
+
+TEST(Signal, QueuedSlotLatest) {
+	DispatchQueue queue;
+	std::vector<int> received;
+	Signal<int> signal;
+	Slot<int> slot([&received](int value) { received.push_back(value); }, queue, QueuedDelivery::Latest);
+	signal.bind(slot);
+
+	for (int i = 0; i < 10; i++)
+		signal.broadcast(i);
+	queue.execute();
+	EXPECT_EQ(received, std::vector<int>({9}));
+
+	// Destroyed slots drop their pending events
+	auto dropped = std::make_unique<Slot<int>>([&received](int value) { received.push_back(-value); }, queue);
+	signal.bind(*dropped);
+	signal.broadcast(10);
+	dropped.reset();
+	queue.execute();
+	EXPECT_EQ(received, std::vector<int>({9, 10}));
+}
+
+TEST(ConcurrentSignal, QueuedSlotFromThreads) {
+	DispatchQueue queue;
+	int count = 0;
+	ConcurrentSignal<int> signal;
+	Slot<int> slot([&count](int value) { count += value; }, queue);
+	signal.bind(slot);
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; i++) {
+		threads.emplace_back([&signal] {
+			for (int j = 0; j < 1000; j++)
+				signal.broadcast(1);
+		});
+	}
+	for (auto &thread : threads)
+		thread.join();
+
+	// The slot callback runs on the thread executing the queue, without locking
+	queue.execute();
+	EXPECT_EQ(count, 4000);
+}
+
+TEST(ConcurrentSignal, UnbindWhileAnotherSlotRuns) {
+	// Unbinding a slot does not wait for the broadcasts running other slots
+	ConcurrentSignal<> signal;
+	std::atomic<bool> entered = false;
+	std::atomic<bool> released = false;
+	auto other = std::make_unique<Slot<>>([] {});
+	Slot<> blocking([&entered, &released] {
+		entered = true;
+		while (!released)
+			std::this_thread::yield();
+	});
+	signal.bind(*other);
+	signal.bind(blocking);
+
+	std::thread thread([&signal] { signal.broadcast(); });
+	while (!entered)
+		std::this_thread::yield();
+	other.reset();
+	released = true;
+	thread.join();
+
+	EXPECT_EQ(signal.getSlotCount(), 1);
+}
+
+TEST(ConcurrentSignal, UnbindWaitsForRunningCallback) {
+	ConcurrentSignal<> signal;
+	std::atomic<bool> entered = false;
+	std::atomic<bool> finished = false;
+	Slot<> slot([&entered, &finished] {
+		entered = true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		finished = true;
+	});
+	signal.bind(slot);
+
+	std::thread thread([&signal] { signal.broadcast(); });
+	while (!entered)
+		std::this_thread::yield();
+	slot.unbind();
+	EXPECT_TRUE(finished);
+	thread.join();
+}
+
+TEST(ConcurrentSignal, UnbindOwnSlotFromCallback) {
+	int count = 0;
+	ConcurrentSignal<> signal;
+	Slot<> slot([&count] { ++count; });
+	Slot<> unbinding([&slot] { slot.unbind(); });
+	signal.bind(unbinding);
+	signal.bind(slot);
+
+	signal.broadcast();
+	signal.broadcast();
+	EXPECT_EQ(count, 0);
+	EXPECT_EQ(signal.getSlotCount(), 1);
+	unbinding.unbind();
+	EXPECT_EQ(signal.getSlotCount(), 0);
+}
@@ -0,0 +1,57 @@
+#include "Utils/StringId.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace Stone;
+
+TEST(StringId, SameStringSameId) {
+	StringId diffuse("diffuse");
+	EXPECT_EQ(diffuse, StringId(std::string("diff") + "use"));
+	EXPECT_EQ(diffuse, "diffuse"_id);
+	EXPECT_NE(diffuse, StringId("specular"));
+	EXPECT_EQ(diffuse.str(), "diffuse");
+	EXPECT_EQ(diffuse.getHash(), StringId::hash("diffuse"));
+
+	static_assert(StringId::hash("diffuse") != StringId::hash("specular"));
+}
+
+TEST(StringId, EmptyString) {
+	EXPECT_TRUE(StringId().empty());
+	EXPECT_EQ(StringId(""), StringId());
+	EXPECT_EQ(StringId().str(), "");
+	EXPECT_EQ(StringId::find(""), StringId());
+}
+
+TEST(StringId, FindDoesNotIntern) {
+	std::size_t count = StringId::count();
+	EXPECT_EQ(StringId::find("never interned string"), std::nullopt);
+	EXPECT_EQ(StringId::count(), count);
+
+	StringId id("now interned string");
+	EXPECT_EQ(StringId::count(), count + 1);
+	EXPECT_EQ(StringId::find("now interned string"), id);
+}
+
+TEST(StringId, ConcurrentInterning) {
+	std::vector<std::vector<StringId>> ids(4);
+	std::vector<std::thread> threads;
+	for (auto &threadIds : ids) {
+		threads.emplace_back([&threadIds] {
+			for (int index = 0; index < 1000; ++index) {
+				threadIds.emplace_back("concurrent_" + std::to_string(index));
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	std::unordered_set<StringId> distinct(ids[0].begin(), ids[0].end());
+	EXPECT_EQ(distinct.size(), 1000);
+	for (const auto &threadIds : ids) {
+		EXPECT_EQ(threadIds, ids[0]);
+	}
+}
@@ -4,6 +4,12 @@
 
 #include "Window/WindowSettings.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 namespace Stone::Scene {
 class WorldNode;
 }
@@ -40,6 +46,12 @@ protected:
 	void _onCloseCallback();
 	void _onResizeCallback(int width, int height);
 
+	/**
+	 * @brief Block until the render thread has drawn every snapshot, so the renderer can be modified.
+	 */
+	void _waitRenderThreadIdle();
+	void _stopRenderThread();
+
 	std::weak_ptr<App> _app;
 	WindowSettings _settings;
 	std::shared_ptr<Stone::Scene::WorldNode> _world;
@@ -47,6 +59,19 @@ protected:
 
 	double _elapsedTime = 0;
 	double _deltaTime = 0;
+
+private:
+	void _startRenderThread();
+	void _renderThreadLoop();
+
+	std::thread _renderThread;
+	std::mutex _renderMutex;
+	std::condition_variable _renderCondition;
+	std::deque<uint32_t> _pendingSnapshots; /**< Snapshots written by the simulation, in order. */
+	std::vector<uint32_t> _freeSnapshots;	/**< Snapshots the simulation can write. */
+	bool _renderThreadStopping = false;
+	bool _renderThreadBusy = false;
+	std::exception_ptr _renderThreadException;
 };
 
 } // namespace Stone::Window
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -15,6 +16,10 @@ struct WindowSettings {
 	bool fullScreen = false;
 	bool resizable = true;
 	std::weak_ptr<class Window> shareContext;
+	/** Record and present frames on a dedicated thread while the next frame is simulated. */
+	bool renderThread = false;
+	/** Number of frames the simulation can get ahead of the render thread. */
+	uint32_t renderLatency = 1;
 };
 
 } // namespace Stone::Window
@@ -2,11 +2,11 @@
 
 #include "Window/App.hpp"
 
+#include "Logging/Logger.hpp"
 #include "Window/GlfwWindow.hpp"
 #include "Window/Window.hpp"
 
 #include <algorithm>
-#include <iostream>
 
 namespace Stone::Window {
 
@@ -44,7 +44,8 @@ int App::run() {
 			}
 		}
 	} catch (const std::exception &e) {
-		std::cerr << "Stone Application ends with Exception: " << e.what() << std::endl;
+		STONE_LOG_ERROR("App", "Stone Application ends with Exception: {}", e.what());
+		Logging::Logger::instance().flush();
 		return 1;
 	}
 	return 0;
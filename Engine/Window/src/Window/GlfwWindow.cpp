@@ -62,6 +62,7 @@ GlfwWindow::GlfwWindow(const std::shared_ptr<App> &app, const WindowSettings &se
 }
 
 GlfwWindow::~GlfwWindow() {
+	_stopRenderThread();
 	if (_glfwWindow != nullptr) {
 		glfwDestroyWindow(_glfwWindow);
 	}
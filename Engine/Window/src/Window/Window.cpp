@@ -2,31 +2,81 @@
 
 #include "Window/Window.hpp"
 
+#include "Logging/Logger.hpp"
+#include "Logging/Profiler.hpp"
 #include "Render/Renderer.hpp"
 #include "Scene/Node/WorldNode.hpp"
 #include "Window/App.hpp"
 
-#include <iostream>
+#include <algorithm>
 
 namespace Stone::Window {
 
 Window::Window(const std::shared_ptr<App> &app, WindowSettings settings)
 	: std::enable_shared_from_this<Window>(), _app(app), _settings(std::move(settings)) {
-	std::cout << "window [" << this << "] created" << std::endl;
-	_world = std::make_shared<Stone::Scene::WorldNode>();
+	STONE_LOG_DEBUG("Window", "window [{}] created", this);
+	_world = Stone::Scene::WorldNode::create();
 }
 
 Window::~Window() {
-	std::cout << "window [" << this << "] destroyed" << std::endl;
+	_stopRenderThread();
+	STONE_LOG_DEBUG("Window", "window [{}] destroyed", this);
 }
 
 void Window::loopOnce() {
-	_world->traverseTopDown(
-		[this](const std::shared_ptr<Scene::Node> &node) { node->update(static_cast<float>(_deltaTime)); });
+	STONE_PROFILE_SCOPE("Window::loopOnce");
 
-	if (_renderer) {
+	{
+		STONE_PROFILE_SCOPE("Update nodes");
+		_world->updateNodes(static_cast<float>(_deltaTime));
+	}
+
+	if (!_renderer) {
+		return;
+	}
+
+	if (!_settings.renderThread) {
 		_renderer->updateDataForWorld(_world);
 		_renderer->renderWorld(_world);
+		return;
+	}
+
+	if (!_renderThread.joinable()) {
+		_startRenderThread();
+	}
+
+	uint32_t slot;
+	{
+		STONE_PROFILE_SCOPE("Wait free snapshot");
+		std::unique_lock<std::mutex> lock(_renderMutex);
+		_renderCondition.wait(lock, [this] { return !_freeSnapshots.empty() || _renderThreadException; });
+		if (_renderThreadException) {
+			std::exception_ptr exception = _renderThreadException;
+			_renderThreadException = nullptr;
+			std::rethrow_exception(exception);
+		}
+		slot = _freeSnapshots.back();
+		_freeSnapshots.pop_back();
+	}
+
+	try {
+		_renderer->snapshotWorld(_world, slot);
+	} catch (...) {
+		std::unique_lock<std::mutex> lock(_renderMutex);
+		_freeSnapshots.push_back(slot);
+		throw;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(_renderMutex);
+		_pendingSnapshots.push_back(slot);
+	}
+	_renderCondition.notify_all();
+
+	{
+		// The render thread reads the renderables that changed before drawing the snapshot
+		STONE_PROFILE_SCOPE("Wait snapshot released");
+		_renderer->waitSnapshotReleased(slot);
 	}
 }
 
@@ -47,36 +97,109 @@ std::shared_ptr<Stone::Scene::WorldNode> Window::getWorld() const {
 }
 
 void Window::_onMouseMoveCallback(double x, double y) {
-	std::cout << this << ":mouse move " << x << " " << y << std::endl;
+	STONE_LOG_TRACE("Window", "{}:mouse move {} {}", this, x, y);
 }
 
 void Window::_onMouseButtonCallback(int button, int action, int mods) {
-	std::cout << this << ":mouse button " << button << " " << action << " " << mods << std::endl;
+	STONE_LOG_TRACE("Window", "{}:mouse button {} {} {}", this, button, action, mods);
 	if (button == 2 && action == 1) {
 		_app.lock()->createWindow(_settings);
 	}
 }
 
 void Window::_onScrollCallback(double x, double y) {
-	std::cout << this << ":scroll " << x << " " << y << std::endl;
+	STONE_LOG_TRACE("Window", "{}:scroll {} {}", this, x, y);
 }
 
 void Window::_onKeyCallback(int key, int scancode, int action, int mods) {
-	std::cout << this << ":key " << key << " " << scancode << " " << action << " " << mods << std::endl;
+	STONE_LOG_TRACE("Window", "{}:key {} {} {} {}", this, key, scancode, action, mods);
 }
 
 void Window::_onCharCallback(unsigned int codepoint) {
-	std::cout << this << ":char " << codepoint << std::endl;
+	STONE_LOG_TRACE("Window", "{}:char {}", this, codepoint);
 }
 
 void Window::_onCloseCallback() {
-	std::cout << this << ":closed" << std::endl;
+	STONE_LOG_DEBUG("Window", "{}:closed", this);
 	getApp()->destroyWindow(shared_from_this());
 }
 
 void Window::_onResizeCallback(int width, int height) {
-	std::cout << this << ":resize " << width << " " << height << std::endl;
+	STONE_LOG_DEBUG("Window", "{}:resize {} {}", this, width, height);
+	_waitRenderThreadIdle();
 	_renderer->updateFrameSize({static_cast<uint32_t>(width), static_cast<uint32_t>(height)});
 }
 
+void Window::_startRenderThread() {
+	uint32_t snapshotCount = std::max(_settings.renderLatency, 1U) + 1;
+	_renderer->setSnapshotCount(snapshotCount);
+
+	_pendingSnapshots.clear();
+	_freeSnapshots.clear();
+	for (uint32_t slot = 0; slot < snapshotCount; ++slot) {
+		_freeSnapshots.push_back(snapshotCount - 1 - slot);
+	}
+	_renderThreadStopping = false;
+	_renderThreadBusy = false;
+
+	_renderThread = std::thread(&Window::_renderThreadLoop, this);
+}
+
+void Window::_renderThreadLoop() {
+	STONE_PROFILE_THREAD_NAME("Render");
+
+	while (true) {
+		uint32_t slot;
+		{
+			std::unique_lock<std::mutex> lock(_renderMutex);
+			_renderCondition.wait(lock, [this] { return _renderThreadStopping || !_pendingSnapshots.empty(); });
+			if (_renderThreadStopping) {
+				return;
+			}
+			slot = _pendingSnapshots.front();
+			_pendingSnapshots.pop_front();
+			_renderThreadBusy = true;
+		}
+
+		std::exception_ptr exception;
+		try {
+			_renderer->renderSnapshot(slot);
+		} catch (...) {
+			exception = std::current_exception();
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(_renderMutex);
+			if (exception) {
+				_renderThreadException = exception;
+			}
+			_renderThreadBusy = false;
+			_freeSnapshots.push_back(slot);
+		}
+		_renderCondition.notify_all();
+	}
+}
+
+void Window::_waitRenderThreadIdle() {
+	if (!_renderThread.joinable()) {
+		return;
+	}
+	std::unique_lock<std::mutex> lock(_renderMutex);
+	_renderCondition.wait(lock, [this] {
+		return (_pendingSnapshots.empty() && !_renderThreadBusy) || _renderThreadException;
+	});
+}
+
+void Window::_stopRenderThread() {
+	if (!_renderThread.joinable()) {
+		return;
+	}
+	{
+		std::unique_lock<std::mutex> lock(_renderMutex);
+		_renderThreadStopping = true;
+	}
+	_renderCondition.notify_all();
+	_renderThread.join();
+}
+
 } // namespace Stone::Window
@@ -0,0 +1,173 @@
+// Copyright 2024 Stone-Engine
+
+#include "SceneGenerator.hpp"
+
+#include "Scene/Node/PivotNode.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Stone::Benchmarks {
+
+uint64_t SceneShape::nodeCount() const {
+	uint64_t count = 0;
+	uint64_t levelCount = 1;
+	for (uint32_t level = 0; level < depth; ++level) {
+		levelCount *= branching;
+		count += levelCount;
+	}
+	return count;
+}
+
+SceneShape SceneShape::withNodeCount(uint64_t nodeCount, uint32_t branching) {
+	SceneShape shape = {1, branching};
+	while (shape.nodeCount() < nodeCount) {
+		shape.depth++;
+	}
+	return shape;
+}
+
+static void generateChildren(const std::shared_ptr<Scene::Node> &parent, uint32_t remainingDepth, uint32_t branching,
+							 std::mt19937 &random) {
+	if (remainingDepth == 0) {
+		return;
+	}
+
+	std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+	for (uint32_t index = 0; index < branching; ++index) {
+		auto child = parent->addChild<Scene::PivotNode>("child_" + std::to_string(index));
+		Scene::Transform3D &transform = child->getTransform();
+		transform.setPosition({position(random), position(random), position(random)});
+		transform.setEulerAngles({angle(random), angle(random), angle(random)});
+		transform.setScale(glm::vec3(scale(random)));
+		generateChildren(child, remainingDepth - 1, branching, random);
+	}
+}
+
+std::shared_ptr<Scene::WorldNode> generateScene(const SceneShape &shape, uint32_t seed,
+												const std::shared_ptr<Core::Memory::Arena> &arena) {
+	std::mt19937 random(seed);
+	auto world = Scene::WorldNode::create();
+	world->setArena(arena);
+	generateChildren(world, shape.depth, shape.branching, random);
+	return world;
+}
+
+std::string deepestNodePath(const SceneShape &shape) {
+	std::string path;
+	for (uint32_t level = 0; level < shape.depth; ++level) {
+		path += level == 0 ? "child_0" : "/child_0";
+	}
+	return path;
+}
+
+std::string generateJson(size_t objectCount, uint32_t seed) {
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<double> number(-1000.0, 1000.0);
+	std::uniform_int_distribution<int> coin(0, 1);
+
+	std::ostringstream stream;
+	stream << "{\"objects\":[";
+	for (size_t index = 0; index < objectCount; ++index) {
+		if (index > 0) {
+			stream << ',';
+		}
+		stream << "{\"name\":\"object_" << index << "\",\"value\":" << number(random)
+			   << ",\"enabled\":" << (coin(random) ? "true" : "false") << ",\"parent\":null"
+			   << ",\"position\":[" << number(random) << ',' << number(random) << ',' << number(random) << ']'
+			   << ",\"tags\":[\"static\",\"mesh\",\"escaped \\\"quote\\\"\"]}";
+	}
+	stream << "]}";
+	return stream.str();
+}
+
+static void writeLittleEndian(std::ofstream &file, uint32_t value, int byteCount) {
+	for (int byte = 0; byte < byteCount; ++byte) {
+		file.put(static_cast<char>((value >> (8 * byte)) & 0xFF));
+	}
+}
+
+std::string writeBmp(const std::string &directory, int width, int height, uint32_t seed) {
+	std::string path = directory + "/image_" + std::to_string(width) + "x" + std::to_string(height) + ".bmp";
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) {
+		throw std::runtime_error("Failed to write benchmark image: " + path);
+	}
+
+	const uint32_t rowSize = (static_cast<uint32_t>(width) * 3 + 3) & ~3U;
+	const uint32_t pixelsSize = rowSize * static_cast<uint32_t>(height);
+
+	// File header
+	file.write("BM", 2);
+	writeLittleEndian(file, 54 + pixelsSize, 4);
+	writeLittleEndian(file, 0, 4);
+	writeLittleEndian(file, 54, 4);
+
+	// Info header
+	writeLittleEndian(file, 40, 4);
+	writeLittleEndian(file, static_cast<uint32_t>(width), 4);
+	writeLittleEndian(file, static_cast<uint32_t>(height), 4);
+	writeLittleEndian(file, 1, 2);
+	writeLittleEndian(file, 24, 2);
+	writeLittleEndian(file, 0, 4);
+	writeLittleEndian(file, pixelsSize, 4);
+	writeLittleEndian(file, 2835, 4);
+	writeLittleEndian(file, 2835, 4);
+	writeLittleEndian(file, 0, 4);
+	writeLittleEndian(file, 0, 4);
+
+	std::mt19937 random(seed);
+	std::vector<char> row(rowSize, 0);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width * 3; ++x) {
+			row[x] = static_cast<char>(random() & 0xFF);
+		}
+		file.write(row.data(), static_cast<std::streamsize>(row.size()));
+	}
+	return path;
+}
+
+std::string writeObjGrid(const std::string &directory, int size) {
+	std::string path = directory + "/grid_" + std::to_string(size) + ".obj";
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open()) {
+		throw std::runtime_error("Failed to write benchmark mesh: " + path);
+	}
+
+	for (int z = 0; z <= size; ++z) {
+		for (int x = 0; x <= size; ++x) {
+			file << "v " << x << " 0 " << z << '\n';
+			file << "vt " << static_cast<float>(x) / static_cast<float>(size) << ' '
+				 << static_cast<float>(z) / static_cast<float>(size) << '\n';
+		}
+	}
+	file << "vn 0 1 0\n";
+
+	// Obj indices start at 1
+	auto vertex = [size](int x, int z) { return z * (size + 1) + x + 1; };
+	for (int z = 0; z < size; ++z) {
+		for (int x = 0; x < size; ++x) {
+			file << "f";
+			for (int corner : {vertex(x, z), vertex(x, z + 1), vertex(x + 1, z + 1), vertex(x + 1, z)}) {
+				file << ' ' << corner << '/' << corner << "/1";
+			}
+			file << '\n';
+		}
+	}
+	return path;
+}
+
+std::string benchmarkDirectory() {
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "stone_benchmarks";
+	std::filesystem::create_directories(directory);
+	return directory.string();
+}
+
+} // namespace Stone::Benchmarks
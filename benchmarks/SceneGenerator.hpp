@@ -0,0 +1,68 @@
+// Copyright 2024 Stone-Engine
+
+#pragma once
+
+#include "Scene/Node/WorldNode.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Stone::Benchmarks {
+
+/**
+ * @brief The shape of a generated scene: every node down to the given depth has the same number of children.
+ */
+struct SceneShape {
+	uint32_t depth = 4;
+	uint32_t branching = 4;
+
+	/**
+	 * @brief The number of nodes under the world, without the world itself.
+	 */
+	[[nodiscard]] uint64_t nodeCount() const;
+
+	/**
+	 * @brief A shape with roughly the given number of nodes, for benchmarks parameterized by the scene size.
+	 */
+	static SceneShape withNodeCount(uint64_t nodeCount, uint32_t branching = 4);
+};
+
+/**
+ * @brief Generate a world of pivot nodes named child_<index>, with random transforms from a fixed seed.
+ *
+ * @param arena The arena of the world in which the nodes are created, or nullptr to create them in their pool.
+ */
+std::shared_ptr<Scene::WorldNode> generateScene(const SceneShape &shape, uint32_t seed = 42,
+												const std::shared_ptr<Core::Memory::Arena> &arena = nullptr);
+
+/**
+ * @brief The path of the first node of the deepest level of a generated scene, like child_0/child_0/child_0.
+ */
+std::string deepestNodePath(const SceneShape &shape);
+
+/**
+ * @brief Generate a Json document of objects holding strings, numbers, booleans and nested arrays.
+ */
+std::string generateJson(size_t objectCount, uint32_t seed = 42);
+
+/**
+ * @brief Write an uncompressed 24 bits BMP of random pixels, decodable by stb_image.
+ *
+ * @return The path of the written file.
+ */
+std::string writeBmp(const std::string &directory, int width, int height, uint32_t seed = 42);
+
+/**
+ * @brief Write a Wavefront OBJ grid of size x size quads, importable by assimp.
+ *
+ * @return The path of the written file.
+ */
+std::string writeObjGrid(const std::string &directory, int size);
+
+/**
+ * @brief A directory for the generated files, inside the temporary directory of the system.
+ */
+std::string benchmarkDirectory();
+
+} // namespace Stone::Benchmarks
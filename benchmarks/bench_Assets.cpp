@@ -0,0 +1,75 @@
+// Copyright 2024 Stone-Engine
+
+#include "Core/Assets/Bundle.hpp"
+#include "Core/Image/ImageData.hpp"
+#include "Scene/Assets/AssetResource.hpp"
+#include "SceneGenerator.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace Stone;
+
+namespace {
+
+class EmptyResource : public Core::Assets::Resource {
+public:
+	EmptyResource(const std::shared_ptr<Core::Assets::Bundle> &bundle, const std::string &filepath)
+		: Resource(bundle, filepath) {
+	}
+
+	const char *getClassName() const override {
+		return "EmptyResource";
+	}
+};
+
+} // namespace
+
+static void BM_BundleLoadResourceCached(benchmark::State &state) {
+	auto bundle = std::make_shared<Core::Assets::Bundle>();
+	for (int64_t index = 0; index < state.range(0); ++index) {
+		bundle->loadResource<EmptyResource>("resources/file_" + std::to_string(index) + ".txt");
+	}
+	const std::string path = "./resources/../resources/file_0.txt";
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(bundle->loadResource<EmptyResource>(path));
+	}
+}
+BENCHMARK(BM_BundleLoadResourceCached)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_BundleLoadResourceNew(benchmark::State &state) {
+	auto bundle = std::make_shared<Core::Assets::Bundle>();
+	int64_t index = 0;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(bundle->loadResource<EmptyResource>("file_" + std::to_string(index++) + ".txt"));
+	}
+}
+BENCHMARK(BM_BundleLoadResourceNew);
+
+static void BM_ImageDataDecode(benchmark::State &state) {
+	const auto size = static_cast<int>(state.range(0));
+	std::string path = Benchmarks::writeBmp(Benchmarks::benchmarkDirectory(), size, size);
+
+	for (auto _ : state) {
+		Core::Image::ImageData image(path, Core::Image::Channel::RGBA);
+		benchmark::DoNotOptimize(image.getData());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size * size * 4));
+}
+BENCHMARK(BM_ImageDataDecode)->RangeMultiplier(4)->Range(64, 2048)->Unit(benchmark::kMillisecond);
+
+static void BM_AssetResourceImport(benchmark::State &state) {
+	const std::string directory = Benchmarks::benchmarkDirectory();
+	std::string path = Benchmarks::writeObjGrid(directory, static_cast<int>(state.range(0)));
+	auto bundle = std::make_shared<Core::Assets::Bundle>(directory);
+	std::string filename = path.substr(directory.size() + 1);
+
+	for (auto _ : state) {
+		// Constructed directly, the bundle would return its cached resource
+		auto asset = std::make_shared<Scene::AssetResource>(bundle, filename);
+		benchmark::DoNotOptimize(asset->getMeshes());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+BENCHMARK(BM_AssetResourceImport)->RangeMultiplier(4)->Range(8, 512)->Unit(benchmark::kMillisecond);
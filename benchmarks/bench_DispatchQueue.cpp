@@ -0,0 +1,43 @@
+// Copyright 2024 Stone-Engine
+
+#include "Utils/DispatchQueue.hpp"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <thread>
+
+using namespace Stone;
+
+static void BM_DispatchQueueExecute(benchmark::State &state) {
+	DispatchQueue queue;
+	int64_t count = 0;
+
+	for (auto _ : state) {
+		for (int64_t index = 0; index < state.range(0); ++index) {
+			queue.async([&count] { ++count; });
+		}
+		queue.execute();
+	}
+	benchmark::DoNotOptimize(count);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DispatchQueueExecute)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_DispatchQueueCrossThread(benchmark::State &state) {
+	for (auto _ : state) {
+		DispatchQueue queue;
+		std::atomic<int64_t> count = 0;
+		std::thread consumer([&queue] { queue.run(); });
+
+		for (int64_t index = 0; index < state.range(0); ++index) {
+			queue.async([&count] { count.fetch_add(1, std::memory_order_relaxed); });
+		}
+		// The lowest priority, runs after every other task
+		queue.async(-1, [&queue] { queue.stop(); });
+		consumer.join();
+
+		benchmark::DoNotOptimize(count.load());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DispatchQueueCrossThread)->RangeMultiplier(10)->Range(100, 100000)->UseRealTime();
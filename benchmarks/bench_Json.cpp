@@ -0,0 +1,107 @@
+// Copyright 2024 Stone-Engine
+
+#include "SceneGenerator.hpp"
+#include "Utils/Json.hpp"
+#include "Utils/JsonDocument.hpp"
+#include "Utils/JsonMessagePack.hpp"
+#include "Utils/JsonStream.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace Stone;
+
+static void BM_JsonParseString(benchmark::State &state) {
+	std::string input = Benchmarks::generateJson(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		Json::Value value;
+		Json::Value::parseString(input, value);
+		benchmark::DoNotOptimize(value);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_JsonParseString)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_JsonDocumentParseString(benchmark::State &state) {
+	std::string input = Benchmarks::generateJson(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		Json::Document document;
+		Json::Document::parseString(input, document);
+		benchmark::DoNotOptimize(document);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_JsonDocumentParseString)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_JsonSerialize(benchmark::State &state) {
+	Json::Value value;
+	Json::Value::parseString(Benchmarks::generateJson(static_cast<size_t>(state.range(0))), value);
+
+	size_t outputSize = 0;
+	for (auto _ : state) {
+		std::string output = value.serialize();
+		outputSize = output.size();
+		benchmark::DoNotOptimize(output);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * outputSize));
+}
+BENCHMARK(BM_JsonSerialize)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_JsonStreamRead(benchmark::State &state) {
+	std::string input = Benchmarks::generateJson(static_cast<size_t>(state.range(0)));
+	Json::Handler handler;
+
+	for (auto _ : state) {
+		Json::StreamReader reader(handler);
+		for (size_t pos = 0; pos < input.size(); pos += Json::StreamReader::defaultChunkSize) {
+			reader.feed(std::string_view(input).substr(pos, Json::StreamReader::defaultChunkSize));
+		}
+		reader.finish();
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_JsonStreamRead)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_JsonStreamWrite(benchmark::State &state) {
+	Json::Value value;
+	Json::Value::parseString(Benchmarks::generateJson(static_cast<size_t>(state.range(0))), value);
+
+	size_t outputSize = 0;
+	for (auto _ : state) {
+		std::string output;
+		Json::StreamWriter(output).value(value);
+		outputSize = output.size();
+		benchmark::DoNotOptimize(output);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * outputSize));
+}
+BENCHMARK(BM_JsonStreamWrite)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_JsonMessagePackEncode(benchmark::State &state) {
+	Json::Value value;
+	Json::Value::parseString(Benchmarks::generateJson(static_cast<size_t>(state.range(0))), value);
+
+	size_t outputSize = 0;
+	for (auto _ : state) {
+		std::vector<char> output = Json::toMessagePack(value);
+		outputSize = output.size();
+		benchmark::DoNotOptimize(output);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * outputSize));
+}
+BENCHMARK(BM_JsonMessagePackEncode)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_JsonMessagePackDecode(benchmark::State &state) {
+	Json::Value value;
+	Json::Value::parseString(Benchmarks::generateJson(static_cast<size_t>(state.range(0))), value);
+	std::vector<char> input = Json::toMessagePack(value);
+
+	for (auto _ : state) {
+		Json::Value decoded;
+		Json::fromMessagePack(std::string_view(input.data(), input.size()), decoded);
+		benchmark::DoNotOptimize(decoded);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_JsonMessagePackDecode)->RangeMultiplier(10)->Range(10, 10000);
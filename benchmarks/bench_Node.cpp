@@ -0,0 +1,217 @@
+// Copyright 2024 Stone-Engine
+
+#include "Core/Handle.hpp"
+#include "Scene/Component/ComponentBridge.hpp"
+#include "Scene/Component/Components.hpp"
+#include "Scene/Node/PivotNode.hpp"
+#include "Scene/SceneArchive.hpp"
+#include "Scene/ScenePatch.hpp"
+#include "SceneGenerator.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace Stone;
+
+static void BM_SceneGenerate(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Benchmarks::generateScene(shape));
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * shape.nodeCount()));
+}
+BENCHMARK(BM_SceneGenerate)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_SceneGenerateInArena(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+
+	for (auto _ : state) {
+		auto arena = std::make_shared<Core::Memory::Arena>(1 << 20);
+		benchmark::DoNotOptimize(Benchmarks::generateScene(shape, 42, arena));
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * shape.nodeCount()));
+}
+BENCHMARK(BM_SceneGenerateInArena)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_NodeWorldTransformMatrix(benchmark::State &state) {
+	Benchmarks::SceneShape shape = {static_cast<uint32_t>(state.range(0)), 2};
+	auto world = Benchmarks::generateScene(shape);
+	auto deepest = world->getChildByPath(Benchmarks::deepestNodePath(shape));
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(deepest->getWorldTransformMatrix());
+	}
+}
+BENCHMARK(BM_NodeWorldTransformMatrix)->DenseRange(2, 12, 2);
+
+static void BM_NodeTraverseTopDown(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+	auto world = Benchmarks::generateScene(shape);
+
+	for (auto _ : state) {
+		uint64_t count = 0;
+		world->traverseTopDown([&count](const std::shared_ptr<Scene::Node> &) { ++count; });
+		benchmark::DoNotOptimize(count);
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (shape.nodeCount() + 1)));
+}
+BENCHMARK(BM_NodeTraverseTopDown)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_NodeForEachTopDown(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+	auto world = Benchmarks::generateScene(shape);
+
+	for (auto _ : state) {
+		uint64_t count = 0;
+		world->forEachTopDown([&count](Scene::Node &) { ++count; });
+		benchmark::DoNotOptimize(count);
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (shape.nodeCount() + 1)));
+}
+BENCHMARK(BM_NodeForEachTopDown)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_NodeForEachOfType(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+	auto world = Benchmarks::generateScene(shape);
+
+	for (auto _ : state) {
+		uint64_t count = 0;
+		world->forEachOfType<Scene::PivotNode>([&count](Scene::PivotNode &) { ++count; });
+		benchmark::DoNotOptimize(count);
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (shape.nodeCount() + 1)));
+}
+BENCHMARK(BM_NodeForEachOfType)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_NodeCreateOfClass(benchmark::State &state) {
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Scene::Node::createOfClass("PivotNode", "pivot"));
+	}
+}
+BENCHMARK(BM_NodeCreateOfClass);
+
+static void BM_NodeHandleLock(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+	auto world = Benchmarks::generateScene(shape);
+	std::vector<Core::Handle<Scene::Node>> handles;
+	world->forEachTopDown([&handles](Scene::Node &node) { handles.emplace_back(node); });
+
+	for (auto _ : state) {
+		for (const auto &handle : handles)
+			benchmark::DoNotOptimize(handle.lock());
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * handles.size()));
+}
+BENCHMARK(BM_NodeHandleLock)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_ComponentSync(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+	auto world = Benchmarks::generateScene(shape);
+	Scene::ComponentBridge bridge;
+
+	for (auto _ : state) {
+		bridge.sync(*world);
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * shape.nodeCount()));
+}
+BENCHMARK(BM_ComponentSync)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_ComponentEachTransform(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+	auto world = Benchmarks::generateScene(shape);
+	Scene::ComponentBridge bridge;
+	bridge.sync(*world);
+
+	for (auto _ : state) {
+		float sum = 0.0f;
+		bridge.getStore().each<Scene::TransformComponent>(
+			[&sum](Scene::Entity, Scene::TransformComponent &transform) { sum += transform.worldMatrix[3][0]; });
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * shape.nodeCount()));
+}
+BENCHMARK(BM_ComponentEachTransform)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_NodeGetChildByPath(benchmark::State &state) {
+	Benchmarks::SceneShape shape = {static_cast<uint32_t>(state.range(0)), 8};
+	auto world = Benchmarks::generateScene(shape);
+	std::string path = Benchmarks::deepestNodePath(shape);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(world->getChildByPath(path));
+	}
+}
+BENCHMARK(BM_NodeGetChildByPath)->DenseRange(1, 5);
+
+static void BM_NodeGetChildByPathWildcard(benchmark::State &state) {
+	Benchmarks::SceneShape shape = {3, static_cast<uint32_t>(state.range(0))};
+	auto world = Benchmarks::generateScene(shape);
+	std::string path = "*/child_" + std::to_string(state.range(0) - 1);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(world->getChildByPath(path));
+	}
+}
+BENCHMARK(BM_NodeGetChildByPathWildcard)->RangeMultiplier(2)->Range(2, 16);
+
+static void BM_NodeGetChildByPathWildcardUnique(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+	auto world = Benchmarks::generateScene(shape);
+	std::shared_ptr<Scene::Node> last = world;
+	while (!last->getChildren().empty()) {
+		last = last->getChildren().back();
+	}
+	last->setName("target");
+
+	// The last node of a top-down traversal, found with the name index of the world
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(world->getChildByPath("*/target"));
+	}
+}
+BENCHMARK(BM_NodeGetChildByPathWildcardUnique)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_SceneArchiveWrite(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+	auto world = Benchmarks::generateScene(shape);
+	std::vector<char> data;
+
+	for (auto _ : state) {
+		data.clear();
+		Scene::SceneArchive::write(world, data);
+		benchmark::DoNotOptimize(data.data());
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (shape.nodeCount() + 1)));
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+BENCHMARK(BM_SceneArchiveWrite)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_SceneArchiveRead(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+	std::vector<char> data;
+	Scene::SceneArchive::write(Benchmarks::generateScene(shape), data);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Scene::SceneArchive::read(std::string_view(data.data(), data.size())));
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (shape.nodeCount() + 1)));
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+BENCHMARK(BM_SceneArchiveRead)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_ScenePatchSmallEdit(benchmark::State &state) {
+	auto shape = Benchmarks::SceneShape::withNodeCount(static_cast<uint64_t>(state.range(0)));
+	std::vector<char> data;
+	Scene::SceneArchive::write(Benchmarks::generateScene(shape), data);
+	auto world = Scene::SceneArchive::read(std::string_view(data.data(), data.size()));
+	auto edited = Scene::SceneArchive::read(std::string_view(data.data(), data.size()));
+	auto pivot = edited->getChildByPath<Scene::PivotNode>(Benchmarks::deepestNodePath(shape));
+	float position = 0.0f;
+
+	// The hot reload of a scene where a single node moved, compared to reading the whole scene again
+	for (auto _ : state) {
+		pivot->getTransform().setPosition(glm::vec3(position += 1.0f));
+		Scene::ScenePatch::diff(world, edited).apply(world);
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (shape.nodeCount() + 1)));
+}
+BENCHMARK(BM_ScenePatchSmallEdit)->RangeMultiplier(8)->Range(64, 32768);
@@ -0,0 +1,76 @@
+// Copyright 2024 Stone-Engine
+
+#include "Utils/SigSlot.hpp"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using namespace Stone;
+
+static void BM_SignalBroadcast(benchmark::State &state) {
+	int64_t sum = 0;
+	Signal<int> signal;
+	std::vector<std::unique_ptr<Slot<int>>> slots;
+	for (int64_t index = 0; index < state.range(0); ++index) {
+		slots.push_back(std::make_unique<Slot<int>>([&sum](int value) { sum += value; }));
+		signal.bind(*slots.back());
+	}
+
+	for (auto _ : state) {
+		signal.broadcast(1);
+	}
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SignalBroadcast)->RangeMultiplier(8)->Range(1, 512);
+
+static void BM_SignalBindUnbind(benchmark::State &state) {
+	Signal<int> signal;
+	Slot<int> slot([](int value) { benchmark::DoNotOptimize(value); });
+
+	for (auto _ : state) {
+		signal.bind(slot);
+		signal.unbind(slot);
+	}
+}
+BENCHMARK(BM_SignalBindUnbind);
+
+static void BM_ConcurrentSignalBroadcast(benchmark::State &state) {
+	std::atomic<int64_t> sum = 0;
+	ConcurrentSignal<int> signal;
+	std::vector<std::unique_ptr<Slot<int>>> slots;
+	for (int64_t index = 0; index < state.range(0); ++index) {
+		slots.push_back(
+			std::make_unique<Slot<int>>([&sum](int value) { sum.fetch_add(value, std::memory_order_relaxed); }));
+		signal.bind(*slots.back());
+	}
+
+	for (auto _ : state) {
+		signal.broadcast(1);
+	}
+	benchmark::DoNotOptimize(sum.load());
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConcurrentSignalBroadcast)->RangeMultiplier(8)->Range(1, 512);
+
+static void BM_SignalQueuedBurst(benchmark::State &state) {
+	DispatchQueue queue;
+	int64_t sum = 0;
+	Signal<int> signal;
+	Slot<int> slot([&sum](int value) { sum += value; }, queue, static_cast<QueuedDelivery>(state.range(1)));
+	signal.bind(slot);
+
+	for (auto _ : state) {
+		for (int64_t index = 0; index < state.range(0); ++index) {
+			signal.broadcast(1);
+		}
+		queue.execute();
+	}
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SignalQueuedBurst)
+	->ArgsProduct({{1, 64, 4096},
+				   {static_cast<int64_t>(QueuedDelivery::All), static_cast<int64_t>(QueuedDelivery::Latest)}});
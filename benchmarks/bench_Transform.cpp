@@ -0,0 +1,51 @@
+// Copyright 2024 Stone-Engine
+
+#include "Scene/Interpolator.hpp"
+#include "Scene/Transform.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace Stone;
+
+static void BM_Transform3DMatrixCached(benchmark::State &state) {
+	Scene::Transform3D transform;
+	transform.setPosition({1.0f, 2.0f, 3.0f});
+	transform.setEulerAngles({0.1f, 0.2f, 0.3f});
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(transform.getTransformMatrix());
+	}
+}
+BENCHMARK(BM_Transform3DMatrixCached);
+
+static void BM_Transform3DMatrixDirty(benchmark::State &state) {
+	Scene::Transform3D transform;
+	transform.setEulerAngles({0.1f, 0.2f, 0.3f});
+	float x = 0.0f;
+
+	for (auto _ : state) {
+		transform.setPosition({x, 2.0f, 3.0f});
+		benchmark::DoNotOptimize(transform.getTransformMatrix());
+		x += 0.001f;
+	}
+}
+BENCHMARK(BM_Transform3DMatrixDirty);
+
+static void BM_InterpolatorValueAt(benchmark::State &state) {
+	Scene::Interpolator<glm::vec3> interpolator;
+	const auto keyCount = static_cast<float>(state.range(0));
+	for (int64_t index = 0; index < state.range(0); ++index) {
+		auto time = static_cast<float>(index);
+		interpolator.addKeyValueAt({time, time * 2.0f, time * 3.0f}, time, Curve::Function<float>::easeInOut());
+	}
+
+	float time = 0.0f;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(interpolator.valueAt(time));
+		time += 0.37f;
+		if (time >= keyCount) {
+			time = 0.0f;
+		}
+	}
+}
+BENCHMARK(BM_InterpolatorValueAt)->RangeMultiplier(8)->Range(2, 4096);
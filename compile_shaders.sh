@@ -2,3 +2,5 @@
 
 glslc -fshader-stage=vertex -c shaders/vert.glsl -o shaders/vert.spv
 glslc -fshader-stage=fragment -c shaders/frag.glsl -o shaders/frag.spv
+glslc -fshader-stage=vertex -c shaders/vert-bindless.glsl -o shaders/vert-bindless.spv
+glslc -fshader-stage=fragment -c shaders/frag-bindless.glsl -o shaders/frag-bindless.spv
@@ -77,8 +77,7 @@ void testNode() {
 
 template <typename T, typename... Args>
 std::shared_ptr<T> makeNode(const std::string &type, Args... args) {
-	return std::dynamic_pointer_cast<T>(
-		Stone::DynamicObjectFactory<Node, const std::string &>::getInstance().create(type, args...));
+	return std::dynamic_pointer_cast<T>(Node::createOfClass(type, args...));
 }
 
 void testNodeDynamic() {
@@ -13,7 +13,7 @@
 #include <filesystem>
 
 class RotatingNode : public Stone::Scene::PivotNode {
-	STONE_NODE(RotatingNode)
+	STONE_NODE(RotatingNode, Stone::Scene::PivotNode)
 
 public:
 	RotatingNode(const std::string &name = "rotating_node") : PivotNode(name) {
@@ -0,0 +1,44 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+struct MaterialParameters {
+    uint textures[8];
+    vec4 vectors[4];
+    float scalars[8];
+};
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+
+layout(std430, set = 1, binding = 1) readonly buffer Materials {
+    MaterialParameters materials[];
+};
+
+layout(location = 0) in vec2 fragUV;
+layout(location = 1) flat in uint fragMaterialIndex;
+
+layout(location = 0) out vec4 outColor;
+
+// Parameter slots, fixed for every material and matching MaterialParameters in BindlessDescriptors.hpp
+const uint DIFFUSE_TEXTURE = 0;
+const uint EMISSIVE_TEXTURE = 3;
+const uint OCCLUSION_TEXTURE = 4;
+const uint OPACITY_TEXTURE = 7;
+
+const uint DIFFUSE_VECTOR = 0;
+const uint EMISSIVE_VECTOR = 3;
+
+const uint OPACITY_SCALAR = 0;
+
+vec4 sampleTexture(uint slot) {
+    uint textureSlot = materials[nonuniformEXT(fragMaterialIndex)].textures[slot];
+    return texture(textures[nonuniformEXT(textureSlot)], fragUV);
+}
+
+void main() {
+    MaterialParameters material = materials[nonuniformEXT(fragMaterialIndex)];
+    vec4 diffuse = sampleTexture(DIFFUSE_TEXTURE) * material.vectors[DIFFUSE_VECTOR];
+    float occlusion = sampleTexture(OCCLUSION_TEXTURE).r;
+    vec3 emissive = sampleTexture(EMISSIVE_TEXTURE).rgb * material.vectors[EMISSIVE_VECTOR].rgb;
+    float opacity = sampleTexture(OPACITY_TEXTURE).r * material.scalars[OPACITY_SCALAR];
+    outColor = vec4(diffuse.rgb * occlusion + emissive, diffuse.a * opacity);
+}
@@ -0,0 +1,26 @@
+#version 450
+
+layout(set = 0, binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+layout(push_constant) uniform DrawConstants {
+    uint materialIndex;
+} draw;
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in vec3 tangent;
+layout(location = 3) in vec3 bitangent;
+layout(location = 4) in vec2 uv;
+
+layout(location = 0) out vec2 fragUV;
+layout(location = 1) flat out uint fragMaterialIndex;
+
+void main() {
+    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(position, 1.0);
+    fragUV = uv;
+    fragMaterialIndex = draw.materialIndex;
+}